@@ -106,9 +106,12 @@ HEADERS += \
     src/SAKMainWindow.hh \
     src/base/SAKBaseListWidget.hh \
     src/base/SAKBaseListWidgetItemWidget.hh \
+    src/base/SAKBaseDatabaseWorker.hh \
+    src/base/SAKBaseListWidgetStorage.hh \
     src/common/SAKCommonCrcInterface.hh \
     src/common/SAKCommonDataStructure.hh \
     src/common/SAKCommonInterface.hh \
+    src/common/SAKCommonStartupTracer.hh \
     src/update/SAKDownloadItemWidget.hh \
     src/update/SAKUpdateManager.hh
 
@@ -117,9 +120,18 @@ SOURCES += \
     src/SAKMainWindow.cc \
     src/base/SAKBaseListWidget.cc \
     src/base/SAKBaseListWidgetItemWidget.cc \
+    src/base/SAKBaseDatabaseWorker.cc \
+    src/base/SAKBaseListWidgetStorage.cc \
     src/common/SAKCommonCrcInterface.cc \
     src/common/SAKCommonDataStructure.cc \
     src/common/SAKCommonInterface.cc \
+    src/common/SAKCommonStartupTracer.cc \
     src/main.cc \
     src/update/SAKDownloadItemWidget.cc \
     src/update/SAKUpdateManager.cc
+
+#--------------------------------------------------------------------------------------------
+#Headless daemon(qmake CONFIG+=sak_daemon)
+contains(CONFIG, sak_daemon){
+    include(src/daemon/SAKDaemon.pri)
+}
@@ -16,6 +16,7 @@
 #include <QDialog>
 #include <QDateTime>
 #include <QSettings>
+#include <QSqlQuery>
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
 #include <QTextCodec>
 #endif
@@ -31,6 +32,7 @@
 #endif
 
 #include "SAKApplication.hh"
+#include "SAKCommonStartupTracer.hh"
 
 QDate buildDate = QLocale(QLocale::English).toDate(
             QString(__DATE__).replace("  ", " 0"),
@@ -59,6 +61,7 @@ SAKApplication::SAKApplication(int argc, char **argv)
     showSplashScreenMessage(tr("Initializing..."));
     mSplashScreen->show();
     processEvents();
+    SAKCommonStartupTracer::mark(QString("Splash screen"));
 
 
     // Initialize the setting key
@@ -111,6 +114,7 @@ SAKApplication::SAKApplication(int argc, char **argv)
             mSettings->setValue(mSettingsKeyContext.appStyle, defauleStyle);
         }
     }
+    SAKCommonStartupTracer::mark(QString("Settings"));
 
 
     // Initialize database.
@@ -124,11 +128,21 @@ SAKApplication::SAKApplication(int argc, char **argv)
         qWarning() << "QSAKDatabase.sqlite3 open failed:"
                    << mSqlDatabase.lastError().text();
         Q_ASSERT_X(false, __FUNCTION__, "Open database failed!");
+    } else {
+        // Readers are not blocked by the writer and a commit does not wait
+        // for the data to be synced to the disk.
+        QSqlQuery sqlQuery(mSqlDatabase);
+        if (!sqlQuery.exec("PRAGMA journal_mode=WAL")) {
+            qWarning() << "Enable WAL mode failed:" << sqlQuery.lastError().text();
+        }
+        sqlQuery.exec("PRAGMA synchronous=NORMAL");
     }
+    SAKCommonStartupTracer::mark(QString("Database"));
 
 
     // Setup ui language.
     installLanguage();
+    SAKCommonStartupTracer::mark(QString("Language"));
 }
 
 SAKApplication::~SAKApplication()
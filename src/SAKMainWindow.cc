@@ -29,6 +29,7 @@
 #include <QJsonObject>
 #include <QSpacerItem>
 #include <QMessageBox>
+#include <QElapsedTimer>
 #include <QActionGroup>
 #include <QStyleFactory>
 #include <QJsonDocument>
@@ -39,10 +40,12 @@
 #include "SAKApplication.hh"
 #include "SAKUpdateManager.hh"
 #include "SAKCommonDataStructure.hh"
+#include "SAKCommonStartupTracer.hh"
 
 // Debugging tools
 #ifdef SAK_IMPORT_MODULE_FILECHECKER
 #include "SAKToolFileChecker.hh"
+#include "SAKToolFileCheckerBatch.hh"
 #endif
 #include "SAKToolCRCCalculator.hh"
 #ifdef SAK_IMPORT_MODULE_QRCODE
@@ -151,6 +154,7 @@ SAKMainWindow::SAKMainWindow(QSettings *settings,
             this, &SAKMainWindow::removeRemovableDebugPage);
     connect(mTabWidget, &QTabWidget::currentChanged, this, [=](int index){
         sakApp->settings()->setValue(mSettingsKeyContext.currentTabPage, index);
+        createDeferredDebugPage(index);
     });
 
     // Create debugger, the operation will emit the signal named currentChanged.
@@ -169,12 +173,15 @@ SAKMainWindow::SAKMainWindow(QSettings *settings,
         }
 #endif
 #endif
-        // The page can not be closed.
-        QWidget *page = debugPageFromDebugPageType(metaEnum.value(i));
-        if (page){
-            mTabWidget->addTab(page, page->windowTitle());
-            appendWindowAction(page);
-        }
+        // The page can not be closed. Only a container is created here, the
+        // debug page is created when the tab page is activated.
+        QWidget *page = new QWidget(mTabWidget);
+        page->setWindowTitle(debuggerNameFromDebugPageType(metaEnum.value(i)));
+        QHBoxLayout *pageLayout = new QHBoxLayout(page);
+        pageLayout->setContentsMargins(0, 0, 0, 0);
+        mDeferredDebugPageTypes.insert(page, metaEnum.value(i));
+        mTabWidget->addTab(page, page->windowTitle());
+        appendWindowAction(page);
     }
     mTabWidget->blockSignals(false);
     if (mWindowsMenu){
@@ -185,6 +192,7 @@ SAKMainWindow::SAKMainWindow(QSettings *settings,
     int currentPage =
             sakApp->settings()->value(mSettingsKeyContext.currentTabPage).toInt();
     mTabWidget->setCurrentIndex(currentPage);
+    createDeferredDebugPage(mTabWidget->currentIndex());
 
     // Hide the close button,
     // the step must be done after calling setTabsClosable() function.
@@ -539,6 +547,13 @@ void SAKMainWindow::aboutQsak()
     auto dateTimeString = sakApp->buildDate()->toString(QLocale::system().dateFormat());
     dateTimeString = dateTimeString.append(" ");
     dateTimeString = dateTimeString.append(sakApp->buildTime()->toString("hh:mm:ss"));
+    // The timings of startup phases, the debug pages those are activated later
+    // are listed too.
+    QStringList startupPhases;
+    for (auto &ctx : SAKCommonStartupTracer::phases()) {
+        startupPhases.append(QString("%1: %2 ms").arg(ctx.name).arg(ctx.elapsed));
+    }
+
     QList<Info> infoList;
     infoList << Info{tr("Version"), QString(qApp->applicationVersion()), false}
              << Info{tr("Author"), QString(SAK_AUTHOR), false}
@@ -546,6 +561,7 @@ void SAKMainWindow::aboutQsak()
              << Info{tr("QQ"), QString("QQ:2869470394"), false}
              << Info{tr("QQ Group"), QString("QQ:952218522"), false}
              << Info{tr("Build Time"), dateTimeString, false}
+             << Info{tr("Startup Time"), startupPhases.join("<br>"), false}
              << Info{tr("Copyright"), tr("Copyright 2018-%1 Qter. All rights reserved.")
                 .arg(sakApp->buildDate()->toString("yyyy")), false}
              << Info{tr("Gitee Url"), QString("<a href=%1>%1</a>")
@@ -720,6 +736,9 @@ void SAKMainWindow::initToosMetaObjectInfoList()
     mToolMetaObjectInfoList.append(SAKToolMetaObjectInfo{
                                        SAKToolFileChecker::staticMetaObject,
                                        tr("File Assistant")});
+    mToolMetaObjectInfoList.append(SAKToolMetaObjectInfo{
+                                       SAKToolFileCheckerBatch::staticMetaObject,
+                                       tr("Checksum Assistant")});
 #endif
     mToolMetaObjectInfoList.append(SAKToolMetaObjectInfo{
                                        SAKToolCRCCalculator::staticMetaObject,
@@ -924,6 +943,27 @@ QWidget *SAKMainWindow::debugPageFromDebugPageType(int type)
     return widget;
 }
 
+void SAKMainWindow::createDeferredDebugPage(int index)
+{
+    QWidget *container = mTabWidget->widget(index);
+    if (!mDeferredDebugPageTypes.contains(container)) {
+        return;
+    }
+
+    // Only the creation is timed, the page may be activated long after
+    // the previous phase.
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+    int type = mDeferredDebugPageTypes.take(container);
+    QWidget *page = debugPageFromDebugPageType(type);
+    if (page) {
+        container->layout()->addWidget(page);
+    }
+
+    SAKCommonStartupTracer::mark(QString("Create %1").arg(container->windowTitle()),
+                                 elapsedTimer.elapsed());
+}
+
 QString SAKMainWindow::debuggerNameFromDebugPageType(int type)
 {
     QString title;
@@ -10,6 +10,7 @@
 #ifndef MAINWINDOW_HH
 #define MAINWINDOW_HH
 
+#include <QHash>
 #include <QMenu>
 #include <QLabel>
 #include <QAction>
@@ -200,9 +201,18 @@ private:
      * @return The default debug page name
      */
     QString debuggerNameFromDebugPageType(int type);
+
+    /**
+     * @brief createDeferredDebugPage: The fixed debug pages are created when they
+     * are activated first time, the tab page is a container before that.
+     * @param index: Index of tab page.
+     */
+    void createDeferredDebugPage(int index);
 private:
     Ui::SAKMainWindow *mUi;
     QTabWidget *mTabWidget;
+    // The container of tab page and the type of debug page to be created.
+    QHash<QWidget*, int> mDeferredDebugPageTypes;
 };
 
 extern SAKMainWindow *sakMainWindow;
@@ -0,0 +1,278 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QDebug>
+#include <QSqlError>
+#include <QSqlRecord>
+#include <QStringList>
+#include <QCoreApplication>
+
+#include "SAKBaseDatabaseWorker.hh"
+
+namespace {
+QMutex sakDatabaseWorkersMutex;
+QHash<QString, SAKBaseDatabaseWorker*> sakDatabaseWorkers;
+}
+
+SAKBaseDatabaseWorker::SAKBaseDatabaseWorker(const QString &driverName,
+                                             const QString &databaseName,
+                                             QObject *parent)
+    :QThread(parent)
+    ,mDriverName(driverName)
+    ,mDatabaseName(databaseName)
+    ,mIdle(true)
+    ,mRequestId(0)
+{
+    qRegisterMetaType<QList<QVariantMap>>("QList<QVariantMap>");
+}
+
+SAKBaseDatabaseWorker::~SAKBaseDatabaseWorker()
+{
+    // The queued requests are executed before exiting.
+    requestInterruption();
+    mRequestsMutex.lock();
+    mRequestsCondition.wakeAll();
+    mRequestsMutex.unlock();
+    wait();
+
+    sakDatabaseWorkersMutex.lock();
+    sakDatabaseWorkers.remove(mDatabaseName);
+    sakDatabaseWorkersMutex.unlock();
+}
+
+SAKBaseDatabaseWorker *SAKBaseDatabaseWorker::instance(QSqlDatabase *sqlDatabase)
+{
+    QMutexLocker locker(&sakDatabaseWorkersMutex);
+    QString databaseName = sqlDatabase->databaseName();
+    SAKBaseDatabaseWorker *worker = sakDatabaseWorkers.value(databaseName);
+    if (!worker) {
+        // The worker is destroyed with the application.
+        worker = new SAKBaseDatabaseWorker(sqlDatabase->driverName(),
+                                           databaseName,
+                                           QCoreApplication::instance());
+        sakDatabaseWorkers.insert(databaseName, worker);
+        worker->start();
+    }
+
+    return worker;
+}
+
+void SAKBaseDatabaseWorker::createTable(const QString &tableName, const QString &sql)
+{
+    SAKStructRequestContext ctx;
+    ctx.request = RequestCreateTable;
+    ctx.id = 0;
+    ctx.tableName = tableName;
+    ctx.sql = sql;
+    appendRequest(ctx);
+}
+
+void SAKBaseDatabaseWorker::write(const QString &tableName,
+                                  const QList<SAKStructWriteContext> &ctxs)
+{
+    SAKStructRequestContext ctx;
+    ctx.request = RequestWrite;
+    ctx.id = 0;
+    ctx.tableName = tableName;
+    ctx.writeCtxs = ctxs;
+    appendRequest(ctx);
+}
+
+quint64 SAKBaseDatabaseWorker::select(const QString &tableName)
+{
+    SAKStructRequestContext ctx;
+    ctx.request = RequestSelect;
+    ctx.tableName = tableName;
+    mRequestsMutex.lock();
+    ctx.id = ++mRequestId;
+    mRequestsMutex.unlock();
+    appendRequest(ctx);
+    return ctx.id;
+}
+
+void SAKBaseDatabaseWorker::waitForIdle()
+{
+    mRequestsMutex.lock();
+    while ((!mIdle) || (!mRequests.isEmpty())) {
+        mIdleCondition.wait(&mRequestsMutex);
+    }
+    mRequestsMutex.unlock();
+}
+
+void SAKBaseDatabaseWorker::run()
+{
+    const QString connectionName = QString("SAKBaseDatabaseWorker%1")
+            .arg(quintptr(this));
+    {
+        QSqlDatabase sqlDatabase = QSqlDatabase::addDatabase(mDriverName,
+                                                             connectionName);
+        sqlDatabase.setDatabaseName(mDatabaseName);
+        sqlDatabase.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+        if (!sqlDatabase.open()) {
+            qWarning() << "Open database failed:" << sqlDatabase.lastError().text();
+        } else {
+            QSqlQuery sqlQuery(sqlDatabase);
+            sqlQuery.exec("PRAGMA synchronous=NORMAL");
+        }
+
+        forever {
+            mRequestsMutex.lock();
+            while (mRequests.isEmpty() && !isInterruptionRequested()) {
+                mIdle = true;
+                mIdleCondition.wakeAll();
+                mRequestsCondition.wait(&mRequestsMutex);
+            }
+
+            if (mRequests.isEmpty()) {
+                mIdle = true;
+                mIdleCondition.wakeAll();
+                mRequestsMutex.unlock();
+                break;
+            }
+
+            mIdle = false;
+            QList<SAKStructRequestContext> ctxs = mRequests;
+            mRequests.clear();
+            mRequestsMutex.unlock();
+
+            if (sqlDatabase.isOpen()) {
+                execRequests(sqlDatabase, ctxs);
+            }
+        }
+
+        mPreparedQueries.clear();
+        sqlDatabase.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
+void SAKBaseDatabaseWorker::appendRequest(const SAKStructRequestContext &ctx)
+{
+    mRequestsMutex.lock();
+    mRequests.append(ctx);
+    mIdle = false;
+    mRequestsCondition.wakeAll();
+    mRequestsMutex.unlock();
+}
+
+void SAKBaseDatabaseWorker::execRequests(QSqlDatabase &sqlDatabase,
+                                         const QList<SAKStructRequestContext> &ctxs)
+{
+    QList<QPair<quint64, QList<QVariantMap>>> selectedRecords;
+    bool transaction = sqlDatabase.transaction();
+    for (auto &ctx : ctxs) {
+        if (ctx.request == RequestCreateTable) {
+            if (!sqlDatabase.tables().contains(ctx.tableName)) {
+                QSqlQuery sqlQuery(sqlDatabase);
+                if (!sqlQuery.exec(ctx.sql)) {
+                    qInfo() << ctx.sql;
+                    qWarning() << "Create table failed:" << sqlQuery.lastError().text();
+                }
+            }
+        } else if (ctx.request == RequestWrite) {
+            for (auto &writeCtx : ctx.writeCtxs) {
+                execWrite(sqlDatabase, ctx.tableName, writeCtx);
+            }
+        } else if (ctx.request == RequestSelect) {
+            selectedRecords.append(qMakePair(ctx.id,
+                                             execSelect(sqlDatabase, ctx.tableName)));
+        }
+    }
+
+    if (transaction && !sqlDatabase.commit()) {
+        qWarning() << "Commit failed:" << sqlDatabase.lastError().text();
+        sqlDatabase.rollback();
+    }
+
+    // The records are emitted after the transaction is finished.
+    for (auto &pair : selectedRecords) {
+        emit recordsSelected(pair.first, pair.second);
+    }
+}
+
+bool SAKBaseDatabaseWorker::execWrite(QSqlDatabase &sqlDatabase,
+                                      const QString &tableName,
+                                      const SAKStructWriteContext &ctx)
+{
+    // The columns are sorted(QVariantMap), so the statements of the same columns
+    // are the same and they are prepared only once.
+    QString sql;
+    QStringList columns = ctx.values.keys();
+    if (ctx.operation == OperationInsert) {
+        QStringList placeholders;
+        for (int i = 0; i < columns.count(); i++) {
+            placeholders.append("?");
+        }
+        sql = QString("INSERT OR REPLACE INTO %1(%2) VALUES(%3)")
+                .arg(tableName, columns.join(","), placeholders.join(","));
+    } else if (ctx.operation == OperationUpdate) {
+        QStringList assignments;
+        for (auto &column : columns) {
+            assignments.append(column + "=?");
+        }
+        sql = QString("UPDATE %1 SET %2 WHERE ID=?")
+                .arg(tableName, assignments.join(","));
+    } else {
+        sql = QString("DELETE FROM %1 WHERE ID=?").arg(tableName);
+    }
+
+    auto it = mPreparedQueries.find(sql);
+    if (it == mPreparedQueries.end()) {
+        QSqlQuery sqlQuery(sqlDatabase);
+        if (!sqlQuery.prepare(sql)) {
+            qInfo() << sql;
+            qWarning() << "Prepare statement failed:" << sqlQuery.lastError().text();
+            return false;
+        }
+        it = mPreparedQueries.insert(sql, sqlQuery);
+    }
+
+    QSqlQuery &sqlQuery = it.value();
+    if (ctx.operation != OperationDelete) {
+        for (auto &column : columns) {
+            sqlQuery.addBindValue(ctx.values.value(column));
+        }
+    }
+    if (ctx.operation != OperationInsert) {
+        sqlQuery.addBindValue(qint64(ctx.id));
+    }
+
+    if (!sqlQuery.exec()) {
+        qWarning() << "Can not write record of" << tableName << ":"
+                   << sqlQuery.lastError().text();
+        return false;
+    }
+
+    return true;
+}
+
+QList<QVariantMap> SAKBaseDatabaseWorker::execSelect(QSqlDatabase &sqlDatabase,
+                                                     const QString &tableName)
+{
+    QList<QVariantMap> records;
+    QSqlQuery sqlQuery(sqlDatabase);
+    sqlQuery.setForwardOnly(true);
+    if (sqlQuery.exec(QString("SELECT * FROM %1").arg(tableName))) {
+        QSqlRecord sqlRecord = sqlQuery.record();
+        while (sqlQuery.next()) {
+            QVariantMap record;
+            for (int i = 0; i < sqlRecord.count(); i++) {
+                record.insert(sqlRecord.fieldName(i), sqlQuery.value(i));
+            }
+            records.append(record);
+        }
+    } else {
+        qWarning() << "Select record form "
+                   << tableName
+                   << " table failed: "
+                   << sqlQuery.lastError().text();
+    }
+
+    return records;
+}
@@ -0,0 +1,116 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#ifndef SAKBASEDATABASEWORKER_HH
+#define SAKBASEDATABASEWORKER_HH
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+#include <QVariant>
+#include <QSqlQuery>
+#include <QSqlDatabase>
+#include <QWaitCondition>
+
+/// @brief The worker owns a connection of the database in its own thread, all of
+/// the sql statements of the list widget tables are executed by the worker. The
+/// requests are executed in order, the requests that are queued at the same time
+/// are executed in a transaction(such as the reading of all tables at startup).
+class SAKBaseDatabaseWorker : public QThread
+{
+    Q_OBJECT
+public:
+    enum SAKEnumOperation {
+        OperationInsert,
+        OperationUpdate,
+        OperationDelete
+    };
+
+    struct SAKStructWriteContext {
+        int operation;          // SAKEnumOperation
+        quint64 id;             // The id of record
+        QVariantMap values;     // Column and value
+    };
+public:
+    ~SAKBaseDatabaseWorker();
+
+    /**
+     * @brief instance: Get the worker of the database, the worker is created when
+     * it is used first time, one worker per database file.
+     * @param sqlDatabase: The database(of main thread) to be cloned.
+     * @return The worker.
+     */
+    static SAKBaseDatabaseWorker *instance(QSqlDatabase *sqlDatabase);
+
+    /**
+     * @brief createTable: Create a table if it is not exist.
+     */
+    void createTable(const QString &tableName, const QString &sql);
+
+    /**
+     * @brief write: Write records, the statements are prepared and the values
+     * are bound.
+     */
+    void write(const QString &tableName, const QList<SAKStructWriteContext> &ctxs);
+
+    /**
+     * @brief select: Read all records of a table.
+     * @return The id of request, see recordsSelected().
+     */
+    quint64 select(const QString &tableName);
+
+    /**
+     * @brief waitForIdle: Block until all of the requests are executed.
+     */
+    void waitForIdle();
+protected:
+    void run() override;
+private:
+    SAKBaseDatabaseWorker(const QString &driverName,
+                          const QString &databaseName,
+                          QObject *parent = Q_NULLPTR);
+private:
+    enum SAKEnumRequest {
+        RequestCreateTable,
+        RequestWrite,
+        RequestSelect
+    };
+
+    struct SAKStructRequestContext {
+        int request;
+        quint64 id;
+        QString tableName;
+        QString sql;
+        QList<SAKStructWriteContext> writeCtxs;
+    };
+private:
+    QString mDriverName;
+    QString mDatabaseName;
+    QList<SAKStructRequestContext> mRequests;
+    QMutex mRequestsMutex;
+    QWaitCondition mRequestsCondition;
+    QWaitCondition mIdleCondition;
+    bool mIdle;
+    quint64 mRequestId;
+    // Accessed in the worker thread only
+    QHash<QString, QSqlQuery> mPreparedQueries;
+private:
+    void appendRequest(const SAKStructRequestContext &ctx);
+    void execRequests(QSqlDatabase &sqlDatabase,
+                      const QList<SAKStructRequestContext> &ctxs);
+    bool execWrite(QSqlDatabase &sqlDatabase,
+                   const QString &tableName,
+                   const SAKStructWriteContext &ctx);
+    QList<QVariantMap> execSelect(QSqlDatabase &sqlDatabase, const QString &tableName);
+signals:
+    void recordsSelected(quint64 requestId, const QList<QVariantMap> &records);
+};
+
+#endif // SAKBASEDATABASEWORKER_HH
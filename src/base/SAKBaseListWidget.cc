@@ -8,9 +8,9 @@
  * the file LICENCE in the root of the source code directory.
  ***************************************************************************************/
 #include <QDebug>
-#include <QSqlError>
 #include <QDateTime>
 #include <QJsonArray>
+#include <QShowEvent>
 #include <QMessageBox>
 #include <QListWidget>
 #include <QFileDialog>
@@ -20,6 +20,7 @@
 
 #include "SAKBaseListWidget.hh"
 #include "ui_SAKBaseListWidget.h"
+#include "SAKBaseListWidgetStorage.hh"
 #include "SAKBaseListWidgetItemWidget.hh"
 
 SAKBaseListWidget::SAKBaseListWidget(QSqlDatabase *sqlDatabase,
@@ -33,9 +34,10 @@ SAKBaseListWidget::SAKBaseListWidget(QSqlDatabase *sqlDatabase,
     ,mSettingsGroup(settingsGroup)
     ,mTableNameSuffix(tableNameSuffix)
     ,mTableName(settingsGroup + tableNameSuffix)
+    ,mStorage(new SAKBaseListWidgetStorage(sqlDatabase, mTableName, this))
+    ,mItemsLoaded(false)
     ,mUi(new Ui::SAKBaseListWidget)
 {
-    mSqlQuery = QSqlQuery(*sqlDatabase);
     mUi->setupUi(this);
     mListWidget = mUi->itemListWidget;
 
@@ -75,6 +77,9 @@ SAKBaseListWidget::SAKBaseListWidget(QSqlDatabase *sqlDatabase,
             this, [&](){
         mSettings->setValue(mForbidAllItemsSettingsKey,
                             mUi->forbidAllItemsCheckBox->isChecked());
+        if (!mUi->forbidAllItemsCheckBox->isChecked()) {
+            loadItems();
+        }
     });
 }
 
@@ -99,30 +104,8 @@ bool SAKBaseListWidget::forbidAllItems()
 
 void SAKBaseListWidget::updateRecord(quint64 id, QString columnName, QVariant value)
 {
-    QString queryString;
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-    if (value.type() == QVariant::String) {
-#else
-    if (value.metaType() == QMetaType(QMetaType::QString)) {
-#endif
-        queryString = QString("UPDATE %1 SET %2='%3' WHERE ID=%4")
-                .arg(mTableName,
-                     columnName,
-                     value.toString(),
-                     QString::number(id));
-    } else {
-        queryString = QString("UPDATE %1 SET %2=%3 WHERE ID=%4")
-                .arg(mTableName,
-                     columnName,
-                     value.toString(),
-                     QString::number(id));
-    }
-
-    if(!mSqlQuery.exec(queryString)) {
-        qInfo() << queryString;
-        qWarning() << QString("Can not update record(%1):%2")
-                      .arg(columnName, mSqlQuery.lastError().text());
-    }
+    // The record is written later, the updates of a record are coalesced.
+    mStorage->updateRecord(id, columnName, value);
 }
 
 void SAKBaseListWidget::outputMessage(QString msg, bool isError)
@@ -181,12 +164,15 @@ void SAKBaseListWidget::importItems()
         auto *itemWidget = createItemFromParameters(parameters);
         QListWidgetItem *item = new QListWidgetItem();
         if (setupItemWidget(item, itemWidget)) {
-            insertRecord(sqlInsert(mTableName, itemWidget));
+            mStorage->insertRecord(toJsonObject(itemWidget));
         } else {
             itemWidget->deleteLater();
             delete item;
         }
     }
+
+    // All of the records are written in a transaction.
+    mStorage->flush();
 }
 
 void SAKBaseListWidget::exportItems()
@@ -229,17 +215,12 @@ void SAKBaseListWidget::deleteItem(QListWidgetItem *item)
     if (item) {
         QWidget *itemWidget = mUi->itemListWidget->itemWidget(item);
         quint64 id = itemId(itemWidget);
+        mItemMap.remove(id);
         mUi->itemListWidget->removeItemWidget(item);
         delete item;
 
         // Delete record from database.
-        QString queryString = QString("DELETE FROM %1 WHERE ID=%2")
-                .arg(mTableName)
-                .arg(id);
-        if (!mSqlQuery.exec(queryString)) {
-            qWarning() << "Can not delete recored form(" << mTableName << ")"
-                       << mSqlQuery.lastError().text();
-        }
+        mStorage->deleteRecord(id);
     } else {
         outputMessage(tr("Plese select an item first."), true);
     }
@@ -250,46 +231,32 @@ void SAKBaseListWidget::addItem()
     QListWidgetItem *item = new QListWidgetItem();
     QWidget *itemWidget = createItemFromParameters(QJsonObject());
     if (setupItemWidget(item, itemWidget)) {
-        insertRecord(sqlInsert(mTableName, itemWidget));
+        mStorage->insertRecord(toJsonObject(itemWidget));
     } else {
         itemWidget->deleteLater();
         delete item;
     }
 }
 
-void SAKBaseListWidget::readinRecords()
+void SAKBaseListWidget::onRecordsRead(const QList<QVariantMap> &records)
 {
-    const QString queryString = QString("SELECT * FROM %1").arg(mTableName);
-    if (mSqlQuery.exec(queryString)) {
-        while (mSqlQuery.next()) {
-            QJsonObject parameters = toJsonObject(mSqlQuery);
-            auto *itemWidget = createItemFromParameters(parameters);
-            QListWidgetItem *item = new QListWidgetItem();
-            if (!setupItemWidget(item, itemWidget)) {
-                itemWidget->deleteLater();
-                delete item;
-            }
-        }
-    } else {
-        qWarning() << "Select record form "
-                   << mTableName
-                   << " table failed: "
-                   << mSqlQuery.lastError().text();
+    // The item widgets are not required if the items are forbidden and the list
+    // widget has not been shown, they are created later.
+    mPendingRecords.append(records);
+    if (mItemsLoaded || !forbidAllItems()) {
+        loadItems();
     }
 }
 
 bool SAKBaseListWidget::setupItemWidget(QListWidgetItem *item,
                                         QWidget *itemWidget)
 {
-    int count = mListWidget->count();
-    for (int i = 0; i < count; i++) {
-        QListWidgetItem *item = mListWidget->item(i);
-        QWidget *w = mListWidget->itemWidget(item);
-        if (itemId(w) == itemId(itemWidget)) {
-            return false;
-        }
+    quint64 id = itemId(itemWidget);
+    if (mItemMap.contains(id)) {
+        return false;
     }
 
+    mItemMap.insert(id, item);
     item->setSizeHint(itemWidget->sizeHint());
     mListWidget->addItem(item);
     mListWidget->setItemWidget(item, itemWidget);
@@ -311,26 +278,40 @@ bool SAKBaseListWidget::setupItemWidget(QListWidgetItem *item,
     return true;
 }
 
-void SAKBaseListWidget::insertRecord(const QString &sql)
+void SAKBaseListWidget::initialize()
 {
-    if (!mSqlQuery.exec(sql)) {
-        qInfo() << sql;
-        qWarning() << "Insert record failed:" << mSqlQuery.lastError().text();
-    }
+    // The records are read in the thread of the database worker, the items are
+    // created when the records are ready.
+    connect(mStorage, &SAKBaseListWidgetStorage::recordsRead,
+            this, &SAKBaseListWidget::onRecordsRead);
+    mStorage->createTable(sqlCreate(mTableName));
+    mStorage->readinRecords();
 }
 
-void SAKBaseListWidget::createTable(const QString &sql)
+void SAKBaseListWidget::loadItems()
 {
-    if (!mSqlDatabase->tables().contains(mTableName)) {
-        if (!mSqlQuery.exec(sql)) {
-            qInfo() << sql;
-            qWarning() << "Create table failed:" << mSqlQuery.lastError().text();
+    mItemsLoaded = true;
+    if (mPendingRecords.isEmpty()) {
+        return;
+    }
+
+    // Layouting is done once for all of the items.
+    mListWidget->setUpdatesEnabled(false);
+    for (auto &record : mPendingRecords) {
+        QJsonObject parameters = toJsonObject(record);
+        auto *itemWidget = createItemFromParameters(parameters);
+        QListWidgetItem *item = new QListWidgetItem();
+        if (!setupItemWidget(item, itemWidget)) {
+            itemWidget->deleteLater();
+            delete item;
         }
     }
+    mPendingRecords.clear();
+    mListWidget->setUpdatesEnabled(true);
 }
 
-void SAKBaseListWidget::initialize()
+void SAKBaseListWidget::showEvent(QShowEvent *event)
 {
-    createTable(sqlCreate(mTableName));
-    readinRecords();
+    loadItems();
+    QWidget::showEvent(event);
 }
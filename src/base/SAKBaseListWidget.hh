@@ -9,14 +9,16 @@
  ***************************************************************************************/
 #ifndef SAKBASELISTWIDGET_HH
 #define SAKBASELISTWIDGET_HH
+#include <QHash>
 #include <QTimer>
 #include <QWidget>
 #include <QSettings>
-#include <QSqlQuery>
+#include <QVariant>
 #include <QJsonObject>
 #include <QSqlDatabase>
 #include <QListWidgetItem>
 
+class SAKBaseListWidgetStorage;
 namespace Ui {
     class SAKBaseListWidget;
 }
@@ -40,16 +42,22 @@ protected:
     QString mTableNameSuffix;
 
     QString mTableName;
-    QSqlQuery mSqlQuery;
     QTimer mClearMessageInfoTimer;
     QListWidget *mListWidget;
 private:
     QString mForbidAllItemsSettingsKey;
+    SAKBaseListWidgetStorage *mStorage;
+    // The records those item widgets are not created yet.
+    QList<QVariantMap> mPendingRecords;
+    bool mItemsLoaded;
+    // Id of item and the item, used to check the duplicated items.
+    QHash<quint64, QListWidgetItem*> mItemMap;
 protected:
     virtual QString sqlCreate(const QString &tableName) = 0;
-    virtual QString sqlInsert(const QString &tableName, QWidget *itemWidget) = 0;
+    // The keys of the object are the names of columns, it is used as the record
+    // of the item too.
     virtual QJsonObject toJsonObject(QWidget *itemWidget) = 0;
-    virtual QJsonObject toJsonObject(const QSqlQuery &sqlQuery) = 0;
+    virtual QJsonObject toJsonObject(const QVariantMap &record) = 0;
     virtual QWidget *createItemFromParameters(const QJsonObject &jsonObj) = 0;
     virtual quint64 itemId(QWidget *itemWidget) = 0;
     virtual void connectSignalsToSlots(QWidget *itemWidget) = 0;
@@ -58,16 +66,19 @@ protected:
     void outputMessage(QString msg, bool isError);
     // It must be called in the subcalss.
     void initialize();
+    // Create the item widgets of the records those have been read, the item
+    // widgets are created when the list widget is shown first time or the items
+    // are not forbidden. Call it if the items are used in other places.
+    void loadItems();
+    void showEvent(QShowEvent *event) override;
 private:
     void clearItems();
     void importItems();
     void exportItems();
     void deleteItem(QListWidgetItem *item);
     void addItem();
-    void readinRecords();
+    void onRecordsRead(const QList<QVariantMap> &records);
     bool setupItemWidget(QListWidgetItem *item, QWidget *itemWidget);
-    void insertRecord(const QString &sql);
-    void createTable(const QString &sql);
 private:
     Ui::SAKBaseListWidget *mUi;
 signals:
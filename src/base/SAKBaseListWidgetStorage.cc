@@ -0,0 +1,119 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include "SAKBaseListWidgetStorage.hh"
+
+SAKBaseListWidgetStorage::SAKBaseListWidgetStorage(QSqlDatabase *sqlDatabase,
+                                                   const QString &tableName,
+                                                   QObject *parent)
+    :QObject(parent)
+    ,mWorker(SAKBaseDatabaseWorker::instance(sqlDatabase))
+    ,mTableName(tableName)
+    ,mSelectRequestId(0)
+{
+    // The timer is not restarted by the following writes, so the records are
+    // written even if the user keeps typing.
+    mFlushTimer.setInterval(200);
+    mFlushTimer.setSingleShot(true);
+    connect(&mFlushTimer, &QTimer::timeout,
+            this, &SAKBaseListWidgetStorage::flush);
+    connect(mWorker, &SAKBaseDatabaseWorker::recordsSelected,
+            this, &SAKBaseListWidgetStorage::onRecordsSelected);
+}
+
+SAKBaseListWidgetStorage::~SAKBaseListWidgetStorage()
+{
+    flush();
+}
+
+void SAKBaseListWidgetStorage::createTable(const QString &sql)
+{
+    mWorker->createTable(mTableName, sql);
+}
+
+void SAKBaseListWidgetStorage::readinRecords()
+{
+    mSelectRequestId = mWorker->select(mTableName);
+}
+
+void SAKBaseListWidgetStorage::insertRecord(const QJsonObject &record)
+{
+    SAKBaseDatabaseWorker::SAKStructWriteContext ctx;
+    ctx.operation = SAKBaseDatabaseWorker::OperationInsert;
+    ctx.id = record.value("id").toVariant().toULongLong();
+    ctx.values = record.toVariantMap();
+    mPendingIndexes.insert(ctx.id, mOperations.count());
+    mOperations.append(ctx);
+
+    if (!mFlushTimer.isActive()) {
+        mFlushTimer.start();
+    }
+}
+
+void SAKBaseListWidgetStorage::updateRecord(quint64 id,
+                                            const QString &columnName,
+                                            const QVariant &value)
+{
+    // The value is merged to the pending insert(update) operation of the record.
+    int index = mPendingIndexes.value(id, -1);
+    if (index == -1) {
+        SAKBaseDatabaseWorker::SAKStructWriteContext ctx;
+        ctx.operation = SAKBaseDatabaseWorker::OperationUpdate;
+        ctx.id = id;
+        mPendingIndexes.insert(id, mOperations.count());
+        mOperations.append(ctx);
+        index = mOperations.count() - 1;
+    }
+    mOperations[index].values.insert(columnName, value);
+
+    if (!mFlushTimer.isActive()) {
+        mFlushTimer.start();
+    }
+}
+
+void SAKBaseListWidgetStorage::deleteRecord(quint64 id)
+{
+    SAKBaseDatabaseWorker::SAKStructWriteContext ctx;
+    ctx.operation = SAKBaseDatabaseWorker::OperationDelete;
+    ctx.id = id;
+    mPendingIndexes.remove(id);
+    mOperations.append(ctx);
+
+    if (!mFlushTimer.isActive()) {
+        mFlushTimer.start();
+    }
+}
+
+void SAKBaseListWidgetStorage::flush()
+{
+    mFlushTimer.stop();
+    if (mOperations.isEmpty()) {
+        return;
+    }
+
+    mWorker->write(mTableName, mOperations);
+    mOperations.clear();
+    mPendingIndexes.clear();
+}
+
+void SAKBaseListWidgetStorage::waitForWritten()
+{
+    flush();
+    mWorker->waitForIdle();
+}
+
+void SAKBaseListWidgetStorage::onRecordsSelected(quint64 requestId,
+                                                 const QList<QVariantMap> &records)
+{
+    // The worker is shared by all tables of the database.
+    if (requestId == mSelectRequestId) {
+        mSelectRequestId = 0;
+        emit recordsRead(records);
+    }
+}
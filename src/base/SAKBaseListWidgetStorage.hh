@@ -0,0 +1,88 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#ifndef SAKBASELISTWIDGETSTORAGE_HH
+#define SAKBASELISTWIDGETSTORAGE_HH
+
+#include <QHash>
+#include <QList>
+#include <QTimer>
+#include <QObject>
+#include <QVariant>
+#include <QJsonObject>
+#include <QSqlDatabase>
+
+#include "SAKBaseDatabaseWorker.hh"
+
+/// @brief Persistence of a list widget table. The writes are queued, updates of
+/// the same record are coalesced and the queue is handed to the database worker
+/// after a short delay, the statements are executed in the thread of the worker,
+/// so the ui thread is never blocked by the disk.
+class SAKBaseListWidgetStorage : public QObject
+{
+    Q_OBJECT
+public:
+    SAKBaseListWidgetStorage(QSqlDatabase *sqlDatabase,
+                             const QString &tableName,
+                             QObject *parent = Q_NULLPTR);
+    ~SAKBaseListWidgetStorage();
+
+    /**
+     * @brief createTable: Create the table if it is not exist.
+     * @param sql: Create statement.
+     */
+    void createTable(const QString &sql);
+
+    /**
+     * @brief readinRecords: Read all records of the table, the records are
+     * reported by recordsRead().
+     */
+    void readinRecords();
+
+    /**
+     * @brief insertRecord: Insert a record, the keys of the object are the names
+     * of columns.
+     */
+    void insertRecord(const QJsonObject &record);
+
+    /**
+     * @brief updateRecord: Update a column of a record.
+     */
+    void updateRecord(quint64 id, const QString &columnName, const QVariant &value);
+
+    /**
+     * @brief deleteRecord: Delete a record.
+     */
+    void deleteRecord(quint64 id);
+
+    /**
+     * @brief flush: Hand all of the queued operations to the worker, they are
+     * written in a transaction.
+     */
+    void flush();
+
+    /**
+     * @brief waitForWritten: Flush and block until the worker is idle.
+     */
+    void waitForWritten();
+private:
+    SAKBaseDatabaseWorker *mWorker;
+    QString mTableName;
+    QTimer mFlushTimer;
+    QList<SAKBaseDatabaseWorker::SAKStructWriteContext> mOperations;
+    // Id of record and the index of its pending insert(update) operation
+    QHash<quint64, int> mPendingIndexes;
+    quint64 mSelectRequestId;
+private:
+    void onRecordsSelected(quint64 requestId, const QList<QVariantMap> &records);
+signals:
+    void recordsRead(const QList<QVariantMap> &records);
+};
+
+#endif // SAKBASELISTWIDGETSTORAGE_HH
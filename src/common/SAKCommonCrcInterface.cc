@@ -269,6 +269,106 @@ int SAKCommonCrcInterface::bitsWidth(SAKCommonCrcInterface::SAKEnumCrcModel mode
     return ret;
 }
 
+void SAKCommonCrcInterface::crcInit(SAKStructCrcContext *ctx,
+                                    SAKCommonCrcInterface::SAKEnumCrcModel model)
+{
+    ctx->model = model;
+    ctx->bitsWidth = bitsWidth(model);
+    ctx->inputReversal = isInputReversal(model);
+    ctx->outputReversal = isOutputReversal(model);
+    ctx->xorValue = xorValue(model);
+    ctx->poly = poly(model);
+    ctx->mask = ctx->bitsWidth == 32 ? 0xffffffff : ((uint32_t(1) << ctx->bitsWidth) - 1);
+    ctx->reg = initialValue(model) & ctx->mask;
+
+    // The remainder of each byte(the highest byte of the register)
+    const uint32_t topBit = uint32_t(1) << (ctx->bitsWidth - 1);
+    const uint32_t rawPoly = poly(model);
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t reg = i << (ctx->bitsWidth - 8);
+        for (int j = 0; j < 8; j++) {
+            reg = (reg & topBit) ? ((reg << 1) ^ rawPoly) : (reg << 1);
+        }
+        ctx->table[i] = reg & ctx->mask;
+    }
+}
+
+void SAKCommonCrcInterface::crcUpdate(SAKStructCrcContext *ctx,
+                                      const uint8_t *input,
+                                      uint64_t length)
+{
+    const int shift = ctx->bitsWidth - 8;
+    const uint32_t mask = ctx->mask;
+    uint32_t reg = ctx->reg;
+    if (ctx->inputReversal) {
+        while (length--) {
+            // Reverse the bits of the byte.
+            uint8_t byte = *(input++);
+            byte = uint8_t(((byte*0x80200802ULL) & 0x0884422110ULL)*0x0101010101ULL >> 32);
+            reg = ((reg << 8) ^ ctx->table[((reg >> shift) ^ byte) & 0xff]) & mask;
+        }
+    } else {
+        while (length--) {
+            reg = ((reg << 8) ^ ctx->table[((reg >> shift) ^ *(input++)) & 0xff]) & mask;
+        }
+    }
+    ctx->reg = reg;
+}
+
+uint32_t SAKCommonCrcInterface::crcFinal(const SAKStructCrcContext *ctx)
+{
+    uint32_t reg = ctx->reg;
+    if (ctx->outputReversal) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < ctx->bitsWidth; i++) {
+            reversed = (reversed << 1) | ((reg >> i) & 0x01);
+        }
+        reg = reversed;
+    }
+
+    return (reg ^ ctx->xorValue) & ctx->mask;
+}
+
+uint32_t SAKCommonCrcInterface::crcCombine(const SAKStructCrcContext *ctx,
+                                           uint32_t regA,
+                                           uint32_t regB,
+                                           uint64_t lengthB)
+{
+    // The register is a polynomial of GF(2), feeding a zero byte multiplies it
+    // by x^8 modulo the poly, so the register of A+B is
+    // regA*x^(8*lengthB) + regB(modulo the poly).
+    const uint32_t topBit = uint32_t(1) << (ctx->bitsWidth - 1);
+    auto multiply = [=](uint32_t a, uint32_t b){
+        uint32_t product = 0;
+        for (int i = ctx->bitsWidth - 1; i >= 0; i--) {
+            product = (product & topBit) ? (((product << 1) ^ ctx->poly) & ctx->mask)
+                                         : ((product << 1) & ctx->mask);
+            if ((b >> i) & 0x01) {
+                product ^= a;
+            }
+        }
+        return product;
+    };
+
+    // x^8 modulo the poly
+    uint32_t power = 1;
+    for (int i = 0; i < 8; i++) {
+        power = (power & topBit) ? (((power << 1) ^ ctx->poly) & ctx->mask)
+                                 : ((power << 1) & ctx->mask);
+    }
+
+    uint32_t reg = regA;
+    while (lengthB) {
+        if (lengthB & 0x01) {
+            reg = multiply(reg, power);
+        }
+        power = multiply(power, power);
+        lengthB >>= 1;
+    }
+
+    return (reg ^ regB) & ctx->mask;
+}
+
 #ifndef SAK_IMPORT_MODULE_TESTLIB
 void SAKCommonCrcInterface::addCrcModelItemsToComboBox(QComboBox *comboBox)
 {
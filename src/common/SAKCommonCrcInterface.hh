@@ -41,21 +41,56 @@ public:
     };
     Q_ENUM(SAKEnumCrcModel);
 
+    /// @brief The state of a table driven calculation, the data can be fed
+    /// block by block(such as the blocks of a large file).
+    struct SAKStructCrcContext {
+        SAKEnumCrcModel model;
+        int bitsWidth;
+        bool inputReversal;
+        bool outputReversal;
+        uint32_t xorValue;
+        uint32_t poly;
+        uint32_t mask;
+        uint32_t reg;
+        uint32_t table[256];
+    };
 
 public:
     SAKCommonCrcInterface(QObject *parent = Q_NULLPTR);
     QStringList supportedParameterModels();
-    uint32_t poly(SAKCommonCrcInterface::SAKEnumCrcModel model);
-    uint32_t xorValue(SAKCommonCrcInterface::SAKEnumCrcModel model);
-    uint32_t initialValue(SAKCommonCrcInterface::SAKEnumCrcModel model);
+    static uint32_t poly(SAKCommonCrcInterface::SAKEnumCrcModel model);
+    static uint32_t xorValue(SAKCommonCrcInterface::SAKEnumCrcModel model);
+    static uint32_t initialValue(SAKCommonCrcInterface::SAKEnumCrcModel model);
     QString friendlyPoly(SAKCommonCrcInterface::SAKEnumCrcModel model);
-    bool isInputReversal(SAKCommonCrcInterface::SAKEnumCrcModel model);
-    bool isOutputReversal(SAKCommonCrcInterface::SAKEnumCrcModel model);
-    int bitsWidth(SAKCommonCrcInterface::SAKEnumCrcModel model);
+    static bool isInputReversal(SAKCommonCrcInterface::SAKEnumCrcModel model);
+    static bool isOutputReversal(SAKCommonCrcInterface::SAKEnumCrcModel model);
+    static int bitsWidth(SAKCommonCrcInterface::SAKEnumCrcModel model);
 #ifndef SAK_IMPORT_MODULE_TESTLIB
     static void addCrcModelItemsToComboBox(QComboBox *comboBox);
 #endif
 
+    /**
+     * @brief crcInit: Initialize the context, the result is the same as the
+     * result of crcCalculate() if all of the data is fed by crcUpdate().
+     */
+    static void crcInit(SAKStructCrcContext *ctx, SAKCommonCrcInterface::SAKEnumCrcModel model);
+    static void crcUpdate(SAKStructCrcContext *ctx, const uint8_t *input, uint64_t length);
+    static uint32_t crcFinal(const SAKStructCrcContext *ctx);
+
+    /**
+     * @brief crcCombine: Get the register of the data A+B without feeding A
+     * again, so the data can be split and calculated by several threads.
+     * @param ctx: The model, the register of it is not used.
+     * @param regA: The register(ctx->reg) after A is fed.
+     * @param regB: The register after B is fed, the initial register is 0.
+     * @param lengthB: The length of B.
+     * @return The register after A+B is fed.
+     */
+    static uint32_t crcCombine(const SAKStructCrcContext *ctx,
+                               uint32_t regA,
+                               uint32_t regB,
+                               uint64_t lengthB);
+
 
 public:
     template<typename T>
@@ -8,10 +8,12 @@
  * the file LICENCE in the root of the source code directory.
  ***************************************************************************************/
 #include <QMetaEnum>
+#include <QRegularExpression>
+#ifdef QT_WIDGETS_LIB
 #include <QLineEdit>
 #include <QStandardItemModel>
-#include <QRegularExpression>
 #include <QRegularExpressionValidator>
+#endif
 #include "SAKCommonDataStructure.hh"
 
 SAKCommonDataStructure::SAKCommonDataStructure(QObject* parent)
@@ -25,6 +27,7 @@ SAKCommonDataStructure::~SAKCommonDataStructure()
 
 }
 
+#ifdef QT_WIDGETS_LIB
 void SAKCommonDataStructure::setComboBoxTextOutputFormat(QComboBox *comboBox)
 {
     if (comboBox){
@@ -65,6 +68,7 @@ void SAKCommonDataStructure::setComboBoxTextWebSocketSendingType(QComboBox *comb
         comboBox->addItem(tr("TEXT"), SAKCommonDataStructure::WebSocketSendingTypeText);
     }
 }
+#endif
 
 QString SAKCommonDataStructure::formattingString(QString &origingString,
                                                  SAKEnumTextFormatInput format)
@@ -225,6 +229,7 @@ QString SAKCommonDataStructure::byteArrayToString(QByteArray &origingData,
     return str;
 }
 
+#ifdef QT_WIDGETS_LIB
 void SAKCommonDataStructure::setLineEditTextFormat(
         QLineEdit *lineEdit,
         SAKEnumTextFormatInput format
@@ -269,6 +274,7 @@ void SAKCommonDataStructure::setLineEditTextFormat(QLineEdit *lineEdit, int form
     auto cookedFormat = static_cast<SAKEnumTextFormatInput>(format);
     SAKCommonDataStructure::setLineEditTextFormat(lineEdit, cookedFormat);
 }
+#endif
 
 QString SAKCommonDataStructure::suffix(SAKEmnuSuffixsType type)
 {
@@ -299,6 +305,7 @@ QString SAKCommonDataStructure::friendlySuffix(SAKEmnuSuffixsType type)
     }
 }
 
+#ifdef QT_WIDGETS_LIB
 void SAKCommonDataStructure::setupSuffix(QComboBox *comboBox)
 {
     if (comboBox){
@@ -368,3 +375,4 @@ void SAKCommonDataStructure::setComboBoxItems(QComboBox *comboBox,
         }
     }
 }
+#endif
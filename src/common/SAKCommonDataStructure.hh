@@ -12,8 +12,12 @@
 
 #include <QMap>
 #include <QObject>
+
+// The daemon and the auto tests are built without Qt Widgets.
+#ifdef QT_WIDGETS_LIB
 #include <QTextEdit>
 #include <QComboBox>
+#endif
 
 #ifdef SAK_IMPORT_MODULE_SERIALPORT
 #include <QSerialPort>
@@ -101,7 +105,12 @@ public:
         QString localHost;
         quint16 localPort;
         bool specifyLocalInfo;
+
+        bool broadcast;                 // Send to 255.255.255.255:peerPort
+        QStringList multicastGroups;    // "group" or "group@interface"
     };
+#endif
+#ifdef SAK_IMPORT_MODULE_UDP_SERVER
     struct SAKStructUdpServerParametersContext {
         QString serverHost;
         quint16 serverPort;
@@ -109,6 +118,9 @@ public:
         QString currentClientHost;
         quint16 currentClientPort;
         QStringList clients;
+
+        bool broadcast;                 // Send to 255.255.255.255:currentClientPort
+        QStringList multicastGroups;    // "group" or "group@interface"
     };
 #endif
 #endif
@@ -151,6 +163,7 @@ public:
 #endif
 #endif
 public:
+#ifdef QT_WIDGETS_LIB
     /**
      * @brief setComboBoxTextOutputFormat: Add output text format items to combo box.
      * @param comboBox: Targat combo box.
@@ -168,6 +181,7 @@ public:
      * @param comboBox: Target combo box.
      */
     static void setComboBoxTextWebSocketSendingType(QComboBox *comboBox);
+#endif
 
     /**
      * @brief formattingString: Formatting input text of text edit.
@@ -196,6 +210,7 @@ public:
     static QString byteArrayToString(QByteArray &origingData,
                                      SAKEnumTextFormatOutput format);
 
+#ifdef QT_WIDGETS_LIB
     /**
      * @brief setLineEditTextFormat: Formating input
      * @param lineEdit: Target component
@@ -204,10 +219,12 @@ public:
     static void setLineEditTextFormat(QLineEdit *lineEdit,
                                       SAKEnumTextFormatInput format);
     static void setLineEditTextFormat(QLineEdit *lineEdit, int format);
+#endif
 
     static QString suffix(SAKEmnuSuffixsType type);
     static QString suffix(int type);
     static QString friendlySuffix(SAKEmnuSuffixsType type);
+#ifdef QT_WIDGETS_LIB
     static void setupSuffix(QComboBox *comboBox);
 
     static void formattingInputText(QTextEdit *textEdit, int model);
@@ -215,6 +232,7 @@ private:
     static void setComboBoxItems(QComboBox *comboBox,
                                  QMap<int, QString> &formatMap,
                                  int currentData);
+#endif
 };
 
 
@@ -222,31 +240,43 @@ typedef SAKCommonDataStructure::SAKEnumTextFormatInput SAKTextFormatInput;
 typedef SAKCommonDataStructure::SAKEnumTextFormatOutput SAKTextFormatOutput;
 typedef SAKCommonDataStructure::SAKEnumWebSocketSendingType SAKWSSendingType;
 typedef SAKCommonDataStructure::SAKEmnuSuffixsType SAKSuffixsType;
+#ifdef SAK_IMPORT_MODULE_TEST
+Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructTestParametersContext);
+#endif
 #ifdef SAK_IMPORT_MODULE_SERIALPORT
 typedef SAKCommonDataStructure::SAKStructSerialPortParametersContext
 SAKSerialPortParametersContext;
+Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructSerialPortParametersContext);
 #endif
+#ifdef SAK_IMPORT_MODULE_UDP_CLIENT
 typedef SAKCommonDataStructure::SAKStructUdpClientParametersContext
 SAKUdpClientParametersContext;
+Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructUdpClientParametersContext);
+#endif
+#ifdef SAK_IMPORT_MODULE_UDP_SERVER
 typedef SAKCommonDataStructure::SAKStructUdpServerParametersContext
 SAKUdpServerParametersContext;
+Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructUdpServerParametersContext);
+#endif
+#ifdef SAK_IMPORT_MODULE_TCP_CLIENT
 typedef SAKCommonDataStructure::SAKStructTcpClientParametersContext
 SAKTcpClientParametersContext;
+Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructTcpClientParametersContext);
+#endif
+#ifdef SAK_IMPORT_MODULE_TCP_SERVER
 typedef SAKCommonDataStructure::SAKStructTcpServerParametersContext
 SAKTcpServerParametersContext;
+Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructTcpServerParametersContext);
+#endif
+#ifdef SAK_IMPORT_MODULE_WEBSOCKET_CLIENT
 typedef SAKCommonDataStructure::SAKStructWSClientParametersContext
 SAKWSClientParametersContext;
+Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructWSClientParametersContext);
+#endif
+#ifdef SAK_IMPORT_MODULE_WEBSOCKET_SERVER
 typedef SAKCommonDataStructure::SAKStructWSServerParametersContext
 SAKWSServerParametersContext;
-
-
-Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructTestParametersContext);
-Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructSerialPortParametersContext);
-Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructUdpClientParametersContext);
-Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructUdpServerParametersContext);
-Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructTcpClientParametersContext);
-Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructTcpServerParametersContext);
-Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructWSClientParametersContext);
 Q_DECLARE_METATYPE(SAKCommonDataStructure::SAKStructWSServerParametersContext);
+#endif
 
 #endif
@@ -0,0 +1,112 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QFile>
+#include <QDebug>
+#include <QMutex>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QElapsedTimer>
+
+#include "SAKCommonStartupTracer.hh"
+
+namespace {
+QMutex sakStartupTracerMutex;
+QElapsedTimer sakStartupTracerTimer;
+qint64 sakStartupTracerLastTimestamp = 0;
+QList<SAKCommonStartupTracer::SAKStructPhaseContext> sakStartupTracerPhases;
+}
+
+void SAKCommonStartupTracer::start()
+{
+    QMutexLocker locker(&sakStartupTracerMutex);
+    sakStartupTracerPhases.clear();
+    sakStartupTracerLastTimestamp = 0;
+    sakStartupTracerTimer.start();
+}
+
+void SAKCommonStartupTracer::mark(const QString &name)
+{
+    mark(name, -1);
+}
+
+void SAKCommonStartupTracer::mark(const QString &name, qint64 elapsed)
+{
+    QMutexLocker locker(&sakStartupTracerMutex);
+    if (!sakStartupTracerTimer.isValid()) {
+        sakStartupTracerTimer.start();
+    }
+
+    qint64 timestamp = sakStartupTracerTimer.elapsed();
+    SAKStructPhaseContext ctx;
+    ctx.name = name;
+    ctx.timestamp = timestamp;
+    if (elapsed < 0) {
+        ctx.elapsed = timestamp - sakStartupTracerLastTimestamp;
+        sakStartupTracerLastTimestamp = timestamp;
+    } else {
+        // The phase may be a part of the current sequential phase, the time
+        // of it is not taken from the sequential phase.
+        ctx.elapsed = elapsed;
+    }
+    sakStartupTracerPhases.append(ctx);
+}
+
+QList<SAKCommonStartupTracer::SAKStructPhaseContext> SAKCommonStartupTracer::phases()
+{
+    QMutexLocker locker(&sakStartupTracerMutex);
+    return sakStartupTracerPhases;
+}
+
+qint64 SAKCommonStartupTracer::elapsed()
+{
+    QMutexLocker locker(&sakStartupTracerMutex);
+    return sakStartupTracerTimer.isValid() ? sakStartupTracerTimer.elapsed() : 0;
+}
+
+bool SAKCommonStartupTracer::finish()
+{
+    mark(QString("Finished"));
+
+    auto ctxs = phases();
+    qint64 total = ctxs.last().timestamp;
+    QJsonArray phasesArray;
+    for (auto &ctx : ctxs) {
+        QJsonObject obj;
+        obj.insert("name", ctx.name);
+        obj.insert("elapsed", ctx.elapsed);
+        obj.insert("timestamp", ctx.timestamp);
+        phasesArray.append(obj);
+    }
+
+    QString fileName = QString::fromLocal8Bit(qgetenv("QSAK_STARTUP_TRACE"));
+    if (!fileName.isEmpty()) {
+        QJsonObject obj;
+        obj.insert("total", total);
+        obj.insert("phases", phasesArray);
+        QFile file(fileName);
+        if (file.open(QFile::WriteOnly | QFile::Truncate)) {
+            file.write(QJsonDocument(obj).toJson());
+            file.close();
+        } else {
+            qWarning() << "Can not write startup trace:" << file.errorString();
+        }
+    }
+
+    bool ok = false;
+    qint64 budget = qgetenv("QSAK_STARTUP_BUDGET").toLongLong(&ok);
+    if (ok && (total > budget)) {
+        qWarning() << "The startup takes" << total << "ms, the budget is"
+                   << budget << "ms";
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,69 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#ifndef SAKCOMMONSTARTUPTRACER_HH
+#define SAKCOMMONSTARTUPTRACER_HH
+
+#include <QList>
+#include <QString>
+
+/// @brief Timings of the startup phases. The trace is written to the file
+/// specified by the environment variable QSAK_STARTUP_TRACE(json), if the
+/// variable QSAK_STARTUP_BUDGET(ms) is set too, a warning is output when the
+/// startup takes longer than the budget.
+class SAKCommonStartupTracer
+{
+public:
+    struct SAKStructPhaseContext {
+        QString name;
+        qint64 elapsed;     // The time of the phase(ms)
+        qint64 timestamp;   // The time since the startup(ms)
+    };
+
+    /**
+     * @brief start: Clear the phases and restart the timer.
+     */
+    static void start();
+
+    /**
+     * @brief mark: Mark the end of a sequential phase, the phase starts at the
+     * end of the previous sequential one, so the sequential phases sum to the
+     * total.
+     * @param name: Name of the phase.
+     */
+    static void mark(const QString &name);
+
+    /**
+     * @brief mark: Mark the end of a phase which is timed by the caller, such
+     * as a phase which is not started at the end of the previous one. It is
+     * not a sequential phase, the next sequential phase still starts at the end
+     * of the previous sequential one.
+     * @param name: Name of the phase.
+     * @param elapsed: The time of the phase(ms).
+     */
+    static void mark(const QString &name, qint64 elapsed);
+
+    /**
+     * @brief phases: Get all of the phases.
+     */
+    static QList<SAKStructPhaseContext> phases();
+
+    /**
+     * @brief elapsed: The time since the startup(ms).
+     */
+    static qint64 elapsed();
+
+    /**
+     * @brief finish: Mark the end of startup and write the trace file.
+     * @return false: The startup takes longer than the budget.
+     */
+    static bool finish();
+};
+
+#endif // SAKCOMMONSTARTUPTRACER_HH
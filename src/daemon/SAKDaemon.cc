@@ -0,0 +1,349 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QFile>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include "SAKDaemon.hh"
+#include "SAKDaemonMetrics.hh"
+#include "SAKDebuggerDevice.hh"
+#include "SAKDaemonAutoResponse.hh"
+#include "SAKCommonDataStructure.hh"
+
+#ifdef SAK_IMPORT_MODULE_SERIALPORT
+#include "SAKSerialPortDevice.hh"
+#endif
+#ifdef SAK_IMPORT_MODULE_TCP_CLIENT
+#include "SAKTcpClientDevice.hh"
+#endif
+#ifdef SAK_IMPORT_MODULE_TCP_SERVER
+#include "SAKTcpServerDevice.hh"
+#endif
+#ifdef SAK_IMPORT_MODULE_UDP_CLIENT
+#include "SAKUdpClientDevice.hh"
+#endif
+#ifdef SAK_IMPORT_MODULE_UDP_SERVER
+#include "SAKUdpServerDevice.hh"
+#endif
+#ifdef SAK_IMPORT_MODULE_WEBSOCKET_CLIENT
+#include "SAKWebSocketClientDevice.hh"
+#endif
+#ifdef SAK_IMPORT_MODULE_WEBSOCKET_SERVER
+#include "SAKWebSocketServerDevice.hh"
+#endif
+
+SAKDaemon::SAKDaemon(QObject *parent)
+    :QObject(parent)
+    ,mMetrics(new SAKDaemonMetrics(this))
+{
+
+}
+
+SAKDaemon::~SAKDaemon()
+{
+    stop();
+    qDeleteAll(mDeviceMap);
+    mDeviceMap.clear();
+}
+
+bool SAKDaemon::load(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        qWarning() << "Can not open the config file:" << file.errorString();
+        return false;
+    }
+
+    QJsonParseError error;
+    QJsonDocument jsonDoc = QJsonDocument::fromJson(file.readAll(), &error);
+    file.close();
+    if (error.error != QJsonParseError::NoError) {
+        qWarning() << "Can not parse the config file:" << error.errorString();
+        return false;
+    }
+
+    QJsonObject rootObj = jsonDoc.object();
+    QJsonArray devices = rootObj.value("devices").toArray();
+    for (int i = 0; i < devices.count(); i++) {
+        if (!createDevice(devices.at(i).toObject())) {
+            return false;
+        }
+    }
+
+    QJsonArray transponders = rootObj.value("transponders").toArray();
+    for (int i = 0; i < transponders.count(); i++) {
+        if (!createTransponder(transponders.at(i).toObject())) {
+            return false;
+        }
+    }
+
+    QJsonArray autoResponse = rootObj.value("autoResponse").toArray();
+    for (int i = 0; i < autoResponse.count(); i++) {
+        if (!createAutoResponse(autoResponse.at(i).toObject())) {
+            return false;
+        }
+    }
+
+    QJsonObject metrics = rootObj.value("metrics").toObject();
+    return mMetrics->setup(metrics.value("interval").toInt(1000),
+                           metrics.value("localServer").toString());
+}
+
+void SAKDaemon::start()
+{
+    for (auto device : mDeviceMap) {
+        if (!device->isRunning()) {
+            device->start();
+        }
+    }
+
+    mMetrics->start();
+}
+
+void SAKDaemon::stop()
+{
+    mMetrics->stop();
+    for (auto device : mDeviceMap) {
+        if (device->isRunning()) {
+            device->exit();
+            device->wait();
+        }
+    }
+}
+
+bool SAKDaemon::createDevice(const QJsonObject &obj)
+{
+    QString name = obj.value("name").toString();
+    QString type = obj.value("type").toString();
+    if (name.isEmpty() || mDeviceMap.contains(name)) {
+        qWarning() << "The name of device is empty or duplicated:" << name;
+        return false;
+    }
+
+    SAKDebuggerDevice *device = newDevice(type, obj.value("parameters").toObject());
+    if (!device) {
+        qWarning() << "Unsupported device type:" << type;
+        return false;
+    }
+
+    auto toBytes = [](const QJsonValue &value){
+        return QByteArray::fromHex(value.toString().toLatin1());
+    };
+
+    QJsonObject maskObj = obj.value("mask").toObject();
+    SAKDebuggerDeviceParameters::SAKStructMaskContext maskCtx;
+    maskCtx.enableRx = maskObj.value("enableRx").toBool();
+    maskCtx.enableTx = maskObj.value("enableTx").toBool();
+    maskCtx.rx = quint8(maskObj.value("rx").toInt());
+    maskCtx.tx = quint8(maskObj.value("tx").toInt());
+    maskCtx.mode = maskObj.value("mode").toInt(SAKDebuggerDeviceParameters::MaskModeByte);
+    maskCtx.rxKey = toBytes(maskObj.value("rxKey"));
+    maskCtx.txKey = toBytes(maskObj.value("txKey"));
+    device->parameters()->setMaskContext(maskCtx);
+
+    QJsonObject analyzerObj = obj.value("analyzer").toObject();
+    SAKDebuggerDeviceParameters::SAKStructAnalyzerContext analyzerCtx;
+    analyzerCtx.enable = analyzerObj.value("enable").toBool();
+    analyzerCtx.fixedLength = analyzerObj.value("fixedLength").toBool();
+    analyzerCtx.length = analyzerObj.value("length").toInt();
+    if (analyzerObj.contains("startFlags")) {
+        analyzerCtx.startFlags = toBytes(analyzerObj.value("startFlags"));
+    }
+    if (analyzerObj.contains("endFlags")) {
+        analyzerCtx.endFlags = toBytes(analyzerObj.value("endFlags"));
+    }
+    device->parameters()->setAnalyzerContext(analyzerCtx);
+
+    // Ignored by the devices which are not network devices.
+    QJsonObject socketObj = obj.value("socketOptions").toObject();
+    SAKDebuggerDeviceParameters::SAKStructSocketOptionsContext socketCtx;
+    socketCtx.receiveBufferSize = socketObj.value("receiveBufferSize").toInt();
+    socketCtx.sendBufferSize = socketObj.value("sendBufferSize").toInt();
+    socketCtx.readBufferSize = socketObj.value("readBufferSize").toInt();
+    socketCtx.lowDelay = socketObj.value("lowDelay").toBool();
+    socketCtx.keepAlive = socketObj.value("keepAlive").toBool();
+    socketCtx.keepAliveIdle = socketObj.value("keepAliveIdle").toInt();
+    socketCtx.keepAliveInterval = socketObj.value("keepAliveInterval").toInt();
+    socketCtx.keepAliveCount = socketObj.value("keepAliveCount").toInt();
+    socketCtx.dscp = socketObj.value("dscp").toInt();
+    device->parameters()->setSocketOptionsContext(socketCtx);
+    connect(device->parameters(),
+            &SAKDebuggerDeviceParameters::socketOptionsDiagnosticsChanged,
+            this, [=](QString diagnostics){
+        if (!diagnostics.isEmpty()) {
+            qInfo() << QString("[%1]%2").arg(name, diagnostics.replace('\n', ", "));
+        }
+    });
+
+    connect(device, &SAKDebuggerDevice::errorOccurred,
+            this, [=](QString error){
+        qWarning() << QString("[%1]%2").arg(name, error);
+    });
+    mMetrics->addDevice(name, device);
+    mDeviceMap.insert(name, device);
+    return true;
+}
+
+bool SAKDaemon::createTransponder(const QJsonObject &obj)
+{
+    SAKDebuggerDevice *source = mDeviceMap.value(obj.value("source").toString());
+    SAKDebuggerDevice *target = mDeviceMap.value(obj.value("target").toString());
+    if (!(source && target) || (source == target)) {
+        qWarning() << "Invalid transponder:" << obj;
+        return false;
+    }
+
+    connect(source, &SAKDebuggerDevice::bytesRead,
+            target, &SAKDebuggerDevice::writeBytes);
+    if (obj.value("bidirectional").toBool()) {
+        connect(target, &SAKDebuggerDevice::bytesRead,
+                source, &SAKDebuggerDevice::writeBytes);
+    }
+
+    return true;
+}
+
+bool SAKDaemon::createAutoResponse(const QJsonObject &obj)
+{
+    SAKDebuggerDevice *device = mDeviceMap.value(obj.value("device").toString());
+    if (!device) {
+        qWarning() << "Invalid auto response item:" << obj;
+        return false;
+    }
+
+    SAKDaemonAutoResponse::SAKStructItemContext ctx;
+    ctx.referenceData = obj.value("referenceData").toString();
+    ctx.responseData = obj.value("responseData").toString();
+    ctx.referenceFormat = obj.value("referenceFormat")
+            .toInt(SAKCommonDataStructure::InputFormatHex);
+    ctx.responseFormat = obj.value("responseFormat")
+            .toInt(SAKCommonDataStructure::InputFormatHex);
+    ctx.option = obj.value("option").toInt();
+    ctx.enableDelay = obj.value("enableDelay").toBool();
+    ctx.delayTime = obj.value("delayTime").toInt();
+
+    auto autoResponse = new SAKDaemonAutoResponse(ctx, this);
+    connect(device, &SAKDebuggerDevice::bytesRead,
+            autoResponse, &SAKDaemonAutoResponse::onBytesRead);
+    connect(autoResponse, &SAKDaemonAutoResponse::invokeWriteBytes,
+            device, &SAKDebuggerDevice::writeBytes);
+    mAutoResponseList.append(autoResponse);
+    return true;
+}
+
+SAKDebuggerDevice *SAKDaemon::newDevice(const QString &type,
+                                        const QJsonObject &parameters)
+{
+    SAKDebuggerDevice *device = Q_NULLPTR;
+    QVariant parametersContext;
+#ifdef SAK_IMPORT_MODULE_SERIALPORT
+    if (type == QString("SerialPort")) {
+        SAKSerialPortParametersContext ctx;
+        ctx.portName = parameters.value("portName").toString();
+        ctx.baudRate = parameters.value("baudRate").toInt(9600);
+        ctx.dataBits = static_cast<QSerialPort::DataBits>(
+                    parameters.value("dataBits").toInt(QSerialPort::Data8));
+        ctx.parity = static_cast<QSerialPort::Parity>(
+                    parameters.value("parity").toInt(QSerialPort::NoParity));
+        ctx.stopBits = static_cast<QSerialPort::StopBits>(
+                    parameters.value("stopBits").toInt(QSerialPort::OneStop));
+        ctx.flowControl = static_cast<QSerialPort::FlowControl>(
+                    parameters.value("flowControl").toInt(QSerialPort::NoFlowControl));
+        ctx.frameIntervel = parameters.value("frameInterval").toInt(4);
+        parametersContext = QVariant::fromValue(ctx);
+        device = new SAKSerialPortDevice(Q_NULLPTR, QString());
+    }
+#endif
+#ifdef SAK_IMPORT_MODULE_TCP_CLIENT
+    if (type == QString("TcpClient")) {
+        SAKTcpClientParametersContext ctx;
+        ctx.localHost = parameters.value("localHost").toString();
+        ctx.localPort = quint16(parameters.value("localPort").toInt());
+        ctx.serverHost = parameters.value("serverHost").toString();
+        ctx.serverPort = quint16(parameters.value("serverPort").toInt());
+        ctx.specifyClientAddressAndPort =
+                parameters.value("specifyClientAddressAndPort").toBool();
+        ctx.allowAutomaticConnection =
+                parameters.value("allowAutomaticConnection").toBool(true);
+        parametersContext = QVariant::fromValue(ctx);
+        device = new SAKTcpClientDevice(Q_NULLPTR, QString());
+    }
+#endif
+#ifdef SAK_IMPORT_MODULE_TCP_SERVER
+    if (type == QString("TcpServer")) {
+        SAKTcpServerParametersContext ctx;
+        ctx.serverHost = parameters.value("serverHost").toString();
+        ctx.serverPort = quint16(parameters.value("serverPort").toInt());
+        ctx.currentClientHost = parameters.value("currentClientHost").toString();
+        ctx.currentClientPort = quint16(parameters.value("currentClientPort").toInt());
+        parametersContext = QVariant::fromValue(ctx);
+        device = new SAKTcpServerDevice(Q_NULLPTR, QString());
+    }
+#endif
+#ifdef SAK_IMPORT_MODULE_UDP_CLIENT
+    if (type == QString("UdpClient")) {
+        SAKUdpClientParametersContext ctx;
+        ctx.peerHost = parameters.value("peerHost").toString();
+        ctx.peerPort = quint16(parameters.value("peerPort").toInt());
+        ctx.localHost = parameters.value("localHost").toString();
+        ctx.localPort = quint16(parameters.value("localPort").toInt());
+        ctx.specifyLocalInfo = parameters.value("specifyLocalInfo").toBool();
+        ctx.broadcast = parameters.value("broadcast").toBool();
+        ctx.multicastGroups = parameters.value("multicastGroups")
+                .toVariant().toStringList();
+        parametersContext = QVariant::fromValue(ctx);
+        device = new SAKUdpClientDevice(Q_NULLPTR, QString());
+    }
+#endif
+#ifdef SAK_IMPORT_MODULE_UDP_SERVER
+    if (type == QString("UdpServer")) {
+        SAKUdpServerParametersContext ctx;
+        ctx.serverHost = parameters.value("serverHost").toString();
+        ctx.serverPort = quint16(parameters.value("serverPort").toInt());
+        ctx.currentClientHost = parameters.value("currentClientHost").toString();
+        ctx.currentClientPort = quint16(parameters.value("currentClientPort").toInt());
+        ctx.broadcast = parameters.value("broadcast").toBool();
+        ctx.multicastGroups = parameters.value("multicastGroups")
+                .toVariant().toStringList();
+        parametersContext = QVariant::fromValue(ctx);
+        device = new SAKUdpServerDevice(Q_NULLPTR, QString());
+    }
+#endif
+#ifdef SAK_IMPORT_MODULE_WEBSOCKET_CLIENT
+    if (type == QString("WebSocketClient")) {
+        SAKWSClientParametersContext ctx;
+        ctx.serverAddress = parameters.value("serverAddress").toString();
+        ctx.sendingType = quint32(parameters.value("sendingType")
+                                  .toInt(SAKCommonDataStructure::WebSocketSendingTypeBin));
+        parametersContext = QVariant::fromValue(ctx);
+        device = new SAKWebSocketClientDevice(Q_NULLPTR, QString());
+    }
+#endif
+#ifdef SAK_IMPORT_MODULE_WEBSOCKET_SERVER
+    if (type == QString("WebSocketServer")) {
+        SAKWSServerParametersContext ctx;
+        ctx.serverHost = parameters.value("serverHost").toString();
+        ctx.serverPort = quint16(parameters.value("serverPort").toInt());
+        ctx.currentClientHost = parameters.value("currentClientHost").toString();
+        ctx.currentClientPort = quint16(parameters.value("currentClientPort").toInt());
+        ctx.sendingType = quint32(parameters.value("sendingType")
+                                  .toInt(SAKCommonDataStructure::WebSocketSendingTypeBin));
+        parametersContext = QVariant::fromValue(ctx);
+        device = new SAKWebSocketServerDevice(Q_NULLPTR, QString());
+    }
+#endif
+
+    if (device) {
+        device->setParametersContext(parametersContext);
+    }
+
+    return device;
+}
@@ -0,0 +1,76 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#ifndef SAKDAEMON_HH
+#define SAKDAEMON_HH
+
+#include <QMap>
+#include <QObject>
+#include <QJsonObject>
+
+class SAKDaemonMetrics;
+class SAKDebuggerDevice;
+class SAKDaemonAutoResponse;
+
+/// @brief Headless bridge, the daemon instantiates devices, transponders and
+/// auto response rules from a json file, no widget is created. Such as:
+/// {
+///     "metrics": {"interval": 1000, "localServer": "qsak-daemon"},
+///     "devices": [
+///         {"name": "com", "type": "SerialPort",
+///          "parameters": {"portName": "ttyUSB0", "baudRate": 115200},
+///          "mask": {"enableRx": false, "rx": 0, "enableTx": false, "tx": 0,
+///                   "mode": 0, "rxKey": "", "txKey": ""},
+///          "analyzer": {"enable": true, "startFlags": "AA", "endFlags": "55"}},
+///         {"name": "net", "type": "TcpClient",
+///          "parameters": {"serverHost": "127.0.0.1", "serverPort": 6000},
+///          "socketOptions": {"lowDelay": true, "keepAlive": true,
+///                            "keepAliveIdle": 10, "receiveBufferSize": 262144}}
+///     ],
+///     "transponders": [{"source": "com", "target": "net", "bidirectional": true}],
+///     "autoResponse": [{"device": "com", "referenceData": "01 03",
+///                       "responseData": "01 03 00", "referenceFormat": 3,
+///                       "responseFormat": 3, "option": 0}]
+/// }
+class SAKDaemon : public QObject
+{
+    Q_OBJECT
+public:
+    SAKDaemon(QObject *parent = Q_NULLPTR);
+    ~SAKDaemon();
+
+    /**
+     * @brief load: Instantiate all of the objects described by the file.
+     * @param fileName: Json file.
+     * @return true: The file is loaded successfully.
+     */
+    bool load(const QString &fileName);
+
+    /**
+     * @brief start: Open all of the devices and start reporting metrics.
+     */
+    void start();
+
+    /**
+     * @brief stop: Close all of the devices.
+     */
+    void stop();
+private:
+    QMap<QString, SAKDebuggerDevice*> mDeviceMap;
+    QList<SAKDaemonAutoResponse*> mAutoResponseList;
+    SAKDaemonMetrics *mMetrics;
+private:
+    bool createDevice(const QJsonObject &obj);
+    bool createTransponder(const QJsonObject &obj);
+    bool createAutoResponse(const QJsonObject &obj);
+    SAKDebuggerDevice *newDevice(const QString &type,
+                                 const QJsonObject &parameters);
+};
+
+#endif
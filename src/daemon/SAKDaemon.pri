@@ -0,0 +1,91 @@
+# Headless bridge/daemon, build it by "qmake CONFIG+=sak_daemon".
+# The daemon shares the device stack(devices, mask kernel, socket options
+# kernel and parameters) with the debuggers, the parameters editors(dialogs)
+# belong to the debuggers and are not compiled, Qt Widgets is not linked.
+contains(CONFIG, debug, debug|release){
+    TARGET = QtSwissArmyKnifeDaemond
+}else{
+    TARGET = QtSwissArmyKnifeDaemon
+}
+
+QT -= gui widgets
+CONFIG += console
+CONFIG -= app_bundle
+DEFINES += SAK_IMPORT_MODULE_DAEMON
+RESOURCES =
+TRANSLATIONS =
+
+DEBUGGERS_DIR = $$PWD/../debuggers
+
+INCLUDEPATH += \
+    $$PWD
+
+FORMS =
+
+HEADERS = \
+    $$PWD/SAKDaemon.hh \
+    $$PWD/SAKDaemonAutoResponse.hh \
+    $$PWD/SAKDaemonMetrics.hh \
+    $$PWD/../common/SAKCommonDataStructure.hh \
+    $${DEBUGGERS_DIR}/debugger/plugins/autoresponse/SAKDebuggerPluginAutoResponseOption.hh \
+    $${DEBUGGERS_DIR}/debugger/device/SAKDebuggerDevice.hh \
+    $${DEBUGGERS_DIR}/debugger/device/SAKDebuggerDeviceMaskKernel.hh \
+    $${DEBUGGERS_DIR}/debugger/device/SAKDebuggerDeviceParameters.hh \
+    $${DEBUGGERS_DIR}/debugger/device/SAKDebuggerDeviceSocketOptionsKernel.hh
+
+SOURCES = \
+    $$PWD/SAKDaemon.cc \
+    $$PWD/SAKDaemonAutoResponse.cc \
+    $$PWD/SAKDaemonMain.cc \
+    $$PWD/SAKDaemonMetrics.cc \
+    $$PWD/../common/SAKCommonDataStructure.cc \
+    $${DEBUGGERS_DIR}/debugger/device/SAKDebuggerDevice.cc \
+    $${DEBUGGERS_DIR}/debugger/device/SAKDebuggerDeviceMaskKernel.cc \
+    $${DEBUGGERS_DIR}/debugger/device/SAKDebuggerDeviceParameters.cc \
+    $${DEBUGGERS_DIR}/debugger/device/SAKDebuggerDeviceSocketOptionsKernel.cc
+
+win32:LIBS += -lws2_32
+
+contains(DEFINES, SAK_IMPORT_MODULE_SERIALPORT){
+    HEADERS += $${DEBUGGERS_DIR}/serialport/SAKSerialPortDevice.hh
+    SOURCES += $${DEBUGGERS_DIR}/serialport/SAKSerialPortDevice.cc
+}
+
+contains(DEFINES, SAK_IMPORT_MODULE_TCP_CLIENT){
+    HEADERS += $${DEBUGGERS_DIR}/tcp/client/SAKTcpClientDevice.hh
+    SOURCES += $${DEBUGGERS_DIR}/tcp/client/SAKTcpClientDevice.cc
+}
+
+contains(DEFINES, SAK_IMPORT_MODULE_TCP_SERVER){
+    HEADERS += $${DEBUGGERS_DIR}/tcp/server/SAKTcpServerDevice.hh
+    SOURCES += $${DEBUGGERS_DIR}/tcp/server/SAKTcpServerDevice.cc
+}
+
+contains(DEFINES, SAK_IMPORT_MODULE_UDP){
+    HEADERS += \
+        $${DEBUGGERS_DIR}/udp/common/SAKUdpMulticastGroups.hh \
+        $${DEBUGGERS_DIR}/udp/common/SAKUdpSessions.hh
+    SOURCES += \
+        $${DEBUGGERS_DIR}/udp/common/SAKUdpMulticastGroups.cc \
+        $${DEBUGGERS_DIR}/udp/common/SAKUdpSessions.cc
+}
+
+contains(DEFINES, SAK_IMPORT_MODULE_UDP_CLIENT){
+    HEADERS += $${DEBUGGERS_DIR}/udp/client/SAKUdpClientDevice.hh
+    SOURCES += $${DEBUGGERS_DIR}/udp/client/SAKUdpClientDevice.cc
+}
+
+contains(DEFINES, SAK_IMPORT_MODULE_UDP_SERVER){
+    HEADERS += $${DEBUGGERS_DIR}/udp/server/SAKUdpServerDevice.hh
+    SOURCES += $${DEBUGGERS_DIR}/udp/server/SAKUdpServerDevice.cc
+}
+
+contains(DEFINES, SAK_IMPORT_MODULE_WEBSOCKET_CLIENT){
+    HEADERS += $${DEBUGGERS_DIR}/websocket/client/SAKWebSocketClientDevice.hh
+    SOURCES += $${DEBUGGERS_DIR}/websocket/client/SAKWebSocketClientDevice.cc
+}
+
+contains(DEFINES, SAK_IMPORT_MODULE_WEBSOCKET_SERVER){
+    HEADERS += $${DEBUGGERS_DIR}/websocket/server/SAKWebSocketServerDevice.hh
+    SOURCES += $${DEBUGGERS_DIR}/websocket/server/SAKWebSocketServerDevice.cc
+}
@@ -0,0 +1,62 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QTimer>
+
+#include "SAKDaemonAutoResponse.hh"
+#include "SAKCommonDataStructure.hh"
+#include "SAKDebuggerPluginAutoResponseOption.hh"
+
+SAKDaemonAutoResponse::SAKDaemonAutoResponse(SAKStructItemContext ctx,
+                                             QObject *parent)
+    :QObject(parent)
+    ,mCtx(ctx)
+{
+    QString referenceString = mCtx.referenceData;
+    if ((mCtx.referenceFormat == SAKCommonDataStructure::InputFormatBin) ||
+            (mCtx.referenceFormat == SAKCommonDataStructure::InputFormatOct) ||
+            (mCtx.referenceFormat == SAKCommonDataStructure::InputFormatDec) ||
+            (mCtx.referenceFormat == SAKCommonDataStructure::InputFormatHex)) {
+        referenceString = referenceString.trimmed();
+    }
+
+    mReferenceData = SAKCommonDataStructure::stringToByteArray(referenceString,
+                                                               mCtx.referenceFormat);
+    mResponseData = SAKCommonDataStructure::stringToByteArray(mCtx.responseData,
+                                                              mCtx.responseFormat);
+}
+
+void SAKDaemonAutoResponse::onBytesRead(QByteArray bytes)
+{
+    if (bytes.isEmpty() || mResponseData.isEmpty()) {
+        return;
+    }
+
+    bool needToResponse = false;
+    if (mCtx.option == SAKDebuggerPluginAutoResponseOption::ReadDataIsEqualToReference) {
+        needToResponse = (bytes == mReferenceData);
+    } else if (mCtx.option
+               == SAKDebuggerPluginAutoResponseOption::ReadDataContainsReferenceData) {
+        needToResponse = bytes.contains(mReferenceData);
+    } else if (mCtx.option
+               == SAKDebuggerPluginAutoResponseOption::ReadDataDoesNotContainReferenceData) {
+        needToResponse = !bytes.contains(mReferenceData);
+    }
+
+    if (needToResponse) {
+        if (mCtx.enableDelay) {
+            QByteArray responseData = mResponseData;
+            QTimer::singleShot(mCtx.delayTime, this, [=](){
+                emit invokeWriteBytes(responseData);
+            });
+        } else {
+            emit invokeWriteBytes(mResponseData);
+        }
+    }
+}
@@ -0,0 +1,43 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#ifndef SAKDAEMONAUTORESPONSE_HH
+#define SAKDAEMONAUTORESPONSE_HH
+
+#include <QObject>
+#include <QByteArray>
+
+/// @brief Auto response rule without ui, the options are
+/// SAKDebuggerPluginAutoResponseOption::SAKEnumAutomaticallyResponseOption.
+class SAKDaemonAutoResponse : public QObject
+{
+    Q_OBJECT
+public:
+    struct SAKStructItemContext {
+        QString referenceData;
+        QString responseData;
+        int referenceFormat;
+        int responseFormat;
+        int option;
+        bool enableDelay;
+        int delayTime;
+    };
+
+    SAKDaemonAutoResponse(SAKStructItemContext ctx, QObject *parent = Q_NULLPTR);
+    void onBytesRead(QByteArray bytes);
+private:
+    SAKStructItemContext mCtx;
+    // The data is converted once while the rule is created.
+    QByteArray mReferenceData;
+    QByteArray mResponseData;
+signals:
+    void invokeWriteBytes(QByteArray bytes);
+};
+
+#endif
@@ -0,0 +1,50 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QDebug>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include "SAKDaemon.hh"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setOrganizationName(QString("Qter"));
+    app.setOrganizationDomain(QString("IT"));
+    app.setApplicationName(QString("QtSwissArmyKnifeDaemon"));
+#ifdef SAK_VERSION
+    app.setApplicationVersion(SAK_VERSION);
+#else
+    app.setApplicationVersion("0.0.0");
+#endif
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QString("Qt Swiss Army Knife headless daemon"));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption configOption(QStringList() << "c" << "config",
+                                    QString("The config file(json) of the daemon."),
+                                    QString("file"));
+    parser.addOption(configOption);
+    parser.process(app);
+
+    if (!parser.isSet(configOption)) {
+        parser.showHelp(-1);
+    }
+
+    SAKDaemon daemon;
+    if (!daemon.load(parser.value(configOption))) {
+        return -1;
+    }
+
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, &daemon, &SAKDaemon::stop);
+    daemon.start();
+    return app.exec();
+}
@@ -0,0 +1,137 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QDebug>
+#include <QDateTime>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+#include "SAKDaemonMetrics.hh"
+#include "SAKDebuggerDevice.hh"
+
+SAKDaemonMetrics::SAKDaemonMetrics(QObject *parent)
+    :QObject(parent)
+    ,mLocalServer(Q_NULLPTR)
+    ,mOut(stdout)
+{
+    mReportTimer.setInterval(1000);
+    connect(&mReportTimer, &QTimer::timeout, this, &SAKDaemonMetrics::report);
+}
+
+SAKDaemonMetrics::~SAKDaemonMetrics()
+{
+    stop();
+}
+
+bool SAKDaemonMetrics::setup(int interval, const QString &localServerName)
+{
+    mReportTimer.setInterval(interval > 100 ? interval : 100);
+    if (localServerName.isEmpty()) {
+        return true;
+    }
+
+    mLocalServer = new QLocalServer(this);
+    QLocalServer::removeServer(localServerName);
+    if (!mLocalServer->listen(localServerName)) {
+        qWarning() << "Can not listen the local server:"
+                   << mLocalServer->errorString();
+        return false;
+    }
+
+    connect(mLocalServer, &QLocalServer::newConnection, this, [=](){
+        while (mLocalServer->hasPendingConnections()) {
+            QLocalSocket *socket = mLocalServer->nextPendingConnection();
+            mClientList.append(socket);
+            connect(socket, &QLocalSocket::disconnected, this, [=](){
+                mClientList.removeOne(socket);
+                socket->deleteLater();
+            });
+        }
+    });
+
+    return true;
+}
+
+void SAKDaemonMetrics::addDevice(const QString &name, SAKDebuggerDevice *device)
+{
+    SAKStructDeviceMetricsContext ctx;
+    ctx.device = device;
+    ctx.txFrames = 0;
+    ctx.txBytes = 0;
+    ctx.rxFrames = 0;
+    ctx.rxBytes = 0;
+    ctx.txBytesTemp = 0;
+    ctx.rxBytesTemp = 0;
+    ctx.errors = 0;
+    mMetricsCtxMap.insert(name, ctx);
+
+    connect(device, &SAKDebuggerDevice::bytesRead, this, [=](QByteArray bytes){
+        SAKStructDeviceMetricsContext &ctx = mMetricsCtxMap[name];
+        ctx.rxFrames += 1;
+        ctx.rxBytes += quint64(bytes.length());
+        ctx.rxBytesTemp += quint64(bytes.length());
+    });
+    connect(device, &SAKDebuggerDevice::bytesWritten, this, [=](QByteArray bytes){
+        SAKStructDeviceMetricsContext &ctx = mMetricsCtxMap[name];
+        ctx.txFrames += 1;
+        ctx.txBytes += quint64(bytes.length());
+        ctx.txBytesTemp += quint64(bytes.length());
+    });
+    connect(device, &SAKDebuggerDevice::errorOccurred, this, [=](){
+        mMetricsCtxMap[name].errors += 1;
+    });
+}
+
+void SAKDaemonMetrics::start()
+{
+    mElapsedTimer.start();
+    mReportTimer.start();
+}
+
+void SAKDaemonMetrics::stop()
+{
+    mReportTimer.stop();
+}
+
+void SAKDaemonMetrics::report()
+{
+    qint64 elapsed = mElapsedTimer.restart();
+    elapsed = elapsed > 0 ? elapsed : 1;
+
+    QJsonObject devices;
+    for (auto it = mMetricsCtxMap.begin(); it != mMetricsCtxMap.end(); ++it) {
+        SAKStructDeviceMetricsContext &ctx = it.value();
+        QJsonObject obj;
+        obj.insert("running", ctx.device->isRunning());
+        obj.insert("txFrames", double(ctx.txFrames));
+        obj.insert("txBytes", double(ctx.txBytes));
+        obj.insert("rxFrames", double(ctx.rxFrames));
+        obj.insert("rxBytes", double(ctx.rxBytes));
+        obj.insert("txSpeed", double(ctx.txBytesTemp)*1000/elapsed);
+        obj.insert("rxSpeed", double(ctx.rxBytesTemp)*1000/elapsed);
+        obj.insert("errors", double(ctx.errors));
+        devices.insert(it.key(), obj);
+
+        ctx.txBytesTemp = 0;
+        ctx.rxBytesTemp = 0;
+    }
+
+    QJsonObject rootObj;
+    rootObj.insert("time", QDateTime::currentDateTime().toString(Qt::ISODateWithMs));
+    rootObj.insert("devices", devices);
+    QByteArray line = QJsonDocument(rootObj).toJson(QJsonDocument::Compact);
+    line.append('\n');
+
+    mOut << QString::fromUtf8(line);
+    mOut.flush();
+
+    for (auto client : mClientList) {
+        client->write(line);
+    }
+}
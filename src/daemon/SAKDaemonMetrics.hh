@@ -0,0 +1,57 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#ifndef SAKDAEMONMETRICS_HH
+#define SAKDAEMONMETRICS_HH
+
+#include <QMap>
+#include <QTimer>
+#include <QObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QTextStream>
+#include <QElapsedTimer>
+
+class SAKDebuggerDevice;
+/// @brief Statistics of daemon devices, a json line is written to stdout
+/// (and to every client of the local server if it is specified) periodically.
+class SAKDaemonMetrics : public QObject
+{
+    Q_OBJECT
+public:
+    SAKDaemonMetrics(QObject *parent = Q_NULLPTR);
+    ~SAKDaemonMetrics();
+
+    bool setup(int interval, const QString &localServerName);
+    void addDevice(const QString &name, SAKDebuggerDevice *device);
+    void start();
+    void stop();
+private:
+    struct SAKStructDeviceMetricsContext {
+        SAKDebuggerDevice *device;
+        quint64 txFrames;
+        quint64 txBytes;
+        quint64 rxFrames;
+        quint64 rxBytes;
+        quint64 txBytesTemp; // The bytes written since last reporting
+        quint64 rxBytesTemp; // The bytes read since last reporting
+        quint64 errors;
+    };
+
+    QMap<QString, SAKStructDeviceMetricsContext> mMetricsCtxMap;
+    QTimer mReportTimer;
+    QElapsedTimer mElapsedTimer;
+    QLocalServer *mLocalServer;
+    QList<QLocalSocket*> mClientList;
+    QTextStream mOut; // stdout, flushed after every report
+private:
+    void report();
+};
+
+#endif
@@ -30,11 +30,14 @@
 #include "SAKDebuggerInput.hh"
 #include "SAKDebuggerDevice.hh"
 #include "SAKDebuggerOutput.hh"
+#include "SAKDebuggerDeviceMask.hh"
 #include "SAKDebuggerPlugins.hh"
 #include "SAKDebuggerStatistics.hh"
 #include "SAKCommonCrcInterface.hh"
 #include "SAKCommonDataStructure.hh"
 #include "SAKDebuggerController.hh"
+#include "SAKDebuggerDeviceAnalyzer.hh"
+#include "SAKDebuggerDeviceSocketOptions.hh"
 
 #ifdef SAK_IMPORT_MODULE_CHARTS
 #include "SAKPluginCharts.hh"
@@ -49,6 +52,9 @@ SAKDebugger::SAKDebugger(QSettings *settings,
     :QWidget(parent)
     ,mModuleDevice(Q_NULLPTR)
     ,mModuleController(Q_NULLPTR)
+    ,mDeviceMask(Q_NULLPTR)
+    ,mDeviceAnalyzer(Q_NULLPTR)
+    ,mDeviceSocketOptions(Q_NULLPTR)
     ,mUi(new Ui::SAKDebugger)
 {
     mUi->setupUi(this);
@@ -181,7 +187,7 @@ void SAKDebugger::initDebuggerDevice()
     Q_ASSERT_X(mModuleDevice,
                __FUNCTION__,
                "You must initialize the mDevice in the subcalss!");
-    mModuleDevice->setupMenu(mDeviceMenu);
+    initDebuggerDeviceMenu();
     auto updateUiState = [=](bool opened){
         mModuleInput->updateUiState(opened);
         mRefreshAction->setEnabled(!opened);
@@ -215,6 +221,49 @@ void SAKDebugger::initDebuggerDevice()
     });
 }
 
+void SAKDebugger::initDebuggerDeviceMenu()
+{
+    auto parameters = mModuleDevice->parameters();
+    mDeviceMenu->addAction(tr("Mask"), this, [=](){
+        if (!mDeviceMask) {
+            mDeviceMask = new SAKDebuggerDeviceMask(parameters, this);
+        }
+
+        if (mDeviceMask->isHidden()) {
+            mDeviceMask->show();
+        } else {
+            mDeviceMask->activateWindow();
+        }
+    });
+
+    mDeviceMenu->addAction(tr("Analyzer"), this, [=](){
+        if (!mDeviceAnalyzer) {
+            mDeviceAnalyzer = new SAKDebuggerDeviceAnalyzer(parameters, this);
+        }
+
+        if (mDeviceAnalyzer->isHidden()) {
+            mDeviceAnalyzer->show();
+        } else {
+            mDeviceAnalyzer->activateWindow();
+        }
+    });
+
+    if (mModuleDevice->socketOptionsSupported()) {
+        mDeviceMenu->addAction(tr("Socket options"), this, [=](){
+            if (!mDeviceSocketOptions) {
+                mDeviceSocketOptions =
+                        new SAKDebuggerDeviceSocketOptions(parameters, this);
+            }
+
+            if (mDeviceSocketOptions->isHidden()) {
+                mDeviceSocketOptions->show();
+            } else {
+                mDeviceSocketOptions->activateWindow();
+            }
+        });
+    }
+}
+
 void SAKDebugger::initDebuggerStatistics()
 {
     connect(mModuleDevice, &SAKDebuggerDevice::bytesRead,
@@ -235,6 +284,17 @@ void SAKDebugger::initDebuggerInput()
 {
     connect(mModuleInput, &SAKDebuggerInput::invokeWriteBytes,
             mModuleDevice, &SAKDebuggerDevice::writeBytes, Qt::QueuedConnection);
+    // The functions are thread safe.
+    connect(mModuleInput, &SAKDebuggerInput::invokeStartCyclicSending,
+            mModuleDevice, &SAKDebuggerDevice::startCyclicSending,
+            Qt::DirectConnection);
+    connect(mModuleInput, &SAKDebuggerInput::invokeStopCyclicSending,
+            mModuleDevice, &SAKDebuggerDevice::stopCyclicSending,
+            Qt::DirectConnection);
+    connect(mModuleDevice, &SAKDebuggerDevice::cyclicSendingStateChanged,
+            mModuleInput, &SAKDebuggerInput::onCyclicSendingStateChanged);
+    connect(mModuleDevice, &SAKDebuggerDevice::cyclicSendingRateChanged,
+            mModuleInput, &SAKDebuggerInput::onCyclicSendingRateChanged);
 }
 
 void SAKDebugger::initDebuggerPlugin()
@@ -37,7 +37,10 @@ class SAKDebuggerPlugins;
 class SAKDebuggerStatistics;
 class SAKCommonCrcInterface;
 class SAKDebuggerController;
+class SAKDebuggerDeviceMask;
+class SAKDebuggerDeviceAnalyzer;
 class SAKDebuggerPluginTransponders;
+class SAKDebuggerDeviceSocketOptions;
 
 namespace Ui {
     class SAKDebugger;
@@ -75,6 +78,7 @@ protected:
 private:
     void initDebuggerController();
     void initDebuggerDevice();
+    void initDebuggerDeviceMenu();
     void initDebuggerStatistics();
     void initDebuggerOutout();
     void initDebuggerInput();
@@ -91,6 +95,12 @@ private:
     SAKDebuggerDevice *mModuleDevice;
     SAKDebuggerController *mModuleController;
     SAKDebuggerPlugins *mModulePlugins;
+
+    // Parameters editors of the device, they are created the first time
+    // they are opened.
+    SAKDebuggerDeviceMask *mDeviceMask;
+    SAKDebuggerDeviceAnalyzer *mDeviceAnalyzer;
+    SAKDebuggerDeviceSocketOptions *mDeviceSocketOptions;
 public:
     static void commonSqlApiUpdateRecord(QSqlQuery *sqlQuery,
                                          QString tableName,
@@ -12,7 +12,9 @@ FORMS += \
     $$PWD/SAKDebugger.ui \
     $$PWD/device/SAKDebuggerDeviceAnalyzer.ui \
     $$PWD/device/SAKDebuggerDeviceMask.ui \
+    $$PWD/device/SAKDebuggerDeviceSocketOptions.ui \
     $$PWD/input/SAKDebuggerInputCrcSettings.ui \
+    $$PWD/input/SAKDebuggerInputCyclicSending.ui \
     $$PWD/input/SAKDebuggerInputDataPresetItem.ui \
     $$PWD/output/SAKDebuggerOutputHighlighter.ui \
     $$PWD/output/SAKDebuggerOutputLog.ui \
@@ -24,10 +26,16 @@ HEADERS += \
     $$PWD/device/SAKDebuggerDevice.hh \
     $$PWD/device/SAKDebuggerDeviceAnalyzer.hh \
     $$PWD/device/SAKDebuggerDeviceMask.hh \
+    $$PWD/device/SAKDebuggerDeviceMaskKernel.hh \
+    $$PWD/device/SAKDebuggerDeviceParameters.hh \
+    $$PWD/device/SAKDebuggerDeviceSocketOptions.hh \
+    $$PWD/device/SAKDebuggerDeviceSocketOptionsKernel.hh \
     $$PWD/input/SAKDebuggerInput.hh \
     $$PWD/input/SAKDebuggerInputCrcSettings.hh \
+    $$PWD/input/SAKDebuggerInputCyclicSending.hh \
     $$PWD/input/SAKDebuggerInputDataPreset.hh \
     $$PWD/input/SAKDebuggerInputDataPresetItem.hh \
+    $$PWD/input/SAKDebuggerInputEncoder.hh \
     $$PWD/output/SAKDebuggerOutput.hh \
     $$PWD/output/SAKDebuggerOutputHighlighter.hh \
     $$PWD/output/SAKDebuggerOutputLog.hh \
@@ -40,12 +48,21 @@ SOURCES += \
     $$PWD/device/SAKDebuggerDevice.cc \
     $$PWD/device/SAKDebuggerDeviceAnalyzer.cc \
     $$PWD/device/SAKDebuggerDeviceMask.cc \
+    $$PWD/device/SAKDebuggerDeviceMaskKernel.cc \
+    $$PWD/device/SAKDebuggerDeviceParameters.cc \
+    $$PWD/device/SAKDebuggerDeviceSocketOptions.cc \
+    $$PWD/device/SAKDebuggerDeviceSocketOptionsKernel.cc \
     $$PWD/input/SAKDebuggerInput.cc \
     $$PWD/input/SAKDebuggerInputCrcSettings.cc \
+    $$PWD/input/SAKDebuggerInputCyclicSending.cc \
     $$PWD/input/SAKDebuggerInputDataPreset.cc \
     $$PWD/input/SAKDebuggerInputDataPresetItem.cc \
+    $$PWD/input/SAKDebuggerInputEncoder.cc \
     $$PWD/output/SAKDebuggerOutput.cc \
     $$PWD/output/SAKDebuggerOutputHighlighter.cc \
     $$PWD/output/SAKDebuggerOutputLog.cc \
     $$PWD/output/SAKDebuggerOutputSave2File.cc \
     $$PWD/statistics/SAKDebuggerStatistics.cc
+
+# setsockopt() of the socket options
+win32:LIBS += -lws2_32
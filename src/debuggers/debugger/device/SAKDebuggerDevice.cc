@@ -9,39 +9,26 @@
  ***************************************************************************************/
 #include <QTimer>
 #include <QDebug>
-#include <QWidget>
-#include <QDialog>
 #include <QEventLoop>
-#include <QApplication>
 
 #include "SAKDebuggerDevice.hh"
-#include "SAKDebuggerDeviceMask.hh"
+#include "SAKDebuggerDeviceMaskKernel.hh"
 
 SAKDebuggerDevice::SAKDebuggerDevice(QSettings *settings,
                                      const QString &settingsGroup,
-                                     QWidget *uiParent,
                                      QObject *parent)
     :QThread(parent)
-    ,mMask(Q_NULLPTR)
+    ,mParameters(new SAKDebuggerDeviceParameters(settings, settingsGroup, this))
 {
-    mMask = new SAKDebuggerDeviceMask(settings, settingsGroup, uiParent);
-    mInnerParametersContext.maskCtx = mMask->parametersContext();
-    connect(mMask, &SAKDebuggerDeviceMask::parametersChanged,
+    mCyclicSendingEnable = false;
+    mCyclicSendingStateCtx.running = false;
+    mMaskStateDirty.storeRelease(1);
+    connect(mParameters, &SAKDebuggerDeviceParameters::maskContextChanged,
             this, [&](){
-        mInnerParametersContextMutex.lock();
-        mInnerParametersContext.maskCtx = mMask->parametersContext();
-        mInnerParametersContextMutex.unlock();
-    });
-
-    mAnalyzer = new SAKDebuggerDeviceAnalyzer(settings, settingsGroup, uiParent);
-    mInnerParametersContext.analyzerCtx = mAnalyzer->parametersContext();
-    connect(mAnalyzer, &SAKDebuggerDeviceAnalyzer::parametersChanged,
-            this, [&](){
-        mInnerParametersContextMutex.lock();
-        mInnerParametersContext.analyzerCtx = mAnalyzer->parametersContext();
-        mInnerParametersContextMutex.unlock();
-    });
-    connect(mAnalyzer, &SAKDebuggerDeviceAnalyzer::clearTemp,
+        // The rolling key and the key stream restart from the beginning.
+        mMaskStateDirty.storeRelease(1);
+    }, Qt::DirectConnection);
+    connect(mParameters, &SAKDebuggerDeviceParameters::clearAnalyzerTemp,
             this, [&](){
         mAnalyzerCtxMutex.lock();
         mAnalyzerCtx.bytesTemp.clear();
@@ -51,10 +38,7 @@ SAKDebuggerDevice::SAKDebuggerDevice(QSettings *settings,
 
 SAKDebuggerDevice::~SAKDebuggerDevice()
 {
-#if 0
-    mMask->deleteLater();
-    mAnalyzer->deleteLater();
-#endif
+
 }
 
 void SAKDebuggerDevice::writeBytes(QByteArray bytes)
@@ -73,23 +57,28 @@ void SAKDebuggerDevice::writeBytes(QByteArray bytes)
     mBytesVectorMutex.unlock();
 }
 
-void SAKDebuggerDevice::setupMenu(QMenu *menu)
+SAKDebuggerDeviceParameters *SAKDebuggerDevice::parameters()
 {
-    menu->addAction(tr("Mask"), this, [=](){
-        if (mMask->isHidden()) {
-            mMask->show();
-        } else {
-            mMask->activateWindow();
-        }
-    });
+    return mParameters;
+}
 
-    menu->addAction(tr("Analyzer"), this, [=](){
-        if (mAnalyzer->isHidden()) {
-            mAnalyzer->show();
-        } else {
-            mAnalyzer->activateWindow();
-        }
-    });
+void SAKDebuggerDevice::startCyclicSending(const SAKStructCyclicSendingContext &ctx)
+{
+    mCyclicSendingCtxMutex.lock();
+    mCyclicSendingCtx = ctx;
+    mCyclicSendingCtx.period = qMax<qint64>(ctx.period, 1);
+    mCyclicSendingCtx.burst = qMax(ctx.burst, 1);
+    mCyclicSendingEnable = true;
+    mCyclicSendingDirty.storeRelease(1);
+    mCyclicSendingCtxMutex.unlock();
+}
+
+void SAKDebuggerDevice::stopCyclicSending()
+{
+    mCyclicSendingCtxMutex.lock();
+    mCyclicSendingEnable = false;
+    mCyclicSendingDirty.storeRelease(1);
+    mCyclicSendingCtxMutex.unlock();
 }
 
 QVariant SAKDebuggerDevice::parametersContext()
@@ -105,6 +94,8 @@ void SAKDebuggerDevice::setParametersContext(QVariant parametersContext)
     mParametersContextMutex.lock();
     mParametersContext = parametersContext;
     mParametersContextMutex.unlock();
+
+    emit parametersContextChanged();
 }
 
 QByteArray SAKDebuggerDevice::takeBytes()
@@ -121,17 +112,21 @@ QByteArray SAKDebuggerDevice::takeBytes()
 
 void SAKDebuggerDevice::run()
 {
+    mMaskStateDirty.storeRelease(1);
+    mCyclicSendingDirty.storeRelease(1);
     QTimer *writeTimer = new QTimer;
     writeTimer->setInterval(5);
     writeTimer->setSingleShot(true);
+    QTimer *cyclicTimer = new QTimer;
+    cyclicTimer->setTimerType(Qt::PreciseTimer);
+    cyclicTimer->setSingleShot(true);
     if (initialize()) {
         connect(this, &SAKDebuggerDevice::readyRead,
                 this, [=](SAKDeviceProtectedSignal){
             QByteArray ret = read();
             if (ret.length()) {
-                ret = mask(ret, true);
-                auto ctx = innerParametersContext();
-                if (ctx.analyzerCtx.enable) {
+                mask(ret, true);
+                if (mParameters->analyzerContext().enable) {
                     analyzer(ret);
                 } else {
                     emit bytesRead(ret);
@@ -140,9 +135,13 @@ void SAKDebuggerDevice::run()
         }, Qt::DirectConnection);
 
         connect(writeTimer, &QTimer::timeout, this, [=](){
+            if (mCyclicSendingDirty.fetchAndStoreAcquire(0)) {
+                updateCyclicSending(cyclicTimer);
+            }
+
             QByteArray bytes = takeBytes();
             if (bytes.length()) {
-                bytes = mask(bytes, false);
+                mask(bytes, false);
                 QByteArray ret = write(bytes);
                 if (ret.length()) {
                     emit bytesWritten(ret);
@@ -151,13 +150,30 @@ void SAKDebuggerDevice::run()
             writeTimer->start();
         }, Qt::DirectConnection);
 
+        connect(cyclicTimer, &QTimer::timeout, this, [=](){
+            cyclicSending(cyclicTimer);
+        }, Qt::DirectConnection);
+
         writeTimer->start();
         exec();
     }
 
+    if (mCyclicSendingStateCtx.running) {
+        finishCyclicSending(cyclicTimer);
+    }
+    cyclicTimer->stop();
+    cyclicTimer->deleteLater();
     writeTimer->stop();
     writeTimer->deleteLater();
     uninitialize();
+    if (socketOptionsSupported()) {
+        mParameters->setSocketOptionsDiagnostics(QString());
+    }
+}
+
+bool SAKDebuggerDevice::socketOptionsSupported()
+{
+    return false;
 }
 
 QByteArray SAKDebuggerDevice::read()
@@ -165,37 +181,169 @@ QByteArray SAKDebuggerDevice::read()
     return QByteArray();
 }
 
-QByteArray SAKDebuggerDevice::mask(const QByteArray &plaintext, bool isRxData)
+void SAKDebuggerDevice::mask(QByteArray &bytes, bool isRxData)
 {
-    auto doMask = [](const QByteArray &plaintext, quint8 mask)->QByteArray{
-        QByteArray ciphertext;
-        for (int i = 0; i < plaintext.length(); i++) {
-            quint8 value = quint8(plaintext.at(i));
-            value ^= mask;
-            ciphertext.append(reinterpret_cast<char*>(&value), 1);
-        }
+    // Nothing to do(no copy) if the mask is disabled.
+    auto ctx = mParameters->maskContext();
+    bool enable = isRxData ? ctx.enableRx : ctx.enableTx;
+    if ((!enable) || bytes.isEmpty()) {
+        return;
+    }
 
-        return ciphertext;
-    };
+    if (mMaskStateDirty.fetchAndStoreAcquire(0)) {
+        mMaskStateCtx.rxKeyOffset = 0;
+        mMaskStateCtx.txKeyOffset = 0;
+        mMaskStateCtx.rxStreamState = SAKDebuggerDeviceMaskKernel::streamSeed(ctx.rxKey);
+        mMaskStateCtx.txStreamState = SAKDebuggerDeviceMaskKernel::streamSeed(ctx.txKey);
+    }
 
-    QByteArray ciphertext;
-    auto ctx = innerParametersContext();
-    quint8 mask = isRxData ? ctx.maskCtx.rx : ctx.maskCtx.tx;
-    bool enable = isRxData ? ctx.maskCtx.enableRx : ctx.maskCtx.enableTx;
-    if (enable) {
-        ciphertext = doMask(plaintext, mask);
+    const QByteArray &key = isRxData ? ctx.rxKey : ctx.txKey;
+    char *data = bytes.data();
+    if (ctx.mode == SAKDebuggerDeviceParameters::MaskModeKey) {
+        SAKDebuggerDeviceMaskKernel::xorKey(data, bytes.length(), key, 0);
+    } else if (ctx.mode == SAKDebuggerDeviceParameters::MaskModeRollingKey) {
+        qint64 &offset = isRxData ? mMaskStateCtx.rxKeyOffset
+                                  : mMaskStateCtx.txKeyOffset;
+        offset = SAKDebuggerDeviceMaskKernel::xorKey(data, bytes.length(), key, offset);
+    } else if (ctx.mode == SAKDebuggerDeviceParameters::MaskModeStream) {
+        quint32 &state = isRxData ? mMaskStateCtx.rxStreamState
+                                  : mMaskStateCtx.txStreamState;
+        state = SAKDebuggerDeviceMaskKernel::xorStream(data, bytes.length(), state);
     } else {
-        ciphertext = plaintext;
+        quint8 mask = isRxData ? ctx.rx : ctx.tx;
+        SAKDebuggerDeviceMaskKernel::xorByte(data, bytes.length(), mask);
+    }
+}
+
+void SAKDebuggerDevice::updateCyclicSending(QTimer *cyclicTimer)
+{
+    mCyclicSendingCtxMutex.lock();
+    bool enable = mCyclicSendingEnable;
+    SAKStructCyclicSendingContext ctx = mCyclicSendingCtx;
+    mCyclicSendingCtxMutex.unlock();
+
+    auto &state = mCyclicSendingStateCtx;
+    if (!enable) {
+        if (state.running) {
+            finishCyclicSending(cyclicTimer);
+        }
+        return;
+    }
+
+    // Only the frame is changed, the clock and the counters are kept.
+    if (state.running
+            && (state.ctx.period == ctx.period)
+            && (state.ctx.burst == ctx.burst)
+            && (state.ctx.count == ctx.count)
+            && (state.ctx.duration == ctx.duration)) {
+        state.ctx.bytes = ctx.bytes;
+        return;
     }
 
-    return ciphertext;
+    state.ctx = ctx;
+    state.periods = 0;
+    state.frames = 0;
+    state.reportTime = 0;
+    state.clock.start();
+    if (!state.running) {
+        state.running = true;
+        emit cyclicSendingStateChanged(true);
+    }
+    cyclicTimer->start(0);
+}
+
+void SAKDebuggerDevice::cyclicSending(QTimer *cyclicTimer)
+{
+    auto &state = mCyclicSendingStateCtx;
+    if (!state.running) {
+        return;
+    }
+
+    // Periods are scheduled against the monotonic clock, so timer jitter does not
+    // accumulate. If the period is shorter than the timer resolution(1ms), all of
+    // the periods that are due are sent in a tick.
+    const SAKStructCyclicSendingContext &ctx = state.ctx;
+    qint64 elapsed = state.clock.nsecsElapsed()/1000;
+    qint64 due = elapsed/ctx.period + 1;
+    qint64 limit = -1;
+    if (ctx.count > 0) {
+        limit = ctx.count;
+    }
+    if (ctx.duration > 0) {
+        qint64 periods = (ctx.duration*1000 + ctx.period - 1)/ctx.period;
+        limit = limit < 0 ? periods : qMin(limit, periods);
+    }
+    if (limit >= 0) {
+        due = qMin(due, limit);
+    }
+
+    // The periods that are far behind(such as a blocked device) are dropped, the
+    // achieved rate tells it.
+    const qint64 maxPendingPeriods = 1000;
+    if (due - state.periods > maxPendingPeriods) {
+        state.periods = due - maxPendingPeriods;
+    }
+
+    for (; state.periods < due; state.periods++) {
+        for (int i = 0; i < ctx.burst; i++) {
+            QByteArray bytes = ctx.bytes;
+            mask(bytes, false);
+            QByteArray ret = write(bytes);
+            if (ret.length()) {
+                state.frames += 1;
+                emit bytesWritten(ret);
+            }
+        }
+    }
+
+    if ((limit >= 0) && (state.periods >= limit)) {
+        finishCyclicSending(cyclicTimer);
+        return;
+    }
+
+    if (elapsed - state.reportTime >= 500*1000) {
+        state.reportTime = elapsed;
+        reportCyclicSendingRate(elapsed);
+    }
+
+    qint64 wait = state.periods*ctx.period - state.clock.nsecsElapsed()/1000;
+    cyclicTimer->start(int(qBound<qint64>(1, wait/1000, INT_MAX)));
+}
+
+void SAKDebuggerDevice::finishCyclicSending(QTimer *cyclicTimer)
+{
+    auto &state = mCyclicSendingStateCtx;
+    cyclicTimer->stop();
+    reportCyclicSendingRate(state.clock.nsecsElapsed()/1000);
+    state.running = false;
+
+    // Do not restart the finished sending when the frame is changed, but a new
+    // request that has not been handled is kept.
+    mCyclicSendingCtxMutex.lock();
+    if (!mCyclicSendingDirty.loadAcquire()) {
+        mCyclicSendingEnable = false;
+    }
+    mCyclicSendingCtxMutex.unlock();
+    emit cyclicSendingStateChanged(false);
+}
+
+void SAKDebuggerDevice::reportCyclicSendingRate(qint64 elapsed)
+{
+    const SAKStructCyclicSendingContext &ctx = mCyclicSendingStateCtx.ctx;
+    double requested = 1000.0*1000.0*ctx.burst/ctx.period;
+    double achieved = 0;
+    if (elapsed > 0) {
+        achieved = 1000.0*1000.0*mCyclicSendingStateCtx.frames/elapsed;
+    }
+
+    emit cyclicSendingRateChanged(requested, achieved);
 }
 
 void SAKDebuggerDevice::analyzer(QByteArray data)
 {
     // If the bytes of temp data is more than maxTempLength(2048) bytes,
     // a frame which length is maxTempLength will be emit.
-    auto ctx = innerParametersContext();
+    auto ctx = mParameters->analyzerContext();
     mAnalyzerCtxMutex.lock();
     mAnalyzerCtx.bytesTemp.append(data);
     if (mAnalyzerCtx.bytesTemp.length() >= mAnalyzerCtx.maxTempLangth) {
@@ -207,13 +355,13 @@ void SAKDebuggerDevice::analyzer(QByteArray data)
     }
 
     // The length of frame is fixed
-    if (ctx.analyzerCtx.fixedLength) {
-        if (ctx.analyzerCtx.length > 0) {
-            while (mAnalyzerCtx.bytesTemp.length() >= ctx.analyzerCtx.length) {
+    if (ctx.fixedLength) {
+        if (ctx.length > 0) {
+            while (mAnalyzerCtx.bytesTemp.length() >= ctx.length) {
                 QByteArray temp = QByteArray(mAnalyzerCtx.bytesTemp.data(),
-                                             ctx.analyzerCtx.length);
+                                             ctx.length);
                 mAnalyzerCtx.bytesTemp =
-                        mAnalyzerCtx.bytesTemp.remove(0, ctx.analyzerCtx.length);
+                        mAnalyzerCtx.bytesTemp.remove(0, ctx.length);
                 emit bytesRead(temp);
             }
         } else {
@@ -231,7 +379,7 @@ void SAKDebuggerDevice::analyzer(QByteArray data)
 
     // Extract data according to the flags
     // If both of start-bytes and end-bytes are empty, temp data will be clear
-    if (ctx.analyzerCtx.startFlags.isEmpty() && ctx.analyzerCtx.endFlags.isEmpty()){
+    if (ctx.startFlags.isEmpty() && ctx.endFlags.isEmpty()){
         if (mAnalyzerCtx.bytesTemp.length()){
             QByteArray temp = mAnalyzerCtx.bytesTemp;
             mAnalyzerCtx.bytesTemp.clear();
@@ -245,17 +393,17 @@ void SAKDebuggerDevice::analyzer(QByteArray data)
 
     while(1){
         // Ensure that bytes is enough
-        if (mAnalyzerCtx.bytesTemp.length() < (ctx.analyzerCtx.startFlags.length() +
-                                               ctx.analyzerCtx.endFlags.length())) {
+        if (mAnalyzerCtx.bytesTemp.length() < (ctx.startFlags.length() +
+                                               ctx.endFlags.length())) {
             break;
         }
 
         // Match start-bytes
         bool startBytesMatched = true;
-        if (ctx.analyzerCtx.startFlags.isEmpty()) {
+        if (ctx.startFlags.isEmpty()) {
             startBytesMatched = true;
         } else {
-            int ret = mAnalyzerCtx.bytesTemp.indexOf(ctx.analyzerCtx.startFlags, 0);
+            int ret = mAnalyzerCtx.bytesTemp.indexOf(ctx.startFlags, 0);
             if (ret >= 0) {
                 startBytesMatched = true;
                 // Remove error data
@@ -272,38 +420,31 @@ void SAKDebuggerDevice::analyzer(QByteArray data)
         // Match end-bytes
         bool endBytesMatched = true;
         quint32 frameLength = 0;
-        if (ctx.analyzerCtx.endFlags.isEmpty()) {
+        if (ctx.endFlags.isEmpty()) {
             endBytesMatched = true;
         } else {
             int ret = mAnalyzerCtx.bytesTemp.indexOf(
-                        ctx.analyzerCtx.endFlags,
-                        ctx.analyzerCtx.startFlags.length());
+                        ctx.endFlags,
+                        ctx.startFlags.length());
             if (ret >= 0) {
                 endBytesMatched = true;
-                frameLength = ret + ctx.analyzerCtx.endFlags.length();
+                frameLength = ret + ctx.endFlags.length();
             } else {
                 endBytesMatched = false;
             }
         }
 
         // A completed data-frame has been extracted
-        if (startBytesMatched && endBytesMatched) {
+        if (startBytesMatched && endBytesMatched && frameLength) {
             QByteArray temp(mAnalyzerCtx.bytesTemp.data(), frameLength);
             mAnalyzerCtx.bytesTemp.remove(0, frameLength);
             if (!temp.isEmpty()) {
                 emit bytesRead(temp);
             }
+        } else {
+            // Waiting for more data
+            break;
         }
     }
     mAnalyzerCtxMutex.unlock();
 }
-
-SAKDebuggerDevice::SAKStructDevicePatametersContext
-SAKDebuggerDevice::innerParametersContext()
-{
-    mInnerParametersContextMutex.lock();
-    auto parasCtx = mInnerParametersContext;
-    mInnerParametersContextMutex.unlock();
-
-    return parasCtx;
-}
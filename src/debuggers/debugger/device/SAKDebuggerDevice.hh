@@ -9,30 +9,59 @@
  ***************************************************************************************/
 #ifndef SAKDEBUGGERDEVICE_HH
 #define SAKDEBUGGERDEVICE_HH
-#include <QMenu>
 #include <QMutex>
+#include <QTimer>
 #include <QThread>
 #include <QSettings>
+#include <QAtomicInt>
+#include <QElapsedTimer>
 #include <QWaitCondition>
 
-#include "SAKDebuggerDeviceMask.hh"
-#include "SAKDebuggerDeviceAnalyzer.hh"
+#include "SAKDebuggerDeviceParameters.hh"
 
-/// @brief device abstract class
+/// @brief device abstract class, the device does not depend on Qt Widgets, the
+/// parameters editors are created by SAKDebugger.
 class SAKDebuggerDevice:public QThread
 {
     Q_OBJECT
 public:
     SAKDebuggerDevice(QSettings *settings,
                       const QString &settingsGroup,
-                      QWidget *uiParent = Q_NULLPTR,
                       QObject *parent = Q_NULLPTR);
     ~SAKDebuggerDevice();
 
     void writeBytes(QByteArray bytes);
-    void setupMenu(QMenu *menu);
     QVariant parametersContext();
     void setParametersContext(QVariant parametersContext);
+    SAKDebuggerDeviceParameters *parameters();
+
+    struct SAKStructCyclicSendingContext {
+        QByteArray bytes;   // The frame to be sent
+        qint64 period;      // Unit is microsecond
+        int burst;          // Frames of every period
+        qint64 count;       // Periods to be sent, 0 means unlimited
+        qint64 duration;    // Unit is millisecond, 0 means unlimited
+    };
+
+    /**
+     * @brief startCyclicSending: Send a frame periodically in the device thread,
+     * if the sending is running and only the frame is changed, the frame is
+     * replaced without restarting. The function is thread safe.
+     * @param ctx: Sending parameters.
+     */
+    void startCyclicSending(const SAKStructCyclicSendingContext &ctx);
+
+    /**
+     * @brief stopCyclicSending: Stop cyclic sending, the function is thread safe.
+     */
+    void stopCyclicSending();
+
+    /**
+     * @brief socketOptionsSupported: Network devices return true, the socket
+     * options editor will be added to the device menu, the options should be
+     * applied in initialize().
+     */
+    virtual bool socketOptionsSupported();
 protected:
     struct SAKDeviceProtectedSignal {};
 protected:
@@ -46,34 +75,56 @@ protected:
 signals:
     void readyRead(SAKDebuggerDevice::SAKDeviceProtectedSignal);
 private:
-    struct SAKStructDevicePatametersContext {
-        SAKDebuggerDeviceMask::SAKStructMaskContext maskCtx ;
-        SAKDebuggerDeviceAnalyzer::SAKStructAnalyzerContext analyzerCtx;
-    }mInnerParametersContext;
     struct SAKStructDeviceAnalyzerContext {
         QByteArray bytesTemp;
         const int maxTempLangth = 2048;
     }mAnalyzerCtx;
+    // Accessed in the device thread only
+    struct SAKStructMaskStateContext {
+        qint64 rxKeyOffset;
+        qint64 txKeyOffset;
+        quint32 rxStreamState;
+        quint32 txStreamState;
+    }mMaskStateCtx;
+    QAtomicInt mMaskStateDirty;
+
+    SAKStructCyclicSendingContext mCyclicSendingCtx;
+    bool mCyclicSendingEnable;
+    QMutex mCyclicSendingCtxMutex;
+    QAtomicInt mCyclicSendingDirty;
+    // Accessed in the device thread only
+    struct SAKStructCyclicSendingStateContext {
+        bool running;
+        SAKStructCyclicSendingContext ctx;
+        QElapsedTimer clock;
+        qint64 periods;     // Periods that have been handled
+        qint64 frames;      // Frames that have been written
+        qint64 reportTime;  // Unit is microsecond
+    }mCyclicSendingStateCtx;
 private:
-    QSettings *settings;
-    const QString settingsGroup;
-    QMutex mInnerParametersContextMutex;
+    SAKDebuggerDeviceParameters *mParameters;
     QMutex mParametersContextMutex;
     QVariant mParametersContext;
     QVector<QByteArray> mBytesVector;
     QMutex mBytesVectorMutex;
     QMutex mAnalyzerCtxMutex;
-    // Parameters editors
-    SAKDebuggerDeviceMask *mMask;
-    SAKDebuggerDeviceAnalyzer *mAnalyzer;
 private:
-    QByteArray mask(const QByteArray &plaintext, bool isRxData);
+    void mask(QByteArray &bytes, bool isRxData);
     void analyzer(QByteArray data);
-    SAKStructDevicePatametersContext innerParametersContext();
+    void updateCyclicSending(QTimer *cyclicTimer);
+    void cyclicSending(QTimer *cyclicTimer);
+    void finishCyclicSending(QTimer *cyclicTimer);
+    void reportCyclicSendingRate(qint64 elapsed);
 signals:
+    // Emitted by setParametersContext(), the devices can update the parameters
+    // which can be changed while the device is opened.
+    void parametersContextChanged();
     void bytesWritten(QByteArray bytes);
     void bytesRead(QByteArray bytes);
     void errorOccurred(QString error);
+    void cyclicSendingStateChanged(bool running);
+    // Unit is frames per second
+    void cyclicSendingRateChanged(double requested, double achieved);
 };
 
 #endif
@@ -11,7 +11,6 @@
 #define SAKDEBUGGERDEVICEANALYZER_HH
 
 #include <QDialog>
-#include <QSettings>
 #include <QCheckBox>
 #include <QLineEdit>
 #include <QPushButton>
@@ -20,40 +19,20 @@ namespace Ui {
     class SAKDebuggerDeviceAnalyzer;
 }
 
-/// @brief Parameters editing widget
+class SAKDebuggerDeviceParameters;
+/// @brief Parameters editing widget, it is created the first time it is opened.
 class SAKDebuggerDeviceAnalyzer:public QDialog
 {
     Q_OBJECT
 public:
-    SAKDebuggerDeviceAnalyzer(QSettings *settings,
-                              const QString &settingsGroup,
+    SAKDebuggerDeviceAnalyzer(SAKDebuggerDeviceParameters *parameters,
                               QWidget *parent = Q_NULLPTR);
     ~SAKDebuggerDeviceAnalyzer();
-
-    struct SAKStructAnalyzerContext {
-        bool enable;
-        bool fixedLength;
-        int length;
-        QByteArray startFlags;
-        QByteArray endFlags;
-    };
-
-    SAKStructAnalyzerContext parametersContext();
-private:
-    struct SAKStructSettingsKeyContext {
-        QString enable;
-
-        QString fixedLength;
-        QString frameLength ;
-
-        QString startFlags;
-        QString endFlags;
-    }mSettingsKeyContext;
 private:
+    SAKDebuggerDeviceParameters *mParameters;
     Ui::SAKDebuggerDeviceAnalyzer *mUi;
-signals:
-    void parametersChanged();
-    void clearTemp();
+private:
+    void updateParameters();
 };
 
 #endif
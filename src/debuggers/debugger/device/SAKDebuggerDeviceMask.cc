@@ -7,55 +7,74 @@
  * QtSwissArmyKnife is licensed according to the terms in
  * the file LICENCE in the root of the source code directory.
  ***************************************************************************************/
-#include <QTimer>
 #include "SAKDebuggerDeviceMask.hh"
+#include "SAKCommonDataStructure.hh"
+#include "SAKDebuggerDeviceParameters.hh"
 #include "ui_SAKDebuggerDeviceMask.h"
 
-SAKDebuggerDeviceMask::SAKDebuggerDeviceMask(QSettings *settings,
-                                             QString settingGroup,
+SAKDebuggerDeviceMask::SAKDebuggerDeviceMask(SAKDebuggerDeviceParameters *parameters,
                                              QWidget *parent)
     :QDialog(parent)
+    ,mParameters(parameters)
     ,mUi(new Ui::SAKDebuggerDeviceMask)
 {
     mUi->setupUi(this);
+    mUi->modeComboBox->addItem(tr("Byte"),
+                               SAKDebuggerDeviceParameters::MaskModeByte);
+    mUi->modeComboBox->addItem(tr("Key"),
+                               SAKDebuggerDeviceParameters::MaskModeKey);
+    mUi->modeComboBox->addItem(tr("Rolling key"),
+                               SAKDebuggerDeviceParameters::MaskModeRollingKey);
+    mUi->modeComboBox->addItem(tr("Stream cipher"),
+                               SAKDebuggerDeviceParameters::MaskModeStream);
+    SAKCommonDataStructure::setLineEditTextFormat(mUi->rxKeyLineEdit,
+                                                  SAKCommonDataStructure::InputFormatHex);
+    SAKCommonDataStructure::setLineEditTextFormat(mUi->txKeyLineEdit,
+                                                  SAKCommonDataStructure::InputFormatHex);
 
+    auto ctx = mParameters->maskContext();
+    mUi->rxMaskCheckBox->setChecked(ctx.enableRx);
+    mUi->txMaskCheckBox->setChecked(ctx.enableTx);
+    mUi->rxMaskSpinBox->setValue(ctx.rx);
+    mUi->txMaskSpinBox->setValue(ctx.tx);
+    int index = mUi->modeComboBox->findData(ctx.mode);
+    mUi->modeComboBox->setCurrentIndex(index == -1 ? 0 : index);
+    auto toHexString = [](QByteArray bytes){
+        return SAKCommonDataStructure::byteArrayToString(
+                    bytes, SAKCommonDataStructure::OutputFormatHex);
+    };
+    mUi->rxKeyLineEdit->setText(toHexString(ctx.rxKey));
+    mUi->txKeyLineEdit->setText(toHexString(ctx.txKey));
 
-    if (settings) {
-        mSettingsKeyCtx.rxMask = settingGroup + "/" + "rxMask";
-        mSettingsKeyCtx.txMask = settingGroup + "/" + "txMask";
-
-        int rxMask = settings->value(mSettingsKeyCtx.rxMask).toInt();
-        mUi->rxMaskSpinBox->setValue(rxMask);
 #if QT_VERSION >= QT_VERSION_CHECK(5,7,0)
     connect(mUi->rxMaskSpinBox, QOverload<int>::of(&QSpinBox::valueChanged),
 #else
     connect(mUi->rxMaskSpinBox,
             static_cast<void(QSpinBox::*)(int)>(&QSpinBox::valueChanged),
 #endif
-        this, [=](){
-            settings->setValue(mSettingsKeyCtx.rxMask, mUi->rxMaskSpinBox->value());
-            emit parametersChanged();
-        });
-
-        int txMask = settings->value(mSettingsKeyCtx.txMask).toInt();
-        mUi->txMaskSpinBox->setValue(txMask);
+            this, &SAKDebuggerDeviceMask::updateParameters);
 #if QT_VERSION >= QT_VERSION_CHECK(5,7,0)
     connect(mUi->txMaskSpinBox, QOverload<int>::of(&QSpinBox::valueChanged),
 #else
     connect(mUi->txMaskSpinBox,
             static_cast<void(QSpinBox::*)(int)>(&QSpinBox::valueChanged),
 #endif
-         this, [=](){
-            settings->setValue(mSettingsKeyCtx.txMask, mUi->txMaskSpinBox->value());
-            emit parametersChanged();
-        });
-    }
-
-
+            this, &SAKDebuggerDeviceMask::updateParameters);
     connect(mUi->rxMaskCheckBox, &QCheckBox::clicked,
-            this, [=](){emit parametersChanged();});
+            this, &SAKDebuggerDeviceMask::updateParameters);
     connect(mUi->txMaskCheckBox, &QCheckBox::clicked,
-            this, [=](){emit parametersChanged();});
+            this, &SAKDebuggerDeviceMask::updateParameters);
+#if QT_VERSION >= QT_VERSION_CHECK(5,7,0)
+    connect(mUi->modeComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+#else
+    connect(mUi->modeComboBox,
+            static_cast<void(QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+#endif
+            this, &SAKDebuggerDeviceMask::updateParameters);
+    connect(mUi->rxKeyLineEdit, &QLineEdit::textChanged,
+            this, &SAKDebuggerDeviceMask::updateParameters);
+    connect(mUi->txKeyLineEdit, &QLineEdit::textChanged,
+            this, &SAKDebuggerDeviceMask::updateParameters);
     setModal(true);
 }
 
@@ -64,13 +83,15 @@ SAKDebuggerDeviceMask::~SAKDebuggerDeviceMask()
     delete mUi;
 }
 
-SAKDebuggerDeviceMask::SAKStructMaskContext SAKDebuggerDeviceMask::parametersContext()
+void SAKDebuggerDeviceMask::updateParameters()
 {
-    SAKStructMaskContext ctx;
+    SAKDebuggerDeviceParameters::SAKStructMaskContext ctx;
     ctx.enableRx = mUi->rxMaskCheckBox->isChecked();
     ctx.enableTx = mUi->txMaskCheckBox->isChecked();
-    ctx.rx = mUi->rxMaskSpinBox->value();
-    ctx.tx = mUi->txMaskSpinBox->value();
-
-    return ctx;
+    ctx.rx = quint8(mUi->rxMaskSpinBox->value());
+    ctx.tx = quint8(mUi->txMaskSpinBox->value());
+    ctx.mode = mUi->modeComboBox->currentData().toInt();
+    ctx.rxKey = QByteArray::fromHex(mUi->rxKeyLineEdit->text().toLatin1());
+    ctx.txKey = QByteArray::fromHex(mUi->txKeyLineEdit->text().toLatin1());
+    mParameters->setMaskContext(ctx);
 }
@@ -11,38 +11,25 @@
 #define SAKDEBUGGERDEVICEMASK_HH
 
 #include <QDialog>
-#include <QSettings>
 
 namespace Ui {
     class SAKDebuggerDeviceMask;
 }
 
+class SAKDebuggerDeviceParameters;
+/// @brief Mask parameters editor, it is created the first time it is opened.
 class SAKDebuggerDeviceMask : public QDialog
 {
     Q_OBJECT
 public:
-    SAKDebuggerDeviceMask(QSettings *settings,
-                           QString settingGroup,
-                           QWidget *parent = Q_NULLPTR);
+    SAKDebuggerDeviceMask(SAKDebuggerDeviceParameters *parameters,
+                          QWidget *parent = Q_NULLPTR);
     ~SAKDebuggerDeviceMask();
-
-    struct SAKStructMaskContext {
-        quint8 rx;
-        quint8 tx;
-        bool enableRx;
-        bool enableTx;
-    };
-
-    SAKStructMaskContext parametersContext();
-private:
-    struct QMDStructSettingsKeyContext {
-        QString rxMask;
-        QString txMask;
-    } mSettingsKeyCtx;
 private:
+    SAKDebuggerDeviceParameters *mParameters;
     Ui::SAKDebuggerDeviceMask *mUi;
-signals:
-    void parametersChanged();
+private:
+    void updateParameters();
 };
 
 #endif // SAKDEBUGGERDEVICEMASK_H
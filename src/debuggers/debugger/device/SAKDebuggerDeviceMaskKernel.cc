@@ -0,0 +1,139 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <cstring>
+#include <QVarLengthArray>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SAK_MASK_KERNEL_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SAK_MASK_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+#include "SAKDebuggerDeviceMaskKernel.hh"
+
+namespace {
+// data[i] ^= pattern[i], 16 bytes per step.
+inline void xor16(char *data, const char *pattern)
+{
+#if defined(SAK_MASK_KERNEL_SSE2)
+    __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data), _mm_xor_si128(d, p));
+#elif defined(SAK_MASK_KERNEL_NEON)
+    uint8x16_t d = vld1q_u8(reinterpret_cast<const uint8_t*>(data));
+    uint8x16_t p = vld1q_u8(reinterpret_cast<const uint8_t*>(pattern));
+    vst1q_u8(reinterpret_cast<uint8_t*>(data), veorq_u8(d, p));
+#else
+    for (int i = 0; i < 16; i += 8) {
+        quint64 d;
+        quint64 p;
+        memcpy(&d, data + i, 8);
+        memcpy(&p, pattern + i, 8);
+        d ^= p;
+        memcpy(data + i, &d, 8);
+    }
+#endif
+}
+}
+
+void SAKDebuggerDeviceMaskKernel::xorByte(char *data, qint64 length, quint8 mask)
+{
+    if (!mask) {
+        return;
+    }
+
+    char pattern[16];
+    memset(pattern, mask, sizeof(pattern));
+
+    qint64 i = 0;
+    for (; i + 16 <= length; i += 16) {
+        xor16(data + i, pattern);
+    }
+
+    for (; i < length; i++) {
+        data[i] = char(quint8(data[i]) ^ mask);
+    }
+}
+
+qint64 SAKDebuggerDeviceMaskKernel::xorKey(char *data,
+                                           qint64 length,
+                                           const QByteArray &key,
+                                           qint64 offset)
+{
+    const qint64 keyLength = key.length();
+    if (keyLength == 0) {
+        return offset;
+    }
+
+    if (keyLength == 1) {
+        xorByte(data, length, quint8(key.at(0)));
+        return 0;
+    }
+
+    offset %= keyLength;
+    // The pattern is the key repeated from offset, its period is a multiple of
+    // the key length and it is 16 bytes longer than the period, so that a
+    // 16 bytes block can be loaded from every position of the period.
+    const qint64 period = keyLength*((256 + keyLength - 1)/keyLength);
+    QVarLengthArray<char, 512> pattern(int(period + 16));
+    for (qint64 i = 0; i < period + 16; i++) {
+        pattern[int(i)] = key.at(int((offset + i) % keyLength));
+    }
+
+    qint64 i = 0;
+    qint64 position = 0;
+    for (; i + 16 <= length; i += 16) {
+        xor16(data + i, pattern.constData() + position);
+        position += 16;
+        if (position >= period) {
+            position -= period;
+        }
+    }
+
+    for (; i < length; i++) {
+        data[i] = char(data[i] ^ pattern[int(position)]);
+        position += 1;
+    }
+
+    return (offset + length) % keyLength;
+}
+
+quint32 SAKDebuggerDeviceMaskKernel::xorStream(char *data, qint64 length, quint32 state)
+{
+    if (state == 0) {
+        state = streamSeed(QByteArray());
+    }
+
+    qint64 i = 0;
+    while (i < length) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        for (int j = 0; (j < 4) && (i < length); j++, i++) {
+            data[i] = char(quint8(data[i]) ^ quint8(state >> (j*8)));
+        }
+    }
+
+    return state;
+}
+
+quint32 SAKDebuggerDeviceMaskKernel::streamSeed(const QByteArray &key)
+{
+    // FNV-1a
+    quint32 seed = 2166136261u;
+    for (int i = 0; i < key.length(); i++) {
+        seed ^= quint8(key.at(i));
+        seed *= 16777619u;
+    }
+
+    return seed ? seed : 2463534242u;
+}
@@ -0,0 +1,44 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#ifndef SAKDEBUGGERDEVICEMASKKERNEL_HH
+#define SAKDEBUGGERDEVICEMASKKERNEL_HH
+
+#include <QByteArray>
+
+/// @brief In-place xor kernels of the device mask, SSE2 or NEON is used if the
+/// target supports it.
+class SAKDebuggerDeviceMaskKernel
+{
+public:
+    /**
+     * @brief xorByte: data[i] ^= mask
+     */
+    static void xorByte(char *data, qint64 length, quint8 mask);
+
+    /**
+     * @brief xorKey: data[i] ^= key[(offset + i) % key.length()]
+     * @return The offset of next frame
+     */
+    static qint64 xorKey(char *data, qint64 length, const QByteArray &key, qint64 offset);
+
+    /**
+     * @brief xorStream: Xor data with a xorshift32 key stream.
+     * @param state: The state of the key stream, it must not be 0
+     * @return The state of next frame
+     */
+    static quint32 xorStream(char *data, qint64 length, quint32 state);
+
+    /**
+     * @brief streamSeed: Get the initial state of key stream from a key.
+     */
+    static quint32 streamSeed(const QByteArray &key);
+};
+
+#endif
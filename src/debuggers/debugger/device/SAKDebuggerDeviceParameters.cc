@@ -0,0 +1,193 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include "SAKDebuggerDeviceParameters.hh"
+
+SAKDebuggerDeviceParameters::SAKDebuggerDeviceParameters(QSettings *settings,
+                                                         const QString &settingsGroup,
+                                                         QObject *parent)
+    :QObject(parent)
+    ,mSettings(settings)
+{
+    mSettingsKeyCtx.rxMask = settingsGroup + "/" + "rxMask";
+    mSettingsKeyCtx.txMask = settingsGroup + "/" + "txMask";
+    mSettingsKeyCtx.maskMode = settingsGroup + "/" + "maskMode";
+    mSettingsKeyCtx.rxMaskKey = settingsGroup + "/" + "rxMaskKey";
+    mSettingsKeyCtx.txMaskKey = settingsGroup + "/" + "txMaskKey";
+
+    QString analyzerSettingsGroup = settingsGroup + "/analyzer/";
+    mSettingsKeyCtx.enable = analyzerSettingsGroup + "enable";
+    mSettingsKeyCtx.fixedLength = analyzerSettingsGroup + "fixedLength";
+    mSettingsKeyCtx.frameLength = analyzerSettingsGroup + "length";
+    mSettingsKeyCtx.startFlags = analyzerSettingsGroup + "startFlags";
+    mSettingsKeyCtx.endFlags = analyzerSettingsGroup + "endFlags";
+
+    QString socketOptionsSettingsGroup = settingsGroup + "/socketOptions/";
+    mSettingsKeyCtx.receiveBufferSize = socketOptionsSettingsGroup + "receiveBufferSize";
+    mSettingsKeyCtx.sendBufferSize = socketOptionsSettingsGroup + "sendBufferSize";
+    mSettingsKeyCtx.readBufferSize = socketOptionsSettingsGroup + "readBufferSize";
+    mSettingsKeyCtx.lowDelay = socketOptionsSettingsGroup + "lowDelay";
+    mSettingsKeyCtx.keepAlive = socketOptionsSettingsGroup + "keepAlive";
+    mSettingsKeyCtx.keepAliveIdle = socketOptionsSettingsGroup + "keepAliveIdle";
+    mSettingsKeyCtx.keepAliveInterval = socketOptionsSettingsGroup + "keepAliveInterval";
+    mSettingsKeyCtx.keepAliveCount = socketOptionsSettingsGroup + "keepAliveCount";
+    mSettingsKeyCtx.dscp = socketOptionsSettingsGroup + "dscp";
+
+    // The masks and the analyzer are disabled by default, the switches are not
+    // restored from the settings file.
+    mMaskCtx.enableRx = false;
+    mMaskCtx.enableTx = false;
+    mMaskCtx.rx = 0;
+    mMaskCtx.tx = 0;
+    mMaskCtx.mode = MaskModeByte;
+    mAnalyzerCtx.enable = false;
+    mAnalyzerCtx.fixedLength = false;
+    mAnalyzerCtx.length = 0;
+    mSocketOptionsCtx.receiveBufferSize = 0;
+    mSocketOptionsCtx.sendBufferSize = 0;
+    mSocketOptionsCtx.readBufferSize = 0;
+    mSocketOptionsCtx.lowDelay = false;
+    mSocketOptionsCtx.keepAlive = false;
+    mSocketOptionsCtx.keepAliveIdle = 0;
+    mSocketOptionsCtx.keepAliveInterval = 0;
+    mSocketOptionsCtx.keepAliveCount = 0;
+    mSocketOptionsCtx.dscp = 0;
+
+    if (mSettings) {
+        mMaskCtx.rx = quint8(mSettings->value(mSettingsKeyCtx.rxMask).toInt());
+        mMaskCtx.tx = quint8(mSettings->value(mSettingsKeyCtx.txMask).toInt());
+        mMaskCtx.mode = mSettings->value(mSettingsKeyCtx.maskMode, MaskModeByte).toInt();
+        QString rxKey = mSettings->value(mSettingsKeyCtx.rxMaskKey).toString();
+        mMaskCtx.rxKey = QByteArray::fromHex(rxKey.toLatin1());
+        QString txKey = mSettings->value(mSettingsKeyCtx.txMaskKey).toString();
+        mMaskCtx.txKey = QByteArray::fromHex(txKey.toLatin1());
+
+        mAnalyzerCtx.fixedLength = mSettings->value(mSettingsKeyCtx.fixedLength).toBool();
+        mAnalyzerCtx.length = mSettings->value(mSettingsKeyCtx.frameLength).toInt();
+        // The flags are saved as hex string, such as "aa bb ".
+        QString startFlags = mSettings->value(mSettingsKeyCtx.startFlags).toString();
+        mAnalyzerCtx.startFlags = QByteArray::fromHex(startFlags.toLatin1());
+        QString endFlags = mSettings->value(mSettingsKeyCtx.endFlags).toString();
+        mAnalyzerCtx.endFlags = QByteArray::fromHex(endFlags.toLatin1());
+
+        auto &options = mSocketOptionsCtx;
+        options.receiveBufferSize = mSettings->value(mSettingsKeyCtx.receiveBufferSize).toInt();
+        options.sendBufferSize = mSettings->value(mSettingsKeyCtx.sendBufferSize).toInt();
+        options.readBufferSize = mSettings->value(mSettingsKeyCtx.readBufferSize).toInt();
+        options.lowDelay = mSettings->value(mSettingsKeyCtx.lowDelay).toBool();
+        options.keepAlive = mSettings->value(mSettingsKeyCtx.keepAlive).toBool();
+        options.keepAliveIdle = mSettings->value(mSettingsKeyCtx.keepAliveIdle).toInt();
+        options.keepAliveInterval = mSettings->value(mSettingsKeyCtx.keepAliveInterval).toInt();
+        options.keepAliveCount = mSettings->value(mSettingsKeyCtx.keepAliveCount).toInt();
+        options.dscp = mSettings->value(mSettingsKeyCtx.dscp).toInt();
+    }
+}
+
+SAKDebuggerDeviceParameters::SAKStructMaskContext
+SAKDebuggerDeviceParameters::maskContext()
+{
+    mContextMutex.lock();
+    auto ctx = mMaskCtx;
+    mContextMutex.unlock();
+    return ctx;
+}
+
+void SAKDebuggerDeviceParameters::setMaskContext(const SAKStructMaskContext &ctx)
+{
+    mContextMutex.lock();
+    mMaskCtx = ctx;
+    mContextMutex.unlock();
+
+    if (mSettings) {
+        mSettings->setValue(mSettingsKeyCtx.rxMask, ctx.rx);
+        mSettings->setValue(mSettingsKeyCtx.txMask, ctx.tx);
+        mSettings->setValue(mSettingsKeyCtx.maskMode, ctx.mode);
+        mSettings->setValue(mSettingsKeyCtx.rxMaskKey, QString(ctx.rxKey.toHex(' ')));
+        mSettings->setValue(mSettingsKeyCtx.txMaskKey, QString(ctx.txKey.toHex(' ')));
+    }
+
+    emit maskContextChanged();
+}
+
+SAKDebuggerDeviceParameters::SAKStructAnalyzerContext
+SAKDebuggerDeviceParameters::analyzerContext()
+{
+    mContextMutex.lock();
+    auto ctx = mAnalyzerCtx;
+    mContextMutex.unlock();
+    return ctx;
+}
+
+void SAKDebuggerDeviceParameters::setAnalyzerContext(const SAKStructAnalyzerContext &ctx)
+{
+    mContextMutex.lock();
+    mAnalyzerCtx = ctx;
+    mContextMutex.unlock();
+
+    if (mSettings) {
+        mSettings->setValue(mSettingsKeyCtx.enable, ctx.enable);
+        mSettings->setValue(mSettingsKeyCtx.fixedLength, ctx.fixedLength);
+        mSettings->setValue(mSettingsKeyCtx.frameLength, ctx.length);
+        mSettings->setValue(mSettingsKeyCtx.startFlags,
+                            QString(ctx.startFlags.toHex(' ')));
+        mSettings->setValue(mSettingsKeyCtx.endFlags,
+                            QString(ctx.endFlags.toHex(' ')));
+    }
+
+    emit analyzerContextChanged();
+}
+
+SAKDebuggerDeviceParameters::SAKStructSocketOptionsContext
+SAKDebuggerDeviceParameters::socketOptionsContext()
+{
+    mContextMutex.lock();
+    auto ctx = mSocketOptionsCtx;
+    mContextMutex.unlock();
+    return ctx;
+}
+
+void SAKDebuggerDeviceParameters::setSocketOptionsContext(
+        const SAKStructSocketOptionsContext &ctx)
+{
+    mContextMutex.lock();
+    mSocketOptionsCtx = ctx;
+    mContextMutex.unlock();
+
+    if (mSettings) {
+        mSettings->setValue(mSettingsKeyCtx.receiveBufferSize, ctx.receiveBufferSize);
+        mSettings->setValue(mSettingsKeyCtx.sendBufferSize, ctx.sendBufferSize);
+        mSettings->setValue(mSettingsKeyCtx.readBufferSize, ctx.readBufferSize);
+        mSettings->setValue(mSettingsKeyCtx.lowDelay, ctx.lowDelay);
+        mSettings->setValue(mSettingsKeyCtx.keepAlive, ctx.keepAlive);
+        mSettings->setValue(mSettingsKeyCtx.keepAliveIdle, ctx.keepAliveIdle);
+        mSettings->setValue(mSettingsKeyCtx.keepAliveInterval, ctx.keepAliveInterval);
+        mSettings->setValue(mSettingsKeyCtx.keepAliveCount, ctx.keepAliveCount);
+        mSettings->setValue(mSettingsKeyCtx.dscp, ctx.dscp);
+    }
+
+    emit socketOptionsContextChanged();
+}
+
+QString SAKDebuggerDeviceParameters::socketOptionsDiagnostics()
+{
+    mContextMutex.lock();
+    QString diagnostics = mSocketOptionsDiagnostics;
+    mContextMutex.unlock();
+    return diagnostics;
+}
+
+void SAKDebuggerDeviceParameters::setSocketOptionsDiagnostics(
+        const QString &diagnostics)
+{
+    mContextMutex.lock();
+    mSocketOptionsDiagnostics = diagnostics;
+    mContextMutex.unlock();
+
+    emit socketOptionsDiagnosticsChanged(diagnostics);
+}
@@ -0,0 +1,123 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#ifndef SAKDEBUGGERDEVICEPARAMETERS_HH
+#define SAKDEBUGGERDEVICEPARAMETERS_HH
+
+#include <QMutex>
+#include <QObject>
+#include <QSettings>
+
+/// @brief The mask, analyzer and socket options parameters of a device. The
+/// class has no ui, SAKDebuggerDeviceMask, SAKDebuggerDeviceAnalyzer and
+/// SAKDebuggerDeviceSocketOptions are editors of it. It
+/// is thread-safe, the device thread reads the parameters, the ui thread
+/// writes them.
+class SAKDebuggerDeviceParameters : public QObject
+{
+    Q_OBJECT
+public:
+    SAKDebuggerDeviceParameters(QSettings *settings,
+                                const QString &settingsGroup,
+                                QObject *parent = Q_NULLPTR);
+
+    enum SAKEnumMaskMode {
+        MaskModeByte,       // Xor every byte with rx or tx
+        MaskModeKey,        // Xor with a multi-byte key, restart from key[0] every frame
+        MaskModeRollingKey, // Xor with a multi-byte key, continue from the last frame
+        MaskModeStream      // Xor with a xorshift32 key stream seeded by the key
+    };
+    Q_ENUM(SAKEnumMaskMode);
+
+    struct SAKStructMaskContext {
+        quint8 rx;
+        quint8 tx;
+        bool enableRx;
+        bool enableTx;
+        int mode;
+        QByteArray rxKey;
+        QByteArray txKey;
+    };
+
+    struct SAKStructAnalyzerContext {
+        bool enable;
+        bool fixedLength;
+        int length;
+        QByteArray startFlags;
+        QByteArray endFlags;
+    };
+
+    // Socket options of network devices, they are applied when the device is
+    // opened, 0 or false means the system default is used.
+    struct SAKStructSocketOptionsContext {
+        int receiveBufferSize;  // SO_RCVBUF, unit is byte
+        int sendBufferSize;     // SO_SNDBUF, unit is byte
+        int readBufferSize;     // Read buffer of QAbstractSocket, unit is byte
+        bool lowDelay;          // TCP_NODELAY
+        bool keepAlive;         // SO_KEEPALIVE
+        int keepAliveIdle;      // TCP_KEEPIDLE, unit is second
+        int keepAliveInterval;  // TCP_KEEPINTVL, unit is second
+        int keepAliveCount;     // TCP_KEEPCNT
+        int dscp;               // 0-63, the type of service is (dscp << 2)
+    };
+
+    SAKStructMaskContext maskContext();
+    void setMaskContext(const SAKStructMaskContext &ctx);
+    SAKStructAnalyzerContext analyzerContext();
+    void setAnalyzerContext(const SAKStructAnalyzerContext &ctx);
+    SAKStructSocketOptionsContext socketOptionsContext();
+    void setSocketOptionsContext(const SAKStructSocketOptionsContext &ctx);
+
+    /**
+     * @brief socketOptionsDiagnostics: The effective values of the socket
+     * options, they are read back from the socket after applying, the system
+     * may adjust the requested values.
+     */
+    QString socketOptionsDiagnostics();
+    void setSocketOptionsDiagnostics(const QString &diagnostics);
+private:
+    struct SAKStructSettingsKeyContext {
+        QString rxMask;
+        QString txMask;
+        QString maskMode;
+        QString rxMaskKey;
+        QString txMaskKey;
+
+        QString enable;
+        QString fixedLength;
+        QString frameLength;
+        QString startFlags;
+        QString endFlags;
+
+        QString receiveBufferSize;
+        QString sendBufferSize;
+        QString readBufferSize;
+        QString lowDelay;
+        QString keepAlive;
+        QString keepAliveIdle;
+        QString keepAliveInterval;
+        QString keepAliveCount;
+        QString dscp;
+    } mSettingsKeyCtx;
+
+    QSettings *mSettings;
+    QMutex mContextMutex;
+    SAKStructMaskContext mMaskCtx;
+    SAKStructAnalyzerContext mAnalyzerCtx;
+    SAKStructSocketOptionsContext mSocketOptionsCtx;
+    QString mSocketOptionsDiagnostics;
+signals:
+    void maskContextChanged();
+    void analyzerContextChanged();
+    void socketOptionsContextChanged();
+    void socketOptionsDiagnosticsChanged(QString diagnostics);
+    void clearAnalyzerTemp();
+};
+
+#endif
@@ -0,0 +1,89 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QDebug>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QPlainTextEdit>
+
+#include "SAKDebuggerDeviceParameters.hh"
+#include "SAKDebuggerDeviceSocketOptions.hh"
+
+#include "ui_SAKDebuggerDeviceSocketOptions.h"
+
+SAKDebuggerDeviceSocketOptions::SAKDebuggerDeviceSocketOptions(
+        SAKDebuggerDeviceParameters *parameters,
+        QWidget *parent)
+    :QDialog(parent)
+    ,mParameters(parameters)
+    ,mUi(new Ui::SAKDebuggerDeviceSocketOptions)
+{
+    mUi->setupUi(this);
+
+    auto ctx = mParameters->socketOptionsContext();
+    mUi->receiveBufferSizeSpinBox->setValue(ctx.receiveBufferSize);
+    mUi->sendBufferSizeSpinBox->setValue(ctx.sendBufferSize);
+    mUi->readBufferSizeSpinBox->setValue(ctx.readBufferSize);
+    mUi->dscpSpinBox->setValue(ctx.dscp);
+    mUi->lowDelayCheckBox->setChecked(ctx.lowDelay);
+    mUi->keepAliveCheckBox->setChecked(ctx.keepAlive);
+    mUi->keepAliveIdleSpinBox->setValue(ctx.keepAliveIdle);
+    mUi->keepAliveIntervalSpinBox->setValue(ctx.keepAliveInterval);
+    mUi->keepAliveCountSpinBox->setValue(ctx.keepAliveCount);
+    updateDiagnostics(mParameters->socketOptionsDiagnostics());
+
+    QList<QSpinBox*> spinBoxes;
+    spinBoxes << mUi->receiveBufferSizeSpinBox
+              << mUi->sendBufferSizeSpinBox
+              << mUi->readBufferSizeSpinBox
+              << mUi->dscpSpinBox
+              << mUi->keepAliveIdleSpinBox
+              << mUi->keepAliveIntervalSpinBox
+              << mUi->keepAliveCountSpinBox;
+    for (auto &var : spinBoxes) {
+        connect(var, static_cast<void(QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+                this, &SAKDebuggerDeviceSocketOptions::updateParameters);
+    }
+    connect(mUi->lowDelayCheckBox, &QCheckBox::clicked,
+            this, &SAKDebuggerDeviceSocketOptions::updateParameters);
+    connect(mUi->keepAliveCheckBox, &QCheckBox::clicked,
+            this, &SAKDebuggerDeviceSocketOptions::updateParameters);
+    connect(mParameters, &SAKDebuggerDeviceParameters::socketOptionsDiagnosticsChanged,
+            this, &SAKDebuggerDeviceSocketOptions::updateDiagnostics);
+    setModal(true);
+}
+
+SAKDebuggerDeviceSocketOptions::~SAKDebuggerDeviceSocketOptions()
+{
+    delete mUi;
+}
+
+void SAKDebuggerDeviceSocketOptions::updateParameters()
+{
+    SAKDebuggerDeviceParameters::SAKStructSocketOptionsContext ctx;
+    ctx.receiveBufferSize = mUi->receiveBufferSizeSpinBox->value();
+    ctx.sendBufferSize = mUi->sendBufferSizeSpinBox->value();
+    ctx.readBufferSize = mUi->readBufferSizeSpinBox->value();
+    ctx.dscp = mUi->dscpSpinBox->value();
+    ctx.lowDelay = mUi->lowDelayCheckBox->isChecked();
+    ctx.keepAlive = mUi->keepAliveCheckBox->isChecked();
+    ctx.keepAliveIdle = mUi->keepAliveIdleSpinBox->value();
+    ctx.keepAliveInterval = mUi->keepAliveIntervalSpinBox->value();
+    ctx.keepAliveCount = mUi->keepAliveCountSpinBox->value();
+    mParameters->setSocketOptionsContext(ctx);
+}
+
+void SAKDebuggerDeviceSocketOptions::updateDiagnostics(QString diagnostics)
+{
+    if (diagnostics.isEmpty()) {
+        mUi->diagnosticsPlainTextEdit->setPlainText(tr("The device is not opened."));
+    } else {
+        mUi->diagnosticsPlainTextEdit->setPlainText(diagnostics);
+    }
+}
@@ -0,0 +1,38 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#ifndef SAKDEBUGGERDEVICESOCKETOPTIONS_HH
+#define SAKDEBUGGERDEVICESOCKETOPTIONS_HH
+
+#include <QDialog>
+
+namespace Ui {
+    class SAKDebuggerDeviceSocketOptions;
+}
+
+class SAKDebuggerDeviceParameters;
+/// @brief Socket options editing widget of network devices, it is created the
+/// first time it is opened. The effective values reported by the device are
+/// shown too.
+class SAKDebuggerDeviceSocketOptions:public QDialog
+{
+    Q_OBJECT
+public:
+    SAKDebuggerDeviceSocketOptions(SAKDebuggerDeviceParameters *parameters,
+                                   QWidget *parent = Q_NULLPTR);
+    ~SAKDebuggerDeviceSocketOptions();
+private:
+    SAKDebuggerDeviceParameters *mParameters;
+    Ui::SAKDebuggerDeviceSocketOptions *mUi;
+private:
+    void updateParameters();
+    void updateDiagnostics(QString diagnostics);
+};
+
+#endif
@@ -0,0 +1,187 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QObject>
+#include <QStringList>
+
+#ifdef Q_OS_WIN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+
+#include "SAKDebuggerDeviceSocketOptionsKernel.hh"
+
+// The idle time before the first probe is named TCP_KEEPALIVE on macOS.
+#if defined(TCP_KEEPIDLE)
+#define SAK_TCP_KEEPIDLE TCP_KEEPIDLE
+#elif defined(TCP_KEEPALIVE)
+#define SAK_TCP_KEEPIDLE TCP_KEEPALIVE
+#endif
+
+QString SAKDebuggerDeviceSocketOptionsKernel::apply(
+        QAbstractSocket *socket,
+        const SAKDebuggerDeviceParameters::SAKStructSocketOptionsContext &ctx)
+{
+    if (ctx.receiveBufferSize > 0) {
+        socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption,
+                                ctx.receiveBufferSize);
+    }
+
+    if (ctx.sendBufferSize > 0) {
+        socket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption,
+                                ctx.sendBufferSize);
+    }
+
+    if (ctx.dscp > 0) {
+        // The lowest two bits are used by ECN.
+        socket->setSocketOption(QAbstractSocket::TypeOfServiceOption,
+                                (ctx.dscp & 0x3f) << 2);
+    }
+
+    if (socket->socketType() == QAbstractSocket::TcpSocket) {
+        // QUdpSocket does not use the read buffer.
+        socket->setReadBufferSize(ctx.readBufferSize);
+        if (ctx.lowDelay) {
+            socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        }
+
+        if (ctx.keepAlive) {
+            socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+            qintptr descriptor = socket->socketDescriptor();
+#ifdef SAK_TCP_KEEPIDLE
+            if (ctx.keepAliveIdle > 0) {
+                setNativeOption(descriptor, IPPROTO_TCP,
+                                SAK_TCP_KEEPIDLE, ctx.keepAliveIdle);
+            }
+#endif
+#ifdef TCP_KEEPINTVL
+            if (ctx.keepAliveInterval > 0) {
+                setNativeOption(descriptor, IPPROTO_TCP,
+                                TCP_KEEPINTVL, ctx.keepAliveInterval);
+            }
+#endif
+#ifdef TCP_KEEPCNT
+            if (ctx.keepAliveCount > 0) {
+                setNativeOption(descriptor, IPPROTO_TCP,
+                                TCP_KEEPCNT, ctx.keepAliveCount);
+            }
+#endif
+            Q_UNUSED(descriptor);
+        }
+    }
+
+    return effectiveValues(socket);
+}
+
+bool SAKDebuggerDeviceSocketOptionsKernel::applyToListener(
+        qintptr descriptor,
+        const SAKDebuggerDeviceParameters::SAKStructSocketOptionsContext &ctx)
+{
+    bool ret = true;
+    if (ctx.receiveBufferSize > 0) {
+        ret &= setNativeOption(descriptor, SOL_SOCKET, SO_RCVBUF, ctx.receiveBufferSize);
+    }
+
+    if (ctx.sendBufferSize > 0) {
+        ret &= setNativeOption(descriptor, SOL_SOCKET, SO_SNDBUF, ctx.sendBufferSize);
+    }
+
+    return ret;
+}
+
+QString SAKDebuggerDeviceSocketOptionsKernel::effectiveValues(QAbstractSocket *socket)
+{
+    auto option = [=](QAbstractSocket::SocketOption key){
+        return socket->socketOption(key).toInt();
+    };
+    auto optional = [](int value){
+        return value < 0 ? QObject::tr("Unsupported") : QString::number(value);
+    };
+
+    QStringList values;
+    values << QObject::tr("Receive buffer size: %1")
+              .arg(option(QAbstractSocket::ReceiveBufferSizeSocketOption));
+    values << QObject::tr("Send buffer size: %1")
+              .arg(option(QAbstractSocket::SendBufferSizeSocketOption));
+    int tos = option(QAbstractSocket::TypeOfServiceOption);
+    values << QObject::tr("DSCP: %1 (type of service: 0x%2)")
+              .arg(tos >> 2).arg(tos, 2, 16, QChar('0'));
+
+    if (socket->socketType() == QAbstractSocket::TcpSocket) {
+        qintptr descriptor = socket->socketDescriptor();
+        values << QObject::tr("Read buffer size: %1")
+                  .arg(socket->readBufferSize());
+        values << QObject::tr("Low delay: %1")
+                  .arg(option(QAbstractSocket::LowDelayOption));
+        values << QObject::tr("Keep alive: %1")
+                  .arg(option(QAbstractSocket::KeepAliveOption));
+        int idle = -1;
+        int interval = -1;
+        int count = -1;
+#ifdef SAK_TCP_KEEPIDLE
+        idle = nativeOption(descriptor, IPPROTO_TCP, SAK_TCP_KEEPIDLE);
+#endif
+#ifdef TCP_KEEPINTVL
+        interval = nativeOption(descriptor, IPPROTO_TCP, TCP_KEEPINTVL);
+#endif
+#ifdef TCP_KEEPCNT
+        count = nativeOption(descriptor, IPPROTO_TCP, TCP_KEEPCNT);
+#endif
+        values << QObject::tr("Keep alive idle: %1").arg(optional(idle));
+        values << QObject::tr("Keep alive interval: %1").arg(optional(interval));
+        values << QObject::tr("Keep alive count: %1").arg(optional(count));
+        Q_UNUSED(descriptor);
+    }
+
+    return values.join(QChar('\n'));
+}
+
+bool SAKDebuggerDeviceSocketOptionsKernel::setNativeOption(qintptr descriptor,
+                                                           int level,
+                                                           int option,
+                                                           int value)
+{
+    if (descriptor == -1) {
+        return false;
+    }
+
+#ifdef Q_OS_WIN
+    int ret = ::setsockopt(SOCKET(descriptor), level, option,
+                           reinterpret_cast<const char*>(&value), sizeof(value));
+#else
+    int ret = ::setsockopt(int(descriptor), level, option,
+                           &value, socklen_t(sizeof(value)));
+#endif
+    return ret == 0;
+}
+
+int SAKDebuggerDeviceSocketOptionsKernel::nativeOption(qintptr descriptor,
+                                                       int level,
+                                                       int option)
+{
+    if (descriptor == -1) {
+        return -1;
+    }
+
+    int value = 0;
+#ifdef Q_OS_WIN
+    int length = sizeof(value);
+    int ret = ::getsockopt(SOCKET(descriptor), level, option,
+                           reinterpret_cast<char*>(&value), &length);
+#else
+    socklen_t length = socklen_t(sizeof(value));
+    int ret = ::getsockopt(int(descriptor), level, option, &value, &length);
+#endif
+    return ret == 0 ? value : -1;
+}
@@ -0,0 +1,57 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#ifndef SAKDEBUGGERDEVICESOCKETOPTIONSKERNEL_HH
+#define SAKDEBUGGERDEVICESOCKETOPTIONSKERNEL_HH
+
+#include <QString>
+#include <QAbstractSocket>
+
+#include "SAKDebuggerDeviceParameters.hh"
+
+/// @brief Apply socket options to a socket and read back the effective values.
+/// The keepalive timings are set with setsockopt() because QAbstractSocket does
+/// not support them, they are ignored if the platform does not support them.
+class SAKDebuggerDeviceSocketOptionsKernel
+{
+public:
+    /**
+     * @brief apply: Apply the options to the socket, the socket must have been
+     * bound or connected. The options of tcp only are ignored by udp sockets.
+     * @param socket: Target socket.
+     * @param ctx: Options, 0 or false means the system default is used.
+     * @return The effective values, see effectiveValues().
+     */
+    static QString apply(QAbstractSocket *socket,
+                         const SAKDebuggerDeviceParameters::SAKStructSocketOptionsContext &ctx);
+
+    /**
+     * @brief applyToListener: Apply the buffer sizes to a listening socket, the
+     * sockets accepted by it inherit the sizes. The tcp window scale is
+     * negotiated while connecting, so the receive buffer size of an accepted
+     * socket must be set here.
+     * @param descriptor: Native descriptor of the listening socket.
+     * @param ctx: Options, the buffer sizes are used only.
+     * @return false: Can not set an option.
+     */
+    static bool applyToListener(qintptr descriptor,
+                                const SAKDebuggerDeviceParameters::SAKStructSocketOptionsContext &ctx);
+
+    /**
+     * @brief effectiveValues: Read back the options from the socket.
+     * @param socket: Target socket.
+     * @return Human readable values, one option per line.
+     */
+    static QString effectiveValues(QAbstractSocket *socket);
+private:
+    static bool setNativeOption(qintptr descriptor, int level, int option, int value);
+    static int nativeOption(qintptr descriptor, int level, int option);
+};
+
+#endif
@@ -11,7 +11,6 @@
 #include <QFile>
 #include <QDebug>
 #include <QAction>
-#include <QtEndian>
 #include <QLineEdit>
 #include <QMessageBox>
 #include <QFileDialog>
@@ -23,9 +22,10 @@
 #include "SAKDebuggerInput.hh"
 #include "SAKCommonCrcInterface.hh"
 #include "SAKCommonDataStructure.hh"
-#include "SAKCommonDataStructure.hh"
+#include "SAKDebuggerInputEncoder.hh"
 #include "SAKDebuggerInputDataPreset.hh"
 #include "SAKDebuggerInputCrcSettings.hh"
+#include "SAKDebuggerInputCyclicSending.hh"
 
 SAKDebuggerInput::SAKDebuggerInput(QComboBox *regularlySending,
                                    QComboBox *inputFormat,
@@ -50,10 +50,20 @@ SAKDebuggerInput::SAKDebuggerInput(QComboBox *regularlySending,
     ,mSettings(settings)
     ,mSettingsGroup(settingsGroup)
     ,mSqlDatabase(sqlDatabase)
-    ,mRregularSendingTimer(new QTimer)
+    ,mCyclicSendingActive(false)
     ,mSuffixsActionGroup(Q_NULLPTR)
-    ,mCrcInterface(new SAKCommonCrcInterface)
+    ,mInputEncoder(new SAKDebuggerInputEncoder)
+    ,mThreadEncoder(new SAKDebuggerInputEncoder)
 {
+    mInputParameters.crc.appending = false;
+    mInputParameters.crc.bigEndian = false;
+    mInputParameters.crc.parametersModel = SAKCommonCrcInterface::CRC_8;
+    mInputParameters.crc.startByte = 1;
+    mInputParameters.crc.endByte = 1;
+    mInputParameters.textFormat = SAKCommonDataStructure::InputFormatHex;
+    mInputParameters.suffixType = SAKCommonDataStructure::SuffixsTypeNone;
+
+
     // Initialize setting key.
     mSettingKeyCtx.suffixsType = settingsGroup + "/suffixsType";
     mSettingKeyCtx.inputTextFormat = settingsGroup + "/inputTextFormat";
@@ -82,12 +92,11 @@ SAKDebuggerInput::~SAKDebuggerInput()
         exit();
         wait();
     }
-    mCrcInterface->deleteLater();
+    delete mInputEncoder;
+    delete mThreadEncoder;
     mDataPreset->deleteLater();
     mCrcSettings->deleteLater();
-
-    mRregularSendingTimer->stop();
-    mRregularSendingTimer->deleteLater();
+    mCyclicSending->deleteLater();
 
     mDataPresetDialog->close();
     mDataPresetDialog->deleteLater();
@@ -110,16 +119,37 @@ void SAKDebuggerInput::inputBytes(QString rawBytes,
 
 void SAKDebuggerInput::updateUiState(bool deviceIsOpened)
 {
+    if (!deviceIsOpened) {
+        // A custom period may be edited while "Forbidden" is the current item,
+        // so the edit text is reset too, and the sending is stopped explicitly.
+        resetRegularSendingComboBox();
+        mCyclicSendingActive = false;
+        emit invokeStopCyclicSending();
+    }
+
     mRegularSendingComboBox->setEnabled(deviceIsOpened);
     mSendPushButton->setEnabled(deviceIsOpened);
     mQuickSendingMenu->setEnabled(deviceIsOpened);
+}
 
-    if (!deviceIsOpened) {
-        mRregularSendingTimer->stop();
-        mRegularSendingComboBox->setCurrentIndex(0);
+void SAKDebuggerInput::onCyclicSendingStateChanged(bool running)
+{
+    // The sending is finished by count or duration limit.
+    if ((!running) && mCyclicSendingActive) {
+        mCyclicSendingActive = false;
+        resetRegularSendingComboBox();
     }
 }
 
+void SAKDebuggerInput::onCyclicSendingRateChanged(double requested, double achieved)
+{
+    mCyclicSending->setRate(requested, achieved);
+    mRegularSendingComboBox->setToolTip(
+                tr("Requested: %1 frames/s, achieved: %2 frames/s")
+                .arg(requested, 0, 'f', 1)
+                .arg(achieved, 0, 'f', 1));
+}
+
 void SAKDebuggerInput::run()
 {
     auto takeBytesInfo =
@@ -139,75 +169,24 @@ void SAKDebuggerInput::run()
         return;
     }
 
-    SAKStructInputParametersContext ctx = pair.second;
-    auto textFormat =
-            static_cast<SAKCommonDataStructure::SAKEnumTextFormatInput>(ctx.textFormat);
-    QByteArray cookedData =
-            SAKCommonDataStructure::stringToByteArray(rawData, textFormat);
-
-
-    if (ctx.suffixType != SAKCommonDataStructure::SuffixsTypeNone) {
-        auto cookedSuffixType =
-                static_cast<SAKCommonDataStructure::SAKEmnuSuffixsType>(ctx.suffixType);
-        QString suffix = SAKCommonDataStructure::suffix(cookedSuffixType);
-        cookedData.append(suffix.toLatin1());
-    }
-
-
-    if (ctx.crc.appending){
-        QByteArray crcInputData = extractCrcData(cookedData, ctx);
-        // Calculate the crc value of input data
-        uint32_t crc  = crcCalculate(crcInputData, ctx.crc.parametersModel);
-        uint8_t crc8  = static_cast<uint8_t>(crc);
-        uint16_t crc16 = static_cast<uint16_t>(crc);
-        int model = ctx.crc.parametersModel;
-        auto cookedModel = static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(model);
-        int bitsWidth = mCrcInterface->bitsWidth(cookedModel);
-        if (ctx.crc.bigEndian){
-            crc16 = qToBigEndian(crc16);
-            crc = qToBigEndian(crc);
-        }
-
-        // Append crc byte to data
-        switch (bitsWidth) {
-        case 8: cookedData.append(reinterpret_cast<char*>(&crc8), 1); break;
-        case 16: cookedData.append(reinterpret_cast<char*>(&crc16), 2); break;
-        case 32: cookedData.append(reinterpret_cast<char*>(&crc), 4); break;
-        default: break;
-        }
-    }
-
+    // The text of data preset is compiled in the input thread.
+    QByteArray cookedData = mThreadEncoder->encode(rawData, pair.second);
     emit invokeWriteBytes(cookedData);
 }
 
 void SAKDebuggerInput::writeBytes()
 {
-    auto inputParametersTemp = mInputParameters;
-    QString rawData = mInputComboBox->currentText();
-    if (rawData.isEmpty()) {
-        inputParametersTemp.textFormat = SAKCommonDataStructure::InputFormatAscii;
-        rawData = QString("(empty)");
+    QByteArray cookedData = inputFrame();
+    if (!cookedData.isEmpty()) {
+        emit invokeWriteBytes(cookedData);
     }
-    inputBytes(rawData, inputParametersTemp);
 }
 
 void SAKDebuggerInput::updateCrc()
 {
     QString rawData = mInputComboBox->currentText();
-    int format = mInputParameters.textFormat;
-    auto parametersTemp = mInputParameters;
-    auto cookedFormat = static_cast<SAKCommonDataStructure::SAKEnumTextFormatInput>(
-                format
-                );
-    QByteArray cookedData =
-            SAKCommonDataStructure::stringToByteArray(rawData, cookedFormat);
-    QByteArray crcInputData = extractCrcData(cookedData, parametersTemp);
-    quint32 crc = crcCalculate(crcInputData, parametersTemp.crc.parametersModel);
-    int bits =  mCrcInterface->bitsWidth(
-                static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(
-                    mInputParameters.crc.parametersModel
-                    )
-                );
+    quint32 crc = mInputEncoder->crc(rawData, mInputParameters);
+    int bits = mInputEncoder->crcBitsWidth(mInputParameters.crc.parametersModel);
     int fillWidth = bits/8*2;
     QString crcString = QString::number(crc, 16);
     crcString = QString("%1").arg(crcString, fillWidth, '0');
@@ -216,50 +195,77 @@ void SAKDebuggerInput::updateCrc()
     mCrcLabel->setText(crcString);
 }
 
-quint32 SAKDebuggerInput::crcCalculate(QByteArray data, int model)
-{
-    auto cookedModel = static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(model);
-    int bitsWidth = mCrcInterface->bitsWidth(cookedModel);
-    switch (bitsWidth) {
-    case 8:
-        return mCrcInterface->crcCalculate<uint8_t>(
-                    reinterpret_cast<uint8_t*>(data.data()),
-                    static_cast<quint64>(data.length()),
-                    static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(model));
-    case 16:
-        return mCrcInterface->crcCalculate<uint16_t>(
-                    reinterpret_cast<uint8_t*>(data.data()),
-                    static_cast<quint64>(data.length()),
-                    static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(model));
-    case 32:
-        return mCrcInterface->crcCalculate<uint32_t>(
-                    reinterpret_cast<uint8_t*>(data.data()),
-                    static_cast<quint64>(data.length()),
-                    static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(model));
-    default:
-        return 0;
+void SAKDebuggerInput::updateFrame()
+{
+    updateCrc();
+    if (mCyclicSendingActive) {
+        // Only the frame is replaced, the sending is not restarted.
+        updateCyclicSending();
+    }
+}
+
+QByteArray SAKDebuggerInput::inputFrame()
+{
+    auto inputParametersTemp = mInputParameters;
+    QString rawData = mInputComboBox->currentText();
+    if (rawData.isEmpty()) {
+        inputParametersTemp.textFormat = SAKCommonDataStructure::InputFormatAscii;
+        rawData = QString("(empty)");
     }
+
+    // The frame has been compiled when the text was edited, there is no
+    // parsing and crc calculating for repeated sending.
+    return mInputEncoder->encode(rawData, inputParametersTemp);
 }
 
-QByteArray SAKDebuggerInput::extractCrcData(QByteArray crcData,
-                          SAKStructInputParametersContext parameters)
+qint64 SAKDebuggerInput::cyclicSendingPeriod()
 {
-    QByteArray crcInputData;
-    int startIndex = parameters.crc.startByte - 1;
-    startIndex = startIndex < 0 ? 0 : startIndex;
+    QString text = mRegularSendingComboBox->currentText();
+    int index = mRegularSendingComboBox->findText(text);
+    if (index != -1) {
+        return mRegularSendingComboBox->itemData(index).toLongLong();
+    }
 
-    int endIndex = (crcData.length() - 1) - (parameters.crc.endByte - 1);
-    endIndex = endIndex < 0 ? 0 : endIndex;
+    // Custom period, such as "0.25 ms" or "0.25", the unit is millisecond.
+    text.remove(tr("ms"));
+    bool ok = false;
+    double period = text.trimmed().toDouble(&ok);
+    if (ok && (period > 0)) {
+        // The minimum period is 10 us.
+        return qMax<qint64>(10, qint64(period*1000));
+    }
 
-    if (((crcData.length() - 1) >= startIndex)
-            && ((crcData.length() - 1) >= endIndex)){
-        int length = endIndex - startIndex + 1;
-        length = length < 0 ? 0 : length;
-        crcInputData = QByteArray(crcData.constData()+startIndex, length);
-    }else{
-        crcInputData = crcData;
+    return 0;
+}
+
+void SAKDebuggerInput::resetRegularSendingComboBox()
+{
+    mRegularSendingComboBox->blockSignals(true);
+    mRegularSendingComboBox->setCurrentIndex(0);
+    mRegularSendingComboBox->setEditText(mRegularSendingComboBox->itemText(0));
+    mRegularSendingComboBox->blockSignals(false);
+}
+
+void SAKDebuggerInput::updateCyclicSending()
+{
+    qint64 period = cyclicSendingPeriod();
+    if (period <= 0) {
+        if (mCyclicSendingActive) {
+            mCyclicSendingActive = false;
+            emit invokeStopCyclicSending();
+        }
+        return;
     }
-    return crcInputData;
+
+    auto parametersCtx = mCyclicSending->parametersContext();
+    SAKDebuggerDevice::SAKStructCyclicSendingContext ctx;
+    ctx.bytes = inputFrame();
+    ctx.period = period;
+    ctx.burst = parametersCtx.burst;
+    ctx.count = parametersCtx.count;
+    ctx.duration = parametersCtx.duration;
+    mCyclicSendingActive = true;
+    emit invokeStartCyclicSending(ctx);
 }
 
 void SAKDebuggerInput::initUi()
@@ -273,27 +279,24 @@ void SAKDebuggerInput::initUi()
 
 void SAKDebuggerInput::initUiRegularSendingComboBox()
 {
-    mRegularSendingComboBox->addItem(tr("Forbidden"), INT_MAX);
+    // The item data is the period, the unit is microsecond. Any period can be
+    // input, such as "0.25 ms".
+    mRegularSendingComboBox->addItem(tr("Forbidden"), 0);
     QString unit = tr("ms");
-    for (int i = 50; i < 500; i += 50) {
-        mRegularSendingComboBox->addItem(QString::number(i) + QString(" ") + unit, i);
-    }
-    for (int i = 1000; i <= 5000; i += 1000) {
-        mRegularSendingComboBox->addItem(QString::number(i) + QString(" ") + unit, i);
+    QList<double> periods = QList<double>() << 0.1 << 0.2 << 0.5 << 1 << 2 << 5
+                                            << 10 << 20 << 50 << 100 << 200
+                                            << 500 << 1000 << 2000 << 5000;
+    for (auto &period : periods) {
+        mRegularSendingComboBox->addItem(QString::number(period) + QString(" ") + unit,
+                                         qint64(period*1000));
     }
+    mRegularSendingComboBox->setEditable(true);
+    mRegularSendingComboBox->setInsertPolicy(QComboBox::NoInsert);
     connect(mRegularSendingComboBox,
             static_cast<void(QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
-            this, [=](int index){
-        mRregularSendingTimer->stop();
-        if (index != 0) {
-            int interval = mRegularSendingComboBox->currentData().toInt();
-            mRregularSendingTimer->stop();
-            mRregularSendingTimer->setInterval(interval);
-            mRregularSendingTimer->start();
-        }
-    });
-    connect(mRregularSendingTimer, &QTimer::timeout,
-            this, &SAKDebuggerInput::writeBytes);
+            this, &SAKDebuggerInput::updateCyclicSending);
+    connect(mRegularSendingComboBox->lineEdit(), &QLineEdit::editingFinished,
+            this, &SAKDebuggerInput::updateCyclicSending);
 }
 
 void SAKDebuggerInput::initUiTextFormatComboBox()
@@ -362,6 +365,7 @@ void SAKDebuggerInput::initUiMoreInputSettingsPushButton()
     addActionToMenuSaveInput(moreInputSettingsPushButtonMenu);
     addActionToMenuClearInput(moreInputSettingsPushButtonMenu);
     addActionToMenuCRCSettings(moreInputSettingsPushButtonMenu);
+    addActionToMenuCyclicSending(moreInputSettingsPushButtonMenu);
     addActionToMenuEnableSendingRecord(moreInputSettingsPushButtonMenu);
 }
 
@@ -403,6 +407,9 @@ void SAKDebuggerInput::initUiInputComboBox()
     connect(mInputComboBox,
             static_cast<void(QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
             this, &SAKDebuggerInput::updateCrc);
+    // Compile the frame when the text is edited.
+    connect(mInputComboBox, &QComboBox::editTextChanged,
+            this, &SAKDebuggerInput::updateFrame);
 }
 
 void SAKDebuggerInput::addActionToMenuQuickSending(QMenu *menu)
@@ -441,6 +448,7 @@ void SAKDebuggerInput::addActionToMenuSuffixs(QMenu *menu)
         QAction *suffixAction = suffixsMenu->addAction(friendlySuffix, this, [=](){
             mSettings->setValue(mSettingKeyCtx.suffixsType, cookedType);
             mInputParameters.suffixType = cookedType;
+            updateFrame();
         });
         suffixAction->setCheckable(true);
         mSuffixsActionGroup->addAction(suffixAction);
@@ -498,6 +506,17 @@ void SAKDebuggerInput::addActionToMenuCRCSettings(QMenu *menu)
     });
 }
 
+void SAKDebuggerInput::addActionToMenuCyclicSending(QMenu *menu)
+{
+    menu->addAction(tr("Cyclic Sending"), this, [=](){
+        if (mCyclicSending->isHidden()) {
+            mCyclicSending->show();
+        } else {
+            mCyclicSending->activateWindow();
+        }
+    });
+}
+
 void SAKDebuggerInput::addActionToMenuEnableSendingRecord(QMenu *menu)
 {
     auto *action = menu->addAction(
@@ -526,6 +545,7 @@ void SAKDebuggerInput::initSubModule()
 {
     initSubModuleDataPreset();
     initSubModuleCrcSettings();
+    initSubModuleCyclicSending();
 }
 
 void SAKDebuggerInput::initSubModuleDataPreset()
@@ -563,10 +583,23 @@ void SAKDebuggerInput::initSubModuleCrcSettings()
         mInputParameters.crc.bigEndian = ctx.bigEndian;
         mInputParameters.crc.startByte = ctx.startByte;
         mInputParameters.crc.endByte = ctx.endByte;
-        updateCrc();
+        updateFrame();
     };
     mCrcSettings = new SAKDebuggerInputCrcSettings(mSettingsGroup, mSettings, mUiParent);
     updateCrcParameters();
     connect(mCrcSettings, &SAKDebuggerInputCrcSettings::crcParametersChanged,
             this, updateCrcParameters);
 }
+
+void SAKDebuggerInput::initSubModuleCyclicSending()
+{
+    mCyclicSending = new SAKDebuggerInputCyclicSending(mSettingsGroup,
+                                                       mSettings,
+                                                       mUiParent);
+    connect(mCyclicSending, &SAKDebuggerInputCyclicSending::parametersChanged,
+            this, [=](){
+        if (mCyclicSendingActive) {
+            updateCyclicSending();
+        }
+    });
+}
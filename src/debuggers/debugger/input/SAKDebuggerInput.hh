@@ -25,9 +25,12 @@
 #include <QSqlDatabase>
 #include <QWaitCondition>
 
-class SAKCommonCrcInterface;
+#include "SAKDebuggerDevice.hh"
+
+class SAKDebuggerInputEncoder;
 class SAKDebuggerInputDataPreset;
 class SAKDebuggerInputCrcSettings;
+class SAKDebuggerInputCyclicSending;
 
 /// @brief input module controller
 class SAKDebuggerInput : public QThread
@@ -62,6 +65,8 @@ public:
 
     void inputBytes(QString rawBytes, SAKStructInputParametersContext parasCtx);
     void updateUiState(bool deviceIsOpened);
+    void onCyclicSendingStateChanged(bool running);
+    void onCyclicSendingRateChanged(double requested, double achieved);
 protected:
     void run() override;
 private:
@@ -94,19 +99,25 @@ private:
     // Sub modules
     SAKDebuggerInputDataPreset *mDataPreset;
     SAKDebuggerInputCrcSettings *mCrcSettings;
+    SAKDebuggerInputCyclicSending *mCyclicSending;
 
 
     // Inner parameters
-    QTimer *mRregularSendingTimer;
+    bool mCyclicSendingActive;
     QActionGroup *mSuffixsActionGroup;
-    SAKCommonCrcInterface *mCrcInterface;
     SAKStructInputParametersContext mInputParameters;
+    // The encoder of input combo box(main thread) and the encoder of
+    // inputBytes()(the input thread).
+    SAKDebuggerInputEncoder *mInputEncoder;
+    SAKDebuggerInputEncoder *mThreadEncoder;
 private:
     void writeBytes();
     void updateCrc();
-    quint32 crcCalculate(QByteArray data, int model);
-    QByteArray extractCrcData(QByteArray crcData,
-                              SAKStructInputParametersContext parameters);
+    void updateFrame();
+    QByteArray inputFrame();
+    qint64 cyclicSendingPeriod();
+    void updateCyclicSending();
+    void resetRegularSendingComboBox();
     void initUi();
     void initUiRegularSendingComboBox();
     void initUiTextFormatComboBox();
@@ -120,13 +131,17 @@ private:
     void addActionToMenuSaveInput(QMenu *menu);
     void addActionToMenuClearInput(QMenu *menu);
     void addActionToMenuCRCSettings(QMenu *menu);
+    void addActionToMenuCyclicSending(QMenu *menu);
     void addActionToMenuEnableSendingRecord(QMenu *menu);
 
     void initSubModule();
     void initSubModuleDataPreset();
     void initSubModuleCrcSettings();
+    void initSubModuleCyclicSending();
 signals:
     void invokeWriteBytes(QByteArray bytes);
+    void invokeStartCyclicSending(SAKDebuggerDevice::SAKStructCyclicSendingContext ctx);
+    void invokeStopCyclicSending();
     void messageChanged(QString msg, bool isError);
 };
 Q_DECLARE_METATYPE(SAKDebuggerInput::SAKStructInputParametersContext);
@@ -0,0 +1,94 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include "SAKDebuggerInputCyclicSending.hh"
+#include "ui_SAKDebuggerInputCyclicSending.h"
+
+SAKDebuggerInputCyclicSending::SAKDebuggerInputCyclicSending(
+        QString settingsGroup,
+        QSettings *settings,
+        QWidget *parent)
+    :QDialog(parent)
+    ,mSettings(settings)
+    ,mUi(new Ui::SAKDebuggerInputCyclicSending)
+{
+    mUi->setupUi(this);
+
+    QString group = settingsGroup + "/cyclicSending/";
+    mSettingsKeyContext.burst = group + "burst";
+    mSettingsKeyContext.count = group + "count";
+    mSettingsKeyContext.duration = group + "duration";
+
+
+    // Readin settings parameters.
+    int burst = mSettings->value(mSettingsKeyContext.burst).toInt();
+    mUi->burstSpinBox->setValue(burst < 1 ? 1 : burst);
+    mUi->countSpinBox->setValue(mSettings->value(mSettingsKeyContext.count).toInt());
+    int duration = mSettings->value(mSettingsKeyContext.duration).toInt();
+    mUi->durationSpinBox->setValue(duration);
+
+
+    // Signals and slots
+#if QT_VERSION >= QT_VERSION_CHECK(5,7,0)
+    connect(mUi->burstSpinBox, QOverload<int>::of(&QSpinBox::valueChanged),
+#else
+    connect(mUi->burstSpinBox,
+            static_cast<void(QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+#endif
+            this, [=](int value){
+        mSettings->setValue(mSettingsKeyContext.burst, value);
+        emit parametersChanged();
+    });
+#if QT_VERSION >= QT_VERSION_CHECK(5,7,0)
+    connect(mUi->countSpinBox, QOverload<int>::of(&QSpinBox::valueChanged),
+#else
+    connect(mUi->countSpinBox,
+            static_cast<void(QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+#endif
+            this, [=](int value){
+        mSettings->setValue(mSettingsKeyContext.count, value);
+        emit parametersChanged();
+    });
+#if QT_VERSION >= QT_VERSION_CHECK(5,7,0)
+    connect(mUi->durationSpinBox, QOverload<int>::of(&QSpinBox::valueChanged),
+#else
+    connect(mUi->durationSpinBox,
+            static_cast<void(QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+#endif
+            this, [=](int value){
+        mSettings->setValue(mSettingsKeyContext.duration, value);
+        emit parametersChanged();
+    });
+
+
+    setModal(true);
+    setWindowTitle(tr("Cyclic Sending"));
+}
+
+SAKDebuggerInputCyclicSending::~SAKDebuggerInputCyclicSending()
+{
+    delete mUi;
+}
+
+SAKDebuggerInputCyclicSending::SAKStructCyclicSendingParametersContext
+SAKDebuggerInputCyclicSending::parametersContext()
+{
+    SAKStructCyclicSendingParametersContext ctx;
+    ctx.burst = mUi->burstSpinBox->value();
+    ctx.count = mUi->countSpinBox->value();
+    ctx.duration = mUi->durationSpinBox->value();
+    return ctx;
+}
+
+void SAKDebuggerInputCyclicSending::setRate(double requested, double achieved)
+{
+    mUi->rateLabel->setText(tr("Requested: %1 frames/s, achieved: %2 frames/s")
+                            .arg(requested, 0, 'f', 1)
+                            .arg(achieved, 0, 'f', 1));
+}
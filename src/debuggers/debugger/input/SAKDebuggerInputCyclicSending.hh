@@ -0,0 +1,62 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#ifndef SAKDEBUGGERINPUTCYCLICSENDING_HH
+#define SAKDEBUGGERINPUTCYCLICSENDING_HH
+
+#include <QDialog>
+#include <QSettings>
+
+namespace Ui {
+    class SAKDebuggerInputCyclicSending;
+}
+
+/// @brief Cyclic sending settings dialog, the period is set by the cycling time
+/// combo box of input module.
+class SAKDebuggerInputCyclicSending : public QDialog
+{
+    Q_OBJECT
+public:
+    SAKDebuggerInputCyclicSending(QString settingsGroup,
+                                  QSettings *settings,
+                                  QWidget *parent = Q_NULLPTR);
+    ~SAKDebuggerInputCyclicSending();
+
+    struct SAKStructCyclicSendingParametersContext {
+        int burst;          // Frames of every period
+        qint64 count;       // Periods to be sent, 0 means unlimited
+        qint64 duration;    // Unit is millisecond, 0 means unlimited
+    };
+
+    /**
+     * @brief parametersContext: get the parameters context
+     * @return parameters context
+     */
+    SAKStructCyclicSendingParametersContext parametersContext();
+
+    /**
+     * @brief setRate: Show the requested rate and the achieved rate.
+     * @param requested: Frames per second.
+     * @param achieved: Frames per second.
+     */
+    void setRate(double requested, double achieved);
+private:
+    QSettings *mSettings;
+    struct {
+        QString burst;
+        QString count;
+        QString duration;
+    } mSettingsKeyContext;
+private:
+    Ui::SAKDebuggerInputCyclicSending *mUi;
+signals:
+    void parametersChanged();
+};
+
+#endif
@@ -44,6 +44,10 @@ SAKDebuggerInputDataPreset::SAKDebuggerInputDataPreset(
     mTableContext.tableName = mTableName;
     initialize();
 
+    // The actions of the menu are created with the item widgets.
+    connect(mItemsMenu, &QMenu::aboutToShow,
+            this, &SAKDebuggerInputDataPreset::loadItems);
+
     setContentsMargins(4, 4, 4, 4);
 }
 
@@ -80,30 +84,6 @@ QString SAKDebuggerInputDataPreset::sqlCreate(const QString &tableName)
 }
 
 
-QString SAKDebuggerInputDataPreset::sqlInsert(const QString &tableName,
-                                              QWidget *itemWidget)
-{
-    auto cookedItemWidget = qobject_cast<SAKDebuggerInputDataPresetItem*>(itemWidget);
-    if (cookedItemWidget) {
-        auto ctx = cookedItemWidget->context();
-        SAKStructTableContext tableCtx;
-        QString queryString = QString("INSERT INTO %1(%2,%3,%4,%5)"
-                                      " VALUES(%6,%7,'%8','%9')")
-                .arg(tableName,
-                     tableCtx.columns.id,
-                     tableCtx.columns.format,
-                     tableCtx.columns.description,
-                     tableCtx.columns.data,
-                     QString::number(cookedItemWidget->id()),
-                     QString::number(ctx.format),
-                     ctx.description,
-                     ctx.data);
-        return queryString;
-    }
-
-    return QString();
-}
-
 QWidget *SAKDebuggerInputDataPreset::createItemFromParameters(
         const QJsonObject &jsonObj
         )
@@ -158,17 +138,17 @@ QJsonObject SAKDebuggerInputDataPreset::toJsonObject(QWidget *itemWidget)
     return obj;
 }
 
-QJsonObject SAKDebuggerInputDataPreset::toJsonObject(const QSqlQuery &sqlQuery)
+QJsonObject SAKDebuggerInputDataPreset::toJsonObject(const QVariantMap &record)
 {
     QJsonObject jsonObj;
     jsonObj.insert(mTableContext.columns.id,
-                   sqlQuery.value(mTableContext.columns.id).toLongLong());
+                   record.value(mTableContext.columns.id).toLongLong());
     jsonObj.insert(mTableContext.columns.format,
-                   sqlQuery.value(mTableContext.columns.format).toInt());
+                   record.value(mTableContext.columns.format).toInt());
     jsonObj.insert(mTableContext.columns.description,
-                   sqlQuery.value(mTableContext.columns.description).toString());
+                   record.value(mTableContext.columns.description).toString());
     jsonObj.insert(mTableContext.columns.data,
-                   sqlQuery.value(mTableContext.columns.data).toString());
+                   record.value(mTableContext.columns.data).toString());
     return jsonObj;
 }
 
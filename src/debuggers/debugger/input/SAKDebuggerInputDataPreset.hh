@@ -35,9 +35,8 @@ public:
 
 protected:
     QString sqlCreate(const QString &tableName) final;
-    QString sqlInsert(const QString &tableName, QWidget *itemWidget) final;
     QJsonObject toJsonObject(QWidget *itemWidget) final;
-    QJsonObject toJsonObject(const QSqlQuery &sqlQuery) final;
+    QJsonObject toJsonObject(const QVariantMap &record) final;
     QWidget *createItemFromParameters(const QJsonObject &jsonObj) final;
     quint64 itemId(QWidget *itemWidget) final;
     void connectSignalsToSlots(QWidget *itemWidget) final;
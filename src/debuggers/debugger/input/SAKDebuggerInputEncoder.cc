@@ -0,0 +1,250 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QtEndian>
+
+#include "SAKCommonCrcInterface.hh"
+#include "SAKCommonDataStructure.hh"
+#include "SAKDebuggerInputEncoder.hh"
+
+SAKDebuggerInputEncoder::SAKDebuggerInputEncoder()
+    :mCrcInterface(new SAKCommonCrcInterface)
+{
+    mTemplateCtx.compiled = false;
+}
+
+SAKDebuggerInputEncoder::~SAKDebuggerInputEncoder()
+{
+    delete mCrcInterface;
+}
+
+QByteArray SAKDebuggerInputEncoder::encode(
+        const QString &rawBytes,
+        const SAKDebuggerInput::SAKStructInputParametersContext &ctx)
+{
+    compile(rawBytes, ctx);
+    return mTemplateCtx.frame;
+}
+
+quint32 SAKDebuggerInputEncoder::crc(
+        const QString &rawBytes,
+        const SAKDebuggerInput::SAKStructInputParametersContext &ctx)
+{
+    compile(rawBytes, ctx);
+    return mTemplateCtx.crc;
+}
+
+int SAKDebuggerInputEncoder::crcBitsWidth(int parametersModel)
+{
+    auto cookedModel =
+            static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(parametersModel);
+    return mCrcInterface->bitsWidth(cookedModel);
+}
+
+void SAKDebuggerInputEncoder::compile(
+        const QString &rawBytes,
+        const SAKDebuggerInput::SAKStructInputParametersContext &ctx)
+{
+    // Every section is recompiled only if the section or the sections
+    // in front of it changed, the sections are patched in place.
+    bool rebuilt = false;
+    bool bodyChanged = true;
+    if ((!mTemplateCtx.compiled) || (mTemplateCtx.textFormat != ctx.textFormat)) {
+        QString temp = rawBytes;
+        mTemplateCtx.rawBytes = rawBytes;
+        mTemplateCtx.textFormat = ctx.textFormat;
+        mTemplateCtx.frame =
+                SAKCommonDataStructure::stringToByteArray(temp, ctx.textFormat);
+        mTemplateCtx.payloadLength = mTemplateCtx.frame.length();
+        mTemplateCtx.suffixLength = 0;
+        mTemplateCtx.crcLength = 0;
+        rebuilt = true;
+    } else if (mTemplateCtx.rawBytes != rawBytes) {
+        patchPayload(rawBytes);
+    } else {
+        bodyChanged = false;
+    }
+
+    if (rebuilt || (mTemplateCtx.suffixType != ctx.suffixType)) {
+        QByteArray suffix;
+        if (ctx.suffixType != SAKCommonDataStructure::SuffixsTypeNone) {
+            suffix = SAKCommonDataStructure::suffix(ctx.suffixType).toLatin1();
+        }
+        mTemplateCtx.suffixType = ctx.suffixType;
+        mTemplateCtx.frame.replace(mTemplateCtx.payloadLength,
+                                   mTemplateCtx.suffixLength,
+                                   suffix);
+        mTemplateCtx.suffixLength = suffix.length();
+        bodyChanged = true;
+    }
+
+    bool crcChanged = bodyChanged
+            || (mTemplateCtx.crcParametersModel != ctx.crc.parametersModel)
+            || (mTemplateCtx.crcStartByte != ctx.crc.startByte)
+            || (mTemplateCtx.crcEndByte != ctx.crc.endByte);
+    int bodyLength = mTemplateCtx.payloadLength + mTemplateCtx.suffixLength;
+    if (crcChanged) {
+        mTemplateCtx.crcParametersModel = ctx.crc.parametersModel;
+        mTemplateCtx.crcStartByte = ctx.crc.startByte;
+        mTemplateCtx.crcEndByte = ctx.crc.endByte;
+        QByteArray crcInputData = extractCrcData(mTemplateCtx.frame.left(bodyLength),
+                                                 ctx.crc.startByte,
+                                                 ctx.crc.endByte);
+        mTemplateCtx.crc = crcCalculate(crcInputData, ctx.crc.parametersModel);
+    }
+
+    bool crcBytesChanged = crcChanged
+            || (mTemplateCtx.crcAppending != ctx.crc.appending)
+            || (mTemplateCtx.crcBigEndian != ctx.crc.bigEndian);
+    if (crcBytesChanged) {
+        mTemplateCtx.crcAppending = ctx.crc.appending;
+        mTemplateCtx.crcBigEndian = ctx.crc.bigEndian;
+        QByteArray bytes = crcBytes(ctx);
+        // The crc bytes are overwritten if the bits width is not changed.
+        mTemplateCtx.frame.replace(bodyLength, mTemplateCtx.crcLength, bytes);
+        mTemplateCtx.crcLength = bytes.length();
+    }
+
+    mTemplateCtx.compiled = true;
+}
+
+void SAKDebuggerInputEncoder::patchPayload(const QString &rawBytes)
+{
+    const QString &oldBytes = mTemplateCtx.rawBytes;
+    int minLength = qMin(oldBytes.length(), rawBytes.length());
+    int prefix = 0;
+    while ((prefix < minLength) && (oldBytes.at(prefix) == rawBytes.at(prefix))) {
+        prefix += 1;
+    }
+    int suffix = 0;
+    while ((suffix < minLength - prefix)
+           && (oldBytes.at(oldBytes.length() - 1 - suffix)
+               == rawBytes.at(rawBytes.length() - 1 - suffix))) {
+        suffix += 1;
+    }
+    int oldEnd = oldBytes.length() - suffix;
+    int newEnd = rawBytes.length() - suffix;
+
+    int format = mTemplateCtx.textFormat;
+    int position = 0;
+    int length = 0;
+    QByteArray bytes;
+    if ((format == SAKCommonDataStructure::InputFormatBin)
+            || (format == SAKCommonDataStructure::InputFormatOct)
+            || (format == SAKCommonDataStructure::InputFormatDec)
+            || (format == SAKCommonDataStructure::InputFormatHex)) {
+        // Every field separated by space is a byte, the fields touched by
+        // the edit are parsed again.
+        for (int i = 0; i < prefix; i++) {
+            position += (oldBytes.at(i) == QChar(' ')) ? 1 : 0;
+        }
+        length = 1;
+        for (int i = prefix; i < oldEnd; i++) {
+            length += (oldBytes.at(i) == QChar(' ')) ? 1 : 0;
+        }
+
+        int start = prefix > 0 ? rawBytes.lastIndexOf(' ', prefix - 1) + 1 : 0;
+        int end = rawBytes.indexOf(' ', newEnd);
+        end = end < 0 ? rawBytes.length() : end;
+        QString fields = rawBytes.mid(start, end - start);
+        bytes = SAKCommonDataStructure::stringToByteArray(fields, format);
+    } else if (format == SAKCommonDataStructure::InputFormatAscii) {
+        // One byte per character.
+        position = prefix;
+        length = oldEnd - prefix;
+        bytes = rawBytes.mid(prefix, newEnd - prefix).toLatin1();
+    } else {
+        // The local 8 bit encoding may be multibyte, the payload is rebuilt.
+        QString temp = rawBytes;
+        length = mTemplateCtx.payloadLength;
+        bytes = SAKCommonDataStructure::stringToByteArray(temp, format);
+    }
+
+    mTemplateCtx.frame.replace(position, length, bytes);
+    mTemplateCtx.payloadLength += bytes.length() - length;
+    mTemplateCtx.rawBytes = rawBytes;
+}
+
+QByteArray SAKDebuggerInputEncoder::crcBytes(
+        const SAKDebuggerInput::SAKStructInputParametersContext &ctx)
+{
+    QByteArray bytes;
+    if (ctx.crc.appending) {
+        uint32_t crc = mTemplateCtx.crc;
+        uint8_t crc8 = static_cast<uint8_t>(crc);
+        uint16_t crc16 = static_cast<uint16_t>(crc);
+        if (ctx.crc.bigEndian) {
+            crc16 = qToBigEndian(crc16);
+            crc = qToBigEndian(crc);
+        }
+
+        switch (crcBitsWidth(ctx.crc.parametersModel)) {
+        case 8:
+            bytes.append(reinterpret_cast<char*>(&crc8), 1);
+            break;
+        case 16:
+            bytes.append(reinterpret_cast<char*>(&crc16), 2);
+            break;
+        case 32:
+            bytes.append(reinterpret_cast<char*>(&crc), 4);
+            break;
+        default:
+            break;
+        }
+    }
+
+    return bytes;
+}
+
+quint32 SAKDebuggerInputEncoder::crcCalculate(QByteArray data, int model)
+{
+    auto cookedModel = static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(model);
+    int bitsWidth = mCrcInterface->bitsWidth(cookedModel);
+    switch (bitsWidth) {
+    case 8:
+        return mCrcInterface->crcCalculate<uint8_t>(
+                    reinterpret_cast<uint8_t*>(data.data()),
+                    static_cast<quint64>(data.length()),
+                    cookedModel);
+    case 16:
+        return mCrcInterface->crcCalculate<uint16_t>(
+                    reinterpret_cast<uint8_t*>(data.data()),
+                    static_cast<quint64>(data.length()),
+                    cookedModel);
+    case 32:
+        return mCrcInterface->crcCalculate<uint32_t>(
+                    reinterpret_cast<uint8_t*>(data.data()),
+                    static_cast<quint64>(data.length()),
+                    cookedModel);
+    default:
+        return 0;
+    }
+}
+
+QByteArray SAKDebuggerInputEncoder::extractCrcData(const QByteArray &crcData,
+                                                   int startByte,
+                                                   int endByte)
+{
+    QByteArray crcInputData;
+    int startIndex = startByte - 1;
+    startIndex = startIndex < 0 ? 0 : startIndex;
+
+    int endIndex = (crcData.length() - 1) - (endByte - 1);
+    endIndex = endIndex < 0 ? 0 : endIndex;
+
+    if (((crcData.length() - 1) >= startIndex)
+            && ((crcData.length() - 1) >= endIndex)){
+        int length = endIndex - startIndex + 1;
+        length = length < 0 ? 0 : length;
+        crcInputData = QByteArray(crcData.constData()+startIndex, length);
+    }else{
+        crcInputData = crcData;
+    }
+    return crcInputData;
+}
@@ -0,0 +1,90 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#ifndef SAKDEBUGGERINPUTENCODER_HH
+#define SAKDEBUGGERINPUTENCODER_HH
+
+#include <QString>
+#include <QByteArray>
+
+#include "SAKDebuggerInput.hh"
+
+class SAKCommonCrcInterface;
+
+/// @brief The encoder compiles the input text to a frame template(payload, suffix
+/// and crc). The sections are recompiled only when their parameters changed, so
+/// sending the same text repeatedly costs nothing but a shallow copy of the
+/// frame. When the text is edited, only the bytes of the changed fields are
+/// parsed and patched into the template. The encoder is not thread safe, one
+/// encoder per thread.
+class SAKDebuggerInputEncoder
+{
+public:
+    SAKDebuggerInputEncoder();
+    ~SAKDebuggerInputEncoder();
+
+    /**
+     * @brief encode: Get the frame of the input text.
+     * @param rawBytes: The input text.
+     * @param ctx: Input parameters.
+     * @return The frame to be written.
+     */
+    QByteArray encode(const QString &rawBytes,
+                      const SAKDebuggerInput::SAKStructInputParametersContext &ctx);
+
+    /**
+     * @brief crc: Get the crc value of the input text, the value is the one
+     * that will be appended to the frame.
+     */
+    quint32 crc(const QString &rawBytes,
+                const SAKDebuggerInput::SAKStructInputParametersContext &ctx);
+
+    /**
+     * @brief crcBitsWidth: Get the bits width of crc parameters model.
+     */
+    int crcBitsWidth(int parametersModel);
+private:
+    struct SAKStructTemplateContext {
+        bool compiled;
+
+        // Payload section, it depends on the text and the text format.
+        QString rawBytes;
+        int textFormat;
+        int payloadLength;
+
+        // Suffix section, it follows the payload.
+        int suffixType;
+        int suffixLength;
+
+        // Crc value of body(payload and suffix).
+        int crcParametersModel;
+        int crcStartByte;
+        int crcEndByte;
+        quint32 crc;
+
+        // Crc section, it follows the suffix.
+        bool crcAppending;
+        bool crcBigEndian;
+        int crcLength;
+
+        // The frame(payload, suffix and crc bytes), the sections are patched
+        // in place.
+        QByteArray frame;
+    } mTemplateCtx;
+    SAKCommonCrcInterface *mCrcInterface;
+private:
+    void compile(const QString &rawBytes,
+                 const SAKDebuggerInput::SAKStructInputParametersContext &ctx);
+    void patchPayload(const QString &rawBytes);
+    QByteArray crcBytes(const SAKDebuggerInput::SAKStructInputParametersContext &ctx);
+    quint32 crcCalculate(QByteArray data, int model);
+    QByteArray extractCrcData(const QByteArray &crcData, int startByte, int endByte);
+};
+
+#endif
@@ -46,43 +46,6 @@ SAKDebuggerPluginAutoResponse::~SAKDebuggerPluginAutoResponse()
 
 }
 
-QString SAKDebuggerPluginAutoResponse::sqlInsert(const QString &tableName,
-                                                 QWidget *itemWidget)
-{
-    auto cookedItemWidget
-            = qobject_cast<SAKDebuggerPluginAutoResponseItem*>(itemWidget);
-    if (!cookedItemWidget) {
-        return QString();
-    }
-
-    auto itemCtx = cookedItemWidget->context();
-    auto tableCtx = mTableCtx;
-    QString queryString = QString("INSERT INTO %1(").arg(tableName);
-    queryString.append(tableCtx.columns.id).append(",");
-    queryString.append(tableCtx.columns.description).append(",");
-    queryString.append(tableCtx.columns.referenceData).append(",");
-    queryString.append(tableCtx.columns.responseData).append(",");
-    queryString.append(tableCtx.columns.enable).append(",");
-    queryString.append(tableCtx.columns.referenceFormat).append(",");
-    queryString.append(tableCtx.columns.responseFormat).append(",");
-    queryString.append(tableCtx.columns.option).append(",");
-    queryString.append(tableCtx.columns.enableDelay).append(",");
-    queryString.append(tableCtx.columns.delayTime).append(")");
-    queryString.append("VALUES(");
-    queryString.append(QString("%1,").arg(itemCtx.id));
-    queryString.append(QString("'%1',").arg(itemCtx.description));
-    queryString.append(QString("'%1',").arg(itemCtx.referenceData));
-    queryString.append(QString("'%1',").arg(itemCtx.responseData));
-    queryString.append(QString("%1,").arg(itemCtx.enable));
-    queryString.append(QString("%1,").arg(itemCtx.referenceFormat));
-    queryString.append(QString("%1,").arg(itemCtx.responseFormat));
-    queryString.append(QString("%1,").arg(itemCtx.option));
-    queryString.append(QString("%1,").arg(itemCtx.enableDelay));
-    queryString.append(QString("%1)").arg(itemCtx.delayTime));
-
-    return queryString;
-}
-
 QWidget *SAKDebuggerPluginAutoResponse::createItemFromParameters(
         const QJsonObject &jsonObj
         )
@@ -126,50 +89,50 @@ QJsonObject SAKDebuggerPluginAutoResponse::toJsonObject(QWidget *itemWidget)
     return jsonObj;
 }
 
-QJsonObject SAKDebuggerPluginAutoResponse::toJsonObject(const QSqlQuery &sqlQuery)
+QJsonObject SAKDebuggerPluginAutoResponse::toJsonObject(const QVariantMap &record)
 {
     QJsonObject jsonObj;
     QString column;
     QVariant valueVariant;
 
     column = mTableCtx.columns.id;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toLongLong());
 
     column = mTableCtx.columns.description;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toString());
 
     column = mTableCtx.columns.referenceData;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toString());
 
     column = mTableCtx.columns.responseData;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toString());
 
     column = mTableCtx.columns.enable;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toBool());
 
     column = mTableCtx.columns.referenceFormat;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toInt());
 
     column = mTableCtx.columns.responseFormat;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toInt());
 
     column = mTableCtx.columns.option;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toInt());
 
     column = mTableCtx.columns.enableDelay;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toBool());
 
     column = mTableCtx.columns.delayTime;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toInt());
 
     return jsonObj;
@@ -39,10 +39,9 @@ public:
 
 protected:
     QString sqlCreate(const QString &tableName) final;
-    QString sqlInsert(const QString &tableName, QWidget *itemWidget) final;
     QWidget *createItemFromParameters(const QJsonObject &jsonObj) final;
     QJsonObject toJsonObject(QWidget *itemWidget) final;
-    QJsonObject toJsonObject(const QSqlQuery &sqlQuery) final;
+    QJsonObject toJsonObject(const QVariantMap &record) final;
     quint64 itemId(QWidget *itemWidget) final;
     void connectSignalsToSlots(QWidget *itemWidget) final;
 
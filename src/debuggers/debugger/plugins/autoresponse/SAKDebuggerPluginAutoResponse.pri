@@ -3,7 +3,8 @@ FORMS += \
 
 HEADERS += \
     $$PWD/SAKDebuggerPluginAutoResponse.hh \
-    $$PWD/SAKDebuggerPluginAutoResponseItem.hh
+    $$PWD/SAKDebuggerPluginAutoResponseItem.hh \
+    $$PWD/SAKDebuggerPluginAutoResponseOption.hh
 
 SOURCES += \
     $$PWD/SAKDebuggerPluginAutoResponse.cc \
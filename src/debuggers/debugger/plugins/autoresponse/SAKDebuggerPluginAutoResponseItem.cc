@@ -16,6 +16,7 @@
 #include "SAKCommonInterface.hh"
 #include "SAKCommonDataStructure.hh"
 #include "SAKDebuggerPluginAutoResponseItem.hh"
+#include "SAKDebuggerPluginAutoResponseOption.hh"
 #include "ui_SAKDebuggerPluginAutoResponseItem.h"
 
 SAKDebuggerPluginAutoResponseItem::SAKDebuggerPluginAutoResponseItem(QWidget *parent)
@@ -133,13 +134,13 @@ void SAKDebuggerPluginAutoResponseItem::onBytesRead(QByteArray bytes)
 void SAKDebuggerPluginAutoResponseItem::setupItem()
 {
     mUi->optionComboBox->clear();
-    int dataValue = ReadDataIsEqualToReference;
+    int dataValue = SAKDebuggerPluginAutoResponseOption::ReadDataIsEqualToReference;
     mUi->optionComboBox->addItem(tr("Rx data is equal to reference data"),
                                  QVariant::fromValue<int>(dataValue));
-    dataValue = ReadDataContainsReferenceData;
+    dataValue = SAKDebuggerPluginAutoResponseOption::ReadDataContainsReferenceData;
     mUi->optionComboBox->addItem(tr("Rx data contains reference data"),
                                  QVariant::fromValue<int>(dataValue));
-    dataValue = ReadDataDoesNotContainReferenceData;
+    dataValue = SAKDebuggerPluginAutoResponseOption::ReadDataDoesNotContainReferenceData;
     mUi->optionComboBox->addItem(tr("Rx data does not contains reference data"),
                                  QVariant::fromValue<int>(dataValue));
 
@@ -209,15 +210,15 @@ bool SAKDebuggerPluginAutoResponseItem::needToResponse(QByteArray receiveData,
                                                        QByteArray referenceData,
                                                        int option)
 {
-    if (option == ReadDataIsEqualToReference){
+    if (option == SAKDebuggerPluginAutoResponseOption::ReadDataIsEqualToReference){
         return (QString(receiveData.toHex()) == QString(referenceData.toHex()));
     }
 
-    if (option == ReadDataContainsReferenceData){
+    if (option == SAKDebuggerPluginAutoResponseOption::ReadDataContainsReferenceData){
         return (QString(receiveData.toHex()).contains(QString(referenceData.toHex())));
     }
 
-    if (option == ReadDataDoesNotContainReferenceData){
+    if (option == SAKDebuggerPluginAutoResponseOption::ReadDataDoesNotContainReferenceData){
         return !(QString(receiveData.toHex()).contains(QString(referenceData.toHex())));
     }
 
@@ -41,14 +41,6 @@ public:
         int delayTime;
     };
 
-    enum SAKEnumAutomaticallyResponseOption {
-        ReadDataIsEqualToReference,
-        ReadDataContainsReferenceData,
-        ReadDataDoesNotContainReferenceData
-    };
-    Q_ENUM(SAKEnumAutomaticallyResponseOption);
-
-
 public:
     SAKDebuggerPluginAutoResponseItem(QWidget *parent = Q_NULLPTR);
     SAKDebuggerPluginAutoResponseItem(SAKStructItemContext ctx,
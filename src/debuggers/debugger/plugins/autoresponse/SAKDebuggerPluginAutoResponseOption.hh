@@ -0,0 +1,29 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#ifndef SAKDEBUGGERPLUGINAUTORESPONSEOPTION_HH
+#define SAKDEBUGGERPLUGINAUTORESPONSEOPTION_HH
+
+#include <QObject>
+
+/// @brief Response options of auto response items, the header does not depend
+/// on Qt Widgets, so the daemon can use the options too.
+class SAKDebuggerPluginAutoResponseOption
+{
+    Q_GADGET
+public:
+    enum SAKEnumAutomaticallyResponseOption {
+        ReadDataIsEqualToReference,
+        ReadDataContainsReferenceData,
+        ReadDataDoesNotContainReferenceData
+    };
+    Q_ENUM(SAKEnumAutomaticallyResponseOption);
+};
+
+#endif
@@ -39,34 +39,6 @@ SAKDebuggerPluginTimedSending::~SAKDebuggerPluginTimedSending()
 
 }
 
-QString SAKDebuggerPluginTimedSending::sqlInsert(const QString &tableName,
-                                                     QWidget *itemWidget)
-{
-    auto cookedItemWidget = qobject_cast<SendingItem*>(itemWidget);
-    if (cookedItemWidget) {
-        QString queryString = QString("INSERT INTO %1").arg(tableName);
-        queryString.append(QString("(%1,%2,%3,%4,%5,%6,%7) VALUES(")
-                           .arg(mTableCtx.columns.id,
-                                mTableCtx.columns.enable,
-                                mTableCtx.columns.description,
-                                mTableCtx.columns.interval,
-                                mTableCtx.columns.format,
-                                mTableCtx.columns.suffix,
-                                mTableCtx.columns.data));
-        auto ctx = cookedItemWidget->context();
-        queryString.append(QString("%1,").arg(cookedItemWidget->id()));
-        queryString.append(QString("%1,").arg(ctx.enable));
-        queryString.append(QString("'%1',").arg(ctx.description));
-        queryString.append(QString("%1,").arg(ctx.interval));
-        queryString.append(QString("%1,").arg(ctx.format));
-        queryString.append(QString("%1,").arg(ctx.suffix));
-        queryString.append(QString("'%1')").arg(ctx.data));
-        return queryString;
-    }
-
-    return QString();
-}
-
 QString SAKDebuggerPluginTimedSending::sqlCreate(const QString &tableName)
 {
     QString queryString = QString("CREATE TABLE %1(")
@@ -152,19 +124,19 @@ QJsonObject SAKDebuggerPluginTimedSending::toJsonObject(QWidget *itemWidget)
     return jsonObj;
 }
 
-QJsonObject SAKDebuggerPluginTimedSending::toJsonObject(const QSqlQuery &sqlQuery)
+QJsonObject SAKDebuggerPluginTimedSending::toJsonObject(const QVariantMap &record)
 {
     QJsonObject parameters;
     parameters.insert(mTableCtx.columns.id,
-                      sqlQuery.value(mTableCtx.columns.id).toLongLong());
+                      record.value(mTableCtx.columns.id).toLongLong());
     parameters.insert(mTableCtx.columns.interval,
-                      sqlQuery.value(mTableCtx.columns.interval).toInt());
+                      record.value(mTableCtx.columns.interval).toInt());
     parameters.insert(mTableCtx.columns.format,
-                      sqlQuery.value(mTableCtx.columns.format).toInt());
+                      record.value(mTableCtx.columns.format).toInt());
     parameters.insert(mTableCtx.columns.description,
-                      sqlQuery.value(mTableCtx.columns.description).toString());
+                      record.value(mTableCtx.columns.description).toString());
     parameters.insert(mTableCtx.columns.data,
-                      sqlQuery.value(mTableCtx.columns.data).toString());
+                      record.value(mTableCtx.columns.data).toString());
 
     return parameters;
 }
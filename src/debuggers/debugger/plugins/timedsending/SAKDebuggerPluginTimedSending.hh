@@ -49,10 +49,9 @@ public:
 
 
 protected:
-    QString sqlInsert(const QString &tableName, QWidget *itemWidget) final;
     QString sqlCreate(const QString &tableName) final;
     QJsonObject toJsonObject(QWidget *itemWidget) final;
-    QJsonObject toJsonObject(const QSqlQuery &sqlQuery) final;
+    QJsonObject toJsonObject(const QVariantMap &record) final;
     quint64 itemId(QWidget *itemWidget) final;
     QWidget *createItemFromParameters(const QJsonObject &jsonObj) final;
     void connectSignalsToSlots(QWidget *itemWidget) final;
@@ -18,7 +18,7 @@
 SAKSerialPortTransponder::SAKSerialPortTransponder(QWidget *parent)
     :SAKDebuggerPluginTransponder(parent)
     ,mUi(new Ui::SAKSerialPortTransponder)
-    ,mDevice(new SAKSerialPortDevice(Q_NULLPTR, QString(), Q_NULLPTR, Q_NULLPTR))
+    ,mDevice(new SAKSerialPortDevice(Q_NULLPTR, QString(), Q_NULLPTR))
 {    
     mUi->setupUi(this);
     initComponents();
@@ -33,7 +33,7 @@ SAKSerialPortTransponder::SAKSerialPortTransponder(
         )
     :SAKDebuggerPluginTransponder(id, parent)
     ,mUi(new Ui::SAKSerialPortTransponder)
-    ,mDevice(new SAKSerialPortDevice(Q_NULLPTR, QString(), Q_NULLPTR, Q_NULLPTR))
+    ,mDevice(new SAKSerialPortDevice(Q_NULLPTR, QString(), Q_NULLPTR))
 {
     mUi->setupUi(this);
     initComponents();
@@ -48,40 +48,6 @@ QString SAKSerialPortTransponders::sqlCreate(const QString &tableName)
     return sqlString;
 }
 
-QString SAKSerialPortTransponders::sqlInsert(const QString &tableName,
-                                            QWidget *itemWidget)
-{
-    auto cookedItemWidget
-            = qobject_cast<SAKSerialPortTransponder*>(itemWidget);
-    if (!cookedItemWidget) {
-        return QString();
-    }
-
-    auto itemCtx = cookedItemWidget->parametersContext()
-            .value<SAKSerialPortParametersContext>();
-    auto tableCtx = mTableCtx;
-    QString queryString = QString("INSERT INTO %1(").arg(tableName);
-    queryString.append(tableCtx.columns.id).append(",");
-    queryString.append(tableCtx.columns.portName).append(",");
-    queryString.append(tableCtx.columns.baudRate).append(",");
-    queryString.append(tableCtx.columns.dataBits).append(",");
-    queryString.append(tableCtx.columns.parity).append(",");
-    queryString.append(tableCtx.columns.stopBits).append(",");
-    queryString.append(tableCtx.columns.flowControl).append(",");
-    queryString.append(tableCtx.columns.frameIntervel).append(")");
-    queryString.append(" VALUES(");
-    queryString.append(QString("%1,").arg(cookedItemWidget->id()));
-    queryString.append(QString("'%1',").arg(itemCtx.portName));
-    queryString.append(QString("%1,").arg(itemCtx.baudRate));
-    queryString.append(QString("%1,").arg(itemCtx.dataBits));
-    queryString.append(QString("%1,").arg(itemCtx.parity));
-    queryString.append(QString("%1,").arg(itemCtx.stopBits));
-    queryString.append(QString("%1,").arg(itemCtx.flowControl));
-    queryString.append(QString("%1)").arg(itemCtx.frameIntervel));
-
-    return queryString;
-}
-
 QJsonObject SAKSerialPortTransponders::toJsonObject(QWidget *itemWidget)
 {
     QJsonObject jsonObj;
@@ -101,42 +67,42 @@ QJsonObject SAKSerialPortTransponders::toJsonObject(QWidget *itemWidget)
     return jsonObj;
 }
 
-QJsonObject SAKSerialPortTransponders::toJsonObject(const QSqlQuery &sqlQuery)
+QJsonObject SAKSerialPortTransponders::toJsonObject(const QVariantMap &record)
 {
     QJsonObject jsonObj;
     QString column;
     QVariant valueVariant;
 
     column = mTableCtx.columns.id;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toLongLong());
 
     column = mTableCtx.columns.portName;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toString());
 
     column = mTableCtx.columns.baudRate;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toInt());
 
     column = mTableCtx.columns.dataBits;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toInt());
 
     column = mTableCtx.columns.parity;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toInt());
 
     column = mTableCtx.columns.stopBits;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toInt());
 
     column = mTableCtx.columns.flowControl;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toInt());
 
     column = mTableCtx.columns.frameIntervel;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toInt());
 
     return jsonObj;
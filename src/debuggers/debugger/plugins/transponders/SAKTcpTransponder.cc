@@ -15,7 +15,7 @@
 SAKTcpTransponder::SAKTcpTransponder(QWidget *parent)
     :SAKDebuggerPluginTransponder(parent)
     ,mUi(new Ui::SAKTcpTransponder)
-    ,mDevice(new SAKTcpClientDevice(Q_NULLPTR, QString(), Q_NULLPTR, Q_NULLPTR))
+    ,mDevice(new SAKTcpClientDevice(Q_NULLPTR, QString(), Q_NULLPTR))
 {
     mUi->setupUi(this);
     setupDevice();
@@ -27,7 +27,7 @@ SAKTcpTransponder::SAKTcpTransponder(quint64 id,
                                      QWidget *parent)
     :SAKDebuggerPluginTransponder(id, parent)
     ,mUi(new Ui::SAKTcpTransponder)
-    ,mDevice(new SAKTcpClientDevice(Q_NULLPTR, QString(), Q_NULLPTR, Q_NULLPTR))
+    ,mDevice(new SAKTcpClientDevice(Q_NULLPTR, QString(), Q_NULLPTR))
 {
     mUi->setupUi(this);
     mUi->serverHostLineEdit->setText(parasCtx.serverHost);
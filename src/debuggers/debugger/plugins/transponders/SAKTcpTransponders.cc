@@ -33,29 +33,6 @@ QString SAKTcpTransponders::sqlCreate(const QString &tableName)
     return sqlString;
 }
 
-QString SAKTcpTransponders::sqlInsert(const QString &tableName, QWidget *itemWidget)
-{
-    auto cookedItemWidget
-            = qobject_cast<SAKTcpTransponder*>(itemWidget);
-    if (!cookedItemWidget) {
-        return QString();
-    }
-
-    auto itemCtx = cookedItemWidget->parametersContext()
-            .value<SAKTcpClientParametersContext>();
-    auto tableCtx = mTableCtx;
-    QString queryString = QString("INSERT INTO %1(").arg(tableName);
-    queryString.append(tableCtx.columns.id).append(",");
-    queryString.append(tableCtx.columns.serverHost).append(",");
-    queryString.append(tableCtx.columns.serverPort).append(")");
-    queryString.append(" VALUES(");
-    queryString.append(QString("%1,").arg(cookedItemWidget->id()));
-    queryString.append(QString("'%1',").arg(itemCtx.serverHost));
-    queryString.append(QString("%1)").arg(itemCtx.serverPort));
-
-    return queryString;
-}
-
 QJsonObject SAKTcpTransponders::toJsonObject(QWidget *itemWidget)
 {
     QJsonObject jsonObj;
@@ -73,22 +50,22 @@ QJsonObject SAKTcpTransponders::toJsonObject(QWidget *itemWidget)
     return jsonObj;
 }
 
-QJsonObject SAKTcpTransponders::toJsonObject(const QSqlQuery &sqlQuery)
+QJsonObject SAKTcpTransponders::toJsonObject(const QVariantMap &record)
 {
     QJsonObject jsonObj;
     QString column;
     QVariant valueVariant;
 
     column = mTableCtx.columns.id;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toLongLong());
 
     column = mTableCtx.columns.serverHost;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toString());
 
     column = mTableCtx.columns.serverPort;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toInt());
 
     return jsonObj;
@@ -127,7 +104,7 @@ void SAKTcpTransponders::connectSignalsToSlots(QWidget *itemWidget)
             auto parasCtx = cookedItemWidget->parametersContext()
                     .value<SAKTcpClientParametersContext>();
             updateRecord(id, mTableCtx.columns.serverHost, parasCtx.serverHost);
-            updateRecord(id, mTableCtx.columns.serverPort, parasCtx.serverHost);
+            updateRecord(id, mTableCtx.columns.serverPort, parasCtx.serverPort);
         });
     }
 }
@@ -15,7 +15,7 @@
 SAKUdpTransponder::SAKUdpTransponder(QWidget *parent)
     :SAKDebuggerPluginTransponder(parent)
     ,mUi(new Ui::SAKUdpTransponder)
-    ,mDevice(new SAKUdpClientDevice(Q_NULLPTR, QString(), Q_NULLPTR, Q_NULLPTR))
+    ,mDevice(new SAKUdpClientDevice(Q_NULLPTR, QString(), Q_NULLPTR))
 {
     mUi->setupUi(this);
     setupDevice();
@@ -27,7 +27,7 @@ SAKUdpTransponder::SAKUdpTransponder(quint64 id,
                                      QWidget *parent)
     :SAKDebuggerPluginTransponder(id, parent)
     ,mUi(new Ui::SAKUdpTransponder)
-    ,mDevice(new SAKUdpClientDevice(Q_NULLPTR, QString(), Q_NULLPTR, Q_NULLPTR))
+    ,mDevice(new SAKUdpClientDevice(Q_NULLPTR, QString(), Q_NULLPTR))
 {
     mUi->setupUi(this);
     mUi->peerHostLineEdit->setText(parasCtx.peerHost);
@@ -53,6 +53,7 @@ QVariant SAKUdpTransponder::parametersContext()
     ctx.peerPort = mUi->peerPortLineEdit->text().trimmed().toInt();
     ctx.localHost.clear();
     ctx.localPort = 0;
+    ctx.broadcast = false;
 
     return QVariant::fromValue(ctx);
 }
@@ -34,29 +34,6 @@ QString SAKUdpTransponders::sqlCreate(const QString &tableName)
     return sqlString;
 }
 
-QString SAKUdpTransponders::sqlInsert(const QString &tableName, QWidget *itemWidget)
-{
-    auto cookedItemWidget
-            = qobject_cast<SAKUdpTransponder*>(itemWidget);
-    if (!cookedItemWidget) {
-        return QString();
-    }
-
-    auto itemCtx = cookedItemWidget->parametersContext()
-            .value<SAKUdpClientParametersContext>();
-    auto tableCtx = mTableCtx;
-    QString queryString = QString("INSERT INTO %1(").arg(tableName);
-    queryString.append(tableCtx.columns.id).append(",");
-    queryString.append(tableCtx.columns.peerHost).append(",");
-    queryString.append(tableCtx.columns.peerPort).append(")");
-    queryString.append(" VALUES(");
-    queryString.append(QString("%1,").arg(cookedItemWidget->id()));
-    queryString.append(QString("'%1',").arg(itemCtx.peerHost));
-    queryString.append(QString("%1)").arg(itemCtx.peerPort));
-
-    return queryString;
-}
-
 QJsonObject SAKUdpTransponders::toJsonObject(QWidget *itemWidget)
 {
     QJsonObject jsonObj;
@@ -68,28 +45,28 @@ QJsonObject SAKUdpTransponders::toJsonObject(QWidget *itemWidget)
         auto parasCtx = cookedItemWidget->parametersContext()
                 .value<SAKUdpClientParametersContext>();
         jsonObj.insert(mTableCtx.columns.id, qint64(cookedItemWidget->id()));
-        jsonObj.insert(mTableCtx.columns.peerHost, parasCtx.peerPort);
+        jsonObj.insert(mTableCtx.columns.peerHost, parasCtx.peerHost);
         jsonObj.insert(mTableCtx.columns.peerPort, parasCtx.peerPort);
     }
     return jsonObj;
 }
 
-QJsonObject SAKUdpTransponders::toJsonObject(const QSqlQuery &sqlQuery)
+QJsonObject SAKUdpTransponders::toJsonObject(const QVariantMap &record)
 {
     QJsonObject jsonObj;
     QString column;
     QVariant valueVariant;
 
     column = mTableCtx.columns.id;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toLongLong());
 
     column = mTableCtx.columns.peerHost;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toString());
 
     column = mTableCtx.columns.peerPort;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toInt());
 
     return jsonObj;
@@ -14,7 +14,7 @@
 SAKWebSocketTransponder::SAKWebSocketTransponder(QWidget *parent)
     :SAKDebuggerPluginTransponder(parent)
     ,mUi(new Ui::SAKWebSocketTransponder)
-    ,mDevice(new SAKWebSocketClientDevice(Q_NULLPTR, QString(), Q_NULLPTR, Q_NULLPTR))
+    ,mDevice(new SAKWebSocketClientDevice(Q_NULLPTR, QString(), Q_NULLPTR))
 {
     mUi->setupUi(this);
     SAKCommonDataStructure::setComboBoxTextWebSocketSendingType(mUi->sendingTypeComboBox);
@@ -27,7 +27,7 @@ SAKWebSocketTransponder::SAKWebSocketTransponder(quint64 id,
                                                  QWidget *parent)
     :SAKDebuggerPluginTransponder(id, parent)
     ,mUi(new Ui::SAKWebSocketTransponder)
-    ,mDevice(new SAKWebSocketClientDevice(Q_NULLPTR, QString(), Q_NULLPTR, Q_NULLPTR))
+    ,mDevice(new SAKWebSocketClientDevice(Q_NULLPTR, QString(), Q_NULLPTR))
 {
     mUi->setupUi(this);
     SAKCommonDataStructure::setComboBoxTextWebSocketSendingType(mUi->sendingTypeComboBox);
@@ -33,29 +33,6 @@ QString SAKWebSocketTransponders::sqlCreate(const QString &tableName)
     return sqlString;
 }
 
-QString SAKWebSocketTransponders::sqlInsert(const QString &tableName, QWidget *itemWidget)
-{
-    auto cookedItemWidget
-            = qobject_cast<SAKWebSocketTransponder*>(itemWidget);
-    if (!cookedItemWidget) {
-        return QString();
-    }
-
-    auto itemCtx = cookedItemWidget->parametersContext()
-            .value<SAKWSClientParametersContext>();
-    auto tableCtx = mTableCtx;
-    QString queryString = QString("INSERT INTO %1(").arg(tableName);
-    queryString.append(tableCtx.columns.id).append(",");
-    queryString.append(tableCtx.columns.serverAddress).append(",");
-    queryString.append(tableCtx.columns.sendingType).append(")");
-    queryString.append(" VALUES(");
-    queryString.append(QString("%1,").arg(cookedItemWidget->id()));
-    queryString.append(QString("'%1',").arg(itemCtx.serverAddress));
-    queryString.append(QString("%1)").arg(itemCtx.sendingType));
-
-    return queryString;
-}
-
 QJsonObject SAKWebSocketTransponders::toJsonObject(QWidget *itemWidget)
 {
     QJsonObject jsonObj;
@@ -73,22 +50,22 @@ QJsonObject SAKWebSocketTransponders::toJsonObject(QWidget *itemWidget)
     return jsonObj;
 }
 
-QJsonObject SAKWebSocketTransponders::toJsonObject(const QSqlQuery &sqlQuery)
+QJsonObject SAKWebSocketTransponders::toJsonObject(const QVariantMap &record)
 {
     QJsonObject jsonObj;
     QString column;
     QVariant valueVariant;
 
     column = mTableCtx.columns.id;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toLongLong());
 
     column = mTableCtx.columns.serverAddress;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toString());
 
     column = mTableCtx.columns.sendingType;
-    valueVariant = sqlQuery.value(column);
+    valueVariant = record.value(column);
     jsonObj.insert(column, valueVariant.toInt());
 
     return jsonObj;
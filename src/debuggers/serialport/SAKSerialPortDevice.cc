@@ -11,11 +11,9 @@
 #include <QElapsedTimer>
 
 #include "SAKSerialPortDevice.hh"
-#include "SAKSerialPortDebugger.hh"
-#include "SAKSerialPortController.hh"
 
-SAKSerialPortDevice::SAKSerialPortDevice(QSettings *settings, const QString &settingsGroup, QWidget *uiParent, QObject *parent)
-    :SAKDebuggerDevice(settings, settingsGroup, uiParent, parent)
+SAKSerialPortDevice::SAKSerialPortDevice(QSettings *settings, const QString &settingsGroup, QObject *parent)
+    :SAKDebuggerDevice(settings, settingsGroup, parent)
     ,mSerialPort(Q_NULLPTR)
 {
 
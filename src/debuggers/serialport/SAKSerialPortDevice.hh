@@ -17,15 +17,12 @@
 #include "SAKDebuggerDevice.hh"
 #include "SAKCommonDataStructure.hh"
 
-class SAKSerialPortDebugger;
-class SAKSerialPortController;
 class SAKSerialPortDevice : public SAKDebuggerDevice
 {
     Q_OBJECT
 public:
     SAKSerialPortDevice(QSettings *settings,
                         const QString &settingsGroup,
-                        QWidget *uiParent,
                         QObject *parent = Q_NULLPTR);
 protected:
     bool initialize() final;
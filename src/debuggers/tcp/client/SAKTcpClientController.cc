@@ -33,6 +33,7 @@ SAKTcpClientController::SAKTcpClientController(QSettings *settings,
     mClientInfoLineEdit = mUi->clientInfoLineEdit;
     mServerHostLineEdit = mUi->serverHostLineEdit;
     mServerPortLineEdit = mUi->serverPortLineEdit;
+    mConnectionLabel = mUi->connectionLabel;
     refreshDevice();
 
     // Read in settings data.
@@ -95,6 +96,7 @@ void SAKTcpClientController::updateUiState(bool opened)
     mLocalhostComboBox->setEnabled(!opened);
     mLocalPortlineEdit->setEnabled(!opened);
     mSpecifyClientAddressAndPort->setEnabled(!opened);
+    mAutomaticConnectionCheckBox->setEnabled(!opened);
     mServerHostLineEdit->setEnabled(!opened);
     mServerPortLineEdit->setEnabled(!opened);
 }
@@ -111,6 +113,7 @@ QVariant SAKTcpClientController::parametersContext()
     parameters.localHost = mLocalhostComboBox->currentText();
     parameters.localPort = mLocalPortlineEdit->text().toInt();
     parameters.specifyClientAddressAndPort = mSpecifyClientAddressAndPort->isChecked();
+    parameters.allowAutomaticConnection = mAutomaticConnectionCheckBox->isChecked();
     parameters.serverHost = mServerHostLineEdit->text();
     parameters.serverPort = mServerPortLineEdit->text().toInt();
     mParametersMutex.unlock();
@@ -121,3 +124,26 @@ void SAKTcpClientController::onServerInfoChanged(QString info)
 {
     mClientInfoLineEdit->setText(info);
 }
+
+void SAKTcpClientController::onConnectionMetricsChanged(bool connected,
+                                                        qint64 connectLatency,
+                                                        qint64 downtime,
+                                                        int reconnections,
+                                                        int timeouts)
+{
+    QString info;
+    if (connected) {
+        info = tr("Connected, latency: %1ms").arg(connectLatency/1000.0, 0, 'f', 3);
+    } else {
+        info = tr("Reconnecting");
+    }
+
+    if (downtime > 0) {
+        info += tr(", downtime: %1ms").arg(downtime);
+    }
+    info += tr(", reconnections: %1").arg(reconnections);
+    if (timeouts > 0) {
+        info += tr(", timeouts: %1").arg(timeouts);
+    }
+    mConnectionLabel->setText(info);
+}
@@ -11,6 +11,7 @@
 #define SAKTCPCLIENTCONTROLLER_HH
 
 #include <QMutex>
+#include <QLabel>
 #include <QWidget>
 #include <QCheckBox>
 #include <QComboBox>
@@ -35,6 +36,11 @@ public:
     void refreshDevice() final;
     QVariant parametersContext() final;
     void onServerInfoChanged(QString info);
+    void onConnectionMetricsChanged(bool connected,
+                                    qint64 connectLatency,
+                                    qint64 downtime,
+                                    int reconnections,
+                                    int timeouts);
 private:
     QMutex mParametersMutex;
 private:
@@ -46,5 +52,6 @@ private:
     QLineEdit *mClientInfoLineEdit;
     QLineEdit *mServerHostLineEdit;
     QLineEdit *mServerPortLineEdit;
+    QLabel *mConnectionLabel;
 };
 #endif
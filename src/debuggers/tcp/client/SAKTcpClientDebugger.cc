@@ -23,11 +23,13 @@ SAKTcpClientDebugger::SAKTcpClientDebugger(QSettings *settings,
     :SAKDebugger(settings, settingsGroup, sqlDatabase, parent)
 {
     mController = new SAKTcpClientController(settings, settingsGroup, parent);
-    mDevice = new  SAKTcpClientDevice(settings, settingsGroup, this, this);
+    mDevice = new  SAKTcpClientDevice(settings, settingsGroup, this);
     initDebugger();
 
     connect(mDevice, &SAKTcpClientDevice::serverInfoChanged,
             mController, &SAKTcpClientController::onServerInfoChanged);
+    connect(mDevice, &SAKTcpClientDevice::connectionMetricsChanged,
+            mController, &SAKTcpClientController::onConnectionMetricsChanged);
 }
 
 SAKDebuggerDevice* SAKTcpClientDebugger::device()
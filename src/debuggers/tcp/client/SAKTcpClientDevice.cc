@@ -10,35 +10,35 @@
 #include <QDebug>
 #include <QTimer>
 #include <QHostAddress>
-#include <QApplication>
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+#include <QRandomGenerator>
+#endif
 
 #include "SAKTcpClientDevice.hh"
-#include "SAKTcpClientDebugger.hh"
-#include "SAKTcpClientController.hh"
 #include "SAKCommonDataStructure.hh"
+#include "SAKDebuggerDeviceSocketOptionsKernel.hh"
+
+// The backoff of reconnecting starts from 50ms, it is doubled after every
+// failure and not more than 5s.
+#define SAK_TCP_CLIENT_MIN_BACKOFF 50
+#define SAK_TCP_CLIENT_MAX_BACKOFF 5000
+// A connecting attempt is aborted if the connection is not made in time, such
+// as the SYN is dropped silently.
+#define SAK_TCP_CLIENT_CONNECT_TIMEOUT 3000
+// Bytes written during reconnecting, the oldest bytes will be discarded if the
+// queue is full.
+#define SAK_TCP_CLIENT_MAX_PENDING_LENGTH (1024*1024)
 
 SAKTcpClientDevice::SAKTcpClientDevice(QSettings *settings,
                                        const QString &settingsGroup,
-                                       QWidget *uiParent,
                                        QObject *parent)
-    :SAKDebuggerDevice(settings, settingsGroup, uiParent, parent)
+    :SAKDebuggerDevice(settings, settingsGroup, parent)
+    ,mAllowAutomaticConnection(false)
+    ,mTcpSocket(Q_NULLPTR)
+    ,mReconnectionTimer(Q_NULLPTR)
+    ,mConnectTimeoutTimer(Q_NULLPTR)
 {
-    // Reconnection
-    connect(this, &SAKTcpClientDevice::finished, this, [&](){
-        auto parameters = parametersContext()
-                .value<SAKTcpClientParametersContext>();
-        if (parameters.allowAutomaticConnection){
-            QTimer *timer = new QTimer(this);
-            timer->setInterval(2000);
-            timer->setSingleShot(true);
-            connect(timer, &QTimer::timeout, this, [=](){
-                auto ret = qobject_cast<QTimer*>(sender());
-                delete ret;
-                start();
-            });
-            timer->start();
-        }
-    });
+
 }
 
 bool SAKTcpClientDevice::initialize()
@@ -50,18 +50,126 @@ bool SAKTcpClientDevice::initialize()
     mServerHost = parameters.serverHost;
     mServerPort = parameters.serverPort;
     mSpecifyClientAddressAndPort = parameters.specifyClientAddressAndPort;
+    mAllowAutomaticConnection = parameters.allowAutomaticConnection;
 
+    mConnectionCtx.connected = false;
+    mConnectionCtx.everConnected = false;
+    mConnectionCtx.backoff = SAK_TCP_CLIENT_MIN_BACKOFF;
+    mConnectionCtx.reconnections = 0;
+    mConnectionCtx.timeouts = 0;
+    mConnectionCtx.downtimeClock.invalidate();
+    mConnectionCtx.pendingBytes.clear();
+    mConnectionCtx.pendingLength = 0;
+
+    // The objects are created in the device thread, all of the signals are
+    // handled in the device thread too.
     mTcpSocket = new QTcpSocket;
+    mReconnectionTimer = new QTimer;
+    mReconnectionTimer->setSingleShot(true);
+    connect(mReconnectionTimer, &QTimer::timeout, this, [=](){
+        connectToServer();
+    }, Qt::DirectConnection);
+    mConnectTimeoutTimer = new QTimer;
+    mConnectTimeoutTimer->setSingleShot(true);
+    mConnectTimeoutTimer->setInterval(SAK_TCP_CLIENT_CONNECT_TIMEOUT);
+    connect(mConnectTimeoutTimer, &QTimer::timeout, this, [=](){
+        onConnectTimeout();
+    }, Qt::DirectConnection);
+    connect(mTcpSocket, &QTcpSocket::readyRead, this, [=](){
+        emit readyRead(SAKDeviceProtectedSignal());
+    }, Qt::DirectConnection);
+    connect(mTcpSocket, &QTcpSocket::connected, this, [=](){
+        onConnected();
+    }, Qt::DirectConnection);
+    connect(mTcpSocket, &QTcpSocket::stateChanged,
+            this, [=](QAbstractSocket::SocketState state){
+        if (state == QAbstractSocket::UnconnectedState) {
+            onConnectionLost(mTcpSocket->errorString());
+        }
+    }, Qt::DirectConnection);
+
+    // If the automatic connection is allowed, the failure will be handled by
+    // reconnecting.
+    return connectToServer() || mAllowAutomaticConnection;
+}
+
+QByteArray SAKTcpClientDevice::read()
+{
+    return mTcpSocket->readAll();
+}
+
+QByteArray SAKTcpClientDevice::write(const QByteArray &bytes)
+{
+    if (!mConnectionCtx.connected) {
+        queuePendingBytes(bytes);
+        return QByteArray();
+    }
+
+    qint64 ret = mTcpSocket->write(bytes);
+    if (ret > 0){
+        return bytes;
+    }else{
+        return QByteArray();
+    }
+}
+
+void SAKTcpClientDevice::uninitialize()
+{
+    if (mReconnectionTimer) {
+        mReconnectionTimer->stop();
+        delete mReconnectionTimer;
+        mReconnectionTimer = Q_NULLPTR;
+    }
+
+    if (mConnectTimeoutTimer) {
+        mConnectTimeoutTimer->stop();
+        delete mConnectTimeoutTimer;
+        mConnectTimeoutTimer = Q_NULLPTR;
+    }
+
+    if (mTcpSocket) {
+        // Do not reconnect while closing.
+        mTcpSocket->disconnect(this);
+        if (mTcpSocket->state() == QTcpSocket::ConnectedState){
+            mTcpSocket->disconnectFromHost();
+        }
+
+        mTcpSocket->close();
+        delete mTcpSocket;
+        mTcpSocket = Q_NULLPTR;
+    }
+
+    mConnectionCtx.pendingBytes.clear();
+    mConnectionCtx.pendingLength = 0;
+    emit serverInfoChanged(QString());
+}
+
+bool SAKTcpClientDevice::socketOptionsSupported()
+{
+    return true;
+}
+
+bool SAKTcpClientDevice::connectToServer()
+{
+    // The socket must be unconnected before binding, the state change caused
+    // by aborting should not be treated as a lost connection.
+    mTcpSocket->blockSignals(true);
+    mTcpSocket->abort();
+    mTcpSocket->blockSignals(false);
+
     bool bindResult = false;
     if (mSpecifyClientAddressAndPort){
-        bindResult = mTcpSocket->bind(QHostAddress(mLocalHost), mLocalPort);
+        // The local port may be in TIME_WAIT state after reconnecting.
+        bindResult = mTcpSocket->bind(QHostAddress(mLocalHost),
+                                      mLocalPort,
+                                      QAbstractSocket::ReuseAddressHint);
     }else{
         bindResult = mTcpSocket->bind();
     }
 
     if (!bindResult){
         QString errorString = tr("Binding failed:") + mTcpSocket->errorString();
-        emit errorOccurred(errorString);
+        onConnectionLost(errorString);
         return false;
     }else{
         QString info = mTcpSocket->localAddress().toString();
@@ -70,52 +178,118 @@ bool SAKTcpClientDevice::initialize()
         emit serverInfoChanged(info);
     }
 
+    // The buffer sizes should be set before connecting, the tcp window scale
+    // is negotiated while connecting.
+    SAKDebuggerDeviceSocketOptionsKernel::apply(mTcpSocket,
+                                                parameters()->socketOptionsContext());
+
+    // The result will be reported by connected() or stateChanged() signal.
+    mConnectionCtx.connectingClock.start();
+    mConnectTimeoutTimer->start();
     mTcpSocket->connectToHost(mServerHost, mServerPort);
-    if (mTcpSocket->state() != QTcpSocket::ConnectedState){
-        if (!mTcpSocket->waitForConnected()){
-            QString errorString = tr("Connect to server failed:")
-                    + mTcpSocket->errorString();
-            emit errorOccurred(errorString);
-            return false;
-        }
+    return true;
+}
+
+void SAKTcpClientDevice::onConnected()
+{
+    mConnectTimeoutTimer->stop();
+    qint64 latency = mConnectionCtx.connectingClock.nsecsElapsed()/1000;
+    qint64 downtime = 0;
+    if (mConnectionCtx.downtimeClock.isValid()) {
+        downtime = mConnectionCtx.downtimeClock.elapsed();
+        mConnectionCtx.downtimeClock.invalidate();
     }
 
-    if (mTcpSocket->open(QTcpSocket::ReadWrite)){
-        connect(mTcpSocket, &QTcpSocket::readyRead, this, [=](){
-            emit readyRead(SAKDeviceProtectedSignal());
-        });
-    }else{
-        QString errorString = tr("Can not open device:") + mTcpSocket->errorString();
-        emit errorOccurred(errorString);
-        return false;
+    if (mConnectionCtx.everConnected) {
+        mConnectionCtx.reconnections += 1;
     }
+    mConnectionCtx.connected = true;
+    mConnectionCtx.everConnected = true;
+    mConnectionCtx.backoff = SAK_TCP_CLIENT_MIN_BACKOFF;
 
-    return true;
+    // The socket engine may be recreated while connecting, apply the options
+    // again.
+    QString diagnostics = SAKDebuggerDeviceSocketOptionsKernel::apply(
+                mTcpSocket, parameters()->socketOptionsContext());
+    parameters()->setSocketOptionsDiagnostics(diagnostics);
+
+    // The bytes have been masked, write them directly.
+    QVector<QByteArray> pendingBytes = mConnectionCtx.pendingBytes;
+    mConnectionCtx.pendingBytes.clear();
+    mConnectionCtx.pendingLength = 0;
+    for (auto &bytes : pendingBytes) {
+        QByteArray ret = write(bytes);
+        if (ret.length()) {
+            emit bytesWritten(ret);
+        }
+    }
+
+    emit connectionMetricsChanged(true, latency, downtime,
+                                  mConnectionCtx.reconnections,
+                                  mConnectionCtx.timeouts);
 }
 
-QByteArray SAKTcpClientDevice::read()
+void SAKTcpClientDevice::onConnectionLost(const QString &reason)
 {
-    return mTcpSocket->readAll();
+    mConnectTimeoutTimer->stop();
+    bool wasConnected = mConnectionCtx.connected;
+    mConnectionCtx.connected = false;
+    if (!mAllowAutomaticConnection) {
+        QString errorString = wasConnected
+                ? tr("Connection lost:") + reason
+                : tr("Connect to server failed:") + reason;
+        emit errorOccurred(errorString);
+        exit();
+        return;
+    }
+
+    if (wasConnected) {
+        mConnectionCtx.downtimeClock.start();
+    }
+
+    if (mReconnectionTimer->isActive()) {
+        return;
+    }
+
+    // Half of the backoff is fixed, the other half is random, so that clients
+    // disconnected at the same time will not reconnect at the same time.
+    int backoff = mConnectionCtx.backoff;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    int jitter = QRandomGenerator::global()->bounded(backoff/2 + 1);
+#else
+    int jitter = qrand() % (backoff/2 + 1);
+#endif
+    mReconnectionTimer->start(backoff/2 + jitter);
+    mConnectionCtx.backoff = qMin(backoff*2, SAK_TCP_CLIENT_MAX_BACKOFF);
+
+    qint64 downtime = mConnectionCtx.downtimeClock.isValid()
+            ? mConnectionCtx.downtimeClock.elapsed() : 0;
+    emit connectionMetricsChanged(false, 0, downtime,
+                                  mConnectionCtx.reconnections,
+                                  mConnectionCtx.timeouts);
 }
 
-QByteArray SAKTcpClientDevice::write(const QByteArray &bytes)
+void SAKTcpClientDevice::onConnectTimeout()
 {
-    qint64 ret = mTcpSocket->write(bytes);
-    if (ret > 0){
-        return bytes;
-    }else{
-        return QByteArray();
-    }
+    // The state change caused by aborting is not reported, the timeout is
+    // reported instead.
+    mTcpSocket->blockSignals(true);
+    mTcpSocket->abort();
+    mTcpSocket->blockSignals(false);
+
+    mConnectionCtx.timeouts += 1;
+    onConnectionLost(tr("Connection timed out(%1ms)")
+                     .arg(SAK_TCP_CLIENT_CONNECT_TIMEOUT));
 }
 
-void SAKTcpClientDevice::uninitialize()
+void SAKTcpClientDevice::queuePendingBytes(const QByteArray &bytes)
 {
-    if (mTcpSocket->state() == QTcpSocket::ConnectedState){
-        mTcpSocket->disconnectFromHost();
+    mConnectionCtx.pendingBytes.append(bytes);
+    mConnectionCtx.pendingLength += bytes.length();
+    while ((mConnectionCtx.pendingLength > SAK_TCP_CLIENT_MAX_PENDING_LENGTH)
+           && (mConnectionCtx.pendingBytes.length() > 1)) {
+        mConnectionCtx.pendingLength -=
+                mConnectionCtx.pendingBytes.first().length();
+        mConnectionCtx.pendingBytes.removeFirst();
     }
-
-    mTcpSocket->close();
-    emit serverInfoChanged(QString());
-    delete mTcpSocket;
-    mTcpSocket = Q_NULLPTR;
 }
@@ -10,33 +10,76 @@
 #ifndef SAKTCPCLIENTDEVICE_HH
 #define SAKTCPCLIENTDEVICE_HH
 
+#include <QTimer>
 #include <QThread>
 #include <QTcpSocket>
+#include <QVector>
+#include <QElapsedTimer>
 
 #include "SAKDebuggerDevice.hh"
 
+/// @brief Tcp client device, the connection is made asynchronously. If the
+/// automatic connection is allowed, the device reconnects in the device thread
+/// with a jittered exponential backoff, the bytes written during reconnecting
+/// are queued and sent when the connection is made again.
 class SAKTcpClientDevice:public SAKDebuggerDevice
 {
     Q_OBJECT
 public:
     SAKTcpClientDevice(QSettings *settings,
                        const QString &settingsGroup,
-                       QWidget *uiParent = Q_NULLPTR,
                        QObject *parent = Q_NULLPTR);
 protected:
     bool initialize() final;
     QByteArray read() final;
     QByteArray write(const QByteArray &bytes) final;
     void uninitialize() final;
+    bool socketOptionsSupported() final;
 private:
     QString mLocalHost;
     quint16 mLocalPort;
     bool mSpecifyClientAddressAndPort;
     QString mServerHost;
     quint16 mServerPort;
+    bool mAllowAutomaticConnection;
     QTcpSocket *mTcpSocket;
+
+    // Accessed in the device thread only
+    struct SAKStructConnectionContext {
+        bool connected;
+        bool everConnected;
+        int backoff;            // Unit is millisecond
+        int reconnections;
+        int timeouts;           // Connecting attempts that timed out
+        QElapsedTimer connectingClock;
+        QElapsedTimer downtimeClock;
+        QVector<QByteArray> pendingBytes;
+        int pendingLength;
+    }mConnectionCtx;
+    QTimer *mReconnectionTimer;
+    QTimer *mConnectTimeoutTimer;
+private:
+    bool connectToServer();
+    void onConnected();
+    void onConnectionLost(const QString &reason);
+    void onConnectTimeout();
+    void queuePendingBytes(const QByteArray &bytes);
 signals:
     void serverInfoChanged(QString info);
+    /**
+     * @brief connectionMetricsChanged: The connection is made or lost.
+     * @param connected: true means the connection is made.
+     * @param connectLatency: From connecting to connected, unit is microsecond.
+     * @param downtime: From the connection is lost to it is made again, unit
+     * is millisecond.
+     * @param reconnections: Times of reconnecting successfully.
+     * @param timeouts: Times of connecting attempts that timed out.
+     */
+    void connectionMetricsChanged(bool connected,
+                                  qint64 connectLatency,
+                                  qint64 downtime,
+                                  int reconnections,
+                                  int timeouts);
 };
 
 #endif
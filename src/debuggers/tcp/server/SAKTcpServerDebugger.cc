@@ -18,7 +18,7 @@ SAKTcpServerDebugger::SAKTcpServerDebugger(QSettings *settings,
     :SAKDebugger(settings, settingsGroup, sqlDatabase, parent)
 {
     mController = new SAKTcpServerController(settings, settingsGroup, parent);
-    mDevice = new SAKTcpServerDevice(settings, settingsGroup, this, parent);
+    mDevice = new SAKTcpServerDevice(settings, settingsGroup, parent);
     initDebugger();
 
     connect(mDevice, &SAKTcpServerDevice::addClient,
@@ -10,19 +10,15 @@
 #include <QDebug>
 #include <QEventLoop>
 #include <QHostAddress>
-#include <QApplication>
 
-#include "SAKDebugger.hh"
 #include "SAKTcpServerDevice.hh"
-#include "SAKTcpServerDebugger.hh"
-#include "SAKTcpServerController.hh"
 #include "SAKCommonDataStructure.hh"
+#include "SAKDebuggerDeviceSocketOptionsKernel.hh"
 
 SAKTcpServerDevice::SAKTcpServerDevice(QSettings *settings,
                                        const QString &settingsGroup,
-                                       QWidget *uiParent,
                                        QObject *parent)
-    :SAKDebuggerDevice(settings, settingsGroup, uiParent, parent)
+    :SAKDebuggerDevice(settings, settingsGroup, parent)
     ,mTcpServer(Q_NULLPTR)
 {
 
@@ -36,9 +32,21 @@ bool SAKTcpServerDevice::initialize()
 
     mTcpServer = new QTcpServer;
     if (mTcpServer->listen(QHostAddress(serverHost), serverPort)){
+        // The buffer sizes are inherited by the accepted sockets, the receive
+        // buffer size must be set before the handshake(tcp window scale).
+        if (!SAKDebuggerDeviceSocketOptionsKernel::applyToListener(
+                    mTcpServer->socketDescriptor(),
+                    SAKDebuggerDevice::parameters()->socketOptionsContext())) {
+            qWarning() << "Can not set the buffer sizes of the server socket";
+        }
+
         connect(mTcpServer, &QTcpServer::newConnection, this, [=](){
             QTcpSocket *socket = mTcpServer->nextPendingConnection();
             if (socket){
+                // The diagnostics show the values of the latest client.
+                QString diagnostics = SAKDebuggerDeviceSocketOptionsKernel::apply(
+                            socket, SAKDebuggerDevice::parameters()->socketOptionsContext());
+                SAKDebuggerDevice::parameters()->setSocketOptionsDiagnostics(diagnostics);
                 emit addClient(socket->peerAddress().toString(), socket->peerPort(), socket);
                 mClientList.append(socket);
             }
@@ -111,3 +119,8 @@ void SAKTcpServerDevice::uninitialize()
     delete mTcpServer;
     mTcpServer = Q_NULLPTR;
 }
+
+bool SAKTcpServerDevice::socketOptionsSupported()
+{
+    return true;
+}
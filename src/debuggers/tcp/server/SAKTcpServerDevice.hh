@@ -23,13 +23,13 @@ class SAKTcpServerDevice:public SAKDebuggerDevice
 public:
     SAKTcpServerDevice(QSettings *settings,
                        const QString &settingsGroup,
-                       QWidget *uiParent = Q_NULLPTR,
                        QObject *parent = Q_NULLPTR);
 protected:
     bool initialize() final;
     QByteArray read() final;
     QByteArray write(const QByteArray &bytes) final;
     void uninitialize() final;
+    bool socketOptionsSupported() final;
 private:
     QTcpServer *mTcpServer;
     QList<QTcpSocket*> mClientList;
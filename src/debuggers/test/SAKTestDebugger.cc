@@ -23,7 +23,7 @@ SAKTestDebugger::SAKTestDebugger(QSettings *settings,
     ,mController(Q_NULLPTR)
 {
     mController = new SAKTestDebuggerController(settings, settingsGroup);
-    mDevice = new SAKTestDebuggerDevice(settings, settingsGroup, this, this);
+    mDevice = new SAKTestDebuggerDevice(settings, settingsGroup, this);
     initDebugger();
 
     connect(mController, &SAKTestDebuggerController::readCircularlyChanged,
@@ -9,18 +9,15 @@
  ***************************************************************************************/
 #include <QDebug>
 #include <QEventLoop>
-#include <QApplication>
+#include <QTimerEvent>
 
-#include "SAKTestDebugger.hh"
 #include "SAKTestDebuggerDevice.hh"
 #include "SAKCommonDataStructure.hh"
-#include "SAKTestDebuggerController.hh"
 
 SAKTestDebuggerDevice::SAKTestDebuggerDevice(QSettings *settings,
                                              const QString &settingsGroup,
-                                             QWidget *uiParent,
                                              QObject *parent)
-    :SAKDebuggerDevice(settings, settingsGroup, uiParent, parent)
+    :SAKDebuggerDevice(settings, settingsGroup, parent)
     ,mReadDataTimerId(-1)
     ,mWriteDateTimerId(-1)
 {
@@ -11,7 +11,6 @@
 #define SAKTESTDEBUGGERDEVICE_HH
 #include <QMutex>
 #include "SAKDebuggerDevice.hh"
-#include "SAKTestDebuggerController.hh"
 
 
 class SAKTestDebuggerDevice : public SAKDebuggerDevice
@@ -20,7 +19,6 @@ class SAKTestDebuggerDevice : public SAKDebuggerDevice
 public:
     SAKTestDebuggerDevice(QSettings *settings,
                           const QString &settingsGroup,
-                          QWidget *uiParent = Q_NULLPTR,
                           QObject *parent = Q_NULLPTR);
     ~SAKTestDebuggerDevice();
 
@@ -4,6 +4,7 @@ qtHaveModule(network){
 }
 
 contains(DEFINES, SAK_IMPORT_MODULE_UDP){
+    include($$PWD/common/SAKUdpCommon.pri)
     include($$PWD/client/SAKUdpClient.pri)
     include($$PWD/server/SAKUdpServer.pri)
 }
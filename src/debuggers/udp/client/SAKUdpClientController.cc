@@ -14,6 +14,7 @@
 #include "SAKDebugger.hh"
 #include "SAKCommonInterface.hh"
 #include "SAKUdpClientDevice.hh"
+#include "SAKUdpSessionsDialog.hh"
 #include "SAKUdpClientController.hh"
 
 #include "ui_SAKUdpClientController.h"
@@ -23,6 +24,7 @@ SAKUdpClientController::SAKUdpClientController(QSettings *settings,
                                                QWidget *parent)
     :SAKDebuggerController(settings, settingsGroup, parent)
     ,mUi(new Ui::SAKUdpClientController)
+    ,mSessionsDialog(new SAKUdpSessionsDialog(this))
 {
     mUi->setupUi(this);
     refreshDevice();
@@ -35,6 +37,10 @@ SAKUdpClientController::SAKUdpClientController(QSettings *settings,
     microIni2LE(settings, settingsGroup, ctx.peerPort, mUi->targetPortLineEdit);
     microIni2ChB(settings, settingsGroup,
                  ctx.specifyLocalInfo, mUi->specifyClientAddressAndPort);
+    microIni2ChB(settings, settingsGroup, ctx.broadcast, mUi->broadcastCheckBox);
+    QString multicastGroupsKey = settingsGroup + QString("/multicastGroups");
+    mSessionsDialog->setMulticastGroups(
+                settings->value(multicastGroupsKey).toStringList());
 
 #if QT_VERSION >= QT_VERSION_CHECK(5,7,0)
     connect(mUi->localhostComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
@@ -71,6 +77,24 @@ SAKUdpClientController::SAKUdpClientController(QSettings *settings,
         emit parametersContextChanged();
         microLE2Ini(settings, settingsGroup, ctx.peerPort, mUi->targetPortLineEdit);
     });
+    connect(mUi->broadcastCheckBox, &QCheckBox::clicked,
+            this, [=](){
+        emit parametersContextChanged();
+        microChB2Ini(settings, settingsGroup, ctx.broadcast, mUi->broadcastCheckBox);
+    });
+    connect(mSessionsDialog, &SAKUdpSessionsDialog::multicastGroupsChanged,
+            this, [=](){
+        emit parametersContextChanged();
+        settings->setValue(multicastGroupsKey, mSessionsDialog->multicastGroups());
+    });
+    connect(mUi->sessionsPushButton, &QPushButton::clicked,
+            this, [=](){
+        if (mSessionsDialog->isHidden()) {
+            mSessionsDialog->show();
+        } else {
+            mSessionsDialog->activateWindow();
+        }
+    });
 }
 
 SAKUdpClientController::~SAKUdpClientController()
@@ -102,6 +126,8 @@ QVariant SAKUdpClientController::parametersContext()
     parasCtx.localHost = mUi->localhostComboBox->currentText();
     parasCtx.localPort = mUi->localPortlineEdit->text().trimmed().toInt();
     parasCtx.specifyLocalInfo = mUi->specifyClientAddressAndPort->isChecked();
+    parasCtx.broadcast = mUi->broadcastCheckBox->isChecked();
+    parasCtx.multicastGroups = mSessionsDialog->multicastGroups();
 
     return QVariant::fromValue(parasCtx);
 }
@@ -110,3 +136,14 @@ void SAKUdpClientController::onClientInfoChanged(QString info)
 {
     mUi->boundInfoLineEdit->setText(info);
 }
+
+void SAKUdpClientController::onMulticastGroupsJoined(QStringList groups)
+{
+    mSessionsDialog->setJoinedGroups(groups);
+}
+
+void SAKUdpClientController::onSessionsChanged(
+        QVector<SAKUdpSessions::SAKStructSession> sessions)
+{
+    mSessionsDialog->updateSessions(sessions);
+}
@@ -16,6 +16,7 @@
 #include <QComboBox>
 #include <QPushButton>
 
+#include "SAKUdpSessions.hh"
 #include "SAKDebuggerController.hh"
 #include "SAKCommonDataStructure.hh"
 
@@ -23,6 +24,7 @@ namespace Ui {
     class SAKUdpClientController;
 }
 
+class SAKUdpSessionsDialog;
 class SAKUdpClientController : public SAKDebuggerController
 {
     Q_OBJECT
@@ -36,7 +38,10 @@ public:
     void refreshDevice() final;
     QVariant parametersContext() final;
     void onClientInfoChanged(QString info);
+    void onMulticastGroupsJoined(QStringList groups);
+    void onSessionsChanged(QVector<SAKUdpSessions::SAKStructSession> sessions);
 private:
     Ui::SAKUdpClientController *mUi;
+    SAKUdpSessionsDialog *mSessionsDialog;
 };
 #endif
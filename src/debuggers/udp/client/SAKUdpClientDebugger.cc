@@ -23,11 +23,15 @@ SAKUdpClientDebugger::SAKUdpClientDebugger(QSettings *settings,
     :SAKDebugger(settings, settingsGroup, sqlDatabase, parent)
 {
     mController = new SAKUdpClientController(settings, settingsGroup, this);
-    mDevice = new SAKUdpClientDevice(settings, settingsGroup, parent, this);
+    mDevice = new SAKUdpClientDevice(settings, settingsGroup, this);
     initDebugger();
 
     connect(mDevice, &SAKUdpClientDevice::clientInfoChanged,
             mController, &SAKUdpClientController::onClientInfoChanged);
+    connect(mDevice, &SAKUdpClientDevice::multicastGroupsJoined,
+            mController, &SAKUdpClientController::onMulticastGroupsJoined);
+    connect(mDevice, &SAKUdpClientDevice::sessionsChanged,
+            mController, &SAKUdpClientController::onSessionsChanged);
 }
 
 SAKDebuggerDevice* SAKUdpClientDebugger::device()
@@ -9,20 +9,22 @@
  */
 #include <QDebug>
 #include <QEventLoop>
-#include <QApplication>
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+#include <QNetworkDatagram>
+#endif
 
 #include "SAKUdpClientDevice.hh"
-#include "SAKUdpClientDebugger.hh"
-#include "SAKUdpClientController.hh"
+#include "SAKDebuggerDeviceSocketOptionsKernel.hh"
 
 SAKUdpClientDevice::SAKUdpClientDevice(QSettings *settings,
                                        const QString &settingsGroup,
-                                       QWidget *uiParent,
                                        QObject *parent)
-    :SAKDebuggerDevice(settings, settingsGroup, uiParent, parent)
+    :SAKDebuggerDevice(settings, settingsGroup, parent)
     ,mUdpSocket(Q_NULLPTR)
+    ,mSessionsTimer(Q_NULLPTR)
 {
-
+    qRegisterMetaType<QVector<SAKUdpSessions::SAKStructSession>>(
+                "QVector<SAKUdpSessions::SAKStructSession>");
 }
 
 SAKUdpClientDevice::~SAKUdpClientDevice()
@@ -41,7 +43,22 @@ bool SAKUdpClientDevice::initialize()
     // Binding host and port.
     mUdpSocket = new QUdpSocket;
     bool bindResult = false;
-    if (specifyLocalInfo) {
+    if (parameters.multicastGroups.length()) {
+        // The group datagrams are sent to group:port, they can not be received
+        // by a socket bound to a unicast address or a random port. The protocol
+        // of the any address must be the same as the groups.
+        if ((!specifyLocalInfo) || (localPort == 0)) {
+            emit errorOccurred(tr("The local port must be specified to receive "
+                                  "the datagrams of multicast groups."));
+            return false;
+        }
+
+        QHostAddress address = SAKUdpMulticastGroups::bindingAddress(
+                    parameters.multicastGroups);
+        bindResult = mUdpSocket->bind(address,
+                                      localPort,
+                                      QUdpSocket::ShareAddress);
+    } else if (specifyLocalInfo) {
         if (localHost.compare(SAK_HOST_ADDRESS_ANY) == 0) {
             bindResult = mUdpSocket->bind(QHostAddress::Any,
                                           localPort,
@@ -62,6 +79,10 @@ bool SAKUdpClientDevice::initialize()
         info.append(":");
         info.append(QString::number(mUdpSocket->localPort()));
         emit clientInfoChanged(info);
+
+        QString diagnostics = SAKDebuggerDeviceSocketOptionsKernel::apply(
+                    mUdpSocket, SAKDebuggerDevice::parameters()->socketOptionsContext());
+        SAKDebuggerDevice::parameters()->setSocketOptionsDiagnostics(diagnostics);
     }else{
         QString errorString = tr("Binding failed:") + mUdpSocket->errorString();
         emit errorOccurred(errorString);
@@ -81,18 +102,53 @@ bool SAKUdpClientDevice::initialize()
     }
 
 
+    // Multicast groups and sessions, the socket lives in the device thread, so
+    // the groups are updated in the device thread.
+    mSessions.clear();
+    mJoinedGroups.clear();
+    updateMulticastGroups();
+    connect(this, &SAKUdpClientDevice::parametersContextChanged,
+            mUdpSocket, [=](){
+        updateMulticastGroups();
+    });
+    mSessionsTimer = new QTimer;
+    mSessionsTimer->setInterval(SAK_UDP_SESSIONS_REPORT_INTERVAL);
+    connect(mSessionsTimer, &QTimer::timeout, this, [=](){
+        reportSessions();
+    }, Qt::DirectConnection);
+    mSessionsTimer->start();
+
+
     return true;
 }
 
 QByteArray SAKUdpClientDevice::read()
 {
     while (mUdpSocket->hasPendingDatagrams()) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+        QNetworkDatagram datagram = mUdpSocket->receiveDatagram();
+        QByteArray data = datagram.data();
+        if (datagram.isValid()){
+            mSessions.received(datagram.senderAddress(),
+                               quint16(datagram.senderPort()),
+                               datagram.destinationAddress(),
+                               data.length());
+            emit bytesRead(data);
+        }
+#else
         QByteArray data;
+        QHostAddress senderAddress;
+        quint16 senderPort = 0;
         data.resize(static_cast<int>(mUdpSocket->pendingDatagramSize()));
-        qint64 ret = mUdpSocket->readDatagram(data.data(), data.length());
-        if (ret > 0){
+        qint64 ret = mUdpSocket->readDatagram(data.data(),
+                                              data.length(),
+                                              &senderAddress,
+                                              &senderPort);
+        if (ret >= 0){
+            mSessions.received(senderAddress, senderPort, QHostAddress(), ret);
             emit bytesRead(data);
         }
+#endif
     }
 
     return QByteArray();
@@ -101,10 +157,12 @@ QByteArray SAKUdpClientDevice::read()
 QByteArray SAKUdpClientDevice::write(const QByteArray &bytes)
 {
     auto parameters = parametersContext().value<SAKUdpClientParametersContext>();
-    qint64 ret = mUdpSocket->writeDatagram(bytes,
-                                           QHostAddress(parameters.peerHost),
-                                           parameters.peerPort);
+    QHostAddress address = parameters.broadcast
+            ? QHostAddress(QHostAddress::Broadcast)
+            : QHostAddress(parameters.peerHost);
+    qint64 ret = mUdpSocket->writeDatagram(bytes, address, parameters.peerPort);
     if (ret > 0){
+        mSessions.sent(address, parameters.peerPort, ret);
         emit bytesWritten(bytes);
     }
 
@@ -113,7 +171,57 @@ QByteArray SAKUdpClientDevice::write(const QByteArray &bytes)
 
 void SAKUdpClientDevice::uninitialize()
 {
-    mUdpSocket->close();
-    delete mUdpSocket;
-    mUdpSocket = Q_NULLPTR;
+    if (mSessionsTimer) {
+        mSessionsTimer->stop();
+        delete mSessionsTimer;
+        mSessionsTimer = Q_NULLPTR;
+        reportSessions();
+    }
+
+    if (mUdpSocket) {
+        mMulticastGroups.leaveAll(mUdpSocket);
+        mUdpSocket->close();
+        delete mUdpSocket;
+        mUdpSocket = Q_NULLPTR;
+    }
+    mJoinedGroups.clear();
+    emit multicastGroupsJoined(QStringList());
+}
+
+bool SAKUdpClientDevice::socketOptionsSupported()
+{
+    return true;
+}
+
+void SAKUdpClientDevice::updateMulticastGroups()
+{
+    auto parameters = parametersContext().value<SAKUdpClientParametersContext>();
+    QStringList groups = parameters.multicastGroups;
+    // The groups may be added after the socket is bound, see initialize(), they
+    // can not be joined until the device is reopened with a specified local
+    // port. It is not an error of the opened device, the rejected groups are
+    // reported as not joined.
+    QHostAddress localAddress = mUdpSocket->localAddress();
+    bool anyAddress = (localAddress == QHostAddress(QHostAddress::Any))
+            || (localAddress == QHostAddress(QHostAddress::AnyIPv4))
+            || (localAddress == QHostAddress(QHostAddress::AnyIPv6));
+    if ((!parameters.specifyLocalInfo) || (!anyAddress)) {
+        groups.clear();
+    }
+
+    // The parameters context is changed by any of the parameters, the joined
+    // groups are reported only if they are changed.
+    groups = mMulticastGroups.update(mUdpSocket, groups);
+    if (groups != mJoinedGroups) {
+        mJoinedGroups = groups;
+        emit multicastGroupsJoined(groups);
+    }
+}
+
+void SAKUdpClientDevice::reportSessions()
+{
+    auto sessions = mSessions.takeChanged();
+    if (sessions.length()) {
+        emit sessionsChanged(sessions);
+    }
 }
@@ -11,21 +11,24 @@
 #define SAKUDPCLIENTDEVICE_HH
 
 #include <QMutex>
+#include <QTimer>
 #include <QThread>
 #include <QUdpSocket>
 
+#include "SAKUdpSessions.hh"
 #include "SAKDebuggerDevice.hh"
+#include "SAKUdpMulticastGroups.hh"
 #include "SAKCommonDataStructure.hh"
 
-class SAKUdpClientDebugger;
-class SAKUdpClientController;
+/// @brief Udp client device, the datagrams can be sent to a peer or the
+/// broadcast address, multicast groups can be joined or left while the device
+/// is opened, received datagrams are counted by source.
 class SAKUdpClientDevice : public SAKDebuggerDevice
 {
     Q_OBJECT
 public:
     SAKUdpClientDevice(QSettings *settings,
                        const QString &settingsGroup,
-                       QWidget *uiParent = Q_NULLPTR,
                        QObject *parent = Q_NULLPTR);
     ~SAKUdpClientDevice();
 
@@ -33,9 +36,20 @@ public:
     QByteArray read() final;
     QByteArray write(const QByteArray &bytes) final;
     void uninitialize() final;
+    bool socketOptionsSupported() final;
 private:
     QUdpSocket *mUdpSocket;
+    // Accessed in the device thread only
+    SAKUdpSessions mSessions;
+    SAKUdpMulticastGroups mMulticastGroups;
+    QStringList mJoinedGroups;      // Reported by multicastGroupsJoined()
+    QTimer *mSessionsTimer;
+private:
+    void updateMulticastGroups();
+    void reportSessions();
 signals:
     void clientInfoChanged(QString info);
+    void multicastGroupsJoined(QStringList groups);
+    void sessionsChanged(QVector<SAKUdpSessions::SAKStructSession> sessions);
 };
 #endif
@@ -0,0 +1,17 @@
+FORMS += \
+    $$PWD/SAKUdpSessionsDialog.ui
+
+HEADERS += \
+    $$PWD/SAKUdpMulticastGroups.hh \
+    $$PWD/SAKUdpSessions.hh \
+    $$PWD/SAKUdpSessionsDialog.hh \
+    $$PWD/SAKUdpSessionsModel.hh
+
+SOURCES += \
+    $$PWD/SAKUdpMulticastGroups.cc \
+    $$PWD/SAKUdpSessions.cc \
+    $$PWD/SAKUdpSessionsDialog.cc \
+    $$PWD/SAKUdpSessionsModel.cc
+
+INCLUDEPATH += \
+    $$PWD
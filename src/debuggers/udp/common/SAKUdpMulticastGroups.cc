@@ -0,0 +1,111 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QDebug>
+
+#include "SAKUdpMulticastGroups.hh"
+
+QStringList SAKUdpMulticastGroups::update(QUdpSocket *socket,
+                                          const QStringList &groups)
+{
+    const QStringList joinedGroups = mJoinedGroups;
+    for (auto &group : joinedGroups) {
+        if (!groups.contains(group)) {
+            leave(socket, group);
+            mJoinedGroups.removeOne(group);
+        }
+    }
+
+    for (auto &group : groups) {
+        if (!mJoinedGroups.contains(group)) {
+            if (join(socket, group)) {
+                mJoinedGroups.append(group);
+            }
+        }
+    }
+
+    return mJoinedGroups;
+}
+
+void SAKUdpMulticastGroups::leaveAll(QUdpSocket *socket)
+{
+    for (auto &group : mJoinedGroups) {
+        leave(socket, group);
+    }
+    mJoinedGroups.clear();
+}
+
+bool SAKUdpMulticastGroups::parse(const QString &group,
+                                  QHostAddress *address,
+                                  QNetworkInterface *networkInterface)
+{
+    QString host = group.section('@', 0, 0).trimmed();
+    QString name = group.section('@', 1).trimmed();
+    *address = QHostAddress(host);
+    *networkInterface = name.isEmpty()
+            ? QNetworkInterface()
+            : QNetworkInterface::interfaceFromName(name);
+    // A group of an unknown interface(such as a renamed one) is not joined
+    // on the default interface.
+    if ((!name.isEmpty()) && (!networkInterface->isValid())) {
+        return false;
+    }
+
+    return address->isMulticast();
+}
+
+QHostAddress SAKUdpMulticastGroups::bindingAddress(const QStringList &groups)
+{
+    for (auto &group : groups) {
+        QHostAddress address;
+        QNetworkInterface networkInterface;
+        if (parse(group, &address, &networkInterface)) {
+            if (address.protocol() == QAbstractSocket::IPv6Protocol) {
+                return QHostAddress(QHostAddress::AnyIPv6);
+            }
+            return QHostAddress(QHostAddress::AnyIPv4);
+        }
+    }
+
+    return QHostAddress(QHostAddress::Any);
+}
+
+bool SAKUdpMulticastGroups::join(QUdpSocket *socket, const QString &group)
+{
+    QHostAddress address;
+    QNetworkInterface networkInterface;
+    if (!parse(group, &address, &networkInterface)) {
+        qWarning() << "Not a multicast group or unknown interface:" << group;
+        return false;
+    }
+
+    bool ret = networkInterface.isValid()
+            ? socket->joinMulticastGroup(address, networkInterface)
+            : socket->joinMulticastGroup(address);
+    if (!ret) {
+        qWarning() << "Can not join the multicast group:" << group
+                   << socket->errorString();
+    }
+    return ret;
+}
+
+bool SAKUdpMulticastGroups::leave(QUdpSocket *socket, const QString &group)
+{
+    QHostAddress address;
+    QNetworkInterface networkInterface;
+    parse(group, &address, &networkInterface);
+    bool ret = networkInterface.isValid()
+            ? socket->leaveMulticastGroup(address, networkInterface)
+            : socket->leaveMulticastGroup(address);
+    if (!ret) {
+        qWarning() << "Can not leave the multicast group:" << group
+                   << socket->errorString();
+    }
+    return ret;
+}
@@ -0,0 +1,65 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKUDPMULTICASTGROUPS_HH
+#define SAKUDPMULTICASTGROUPS_HH
+
+#include <QUdpSocket>
+#include <QStringList>
+#include <QHostAddress>
+#include <QNetworkInterface>
+
+/// @brief Multicast groups joined by a udp socket, a group is described as
+/// "group" or "group@interface", such as "239.0.0.1@eth0". The class is used
+/// in the device thread.
+class SAKUdpMulticastGroups
+{
+public:
+    /**
+     * @brief update: Join the groups which have not been joined and leave the
+     * groups which are not in the list.
+     * @param socket: The socket, it must have been bound.
+     * @param groups: Groups to be joined.
+     * @return The groups which have been joined.
+     */
+    QStringList update(QUdpSocket *socket, const QStringList &groups);
+
+    /**
+     * @brief leaveAll: Leave all of the joined groups.
+     */
+    void leaveAll(QUdpSocket *socket);
+
+    /**
+     * @brief parse: Parse a group description.
+     * @param group: "group" or "group@interface".
+     * @param address: Group address.
+     * @param networkInterface: Invalid if the interface is not specified.
+     * @return false: The group address is not a multicast address, or the
+     * interface is specified but it is not found.
+     */
+    static bool parse(const QString &group,
+                      QHostAddress *address,
+                      QNetworkInterface *networkInterface);
+
+    /**
+     * @brief bindingAddress: The any address of the protocol of the groups,
+     * the group datagrams are not received if the socket is bound to a unicast
+     * address on some platforms.
+     * @return QHostAddress::AnyIPv4, QHostAddress::AnyIPv6 or QHostAddress::Any
+     * if the groups are empty.
+     */
+    static QHostAddress bindingAddress(const QStringList &groups);
+private:
+    QStringList mJoinedGroups;
+private:
+    bool join(QUdpSocket *socket, const QString &group);
+    bool leave(QUdpSocket *socket, const QString &group);
+};
+
+#endif
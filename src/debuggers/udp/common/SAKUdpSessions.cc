@@ -0,0 +1,156 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QDateTime>
+
+#include "SAKUdpSessions.hh"
+
+SAKUdpSessions::SAKUdpSessions(int maxSessions)
+    :mMaxSessions(maxSessions)
+    ,mDroppedDatagrams(0)
+{
+    mReportClock.start();
+}
+
+void SAKUdpSessions::received(const QHostAddress &host,
+                              quint16 port,
+                              const QHostAddress &destination,
+                              qint64 length)
+{
+    int index = sessionIndex(host, port, true);
+    if (index < 0) {
+        mDroppedDatagrams += 1;
+        return;
+    }
+
+    SAKStructSession &session = mSessions[index];
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (session.rxDatagrams == 0) {
+        session.firstSeen = now;
+    }
+    session.rxDatagrams += 1;
+    session.rxBytes += length;
+    session.lastSeen = now;
+    // Multicast, broadcast or unicast, the string is created only if the
+    // destination is changed.
+    if ((!destination.isNull()) && (mDestinations.at(index) != destination)) {
+        mDestinations[index] = destination;
+        session.destination = destination.toString();
+    }
+    markChanged(index);
+}
+
+void SAKUdpSessions::sent(const QHostAddress &host, quint16 port, qint64 length)
+{
+    int index = sessionIndex(host, port, false);
+    if (index >= 0) {
+        mSessions[index].txDatagrams += 1;
+        mSessions[index].txBytes += length;
+        markChanged(index);
+    }
+}
+
+QVector<SAKUdpSessions::SAKStructSession> SAKUdpSessions::takeChanged()
+{
+    qint64 elapsed = qMax<qint64>(mReportClock.restart(), 1);
+    QVector<int> activeIndexes;
+    // The sessions which became idle are reported with rx rate 0.
+    for (int index : mActiveIndexes) {
+        markChanged(index);
+    }
+
+    QVector<SAKStructSession> sessions;
+    sessions.reserve(mChangedIndexes.length());
+    for (int index : mChangedIndexes) {
+        SAKStructSession &session = mSessions[index];
+        qint64 datagrams = session.rxDatagrams - mReportedDatagrams.at(index);
+        session.rxRate = datagrams*1000.0/elapsed;
+        mReportedDatagrams[index] = session.rxDatagrams;
+        mChangedFlags[index] = false;
+        if (datagrams) {
+            activeIndexes.append(index);
+        }
+        sessions.append(session);
+    }
+
+    mChangedIndexes.clear();
+    mActiveIndexes = activeIndexes;
+    return sessions;
+}
+
+void SAKUdpSessions::clear()
+{
+    mIndexes.clear();
+    mSessions.clear();
+    mReportedDatagrams.clear();
+    mDestinations.clear();
+    mChangedFlags.clear();
+    mChangedIndexes.clear();
+    mActiveIndexes.clear();
+    mDroppedDatagrams = 0;
+    mReportClock.restart();
+}
+
+int SAKUdpSessions::count() const
+{
+    return mSessions.length();
+}
+
+qint64 SAKUdpSessions::droppedDatagrams() const
+{
+    return mDroppedDatagrams;
+}
+
+int SAKUdpSessions::sessionIndex(const QHostAddress &host, quint16 port, bool create)
+{
+    // The sources are IPv4-mapped IPv6 addresses if the socket is bound to
+    // the dual stack any address.
+    QHostAddress address = host;
+    bool isIPv4 = false;
+    quint32 ipv4 = host.toIPv4Address(&isIPv4);
+    if (isIPv4 && (host.protocol() == QAbstractSocket::IPv6Protocol)) {
+        address = QHostAddress(ipv4);
+    }
+
+    SAKSessionKey key(address, port);
+    auto it = mIndexes.constFind(key);
+    if (it != mIndexes.constEnd()) {
+        return it.value();
+    }
+
+    if (!create || (mSessions.length() >= mMaxSessions)) {
+        return -1;
+    }
+
+    SAKStructSession session;
+    session.host = address.toString();
+    session.port = port;
+    session.rxDatagrams = 0;
+    session.rxBytes = 0;
+    session.txDatagrams = 0;
+    session.txBytes = 0;
+    session.firstSeen = 0;
+    session.lastSeen = 0;
+    session.rxRate = 0;
+    mSessions.append(session);
+    mReportedDatagrams.append(0);
+    mDestinations.append(QHostAddress());
+    mChangedFlags.append(false);
+    int index = mSessions.length() - 1;
+    mIndexes.insert(key, index);
+    return index;
+}
+
+void SAKUdpSessions::markChanged(int index)
+{
+    if (!mChangedFlags.at(index)) {
+        mChangedFlags[index] = true;
+        mChangedIndexes.append(index);
+    }
+}
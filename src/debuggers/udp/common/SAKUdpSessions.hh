@@ -0,0 +1,101 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKUDPSESSIONS_HH
+#define SAKUDPSESSIONS_HH
+
+#include <QHash>
+#include <QPair>
+#include <QVector>
+#include <QMetaType>
+#include <QHostAddress>
+#include <QElapsedTimer>
+
+// The changed sessions are reported every 500ms, unit is millisecond.
+#define SAK_UDP_SESSIONS_REPORT_INTERVAL 500
+
+/// @brief Received datagrams are demultiplexed into sessions by the source
+/// address and port, every session has its own counters. The class is used in
+/// the device thread, the changed sessions are taken and reported to the ui
+/// periodically, so that hundreds of publishers can be monitored by one page.
+class SAKUdpSessions
+{
+public:
+    struct SAKStructSession {
+        QString host;
+        quint16 port;
+        QString destination;    // Destination address of the last datagram
+        qint64 rxDatagrams;
+        qint64 rxBytes;
+        qint64 txDatagrams;
+        qint64 txBytes;
+        qint64 firstSeen;       // Milliseconds since epoch
+        qint64 lastSeen;        // Milliseconds since epoch
+        double rxRate;          // Datagrams per second since the last report
+    };
+
+    /**
+     * @brief SAKUdpSessions: Session table.
+     * @param maxSessions: The datagrams of new sources are not counted if the
+     * table is full.
+     */
+    SAKUdpSessions(int maxSessions = 1024);
+
+    /**
+     * @brief received: Count a received datagram.
+     * @param host: Source address.
+     * @param port: Source port.
+     * @param destination: Destination address of the datagram, it is null if
+     * it is unknown.
+     * @param length: Length of the datagram.
+     */
+    void received(const QHostAddress &host,
+                  quint16 port,
+                  const QHostAddress &destination,
+                  qint64 length);
+
+    /**
+     * @brief sent: Count a sent datagram, nothing will be done if the session
+     * does not exist.
+     */
+    void sent(const QHostAddress &host, quint16 port, qint64 length);
+
+    /**
+     * @brief takeChanged: Get the sessions changed since the last calling, the
+     * sessions become idle since the last calling are included too, their rx
+     * rates are 0.
+     */
+    QVector<SAKStructSession> takeChanged();
+
+    void clear();
+    int count() const;
+    qint64 droppedDatagrams() const;
+private:
+    typedef QPair<QHostAddress, quint16> SAKSessionKey;
+    QHash<SAKSessionKey, int> mIndexes;
+    QVector<SAKStructSession> mSessions;
+    // The rx datagrams when the session is reported last time
+    QVector<qint64> mReportedDatagrams;
+    QVector<QHostAddress> mDestinations;
+    QVector<bool> mChangedFlags;
+    QVector<int> mChangedIndexes;
+    // Sessions that have a non-zero rx rate in the last report
+    QVector<int> mActiveIndexes;
+    QElapsedTimer mReportClock;
+    int mMaxSessions;
+    qint64 mDroppedDatagrams;
+private:
+    int sessionIndex(const QHostAddress &host, quint16 port, bool create);
+    void markChanged(int index);
+};
+
+Q_DECLARE_METATYPE(SAKUdpSessions::SAKStructSession)
+Q_DECLARE_METATYPE(QVector<SAKUdpSessions::SAKStructSession>)
+
+#endif
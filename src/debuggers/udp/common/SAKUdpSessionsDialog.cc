@@ -0,0 +1,127 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QHeaderView>
+#include <QHostAddress>
+#include <QListWidgetItem>
+#include <QNetworkInterface>
+
+#include "SAKUdpSessionsModel.hh"
+#include "SAKUdpSessionsDialog.hh"
+#include "ui_SAKUdpSessionsDialog.h"
+
+SAKUdpSessionsDialog::SAKUdpSessionsDialog(QWidget *parent)
+    :QDialog(parent)
+    ,mUi(new Ui::SAKUdpSessionsDialog)
+    ,mSessionsModel(new SAKUdpSessionsModel(this))
+{
+    mUi->setupUi(this);
+    mUi->sessionsTableView->setModel(mSessionsModel);
+    mUi->sessionsTableView->verticalHeader()->hide();
+    mUi->sessionsTableView->horizontalHeader()->setStretchLastSection(true);
+
+    mUi->interfaceComboBox->addItem(tr("Default interface"), QString());
+    auto interfaces = QNetworkInterface::allInterfaces();
+    for (auto &var : interfaces) {
+        if (var.flags() & QNetworkInterface::CanMulticast) {
+            mUi->interfaceComboBox->addItem(var.humanReadableName(), var.name());
+        }
+    }
+
+    connect(mUi->joinPushButton, &QPushButton::clicked,
+            this, &SAKUdpSessionsDialog::joinGroup);
+    connect(mUi->groupLineEdit, &QLineEdit::returnPressed,
+            this, &SAKUdpSessionsDialog::joinGroup);
+    connect(mUi->leavePushButton, &QPushButton::clicked,
+            this, &SAKUdpSessionsDialog::leaveGroup);
+    connect(mUi->clearPushButton, &QPushButton::clicked, this, [=](){
+        mSessionsModel->clear();
+        mUi->sessionsLabel->clear();
+    });
+}
+
+SAKUdpSessionsDialog::~SAKUdpSessionsDialog()
+{
+    delete mUi;
+}
+
+QStringList SAKUdpSessionsDialog::multicastGroups()
+{
+    QStringList groups;
+    for (int i = 0; i < mUi->groupsListWidget->count(); i++) {
+        groups.append(mUi->groupsListWidget->item(i)->data(Qt::UserRole).toString());
+    }
+    return groups;
+}
+
+void SAKUdpSessionsDialog::setMulticastGroups(const QStringList &groups)
+{
+    mUi->groupsListWidget->clear();
+    for (auto &group : groups) {
+        auto item = new QListWidgetItem(mUi->groupsListWidget);
+        item->setData(Qt::UserRole, group);
+    }
+    updateGroupItems();
+}
+
+void SAKUdpSessionsDialog::setJoinedGroups(const QStringList &groups)
+{
+    mJoinedGroups = groups;
+    updateGroupItems();
+}
+
+void SAKUdpSessionsDialog::updateSessions(
+        const QVector<SAKUdpSessions::SAKStructSession> &sessions)
+{
+    mSessionsModel->updateSessions(sessions);
+    mUi->sessionsLabel->setText(tr("%1 sources").arg(mSessionsModel->rowCount()));
+}
+
+void SAKUdpSessionsDialog::joinGroup()
+{
+    QString address = mUi->groupLineEdit->text().trimmed();
+    if (!QHostAddress(address).isMulticast()) {
+        mUi->groupLineEdit->selectAll();
+        return;
+    }
+
+    QString group = address;
+    QString name = mUi->interfaceComboBox->currentData().toString();
+    if (!name.isEmpty()) {
+        group.append('@');
+        group.append(name);
+    }
+
+    if (!multicastGroups().contains(group)) {
+        auto item = new QListWidgetItem(mUi->groupsListWidget);
+        item->setData(Qt::UserRole, group);
+        updateGroupItems();
+        emit multicastGroupsChanged();
+    }
+}
+
+void SAKUdpSessionsDialog::leaveGroup()
+{
+    auto item = mUi->groupsListWidget->currentItem();
+    if (item) {
+        delete item;
+        emit multicastGroupsChanged();
+    }
+}
+
+void SAKUdpSessionsDialog::updateGroupItems()
+{
+    for (int i = 0; i < mUi->groupsListWidget->count(); i++) {
+        auto item = mUi->groupsListWidget->item(i);
+        QString group = item->data(Qt::UserRole).toString();
+        QString state = mJoinedGroups.contains(group)
+                ? tr("joined") : tr("not joined");
+        item->setText(QString("%1 (%2)").arg(group, state));
+    }
+}
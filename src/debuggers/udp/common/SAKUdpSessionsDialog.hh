@@ -0,0 +1,56 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKUDPSESSIONSDIALOG_HH
+#define SAKUDPSESSIONSDIALOG_HH
+
+#include <QDialog>
+#include <QStringList>
+
+#include "SAKUdpSessions.hh"
+
+namespace Ui {
+    class SAKUdpSessionsDialog;
+}
+
+class SAKUdpSessionsModel;
+/// @brief Multicast groups editor and sessions monitor of udp devices, it is
+/// owned by the controller, the groups and the sessions are kept when it is
+/// hidden.
+class SAKUdpSessionsDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    SAKUdpSessionsDialog(QWidget *parent = Q_NULLPTR);
+    ~SAKUdpSessionsDialog();
+
+    /**
+     * @brief multicastGroups: Groups to be joined, "group" or "group@interface".
+     */
+    QStringList multicastGroups();
+    void setMulticastGroups(const QStringList &groups);
+
+    /**
+     * @brief setJoinedGroups: Groups joined by the device actually.
+     */
+    void setJoinedGroups(const QStringList &groups);
+    void updateSessions(const QVector<SAKUdpSessions::SAKStructSession> &sessions);
+private:
+    Ui::SAKUdpSessionsDialog *mUi;
+    SAKUdpSessionsModel *mSessionsModel;
+    QStringList mJoinedGroups;
+private:
+    void joinGroup();
+    void leaveGroup();
+    void updateGroupItems();
+signals:
+    void multicastGroupsChanged();
+};
+
+#endif
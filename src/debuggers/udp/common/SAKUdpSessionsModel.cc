@@ -0,0 +1,131 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QDateTime>
+
+#include "SAKUdpSessionsModel.hh"
+
+SAKUdpSessionsModel::SAKUdpSessionsModel(QObject *parent)
+    :QAbstractTableModel(parent)
+{
+
+}
+
+int SAKUdpSessionsModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : mSessions.length();
+}
+
+int SAKUdpSessionsModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant SAKUdpSessionsModel::data(const QModelIndex &index, int role) const
+{
+    if ((!index.isValid()) || (index.row() >= mSessions.length())) {
+        return QVariant();
+    }
+
+    const SAKUdpSessions::SAKStructSession &session = mSessions.at(index.row());
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case ColumnSource:
+            return QString("%1:%2").arg(session.host).arg(session.port);
+        case ColumnDestination:
+            return session.destination;
+        case ColumnRxDatagrams:
+            return session.rxDatagrams;
+        case ColumnRxBytes:
+            return session.rxBytes;
+        case ColumnRxRate:
+            return QString::number(session.rxRate, 'f', 1);
+        case ColumnTxDatagrams:
+            return session.txDatagrams;
+        case ColumnTxBytes:
+            return session.txBytes;
+        case ColumnLastSeen:
+            return QDateTime::fromMSecsSinceEpoch(session.lastSeen)
+                    .toString("hh:mm:ss.zzz");
+        default:
+            break;
+        }
+    } else if (role == Qt::TextAlignmentRole) {
+        if ((index.column() != ColumnSource)
+                && (index.column() != ColumnDestination)) {
+            return int(Qt::AlignRight | Qt::AlignVCenter);
+        }
+    }
+
+    return QVariant();
+}
+
+QVariant SAKUdpSessionsModel::headerData(int section,
+                                         Qt::Orientation orientation,
+                                         int role) const
+{
+    if ((orientation != Qt::Horizontal) || (role != Qt::DisplayRole)) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section) {
+    case ColumnSource: return tr("Source");
+    case ColumnDestination: return tr("Destination");
+    case ColumnRxDatagrams: return tr("Rx datagrams");
+    case ColumnRxBytes: return tr("Rx bytes");
+    case ColumnRxRate: return tr("Rx rate(/s)");
+    case ColumnTxDatagrams: return tr("Tx datagrams");
+    case ColumnTxBytes: return tr("Tx bytes");
+    case ColumnLastSeen: return tr("Last seen");
+    default: return QVariant();
+    }
+}
+
+void SAKUdpSessionsModel::updateSessions(
+        const QVector<SAKUdpSessions::SAKStructSession> &sessions)
+{
+    int firstChangedRow = mSessions.length();
+    int lastChangedRow = -1;
+    QVector<SAKUdpSessions::SAKStructSession> newSessions;
+    for (auto &session : sessions) {
+        QString key = QString("%1:%2").arg(session.host).arg(session.port);
+        auto it = mRows.constFind(key);
+        if (it == mRows.constEnd()) {
+            mRows.insert(key, mSessions.length() + newSessions.length());
+            newSessions.append(session);
+        } else {
+            int row = it.value();
+            mSessions[row] = session;
+            firstChangedRow = qMin(firstChangedRow, row);
+            lastChangedRow = qMax(lastChangedRow, row);
+        }
+    }
+
+    // One signal for all of the changed rows, the views repaint the visible
+    // rows only.
+    if (lastChangedRow >= 0) {
+        emit dataChanged(index(firstChangedRow, 0),
+                         index(lastChangedRow, ColumnCount - 1));
+    }
+
+    if (newSessions.length()) {
+        int first = mSessions.length();
+        beginInsertRows(QModelIndex(), first, first + newSessions.length() - 1);
+        mSessions.append(newSessions);
+        endInsertRows();
+    }
+}
+
+void SAKUdpSessionsModel::clear()
+{
+    beginResetModel();
+    mSessions.clear();
+    mRows.clear();
+    endResetModel();
+}
@@ -0,0 +1,53 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKUDPSESSIONSMODEL_HH
+#define SAKUDPSESSIONSMODEL_HH
+
+#include <QHash>
+#include <QVector>
+#include <QAbstractTableModel>
+
+#include "SAKUdpSessions.hh"
+
+/// @brief Sessions of a udp device, the rows are updated in place by the
+/// changed sessions reported by the device, new sessions are appended.
+class SAKUdpSessionsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum SAKEnumColumn {
+        ColumnSource,
+        ColumnDestination,
+        ColumnRxDatagrams,
+        ColumnRxBytes,
+        ColumnRxRate,
+        ColumnTxDatagrams,
+        ColumnTxBytes,
+        ColumnLastSeen,
+        ColumnCount
+    };
+
+    SAKUdpSessionsModel(QObject *parent = Q_NULLPTR);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const final;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const final;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const final;
+    QVariant headerData(int section,
+                        Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const final;
+
+    void updateSessions(const QVector<SAKUdpSessions::SAKStructSession> &sessions);
+    void clear();
+private:
+    QVector<SAKUdpSessions::SAKStructSession> mSessions;
+    QHash<QString, int> mRows;   // "host:port" to row
+};
+
+#endif
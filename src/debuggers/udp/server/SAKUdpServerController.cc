@@ -14,6 +14,7 @@
 
 #include "SAKDebugger.hh"
 #include "SAKCommonInterface.hh"
+#include "SAKUdpSessionsDialog.hh"
 #include "SAKCommonDataStructure.hh"
 #include "SAKUdpServerController.hh"
 #include "ui_SAKUdpServerController.h"
@@ -23,6 +24,7 @@ SAKUdpServerController::SAKUdpServerController(QSettings *settings,
                                                QWidget *parent)
     :SAKDebuggerController(settings, settingsGroup, parent)
     ,mUi(new Ui::SAKUdpServerController)
+    ,mSessionsDialog(new SAKUdpSessionsDialog(this))
 {
     mUi->setupUi(this);
     refreshDevice();
@@ -31,6 +33,10 @@ SAKUdpServerController::SAKUdpServerController(QSettings *settings,
     SAKUdpServerParametersContext ctx;
     microIni2CoB(settings, settingsGroup, ctx.serverHost, mUi->serverhostComboBox);
     microIni2LE(settings, settingsGroup, ctx.serverPort, mUi->serverPortLineEdit);
+    microIni2ChB(settings, settingsGroup, ctx.broadcast, mUi->broadcastCheckBox);
+    QString multicastGroupsKey = settingsGroup + QString("/multicastGroups");
+    mSessionsDialog->setMulticastGroups(
+                settings->value(multicastGroupsKey).toStringList());
 
 #if QT_VERSION >= QT_VERSION_CHECK(5,7,0)
     connect(mUi->serverhostComboBox, QOverload<int>::of(&QComboBox::activated),
@@ -49,6 +55,24 @@ SAKUdpServerController::SAKUdpServerController(QSettings *settings,
         emit parametersContextChanged();
         microLE2Ini(settings, settingsGroup, ctx.serverPort, mUi->serverPortLineEdit);
     });
+    connect(mUi->broadcastCheckBox, &QCheckBox::clicked,
+            this, [=](){
+        emit parametersContextChanged();
+        microChB2Ini(settings, settingsGroup, ctx.broadcast, mUi->broadcastCheckBox);
+    });
+    connect(mSessionsDialog, &SAKUdpSessionsDialog::multicastGroupsChanged,
+            this, [=](){
+        emit parametersContextChanged();
+        settings->setValue(multicastGroupsKey, mSessionsDialog->multicastGroups());
+    });
+    connect(mUi->sessionsPushButton, &QPushButton::clicked,
+            this, [=](){
+        if (mSessionsDialog->isHidden()) {
+            mSessionsDialog->show();
+        } else {
+            mSessionsDialog->activateWindow();
+        }
+    });
 }
 
 SAKUdpServerController::~SAKUdpServerController()
@@ -73,6 +97,8 @@ QVariant SAKUdpServerController::parametersContext()
 
     ctx.serverHost = mUi->serverhostComboBox->currentText().trimmed();
     ctx.serverPort = mUi->serverPortLineEdit->text().trimmed().toInt();
+    ctx.broadcast = mUi->broadcastCheckBox->isChecked();
+    ctx.multicastGroups = mSessionsDialog->multicastGroups();
 
     QString currentText = mUi->clientHostComboBox->currentText();
     QStringList infoList = currentText.trimmed().split(':');
@@ -107,3 +133,14 @@ void SAKUdpServerController::onAddClient(QString host, quint16 port)
         emit parametersContextChanged();
     }
 }
+
+void SAKUdpServerController::onMulticastGroupsJoined(QStringList groups)
+{
+    mSessionsDialog->setJoinedGroups(groups);
+}
+
+void SAKUdpServerController::onSessionsChanged(
+        QVector<SAKUdpSessions::SAKStructSession> sessions)
+{
+    mSessionsDialog->updateSessions(sessions);
+}
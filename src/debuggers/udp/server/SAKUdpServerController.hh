@@ -17,12 +17,14 @@
 #include <QComboBox>
 #include <QTcpSocket>
 
+#include "SAKUdpSessions.hh"
 #include "SAKDebuggerController.hh"
 
 namespace Ui {
     class SAKUdpServerController;
 }
 
+class SAKUdpSessionsDialog;
 /// @brief Udp server control panel
 class SAKUdpServerController:public SAKDebuggerController
 {
@@ -38,7 +40,10 @@ public:
     QVariant parametersContext() final;
 
     void onAddClient(QString host, quint16 port);
+    void onMulticastGroupsJoined(QStringList groups);
+    void onSessionsChanged(QVector<SAKUdpSessions::SAKStructSession> sessions);
 private:
     Ui::SAKUdpServerController *mUi;
+    SAKUdpSessionsDialog *mSessionsDialog;
 };
 #endif
@@ -23,11 +23,15 @@ SAKUdpServerDebugger::SAKUdpServerDebugger(QSettings *settings,
     :SAKDebugger(settings, settingsGroup, sqlDatabase, parent)
 {
     mController = new SAKUdpServerController(settings, settingsGroup, parent);
-    mDevice = new SAKUdpServerDevice(settings, settingsGroup, this, parent);
+    mDevice = new SAKUdpServerDevice(settings, settingsGroup, parent);
     initDebugger();
 
     connect(mDevice, &SAKUdpServerDevice::addClient,
             mController, &SAKUdpServerController::onAddClient);
+    connect(mDevice, &SAKUdpServerDevice::multicastGroupsJoined,
+            mController, &SAKUdpServerController::onMulticastGroupsJoined);
+    connect(mDevice, &SAKUdpServerDevice::sessionsChanged,
+            mController, &SAKUdpServerController::onSessionsChanged);
 }
 
 SAKDebuggerDevice* SAKUdpServerDebugger::device()
@@ -10,47 +10,91 @@
 #include <QDebug>
 #include <QEventLoop>
 #include <QHostAddress>
-#include <QApplication>
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+#include <QNetworkDatagram>
+#endif
 
-#include "SAKDebugger.hh"
 #include "SAKUdpServerDevice.hh"
-#include "SAKUdpServerDebugger.hh"
 #include "SAKCommonDataStructure.hh"
-#include "SAKUdpServerController.hh"
+#include "SAKDebuggerDeviceSocketOptionsKernel.hh"
 
 SAKUdpServerDevice::SAKUdpServerDevice(QSettings *settings,
                                        const QString &settingsGroup,
-                                       QWidget *uiParent,
                                        QObject *parent)
-    :SAKDebuggerDevice(settings, settingsGroup, uiParent, parent)
+    :SAKDebuggerDevice(settings, settingsGroup, parent)
     ,mUdpServer(Q_NULLPTR)
+    ,mSessionsTimer(Q_NULLPTR)
 {
-
+    qRegisterMetaType<QVector<SAKUdpSessions::SAKStructSession>>(
+                "QVector<SAKUdpSessions::SAKStructSession>");
 }
 
 bool SAKUdpServerDevice::initialize()
 {
     auto parameters = parametersContext().value<SAKUdpServerParametersContext>();
+    // The group datagrams may not be received by a socket bound to a unicast
+    // address, the any address is used if there are multicast groups.
+    QHostAddress serverAddress(parameters.serverHost);
+    if (parameters.multicastGroups.length()) {
+        serverAddress = SAKUdpMulticastGroups::bindingAddress(
+                    parameters.multicastGroups);
+    }
+
     mUdpServer = new QUdpSocket;
-    if (!mUdpServer->bind(QHostAddress(parameters.serverHost),
+    if (!mUdpServer->bind(serverAddress,
                           parameters.serverPort,
                           QUdpSocket::ShareAddress)) {
         QString errorString = tr("Binding failed：") + mUdpServer->errorString();
         emit errorOccurred(errorString);
         return false;
     } else {
+        QString diagnostics = SAKDebuggerDeviceSocketOptionsKernel::apply(
+                    mUdpServer, SAKDebuggerDevice::parameters()->socketOptionsContext());
+        SAKDebuggerDevice::parameters()->setSocketOptionsDiagnostics(diagnostics);
         connect(mUdpServer, &QUdpSocket::readyRead,
                 this, [=](){
             emit readyRead(SAKDeviceProtectedSignal());
         }, Qt::DirectConnection);
     }
 
+    // Multicast groups and sessions, the socket lives in the device thread, so
+    // the groups are updated in the device thread.
+    mSessions.clear();
+    mJoinedGroups.clear();
+    updateMulticastGroups();
+    connect(this, &SAKUdpServerDevice::parametersContextChanged,
+            mUdpServer, [=](){
+        updateMulticastGroups();
+    });
+    mSessionsTimer = new QTimer;
+    mSessionsTimer->setInterval(SAK_UDP_SESSIONS_REPORT_INTERVAL);
+    connect(mSessionsTimer, &QTimer::timeout, this, [=](){
+        reportSessions();
+    }, Qt::DirectConnection);
+    mSessionsTimer->start();
+
     return true;
 }
 
 QByteArray SAKUdpServerDevice::read()
 {
+    // The parameters are not changed while reading the pending datagrams.
+    auto parameters = parametersContext().value<SAKUdpServerParametersContext>();
+    QString currentHost = parameters.currentClientHost;
+    quint16 currentPort = parameters.currentClientPort;
+    QStringList clients = parameters.clients;
     while (mUdpServer->hasPendingDatagrams()) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+        QNetworkDatagram datagram = mUdpServer->receiveDatagram();
+        QByteArray bytes = datagram.data();
+        QHostAddress peerAddress = datagram.senderAddress();
+        quint16 peerPort = quint16(datagram.senderPort());
+        bool isValid = datagram.isValid();
+        if (isValid) {
+            mSessions.received(peerAddress, peerPort,
+                               datagram.destinationAddress(), bytes.length());
+        }
+#else
         qint64 size = mUdpServer->pendingDatagramSize();
         QByteArray bytes;
         bytes.resize(size);
@@ -60,20 +104,21 @@ QByteArray SAKUdpServerDevice::read()
                                               size,
                                               &peerAddress,
                                               &peerPort);
-        if (ret > 0) {
-            auto parameters = parametersContext().value<SAKUdpServerParametersContext>();
-            QString currentHost = parameters.currentClientHost;
-            quint16 currentPort = parameters.currentClientPort;
-
+        bool isValid = ret > 0;
+        if (isValid) {
+            mSessions.received(peerAddress, peerPort, QHostAddress(), ret);
+        }
+#endif
+        if (isValid) {
             if (currentHost.isEmpty()) {
                 emit addClient(peerAddress.toString(), peerPort);
                 emit bytesRead(bytes);
             } else {
-                QStringList clients = parameters.clients;
                 QString client = QString("%1:%2")
                         .arg(peerAddress.toString(), QString::number(peerPort));
                 if (!clients.contains(client)) {
                     emit addClient(peerAddress.toString(), peerPort);
+                    clients.append(client);
                 }
 
                 if ((currentHost == peerAddress.toString())
@@ -92,10 +137,14 @@ QByteArray SAKUdpServerDevice::write(const QByteArray &bytes)
     auto parameters = parametersContext().value<SAKUdpServerParametersContext>();
     QString currentHost = parameters.currentClientHost;
     quint16 currentPort = parameters.currentClientPort;
+    QHostAddress address = parameters.broadcast
+            ? QHostAddress(QHostAddress::Broadcast)
+            : QHostAddress(currentHost);
     qint64 ret = mUdpServer->writeDatagram(bytes,
-                                           QHostAddress(currentHost),
+                                           address,
                                            currentPort);
     if (ret > 0){
+        mSessions.sent(address, currentPort, ret);
         return bytes;
     }
     return QByteArray();
@@ -103,7 +152,43 @@ QByteArray SAKUdpServerDevice::write(const QByteArray &bytes)
 
 void SAKUdpServerDevice::uninitialize()
 {
+    if (mSessionsTimer) {
+        mSessionsTimer->stop();
+        delete mSessionsTimer;
+        mSessionsTimer = Q_NULLPTR;
+        reportSessions();
+    }
+
+    mMulticastGroups.leaveAll(mUdpServer);
     mUdpServer->close();
     delete mUdpServer;
     mUdpServer = Q_NULLPTR;
+    mJoinedGroups.clear();
+    emit multicastGroupsJoined(QStringList());
+}
+
+bool SAKUdpServerDevice::socketOptionsSupported()
+{
+    return true;
+}
+
+void SAKUdpServerDevice::updateMulticastGroups()
+{
+    auto parameters = parametersContext().value<SAKUdpServerParametersContext>();
+    QStringList groups = mMulticastGroups.update(mUdpServer,
+                                                 parameters.multicastGroups);
+    // The parameters context is changed by any of the parameters, the joined
+    // groups are reported only if they are changed.
+    if (groups != mJoinedGroups) {
+        mJoinedGroups = groups;
+        emit multicastGroupsJoined(groups);
+    }
+}
+
+void SAKUdpServerDevice::reportSessions()
+{
+    auto sessions = mSessions.takeChanged();
+    if (sessions.length()) {
+        emit sessionsChanged(sessions);
+    }
 }
@@ -10,30 +10,44 @@
 #ifndef SAKUDPSERVERDEVICE_HH
 #define SAKUDPSERVERDEVICE_HH
 
+#include <QTimer>
 #include <QThread>
 #include <QUdpSocket>
 
+#include "SAKUdpSessions.hh"
 #include "SAKDebuggerDevice.hh"
+#include "SAKUdpMulticastGroups.hh"
 
-class SAKUdpServerDebugger;
-class SAKUdpServerController;
+/// @brief Udp server device, the datagrams can be sent to the current client
+/// or the broadcast address, multicast groups can be joined or left while the
+/// device is opened, received datagrams are counted by source.
 class SAKUdpServerDevice:public SAKDebuggerDevice
 {
     Q_OBJECT
 public:
     SAKUdpServerDevice(QSettings *settings,
                        const QString &settingsGroup,
-                       QWidget *uiParent = Q_NULLPTR,
                        QObject *parent = Q_NULLPTR);
 private:
     bool initialize() final;
     QByteArray read() final;
     QByteArray write(const QByteArray &bytes) final;
     void uninitialize() final;
+    bool socketOptionsSupported() final;
 private:
     QUdpSocket *mUdpServer;
+    // Accessed in the device thread only
+    SAKUdpSessions mSessions;
+    SAKUdpMulticastGroups mMulticastGroups;
+    QStringList mJoinedGroups;      // Reported by multicastGroupsJoined()
+    QTimer *mSessionsTimer;
+private:
+    void updateMulticastGroups();
+    void reportSessions();
 signals:
     void addClient(QString host, quint16 port);
+    void multicastGroupsJoined(QStringList groups);
+    void sessionsChanged(QVector<SAKUdpSessions::SAKStructSession> sessions);
 };
 
 #endif
@@ -23,7 +23,7 @@ SAKWebSocketClientDebugger::SAKWebSocketClientDebugger(QSettings *settings,
     :SAKDebugger(settings, settingsGroup, sqlDatabase, parent)
 {
     mController = new SAKWebSocketClientController(settings, settingsGroup, parent);
-    mDevice = new SAKWebSocketClientDevice(settings, settingsGroup, this, parent);
+    mDevice = new SAKWebSocketClientDevice(settings, settingsGroup, parent);
     initDebugger();
     connect(mDevice, &SAKWebSocketClientDevice::clientInfoChanged,
             mController, &SAKWebSocketClientController::onClientInfoChanged);
@@ -15,14 +15,11 @@
 
 #include "SAKCommonDataStructure.hh"
 #include "SAKWebSocketClientDevice.hh"
-#include "SAKWebSocketClientDebugger.hh"
-#include "SAKWebSocketClientController.hh"
 
 SAKWebSocketClientDevice::SAKWebSocketClientDevice(QSettings *settings,
                                                    const QString &settingsGroup,
-                                                   QWidget *uiParent,
                                                    QObject *parent)
-    :SAKDebuggerDevice(settings, settingsGroup, uiParent, parent)
+    :SAKDebuggerDevice(settings, settingsGroup, parent)
     ,mWebSocket(Q_NULLPTR)
 {
     qRegisterMetaType<QAbstractSocket::SocketError>("QAbstractSocket::SocketError");
@@ -32,11 +29,17 @@ bool SAKWebSocketClientDevice::initialize()
 {
     QEventLoop *eventLoop = new QEventLoop;
     mWebSocket = new QWebSocket;
+    // QWebSocket does not expose its tcp socket, only the read buffer size can
+    // be set.
+    int readBufferSize = parameters()->socketOptionsContext().readBufferSize;
+    mWebSocket->setReadBufferSize(readBufferSize);
     connect(mWebSocket, &QWebSocket::connected, this, [=](){
         QString info = mWebSocket->localAddress().toString();
         info.append(":");
         info.append(QString::number(mWebSocket->localPort()));
         emit clientInfoChanged(info);
+        parameters()->setSocketOptionsDiagnostics(
+                    tr("Read buffer size: %1").arg(mWebSocket->readBufferSize()));
         eventLoop->exit();
     });
 
@@ -108,6 +111,11 @@ void SAKWebSocketClientDevice::uninitialize()
     mWebSocket = Q_NULLPTR;
 }
 
+bool SAKWebSocketClientDevice::socketOptionsSupported()
+{
+    return true;
+}
+
 void SAKWebSocketClientDevice::appendMessage(const QByteArray &byteArray)
 {
     mByteArrayVectorMutex.lock();
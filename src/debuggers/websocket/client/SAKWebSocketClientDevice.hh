@@ -22,13 +22,13 @@ class SAKWebSocketClientDevice : public SAKDebuggerDevice
 public:
     SAKWebSocketClientDevice(QSettings *settings,
                              const QString &settingsGroup,
-                             QWidget *uiParent = Q_NULLPTR,
                              QObject *parent = Q_NULLPTR);
 protected:
     bool initialize() final;
     QByteArray read() final;
     QByteArray write(const QByteArray &bytes) final;
     void uninitialize() final;
+    bool socketOptionsSupported() final;
 private:
     QWebSocket *mWebSocket;
     QVector<QByteArray> mByteArrayVector;
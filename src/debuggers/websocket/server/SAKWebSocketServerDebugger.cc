@@ -23,7 +23,7 @@ SAKWebSocketServerDebugger::SAKWebSocketServerDebugger(QSettings *settings,
     :SAKDebugger(settings, settingsGroup, sqlDatabase, parent)
 {
     mController = new SAKWebSocketServerController(settings, settingsGroup, parent);
-    mDevice = new SAKWebSocketServerDevice(settings, settingsGroup, this, parent);
+    mDevice = new SAKWebSocketServerDevice(settings, settingsGroup, parent);
     initDebugger();
     connect(mDevice, &SAKWebSocketServerDevice::addClient,
             mController, &SAKWebSocketServerController::addClient);
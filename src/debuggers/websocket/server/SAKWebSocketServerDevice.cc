@@ -10,19 +10,14 @@
 #include <QDebug>
 #include <QEventLoop>
 #include <QHostAddress>
-#include <QApplication>
 
-#include "SAKDebugger.hh"
 #include "SAKCommonDataStructure.hh"
 #include "SAKWebSocketServerDevice.hh"
-#include "SAKWebSocketServerDebugger.hh"
-#include "SAKWebSocketServerController.hh"
 
 SAKWebSocketServerDevice::SAKWebSocketServerDevice(QSettings *settings,
                                                    const QString &settingsGroup,
-                                                   QWidget *uiParent,
                                                    QObject *parent)
-    :SAKDebuggerDevice(settings, settingsGroup, uiParent, parent)
+    :SAKDebuggerDevice(settings, settingsGroup, parent)
     ,mWebSocketServer(Q_NULLPTR)
 {
 
@@ -43,6 +38,12 @@ bool SAKWebSocketServerDevice::initialize()
         while (mWebSocketServer->hasPendingConnections()){
             QWebSocket *socket = mWebSocketServer->nextPendingConnection();
             if (socket){
+                // QWebSocket does not expose its tcp socket, only the read
+                // buffer size can be set.
+                auto ctx = SAKDebuggerDevice::parameters()->socketOptionsContext();
+                socket->setReadBufferSize(ctx.readBufferSize);
+                SAKDebuggerDevice::parameters()->setSocketOptionsDiagnostics(
+                            tr("Read buffer size: %1").arg(socket->readBufferSize()));
                 mClientList.append(socket);
                 emit addClient(socket->peerAddress().toString(), socket->peerPort(), socket);
 
@@ -103,6 +104,11 @@ void SAKWebSocketServerDevice::uninitialize()
     mWebSocketServer = Q_NULLPTR;
 }
 
+bool SAKWebSocketServerDevice::socketOptionsSupported()
+{
+    return true;
+}
+
 void SAKWebSocketServerDevice::readBytesActually(QWebSocket *socket, QByteArray bytes)
 {
     auto parameters = parametersContext().value<SAKWSServerParametersContext>();
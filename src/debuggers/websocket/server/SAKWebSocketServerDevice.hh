@@ -22,13 +22,13 @@ class SAKWebSocketServerDevice : public SAKDebuggerDevice
 public:
     SAKWebSocketServerDevice(QSettings *settings,
                              const QString &settingsGroup,
-                             QWidget *uiParent,
                              QObject *parent = Q_NULLPTR);
 protected:
     bool initialize() final;
     QByteArray read() final;
     QByteArray write(const QByteArray &bytes) final;
     void uninitialize() final;
+    bool socketOptionsSupported() final;
 private:
     QWebSocketServer *mWebSocketServer;
     QList<QWebSocket*> mClientList;
@@ -20,6 +20,7 @@
 
 #include "SAKMainWindow.hh"
 #include "SAKApplication.hh"
+#include "SAKCommonStartupTracer.hh"
 
 int main(int argc, char *argv[])
 {
@@ -29,10 +30,12 @@ int main(int argc, char *argv[])
 #endif
     // The application can be reboot.
     do {
+        SAKCommonStartupTracer::start();
         SAKApplication app(argc, argv);
         // Setup main window
         app.showSplashScreenMessage(QObject::tr("Initializing main window..."));
         SAKMainWindow mainWindow(app.settings(), app.sqlDatabase());
+        SAKCommonStartupTracer::mark(QString("Main window"));
         QObject::connect(&app, &SAKApplication::activeMainWindow,
                          &mainWindow, &SAKMainWindow::activateWindow);
         mainWindow.show();
@@ -57,6 +60,19 @@ int main(int argc, char *argv[])
         // Close the splash screen.
         QSplashScreen *splashScreen = app.splashScreen();
         splashScreen->finish(&mainWindow);
+        SAKCommonStartupTracer::mark(QString("Show main window"));
+
+
+        // The startup is finished when the event loop is running, if the
+        // environment variable QSAK_STARTUP_EXIT is set, the application exits
+        // at once(the exit code is 2 if the startup is out of budget), it is
+        // used to measure the startup time.
+        QTimer::singleShot(0, &app, [&](){
+            bool ok = SAKCommonStartupTracer::finish();
+            if (!qgetenv("QSAK_STARTUP_EXIT").isEmpty()) {
+                app.exit(ok ? 0 : 2);
+            }
+        });
 
 
         // If exit code is SAK_REBOOT_CODE(1314), The application will reboot.
@@ -22,48 +22,64 @@ INCLUDEPATH += \
 
 FORMS += \
     $$PWD/SAKModbusDebugPage.ui \
+    $$PWD/client/SAKModbusClientPollingWidget.ui \
     $$PWD/common/SAKModbusCommonClientSection.ui \
     $$PWD/common/SAKModbusCommonHostSection.ui \
-    $$PWD/common/SAKModbusCommonRegister.ui \
     $$PWD/common/SAKModbusCommonRegisterViewController.ui \
     $$PWD/common/SAKModbusCommonReigsterView.ui \
     $$PWD/common/SAKModbusCommonSerialPortSection.ui \
-    $$PWD/common/SAKModbusCommonServerSection.ui
+    $$PWD/common/SAKModbusCommonServerSection.ui \
+    $$PWD/common/SAKModbusCommonStatisticsWidget.ui
 
 HEADERS += \
     $$PWD/SAKModbusDebugger.hh \
     $$PWD/client/SAKModbusClientController.hh \
     $$PWD/client/SAKModbusClientControllerSerialPort.hh \
     $$PWD/client/SAKModbusClientControllerTcp.hh \
+    $$PWD/client/SAKModbusClientPoller.hh \
+    $$PWD/client/SAKModbusClientPollingWidget.hh \
     $$PWD/common/SAKModbusCommonClientSection.hh \
+    $$PWD/common/SAKModbusCommonCodec.hh \
     $$PWD/common/SAKModbusCommonController.hh \
-    $$PWD/common/SAKModbusCommonFlowLayout.hh \
     $$PWD/common/SAKModbusCommonHostSection.hh \
     $$PWD/common/SAKModbusCommonInterface.hh \
-    $$PWD/common/SAKModbusCommonRegister.hh \
+    $$PWD/common/SAKModbusCommonRegisterModel.hh \
     $$PWD/common/SAKModbusCommonRegisterView.hh \
     $$PWD/common/SAKModbusCommonRegisterViewController.hh \
     $$PWD/common/SAKModbusCommonSerialPortSection.hh \
     $$PWD/common/SAKModbusCommonServerSection.hh \
+    $$PWD/common/SAKModbusCommonSnapshot.hh \
+    $$PWD/common/SAKModbusCommonSnapshotDiffDialog.hh \
+    $$PWD/common/SAKModbusCommonStatistics.hh \
+    $$PWD/common/SAKModbusCommonStatisticsChart.hh \
+    $$PWD/common/SAKModbusCommonStatisticsWidget.hh \
     $$PWD/server/SAKModbusServerController.hh \
     $$PWD/server/SAKModbusServerControllerSerialPort.hh \
-    $$PWD/server/SAKModbusServerControllerTcp.hh
+    $$PWD/server/SAKModbusServerControllerTcp.hh \
+    $$PWD/server/SAKModbusServerDevice.hh
 
 SOURCES += \
     $$PWD/SAKModbusDebugger.cc \
     $$PWD/client/SAKModbusClientController.cc \
     $$PWD/client/SAKModbusClientControllerSerialPort.cc \
     $$PWD/client/SAKModbusClientControllerTcp.cc \
+    $$PWD/client/SAKModbusClientPoller.cc \
+    $$PWD/client/SAKModbusClientPollingWidget.cc \
     $$PWD/common/SAKModbusCommonClientSection.cc \
+    $$PWD/common/SAKModbusCommonCodec.cc \
     $$PWD/common/SAKModbusCommonController.cc \
-    $$PWD/common/SAKModbusCommonFlowLayout.cc \
     $$PWD/common/SAKModbusCommonHostSection.cc \
     $$PWD/common/SAKModbusCommonInterface.cc \
-    $$PWD/common/SAKModbusCommonRegister.cc \
+    $$PWD/common/SAKModbusCommonRegisterModel.cc \
     $$PWD/common/SAKModbusCommonRegisterView.cc \
     $$PWD/common/SAKModbusCommonRegisterViewController.cc \
     $$PWD/common/SAKModbusCommonSerialPortSection.cc \
     $$PWD/common/SAKModbusCommonServerSection.cc \
+    $$PWD/common/SAKModbusCommonSnapshot.cc \
+    $$PWD/common/SAKModbusCommonSnapshotDiffDialog.cc \
+    $$PWD/common/SAKModbusCommonStatistics.cc \
+    $$PWD/common/SAKModbusCommonStatisticsChart.cc \
+    $$PWD/common/SAKModbusCommonStatisticsWidget.cc \
     $$PWD/server/SAKModbusServerController.cc \
     $$PWD/server/SAKModbusServerControllerSerialPort.cc \
     $$PWD/server/SAKModbusServerControllerTcp.cc
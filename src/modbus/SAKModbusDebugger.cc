@@ -11,16 +11,18 @@
 #include <QDateTime>
 #include <QLineEdit>
 #include <QTabWidget>
+#include <QElapsedTimer>
 #include <QModbusDataUnit>
 #include <QStandardItemModel>
 
 #include "SAKModbusDebugger.hh"
-#include "SAKModbusCommonRegister.hh"
-#include "SAKModbusCommonFlowLayout.hh"
+#include "SAKModbusCommonCodec.hh"
 #include "SAKModbusCommonController.hh"
 #include "SAKModbusCommonRegisterView.hh"
 #include "SAKModbusClientControllerTcp.hh"
 #include "SAKModbusServerControllerTcp.hh"
+#include "SAKModbusClientPollingWidget.hh"
+#include "SAKModbusCommonStatisticsWidget.hh"
 #include "SAKModbusCommonSerialPortSection.hh"
 #include "SAKModbusClientControllerSerialPort.hh"
 #include "SAKModbusServerControllerSerialPort.hh"
@@ -38,6 +40,8 @@ SAKModbusDebugger::SAKModbusDebugger(QSettings *settings,
     ,mSettings(settings)
     ,mSplashScreen(Q_NULLPTR)
     ,mSqlDatabase(sqlDatabase)
+    ,mPollingWidget(Q_NULLPTR)
+    ,mStatisticsWidget(Q_NULLPTR)
     ,ui(new Ui::SAKModbusDebugPage)
 {
     Q_UNUSED(settingsGroup)
@@ -87,6 +91,23 @@ SAKModbusDebugger::SAKModbusDebugger(QSettings *settings,
         var.widget->layout()->addWidget(registerViewController);
     }
 
+    // Cyclic reading, the page is available for clients only.
+    mPollingWidget = new SAKModbusClientPollingWidget(this);
+    ui->tabWidget->addTab(mPollingWidget, tr("Polling"));
+    connect(mPollingWidget->poller(), &SAKModbusClientPoller::requestFinished,
+            this, &SAKModbusDebugger::addStatisticsRecord);
+    connect(mPollingWidget->poller(), &SAKModbusClientPoller::errorOccurred,
+            this, [=](QString msg){outputMessage(msg, true);});
+    connect(mPollingWidget->poller(), &SAKModbusClientPoller::dataUnitRead,
+            this, [=](int serverAddress, const QModbusDataUnit &mdu){
+        Q_UNUSED(serverAddress);
+        saveDataUnit(mdu);
+    });
+
+    // Traffic statistics of the current device(client or server).
+    mStatisticsWidget = new SAKModbusCommonStatisticsWidget(this);
+    ui->tabWidget->addTab(mStatisticsWidget, tr("Statistics"));
+
     // Combo box items
     struct DeviceInfo {int type; QString name;};
     QList<DeviceInfo> deviceInfoList;
@@ -198,19 +219,8 @@ QWidget *SAKModbusDebugger::controllerFromType(int type)
 
 void SAKModbusDebugger::outputModbusDataUnit(QModbusDataUnit mdu)
 {
-    auto startAddress = mdu.startAddress();
-    auto valueCount = mdu.valueCount();
-    QList<qint16> valueList;
-    for (unsigned int i = startAddress; i < valueCount; i++){
-        auto value = mdu.value(i);
-        valueList.append(value);
-    }
-
-    QByteArray data;
-    for (auto &var : valueList){
-        data.append(reinterpret_cast<char*>(&var)[1]);
-        data.append(reinterpret_cast<char*>(&var)[0]);
-    }
+    // The values in the order of the wire(big endian).
+    QByteArray data = SAKModbusCommonCodec::bytes(mdu.values());
 #if QT_VERSION >= QT_VERSION_CHECK(5, 9, 0)
     QString dataStr = QString(data.toHex(' '));
 #else
@@ -241,16 +251,24 @@ void SAKModbusDebugger::setData(QModbusDataUnit::RegisterType type,
     }
 }
 
+void SAKModbusDebugger::saveDataUnit(const QModbusDataUnit &mdu)
+{
+    auto clientController = qobject_cast<SAKModbusClientController*>(mController);
+    if (clientController){
+        clientController->setDataUnit(mdu);
+    }
+}
+
 void SAKModbusDebugger::updateRegisterValue(QModbusDataUnit::RegisterType registerTyp,
                                             quint16 startAddress,
                                             quint16 addressNumber)
 {
     auto view = registerView(registerTyp);
-    if (view){
-        for (quint16 i = startAddress; i < addressNumber; i++){
-            auto value = mController->registerValue(registerTyp, startAddress + i);
-            view->updateRegisterValue(startAddress + i, value);
-        }
+    if (view && mController && addressNumber){
+        view->updateRegisterValues(startAddress,
+                                   mController->registerValues(registerTyp,
+                                                               startAddress,
+                                                               addressNumber));
     }
 }
 
@@ -271,26 +289,10 @@ void SAKModbusDebugger::dataWritten(QModbusDataUnit::RegisterType table,
                                     int address,
                                     int size)
 {
-    // The operation is for client only.
-    auto server = qobject_cast<QModbusServer*>(mController->device());
-    if (server){
-        for (int i = address; i < size; i++){
-            quint16 value = 0;
-            server->data(table, address + i, &value);
-            auto view = registerView(table);
-            view->updateRegisterValue(address+i, value);
-        }
-    }
-
-    // The operation is for client only.
-    auto clientController = qobject_cast<SAKModbusClientController*>(mController);
-    if (clientController){
-        for (int i = address; i < size; i++){
-            quint16 value = 0;
-            clientController->tempData(table, address + i, &value);
-            auto view = registerView(table);
-            view->updateRegisterValue(address+i, value);
-        }
+    // The values are read from the registers of server(or the local registers
+    // of client) in one step, and the written range is refreshed once.
+    if ((address >= 0) && (address <= 0xffff) && (size > 0)){
+        updateRegisterValue(table, quint16(address), quint16(qMin(size, 0x10000 - address)));
     }
 }
 
@@ -304,6 +306,16 @@ void SAKModbusDebugger::outputMessage(QString msg, bool isErrorMsg)
     ui->textBrowser->append(msg);
 }
 
+void SAKModbusDebugger::addStatisticsRecord(int serverAddress,
+                                            int functionCode,
+                                            qint64 latency,
+                                            int result)
+{
+    if (mController){
+        mController->statistics()->addRecord(serverAddress, functionCode, latency, result);
+    }
+}
+
 void SAKModbusDebugger::updateTableWidget()
 {
     bool isCoilsRegisterType = true;
@@ -434,31 +446,34 @@ void SAKModbusDebugger::sendReadRequest()
     auto mdu = QModbusDataUnit(registerType, startAddress, number);
     auto controller = qobject_cast<SAKModbusClientController*>(mController);
     QModbusClient *device = qobject_cast<QModbusClient*>(controller->device());
-    auto reply = device->sendReadRequest(mdu, ui->serverAddressSpinBox->value());
+    int serverAddress = ui->serverAddressSpinBox->value();
+    int functionCode = SAKModbusCommonStatistics::functionCode(registerType, false);
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+    auto reply = device->sendReadRequest(mdu, serverAddress);
     if (reply){
         outputModbusDataUnit(mdu);
         if (!reply->isFinished()) {
             connect(reply, &QModbusReply::finished,
                     this, [=](){
+                addStatisticsRecord(serverAddress, functionCode,
+                                    elapsedTimer.nsecsElapsed()/1000,
+                                    SAKModbusCommonStatistics::result(reply->error()));
                 if (reply->error() == QModbusDevice::NoError) {
                     const QModbusDataUnit mdu = reply->result();
                     updateTableWidgetData(mdu);
-                    auto registerType = reply->result().registerType();
-                    auto startAddress = reply->result().startAddress();
-                    auto registerNumber = reply->result().valueCount();
                     outputMessage(QString("<font color=green>%1</font>")
                                   .arg(tr("Register(s) read:")));
                     for (uint i = 0; i < mdu.valueCount(); i++) {
-                        auto value = reply->result().value(startAddress + i);
-                        setData(registerType, startAddress + i, value);
                         int base = mdu.registerType() <= QModbusDataUnit::Coils ? 10 : 16;
                         const QString entry = tr("[Address: %1, Value: %2]")
                                 .arg(mdu.startAddress() + i).
                                 arg(QString::number(mdu.value(i), base));
                         outputMessage(entry);
                     }
-                    // The signal is using to update ui value.
-                    dataWritten(registerType, startAddress, registerNumber);
+                    // The values are saved in one step, and the register view
+                    // is updated by the dataWritten signal.
+                    saveDataUnit(mdu);
                 } else if (reply->error() == QModbusDevice::ProtocolError) {
                     QString error = QString("%1 (Mobus exception: 0x%2)")
                             .arg(reply->errorString())
@@ -500,23 +515,29 @@ void SAKModbusDebugger::sendWriteRequest()
 
     auto controller = qobject_cast<SAKModbusClientController*>(mController);
     QModbusClient *device = qobject_cast<QModbusClient*>(controller->device());
-    auto reply = device->sendWriteRequest(mdu, ui->serverAddressSpinBox->value());
+    int serverAddress = ui->serverAddressSpinBox->value();
+    int functionCode = SAKModbusCommonStatistics::functionCode(registerType, true);
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+    auto reply = device->sendWriteRequest(mdu, serverAddress);
     if (reply) {
         outputModbusDataUnit(mdu);
         if (!reply->isFinished()) {
             connect(reply, &QModbusReply::finished, this, [=]() {
+                addStatisticsRecord(serverAddress, functionCode,
+                                    elapsedTimer.nsecsElapsed()/1000,
+                                    SAKModbusCommonStatistics::result(reply->error()));
                 if (reply->error() == QModbusDevice::NoError) {
                     outputMessage(QString("<font color=blue>%1</font>")
                                   .arg(tr("Register(s) Written:")));
                     for (uint i = 0; i < mdu.valueCount(); i++) {
-                        auto value = reply->result().value(startAddress + i);
-                        setData(registerType, startAddress + i, value);
                         int base = mdu.registerType() <= QModbusDataUnit::Coils ? 10 : 16;
                         const QString entry = tr("[Address: %1, Value: %2]")
                                 .arg(mdu.startAddress() + i).
                                 arg(QString::number(mdu.value(i), base));
                         outputMessage(entry);
                     }
+                    saveDataUnit(mdu);
                 } else if (reply->error() == QModbusDevice::ProtocolError) {
                     QString err = QString("%1 (Mobus exception: 0x%2)")
                             .arg(reply->errorString())
@@ -543,10 +564,13 @@ void SAKModbusDebugger::sendWriteRequest()
 
 void SAKModbusDebugger::updateController(int index)
 {
+    // The old controller(and the client) will be deleted later.
+    mPollingWidget->setClient(Q_NULLPTR);
     mController = qobject_cast<SAKModbusCommonController*>(controllerFromType(index));
     mController->setContentsMargins(0, 0, 0 ,0);
 
     auto *dev = mController->device();
+    mStatisticsWidget->setStatistics(mController->statistics());
     connect(mController, &SAKModbusCommonController::dataWritten,
             this, &SAKModbusDebugger::dataWritten);
     connect(mController, &SAKModbusCommonController::invokeOutputMessage,
@@ -556,6 +580,8 @@ void SAKModbusDebugger::updateController(int index)
                 mController, &SAKModbusCommonController::importRegisterData);
         connect(var, &SAKModbusCommonRegisterViewController::invokeExport,
                 mController, &SAKModbusCommonController::exportRegisterData);
+        connect(var, &SAKModbusCommonRegisterViewController::invokeCompare,
+                mController, &SAKModbusCommonController::compareRegisterData);
     }
     connect(dev, &QModbusDevice::stateChanged, this, [=](){
         ui->connectionPushButton->setEnabled(
@@ -583,32 +609,23 @@ void SAKModbusDebugger::updateController(int index)
         ui->connectionPushButton->setEnabled(true);
     }
 
-    // Update the value of registers.
+    // Update the value of registers, the values of the range are updated by
+    // invokeUpdateRegisterValue signal.
     quint16 startAddress = 0;
     quint16 registerNumber = 16;
     for (auto &var : mRegisterViewList){
         var->updateRegister(startAddress, registerNumber);
-        for (int i = startAddress; i < registerNumber; i++){
-            var->updateRegisterValue(startAddress + i,
-                                     mController->registerValue(var->registerType(),
-                                                                startAddress + i));
-        }
     }
 
+    // The register pages of a client show the values read(or polled).
+    int pollingPageIndex = ui->tabWidget->indexOf(mPollingWidget);
     if (index == 0 || index == 2) {
         ui->operationPanelGroupBox->setHidden(false);
-        for (int i = 0; i < ui->tabWidget->count(); i++) {
-            if (i > 0) {
-                ui->tabWidget->setTabEnabled(i, false);
-            }
-        }
+        ui->tabWidget->setTabEnabled(pollingPageIndex, true);
+        mPollingWidget->setClient(qobject_cast<QModbusClient*>(dev));
     } else {
         ui->operationPanelGroupBox->setHidden(true);
-        for (int i = 0; i < ui->tabWidget->count(); i++) {
-            if (i > 0) {
-                ui->tabWidget->setTabEnabled(i, true);
-            }
-        }
+        ui->tabWidget->setTabEnabled(pollingPageIndex, false);
     }
 }
 
@@ -25,6 +25,8 @@ namespace Ui {
 class SAKModbusCommonController;
 class SAKModbusCommonRegisterView;
 class SAKModbusCommonRegisterViewController;
+class SAKModbusClientPollingWidget;
+class SAKModbusCommonStatisticsWidget;
 class SAKModbusDebugger : public QWidget
 {
     Q_OBJECT
@@ -55,16 +57,21 @@ private:
     SAKModbusCommonController *mController;
     QList<SAKModbusCommonRegisterView *> mRegisterViewList;
     QList<SAKModbusCommonRegisterViewController *> mRegisterViewControllerList;
+    SAKModbusClientPollingWidget *mPollingWidget;
+    SAKModbusCommonStatisticsWidget *mStatisticsWidget;
     SettingsKeyContext mSettingsKeyContext;
 private:
     QWidget *controllerFromType(int type);
     void outputModbusDataUnit(QModbusDataUnit mdu);
     void setData(QModbusDataUnit::RegisterType type, quint16 address, quint16 value);
+    // Save the values read(or written) by client to the local registers.
+    void saveDataUnit(const QModbusDataUnit &mdu);
     void updateRegisterValue(QModbusDataUnit::RegisterType registerTyp, quint16 startAddress, quint16 addressNumber);
     SAKModbusCommonRegisterView *registerView(QModbusDataUnit::RegisterType registerTyp);
-    // Just for modbus server
+    // Refresh the range written(by a remote client or by reading)
     void dataWritten(QModbusDataUnit::RegisterType table, int address, int size);
     void outputMessage(QString msg, bool isErrorMsg = false);
+    void addStatisticsRecord(int serverAddress, int functionCode, qint64 latency, int result);
     void updateTableWidget();
     void sendReadRequest();
     void sendWriteRequest();
@@ -42,6 +42,13 @@ void SAKModbusClientController::setData(QModbusDataUnit::RegisterType type,
     }
 }
 
+void SAKModbusClientController::setDataUnit(const QModbusDataUnit &mdu)
+{
+    if (mModbusServer->setData(mdu)){
+        emit dataWritten(mdu.registerType(), mdu.startAddress(), int(mdu.valueCount()));
+    }
+}
+
 quint16 SAKModbusClientController::registerValue(QModbusDataUnit::RegisterType type,
                                                  quint16 address)
 {
@@ -54,6 +61,13 @@ quint16 SAKModbusClientController::registerValue(QModbusDataUnit::RegisterType t
     return value;
 }
 
+QVector<quint16> SAKModbusClientController::registerValues(QModbusDataUnit::RegisterType type,
+                                                          quint16 startAddress,
+                                                          quint16 registerNumber)
+{
+    return serverRegisterValues(mModbusServer, type, startAddress, registerNumber);
+}
+
 void SAKModbusClientController::exportRegisterData()
 {
     auto fileName = getSaveFileName();
@@ -149,20 +163,15 @@ void SAKModbusClientController::readReply()
         const QModbusDataUnit mdu = reply->result();
         emit modbusDataUnitRead(mdu);
 
-        auto registerType = reply->result().registerType();
-        auto startAddress = reply->result().startAddress();
-        auto registerNumber = reply->result().valueCount();
         emit invokeOutputMessage(tr("Received a reply:"));
         for (uint i = 0; i < mdu.valueCount(); i++) {
-            auto value = reply->result().value(startAddress + i);
-            setData(registerType, startAddress + i, value);
             int base = mdu.registerType() <= QModbusDataUnit::Coils ? 10 : 16;
             const QString entry = tr("[Address: %1, Value: %2]")
                     .arg(mdu.startAddress() + i).arg(QString::number(mdu.value(i), base));
             emit invokeOutputMessage(entry);
         }
-        // The signal is using to update ui value.
-        emit dataWritten(registerType, startAddress, registerNumber);
+        // The signal(dataWritten) is using to update ui value.
+        setDataUnit(mdu);
     } else if (reply->error() == QModbusDevice::ProtocolError) {
         QString error = tr("Read response error: %1 (Mobus exception: 0x%2)")
                 .arg(reply->errorString()).arg(reply->rawResult().exceptionCode(), -1, 16);
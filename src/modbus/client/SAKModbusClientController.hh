@@ -23,10 +23,13 @@ public:
     SAKModbusClientController(QWidget *parent = Q_NULLPTR);
     virtual void setData(QModbusDataUnit::RegisterType type, quint16 address, quint16 value) final;
     virtual quint16 registerValue(QModbusDataUnit::RegisterType type, quint16 address) final;
+    virtual QVector<quint16> registerValues(QModbusDataUnit::RegisterType type, quint16 startAddress, quint16 registerNumber) final;
     virtual void exportRegisterData() final;
     virtual void importRegisterData() final;
 
     bool tempData(QModbusDataUnit::RegisterType table, quint16 address, quint16 *data);
+    /// @brief Save a unit(such as a polling result) to local registers in one step.
+    void setDataUnit(const QModbusDataUnit &mdu);
 protected:
     SAKModbusCommonClientSection *mClientSection;
     // The value is for saving data only.
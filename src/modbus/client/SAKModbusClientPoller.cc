@@ -0,0 +1,304 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QMap>
+#include <QDebug>
+#include <QtAlgorithms>
+
+#include "SAKModbusClientPoller.hh"
+#include "SAKModbusCommonStatistics.hh"
+
+SAKModbusClientPoller::SAKModbusClientPoller(QObject *parent)
+    :QObject(parent)
+    ,mNextBlock(0)
+    ,mInFlight(0)
+    ,mDepth(1)
+    ,mActive(false)
+    ,mGeneration(0)
+    ,mPoints(0)
+    ,mRequests(0)
+    ,mReplies(0)
+    ,mLatency(0)
+    ,mTimeouts(0)
+    ,mErrors(0)
+{
+    mCycleTimer.setSingleShot(true);
+    connect(&mCycleTimer, &QTimer::timeout, this, &SAKModbusClientPoller::startCycle);
+    mStatisticsTimer.setInterval(1000);
+    connect(&mStatisticsTimer, &QTimer::timeout,
+            this, &SAKModbusClientPoller::onStatisticsTimerTimeout);
+}
+
+SAKModbusClientPoller::~SAKModbusClientPoller()
+{
+    stop();
+}
+
+int SAKModbusClientPoller::maxRegisterNumber(QModbusDataUnit::RegisterType type)
+{
+    // The limits of function code 0x01, 0x02, 0x03 and 0x04.
+    if ((type == QModbusDataUnit::Coils) || (type == QModbusDataUnit::DiscreteInputs)) {
+        return 2000;
+    }
+
+    return 125;
+}
+
+QList<SAKModbusClientPoller::SAKStructRangeContext>
+SAKModbusClientPoller::coalesce(QList<SAKStructRangeContext> ranges, int maxGap)
+{
+    std::sort(ranges.begin(), ranges.end(),
+              [](const SAKStructRangeContext &a, const SAKStructRangeContext &b){
+        if (a.serverAddress != b.serverAddress) {
+            return a.serverAddress < b.serverAddress;
+        } else if (a.type != b.type) {
+            return a.type < b.type;
+        }
+        return a.startAddress < b.startAddress;
+    });
+
+    // The end addresses are exclusive.
+    QList<SAKStructRangeContext> merged;
+    int start = -1;
+    int end = -1;
+    SAKStructRangeContext current{0, QModbusDataUnit::Invalid, 0, 0};
+    auto flush = [&](){
+        if (start < 0) {
+            return;
+        }
+
+        // The range may be longer than the limit of a request.
+        int limit = maxRegisterNumber(current.type);
+        for (int address = start; address < end; address += limit) {
+            SAKStructRangeContext ctx = current;
+            ctx.startAddress = quint16(address);
+            ctx.registerNumber = quint16(qMin(limit, end - address));
+            merged.append(ctx);
+        }
+        start = -1;
+    };
+
+    for (auto &range : ranges) {
+        if (range.registerNumber == 0) {
+            continue;
+        }
+
+        int rangeStart = range.startAddress;
+        int rangeEnd = qMin(rangeStart + int(range.registerNumber), 65536);
+        bool sameTable = (start >= 0)
+                && (range.serverAddress == current.serverAddress)
+                && (range.type == current.type);
+        int limit = maxRegisterNumber(range.type);
+        if (sameTable
+                && (rangeStart <= end + maxGap)
+                && ((qMax(end, rangeEnd) - start <= limit) || (rangeStart < end))) {
+            end = qMax(end, rangeEnd);
+        } else {
+            flush();
+            current = range;
+            start = rangeStart;
+            end = rangeEnd;
+        }
+    }
+    flush();
+
+    return merged;
+}
+
+void SAKModbusClientPoller::setClient(QModbusClient *client)
+{
+    stop();
+    mClient = client;
+    // The replies of the old client may never finish.
+    mInFlight = 0;
+    mGeneration += 1;
+}
+
+void SAKModbusClientPoller::setScanList(const QList<SAKStructRangeContext> &ranges,
+                                        int maxGap)
+{
+    mBlocks.clear();
+    for (auto &range : coalesce(ranges, maxGap)) {
+        mBlocks.append(SAKStructBlockContext{range, 0, 0, 0, 0, 0});
+    }
+    mNextBlock = 0;
+    mInFlight = 0;
+    mGeneration += 1;
+}
+
+void SAKModbusClientPoller::setInterval(int interval)
+{
+    mCycleTimer.setInterval(qMax(interval, 0));
+}
+
+void SAKModbusClientPoller::setDepth(int depth)
+{
+    mDepth = qMax(depth, 1);
+}
+
+void SAKModbusClientPoller::start()
+{
+    if (mActive || (!mClient) || mBlocks.isEmpty()) {
+        return;
+    }
+
+    mActive = true;
+    mInFlight = 0;
+    mGeneration += 1;
+    mPoints = 0;
+    mRequests = 0;
+    mReplies = 0;
+    mLatency = 0;
+    mTimeouts = 0;
+    mErrors = 0;
+    mStatisticsElapsedTimer.start();
+    mStatisticsTimer.start();
+    emit activeChanged(true);
+    startCycle();
+}
+
+void SAKModbusClientPoller::stop()
+{
+    // The requests in flight are ignored, their replies belong to an old
+    // generation, they are not counted.
+    mInFlight = 0;
+    mGeneration += 1;
+    if (!mActive) {
+        return;
+    }
+
+    mActive = false;
+    mCycleTimer.stop();
+    mStatisticsTimer.stop();
+    emit activeChanged(false);
+}
+
+bool SAKModbusClientPoller::isActive()
+{
+    return mActive;
+}
+
+QList<SAKModbusClientPoller::SAKStructBlockContext> SAKModbusClientPoller::blocks()
+{
+    return mBlocks;
+}
+
+void SAKModbusClientPoller::startCycle()
+{
+    mNextBlock = 0;
+    mCycleElapsedTimer.start();
+    sendRequests();
+}
+
+void SAKModbusClientPoller::sendRequests()
+{
+    if ((!mActive) || (!mClient)) {
+        return;
+    }
+
+    if (mClient->state() != QModbusDevice::ConnectedState) {
+        emit errorOccurred(tr("The device is not connected, polling is stopped."));
+        stop();
+        return;
+    }
+
+    // The serial port client handles a request at a time, the requests are
+    // queued by the client, so the latency includes the time of queuing.
+    int depth = mClient->inherits("QModbusTcpClient") ? mDepth : 1;
+    while ((mInFlight < depth) && (mNextBlock < mBlocks.count())) {
+        int blockIndex = mNextBlock++;
+        auto range = mBlocks.at(blockIndex).range;
+        QModbusDataUnit unit(range.type, range.startAddress, range.registerNumber);
+        qint64 sendingTime = mStatisticsElapsedTimer.nsecsElapsed();
+        QModbusReply *reply = mClient->sendReadRequest(unit, range.serverAddress);
+        if (!reply) {
+            mBlocks[blockIndex].errors += 1;
+            mErrors += 1;
+            emit requestFinished(range.serverAddress,
+                                 SAKModbusCommonStatistics::functionCode(range.type, false),
+                                 0, SAKModbusCommonStatistics::ResultError);
+            emit errorOccurred(mClient->errorString());
+            continue;
+        }
+
+        mBlocks[blockIndex].requests += 1;
+        mRequests += 1;
+        if (reply->isFinished()) {
+            // Broadcast
+            reply->deleteLater();
+            continue;
+        }
+
+        mInFlight += 1;
+        quint64 generation = mGeneration;
+        connect(reply, &QModbusReply::finished, this, [=](){
+            onReplyFinished(reply, blockIndex, sendingTime, generation);
+        });
+    }
+
+    // The cycle is finished, the next cycle is started after the interval.
+    if ((mNextBlock >= mBlocks.count()) && (mInFlight == 0)) {
+        qint64 elapsed = mCycleElapsedTimer.elapsed();
+        int remaining = int(qMax(qint64(0), mCycleTimer.interval() - elapsed));
+        mCycleTimer.start(remaining);
+    }
+}
+
+void SAKModbusClientPoller::onReplyFinished(QModbusReply *reply,
+                                            int blockIndex,
+                                            qint64 sendingTime,
+                                            quint64 generation)
+{
+    reply->deleteLater();
+    if (generation != mGeneration) {
+        // The reply of an old generation is not counted by mInFlight.
+        sendRequests();
+        return;
+    }
+
+    mInFlight -= 1;
+    if (!mActive) {
+        return;
+    }
+
+    qint64 latency = (mStatisticsElapsedTimer.nsecsElapsed() - sendingTime)/1000;
+    auto &block = mBlocks[blockIndex];
+    emit requestFinished(block.range.serverAddress,
+                         SAKModbusCommonStatistics::functionCode(block.range.type, false),
+                         latency, SAKModbusCommonStatistics::result(reply->error()));
+    if (reply->error() == QModbusDevice::NoError) {
+        block.lastLatency = latency;
+        block.totalLatency += latency;
+        mLatency += latency;
+        mReplies += 1;
+        mPoints += reply->result().valueCount();
+        emit dataUnitRead(block.range.serverAddress, reply->result());
+    } else if (reply->error() == QModbusDevice::TimeoutError) {
+        block.timeouts += 1;
+        mTimeouts += 1;
+    } else {
+        block.errors += 1;
+        mErrors += 1;
+        emit errorOccurred(reply->errorString());
+    }
+
+    sendRequests();
+}
+
+void SAKModbusClientPoller::onStatisticsTimerTimeout()
+{
+    double seconds = mStatisticsElapsedTimer.elapsed()/1000.0;
+    SAKStructStatisticsContext ctx;
+    ctx.pointsPerSecond = seconds > 0 ? mPoints/seconds : 0;
+    ctx.requestsPerSecond = seconds > 0 ? mRequests/seconds : 0;
+    ctx.averageLatency = mReplies > 0 ? (mLatency/1000.0)/mReplies : 0;
+    ctx.timeouts = mTimeouts;
+    ctx.errors = mErrors;
+    emit statisticsChanged(ctx);
+}
@@ -0,0 +1,120 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKMODBUSCLIENTPOLLER_HH
+#define SAKMODBUSCLIENTPOLLER_HH
+
+#include <QList>
+#include <QTimer>
+#include <QObject>
+#include <QPointer>
+#include <QModbusReply>
+#include <QElapsedTimer>
+#include <QModbusClient>
+#include <QModbusDataUnit>
+
+/// @brief Poll the ranges of the scan list continuously. The ranges of the same
+/// server and register type are merged into the fewest requests, several
+/// requests can be in flight at the same time(modbus tcp). The timeout and the
+/// retries are the parameters of the client.
+class SAKModbusClientPoller : public QObject
+{
+    Q_OBJECT
+public:
+    struct SAKStructRangeContext {
+        int serverAddress;
+        QModbusDataUnit::RegisterType type;
+        quint16 startAddress;
+        quint16 registerNumber;
+    };
+
+    struct SAKStructBlockContext {
+        SAKStructRangeContext range;
+        qint64 requests;
+        qint64 timeouts;
+        qint64 errors;
+        qint64 lastLatency;     // us
+        qint64 totalLatency;    // us
+    };
+
+    struct SAKStructStatisticsContext {
+        double pointsPerSecond;
+        double requestsPerSecond;
+        double averageLatency;  // ms
+        qint64 timeouts;
+        qint64 errors;
+    };
+public:
+    SAKModbusClientPoller(QObject *parent = Q_NULLPTR);
+    ~SAKModbusClientPoller();
+
+    /**
+     * @brief maxRegisterNumber: The max number of registers that can be read
+     * by a request.
+     */
+    static int maxRegisterNumber(QModbusDataUnit::RegisterType type);
+
+    /**
+     * @brief coalesce: Merge the adjacent or overlapping ranges.
+     * @param ranges: Ranges to be merged.
+     * @param maxGap: Ranges are merged if the gap between them is not greater
+     * than the value(the registers of the gap are read too).
+     * @return The ranges those can be read by a request each.
+     */
+    static QList<SAKStructRangeContext> coalesce(QList<SAKStructRangeContext> ranges,
+                                                 int maxGap = 0);
+
+    void setClient(QModbusClient *client);
+    void setScanList(const QList<SAKStructRangeContext> &ranges, int maxGap = 0);
+    // The min interval of scanning cycles(ms), 0 means polling without waiting.
+    void setInterval(int interval);
+    // The max number of requests in flight, it is 1 for serial port.
+    void setDepth(int depth);
+
+    void start();
+    void stop();
+    bool isActive();
+    QList<SAKStructBlockContext> blocks();
+private:
+    QPointer<QModbusClient> mClient;
+    QList<SAKStructBlockContext> mBlocks;
+    int mNextBlock;
+    int mInFlight;
+    int mDepth;
+    bool mActive;
+    QTimer mCycleTimer;
+    QTimer mStatisticsTimer;
+    QElapsedTimer mCycleElapsedTimer;
+    QElapsedTimer mStatisticsElapsedTimer;
+    // The replies of previous scan lists are ignored.
+    quint64 mGeneration;
+    qint64 mPoints;
+    qint64 mRequests;
+    qint64 mReplies;
+    qint64 mLatency;
+    qint64 mTimeouts;
+    qint64 mErrors;
+private:
+    void startCycle();
+    void sendRequests();
+    void onReplyFinished(QModbusReply *reply,
+                         int blockIndex,
+                         qint64 sendingTime,
+                         quint64 generation);
+    void onStatisticsTimerTimeout();
+signals:
+    void dataUnitRead(int serverAddress, const QModbusDataUnit &unit);
+    // The result is SAKModbusCommonStatistics::SAKEnumResult, latency unit: us.
+    void requestFinished(int serverAddress, int functionCode, qint64 latency, int result);
+    void errorOccurred(const QString &errorString);
+    void statisticsChanged(const SAKStructStatisticsContext &ctx);
+    void activeChanged(bool active);
+};
+
+#endif // SAKMODBUSCLIENTPOLLER_HH
@@ -0,0 +1,213 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QDebug>
+#include <QHeaderView>
+#include <QTableWidget>
+
+#include "SAKModbusCommonCodec.hh"
+#include "SAKModbusClientPollingWidget.hh"
+#include "ui_SAKModbusClientPollingWidget.h"
+
+SAKModbusClientPollingWidget::SAKModbusClientPollingWidget(QWidget *parent)
+    :QWidget(parent)
+    ,mPoller(new SAKModbusClientPoller(this))
+    ,mClient(Q_NULLPTR)
+    ,ui(new Ui::SAKModbusClientPollingWidget)
+{
+    ui->setupUi(this);
+
+    ui->registerTypeComboBox->addItem(tr("Coils(0x01)"), QModbusDataUnit::Coils);
+    ui->registerTypeComboBox->addItem(tr("Discrete Inputs(0x02)"), QModbusDataUnit::DiscreteInputs);
+    ui->registerTypeComboBox->addItem(tr("Holding Registers(0x03)"), QModbusDataUnit::HoldingRegisters);
+    ui->registerTypeComboBox->addItem(tr("Input Registers(0x04)"), QModbusDataUnit::InputRegisters);
+
+    QStringList dataTypeNames = SAKModbusCommonCodec::dataTypeNames();
+    for (int i = 0; i < dataTypeNames.count(); i++) {
+        ui->dataTypeComboBox->addItem(dataTypeNames.at(i), i);
+    }
+    QStringList byteOrderNames = SAKModbusCommonCodec::byteOrderNames();
+    for (int i = 0; i < byteOrderNames.count(); i++) {
+        ui->byteOrderComboBox->addItem(byteOrderNames.at(i), i);
+    }
+
+    QStringList headerLabels;
+    headerLabels << tr("Server Address")
+                 << tr("Register Type")
+                 << tr("Start Address")
+                 << tr("Register Number")
+                 << tr("Data Type")
+                 << tr("Byte Order")
+                 << tr("Values");
+    ui->scanTableWidget->setColumnCount(headerLabels.count());
+    ui->scanTableWidget->setHorizontalHeaderLabels(headerLabels);
+    ui->scanTableWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    ui->scanTableWidget->horizontalHeader()->setStretchLastSection(true);
+    ui->scanTableWidget->verticalHeader()->setVisible(false);
+
+    connect(ui->addPushButton, &QPushButton::clicked,
+            this, &SAKModbusClientPollingWidget::addRange);
+    connect(ui->removePushButton, &QPushButton::clicked,
+            this, &SAKModbusClientPollingWidget::removeRange);
+    connect(ui->startPushButton, &QPushButton::clicked,
+            this, &SAKModbusClientPollingWidget::startPolling);
+    connect(ui->stopPushButton, &QPushButton::clicked,
+            mPoller, &SAKModbusClientPoller::stop);
+    connect(mPoller, &SAKModbusClientPoller::activeChanged,
+            this, &SAKModbusClientPollingWidget::updateUiState);
+    connect(mPoller, &SAKModbusClientPoller::statisticsChanged,
+            this, &SAKModbusClientPollingWidget::onStatisticsChanged);
+    connect(mPoller, &SAKModbusClientPoller::dataUnitRead,
+            this, &SAKModbusClientPollingWidget::onDataUnitRead);
+
+    updateUiState();
+}
+
+SAKModbusClientPollingWidget::~SAKModbusClientPollingWidget()
+{
+    delete ui;
+}
+
+void SAKModbusClientPollingWidget::setClient(QModbusClient *client)
+{
+    mClient = client;
+    mPoller->setClient(client);
+    updateUiState();
+}
+
+SAKModbusClientPoller *SAKModbusClientPollingWidget::poller()
+{
+    return mPoller;
+}
+
+QList<SAKModbusClientPoller::SAKStructRangeContext>
+SAKModbusClientPollingWidget::scanList()
+{
+    QList<SAKModbusClientPoller::SAKStructRangeContext> ranges;
+    for (int row = 0; row < ui->scanTableWidget->rowCount(); row++) {
+        auto cell = [=](int column){
+            return ui->scanTableWidget->item(row, column)->data(Qt::UserRole).toInt();
+        };
+        SAKModbusClientPoller::SAKStructRangeContext ctx;
+        ctx.serverAddress = cell(0);
+        ctx.type = static_cast<QModbusDataUnit::RegisterType>(cell(1));
+        ctx.startAddress = quint16(cell(2));
+        ctx.registerNumber = quint16(cell(3));
+        ranges.append(ctx);
+    }
+
+    return ranges;
+}
+
+void SAKModbusClientPollingWidget::addRange()
+{
+    int row = ui->scanTableWidget->rowCount();
+    ui->scanTableWidget->insertRow(row);
+    auto setCell = [=](int column, const QString &text, int value){
+        auto item = new QTableWidgetItem(text);
+        item->setData(Qt::UserRole, value);
+        item->setTextAlignment(Qt::AlignCenter);
+        ui->scanTableWidget->setItem(row, column, item);
+    };
+
+    int serverAddress = ui->serverAddressSpinBox->value();
+    int startAddress = ui->startAddressSpinBox->value();
+    int registerNumber = qMin(ui->registerNumberSpinBox->value(), 65536 - startAddress);
+    setCell(0, QString::number(serverAddress), serverAddress);
+    setCell(1, ui->registerTypeComboBox->currentText(),
+            ui->registerTypeComboBox->currentData().toInt());
+    setCell(2, QString::number(startAddress), startAddress);
+    setCell(3, QString::number(registerNumber), registerNumber);
+
+    // The bits are shown as 0 and 1.
+    auto registerType = ui->registerTypeComboBox->currentData().toInt();
+    bool isBitRegister = (registerType == QModbusDataUnit::Coils)
+            || (registerType == QModbusDataUnit::DiscreteInputs);
+    int dataType = isBitRegister
+            ? int(SAKModbusCommonCodec::DataTypeUInt16)
+            : ui->dataTypeComboBox->currentData().toInt();
+    int byteOrder = ui->byteOrderComboBox->currentData().toInt();
+    setCell(4, ui->dataTypeComboBox->itemText(dataType), dataType);
+    setCell(5, ui->byteOrderComboBox->currentText(), byteOrder);
+    setCell(6, QString(), 0);
+    updateUiState();
+}
+
+void SAKModbusClientPollingWidget::removeRange()
+{
+    int row = ui->scanTableWidget->currentRow();
+    if (row >= 0) {
+        ui->scanTableWidget->removeRow(row);
+    }
+    updateUiState();
+}
+
+void SAKModbusClientPollingWidget::startPolling()
+{
+    mPoller->setScanList(scanList(), ui->maxGapSpinBox->value());
+    mPoller->setInterval(ui->intervalSpinBox->value());
+    mPoller->setDepth(ui->depthSpinBox->value());
+    mPoller->start();
+}
+
+void SAKModbusClientPollingWidget::updateUiState()
+{
+    bool isActive = mPoller->isActive();
+    bool isEmpty = ui->scanTableWidget->rowCount() == 0;
+    ui->startPushButton->setEnabled(mClient && (!isActive) && (!isEmpty));
+    ui->stopPushButton->setEnabled(isActive);
+    ui->addPushButton->setEnabled(!isActive);
+    ui->removePushButton->setEnabled(!isActive);
+    ui->maxGapSpinBox->setEnabled(!isActive);
+    ui->intervalSpinBox->setEnabled(!isActive);
+    ui->depthSpinBox->setEnabled(!isActive);
+}
+
+void SAKModbusClientPollingWidget::onStatisticsChanged(
+        const SAKModbusClientPoller::SAKStructStatisticsContext &ctx)
+{
+    QString text = tr("Requests: %1/s, Points: %2/s, Latency: %3 ms, "
+                      "Timeouts: %4, Errors: %5, Requests per cycle: %6")
+            .arg(ctx.requestsPerSecond, 0, 'f', 1)
+            .arg(ctx.pointsPerSecond, 0, 'f', 1)
+            .arg(ctx.averageLatency, 0, 'f', 2)
+            .arg(ctx.timeouts)
+            .arg(ctx.errors)
+            .arg(mPoller->blocks().count());
+    ui->statisticsLabel->setText(text);
+}
+
+void SAKModbusClientPollingWidget::onDataUnitRead(int serverAddress,
+                                                  const QModbusDataUnit &unit)
+{
+    if (!isVisible()) {
+        return;
+    }
+
+    // The unit is a coalesced block, it may cover several ranges.
+    const QVector<quint16> values = unit.values();
+    int unitStart = unit.startAddress();
+    int unitEnd = unitStart + int(unit.valueCount());
+    for (int row = 0; row < ui->scanTableWidget->rowCount(); row++) {
+        auto cell = [=](int column){
+            return ui->scanTableWidget->item(row, column)->data(Qt::UserRole).toInt();
+        };
+        int start = cell(2);
+        int end = start + cell(3);
+        if ((cell(0) != serverAddress) || (cell(1) != unit.registerType())
+                || (start < unitStart) || (end > unitEnd)) {
+            continue;
+        }
+
+        // The first values are shown only.
+        QStringList texts = SAKModbusCommonCodec::texts(values.mid(start - unitStart, end - start),
+                                                        cell(4), cell(5), 32);
+        ui->scanTableWidget->item(row, 6)->setText(texts.join(' '));
+    }
+}
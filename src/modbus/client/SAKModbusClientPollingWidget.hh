@@ -0,0 +1,52 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKMODBUSCLIENTPOLLINGWIDGET_HH
+#define SAKMODBUSCLIENTPOLLINGWIDGET_HH
+
+#include <QWidget>
+#include <QModbusClient>
+
+#include "SAKModbusClientPoller.hh"
+
+namespace Ui {
+    class SAKModbusClientPollingWidget;
+}
+
+/// @brief Edit the scan list and control the poller.
+class SAKModbusClientPollingWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit SAKModbusClientPollingWidget(QWidget *parent = Q_NULLPTR);
+    ~SAKModbusClientPollingWidget();
+
+    /**
+     * @brief setClient: Set the client to be used, polling is stopped.
+     * @param client: The client, it can be null(the device is not a client).
+     */
+    void setClient(QModbusClient *client);
+    SAKModbusClientPoller *poller();
+private:
+    SAKModbusClientPoller *mPoller;
+    QModbusClient *mClient;
+private:
+    QList<SAKModbusClientPoller::SAKStructRangeContext> scanList();
+    void addRange();
+    void removeRange();
+    void startPolling();
+    void updateUiState();
+    void onStatisticsChanged(const SAKModbusClientPoller::SAKStructStatisticsContext &ctx);
+    // Show the decoded values of the ranges those are covered by the unit.
+    void onDataUnitRead(int serverAddress, const QModbusDataUnit &unit);
+private:
+    Ui::SAKModbusClientPollingWidget *ui;
+};
+
+#endif // SAKMODBUSCLIENTPOLLINGWIDGET_HH
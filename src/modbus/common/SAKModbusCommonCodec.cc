@@ -0,0 +1,244 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <cstring>
+#include <QtEndian>
+
+#include "SAKModbusCommonCodec.hh"
+
+namespace {
+template <int Size> struct SAKBits {};
+template <> struct SAKBits<2> {typedef quint16 Type;};
+template <> struct SAKBits<4> {typedef quint32 Type;};
+template <> struct SAKBits<8> {typedef quint64 Type;};
+
+// The bits of a value which starts at registers.
+template <int Width>
+inline quint64 sakRawValue(const quint16 *registers, bool swapWords, bool swapBytes)
+{
+    quint64 value = 0;
+    for (int i = 0; i < Width; i++) {
+        quint16 word = registers[swapWords ? (Width - 1 - i) : i];
+        if (swapBytes) {
+            word = quint16((word << 8) | (word >> 8));
+        }
+        value = (value << 16) | word;
+    }
+
+    return value;
+}
+
+template <int Width, typename T>
+void sakDecode(const quint16 *registers, int count, bool swapWords, bool swapBytes, double *values)
+{
+    for (int i = 0; i < count; i++) {
+        quint64 raw = sakRawValue<Width>(registers + i*Width, swapWords, swapBytes);
+        // The integer of the same size is reinterpreted as T(such as float).
+        typename SAKBits<sizeof(T)>::Type bits = typename SAKBits<sizeof(T)>::Type(raw);
+        T value;
+        std::memcpy(&value, &bits, sizeof(T));
+        values[i] = double(value);
+    }
+}
+}
+
+QStringList SAKModbusCommonCodec::dataTypeNames()
+{
+    QStringList names;
+    names << QString("UInt16") << QString("Int16")
+          << QString("UInt32") << QString("Int32")
+          << QString("UInt64") << QString("Int64")
+          << QString("Float") << QString("Double")
+          << QString("String");
+    return names;
+}
+
+QStringList SAKModbusCommonCodec::byteOrderNames()
+{
+    QStringList names;
+    names << QString("ABCD") << QString("DCBA") << QString("BADC") << QString("CDAB");
+    return names;
+}
+
+int SAKModbusCommonCodec::registerWidth(int dataType)
+{
+    switch (dataType) {
+    case DataTypeUInt32:
+    case DataTypeInt32:
+    case DataTypeFloat32:
+        return 2;
+    case DataTypeUInt64:
+    case DataTypeInt64:
+    case DataTypeFloat64:
+        return 4;
+    case DataTypeString:
+        return 0;
+    default:
+        return 1;
+    }
+}
+
+quint64 SAKModbusCommonCodec::rawValue(const quint16 *registers, int width, int byteOrder)
+{
+    bool swapWords = (byteOrder == ByteOrderDCBA) || (byteOrder == ByteOrderCDAB);
+    bool swapBytes = (byteOrder == ByteOrderDCBA) || (byteOrder == ByteOrderBADC);
+    switch (width) {
+    case 1:
+        return sakRawValue<1>(registers, swapWords, swapBytes);
+    case 2:
+        return sakRawValue<2>(registers, swapWords, swapBytes);
+    case 4:
+        return sakRawValue<4>(registers, swapWords, swapBytes);
+    default:
+        return 0;
+    }
+}
+
+int SAKModbusCommonCodec::decode(const quint16 *registers,
+                                 int registerNumber,
+                                 int dataType,
+                                 int byteOrder,
+                                 double *values)
+{
+    int width = registerWidth(dataType);
+    if ((width == 0) || (registerNumber <= 0)) {
+        return 0;
+    }
+
+    int count = registerNumber/width;
+    bool swapWords = (byteOrder == ByteOrderDCBA) || (byteOrder == ByteOrderCDAB);
+    bool swapBytes = (byteOrder == ByteOrderDCBA) || (byteOrder == ByteOrderBADC);
+    switch (dataType) {
+    case DataTypeUInt16:
+        sakDecode<1, quint16>(registers, count, swapWords, swapBytes, values);
+        break;
+    case DataTypeInt16:
+        sakDecode<1, qint16>(registers, count, swapWords, swapBytes, values);
+        break;
+    case DataTypeUInt32:
+        sakDecode<2, quint32>(registers, count, swapWords, swapBytes, values);
+        break;
+    case DataTypeInt32:
+        sakDecode<2, qint32>(registers, count, swapWords, swapBytes, values);
+        break;
+    case DataTypeUInt64:
+        sakDecode<4, quint64>(registers, count, swapWords, swapBytes, values);
+        break;
+    case DataTypeInt64:
+        sakDecode<4, qint64>(registers, count, swapWords, swapBytes, values);
+        break;
+    case DataTypeFloat32:
+        sakDecode<2, float>(registers, count, swapWords, swapBytes, values);
+        break;
+    case DataTypeFloat64:
+        sakDecode<4, double>(registers, count, swapWords, swapBytes, values);
+        break;
+    default:
+        return 0;
+    }
+
+    return count;
+}
+
+QString SAKModbusCommonCodec::text(const quint16 *registers,
+                                   int registerNumber,
+                                   int dataType,
+                                   int byteOrder)
+{
+    if (dataType == DataTypeString) {
+        // Two characters in a register, the string is ended with '\0'.
+        bool swapBytes = (byteOrder == ByteOrderDCBA) || (byteOrder == ByteOrderBADC);
+        QByteArray data;
+        data.reserve(registerNumber*2);
+        for (int i = 0; i < registerNumber; i++) {
+            quint16 word = registers[i];
+            char high = char(word >> 8);
+            char low = char(word & 0xff);
+            data.append(swapBytes ? low : high);
+            data.append(swapBytes ? high : low);
+        }
+
+        int end = data.indexOf('\0');
+        return QString::fromLatin1(end >= 0 ? data.left(end) : data);
+    }
+
+    int width = registerWidth(dataType);
+    if (registerNumber < width) {
+        return QString();
+    }
+
+    // The integers of 64 bits are formatted from the raw value, the values are
+    // not limited by the precision of double.
+    quint64 raw = rawValue(registers, width, byteOrder);
+    switch (dataType) {
+    case DataTypeUInt64:
+        return QString::number(raw);
+    case DataTypeInt64:
+        return QString::number(qint64(raw));
+    case DataTypeFloat32:
+    case DataTypeFloat64: {
+        double value = 0;
+        decode(registers, width, dataType, byteOrder, &value);
+        return QString::number(value, 'g', dataType == DataTypeFloat32 ? 7 : 15);
+    }
+    default: {
+        double value = 0;
+        decode(registers, width, dataType, byteOrder, &value);
+        return QString::number(qint64(value));
+    }
+    }
+}
+
+QStringList SAKModbusCommonCodec::texts(const QVector<quint16> &registers,
+                                        int dataType,
+                                        int byteOrder,
+                                        int maxCount)
+{
+    QStringList list;
+    if (dataType == DataTypeString) {
+        list.append(text(registers.constData(), registers.count(), dataType, byteOrder));
+        return list;
+    }
+
+    int width = registerWidth(dataType);
+    int count = registers.count()/width;
+    if ((maxCount >= 0) && (count > maxCount)) {
+        count = maxCount;
+    }
+
+    // The values are decoded as a block.
+    if ((dataType == DataTypeUInt64) || (dataType == DataTypeInt64)) {
+        for (int i = 0; i < count; i++) {
+            list.append(text(registers.constData() + i*width, width, dataType, byteOrder));
+        }
+    } else {
+        QVector<double> values(count);
+        decode(registers.constData(), count*width, dataType, byteOrder, values.data());
+        for (auto &value : values) {
+            if ((dataType == DataTypeFloat32) || (dataType == DataTypeFloat64)) {
+                list.append(QString::number(value, 'g', dataType == DataTypeFloat32 ? 7 : 15));
+            } else {
+                list.append(QString::number(qint64(value)));
+            }
+        }
+    }
+
+    return list;
+}
+
+QByteArray SAKModbusCommonCodec::bytes(const QVector<quint16> &registers)
+{
+    QByteArray data(registers.count()*2, 0);
+    uchar *ptr = reinterpret_cast<uchar*>(data.data());
+    for (int i = 0; i < registers.count(); i++) {
+        qToBigEndian<quint16>(registers.at(i), ptr + i*2);
+    }
+
+    return data;
+}
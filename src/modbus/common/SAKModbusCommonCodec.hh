@@ -0,0 +1,104 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKMODBUSCOMMONCODEC_HH
+#define SAKMODBUSCOMMONCODEC_HH
+
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+#include <QStringList>
+
+/// @brief Typed values over continuous registers. A value of 32 or 64 bits is
+/// spanned several registers, the byte order is named as the bytes of 0xAABBCCDD
+/// in the registers, such as CDAB means the low word is the first register.
+class SAKModbusCommonCodec
+{
+public:
+    enum SAKEnumDataType {
+        DataTypeUInt16,
+        DataTypeInt16,
+        DataTypeUInt32,
+        DataTypeInt32,
+        DataTypeUInt64,
+        DataTypeInt64,
+        DataTypeFloat32,
+        DataTypeFloat64,
+        DataTypeString
+    };
+
+    enum SAKEnumByteOrder {
+        ByteOrderABCD,  // Big endian
+        ByteOrderDCBA,  // Little endian
+        ByteOrderBADC,  // Big endian, bytes of registers are swapped
+        ByteOrderCDAB   // Little endian, bytes of registers are swapped
+    };
+
+    /// @brief The registers those are decoded as the same type.
+    struct SAKStructDefinitionContext {
+        quint16 startAddress;
+        quint16 registerNumber;
+        int dataType;
+        int byteOrder;
+    };
+
+    static QStringList dataTypeNames();
+    static QStringList byteOrderNames();
+
+    /**
+     * @brief registerWidth: The number of registers of a value, a string is
+     * spanned all of the registers of the definition(0 is returned).
+     */
+    static int registerWidth(int dataType);
+
+    /**
+     * @brief rawValue: Get the bits of a value which is spanned several
+     * registers, the first byte of the value is the highest byte.
+     */
+    static quint64 rawValue(const quint16 *registers, int width, int byteOrder);
+
+    /**
+     * @brief decode: Decode the values of a block, the loop of each type is
+     * simple enough to be vectorized by the compiler.
+     * @param registers: Register values.
+     * @param registerNumber: The number of registers.
+     * @param values: Decoded values(the integers of 64 bits are exact if they
+     * are less than 2^53), the buffer must hold registerNumber/width values.
+     * @return The number of values decoded.
+     */
+    static int decode(const quint16 *registers,
+                      int registerNumber,
+                      int dataType,
+                      int byteOrder,
+                      double *values);
+
+    /**
+     * @brief text: The text of a value(or a string) starts at registers.
+     */
+    static QString text(const quint16 *registers,
+                        int registerNumber,
+                        int dataType,
+                        int byteOrder);
+
+    /**
+     * @brief texts: The texts of the values of a block.
+     * @param maxCount: The max number of texts, -1 means all of the values.
+     */
+    static QStringList texts(const QVector<quint16> &registers,
+                             int dataType,
+                             int byteOrder,
+                             int maxCount = -1);
+
+    /**
+     * @brief bytes: Register values in the byte order of the wire(big endian).
+     */
+    static QByteArray bytes(const QVector<quint16> &registers);
+};
+
+#endif // SAKMODBUSCOMMONCODEC_HH
@@ -18,13 +18,16 @@
 #include <QJsonDocument>
 #include <QModbusServer>
 
+#include "SAKModbusCommonSnapshot.hh"
 #include "SAKModbusCommonController.hh"
+#include "SAKModbusCommonSnapshotDiffDialog.hh"
 
 SAKModbusCommonController::SAKModbusCommonController(QWidget *parent)
     :QWidget(parent)
     ,mBottomSection(Q_NULLPTR)
     ,mDevice(Q_NULLPTR)
     ,mRegisterNumber(65535)
+    ,mStatistics(new SAKModbusCommonStatistics(this))
 {
     mSectionLayout = new QVBoxLayout(this);
     mSectionLayout->setContentsMargins(0, 0, 0, 0);
@@ -35,7 +38,6 @@ SAKModbusCommonController::SAKModbusCommonController(QWidget *parent)
     mInfoMap.insert(QModbusDataUnit::DiscreteInputs, "DiscreteInputs");
     mInfoMap.insert(QModbusDataUnit::InputRegisters, "InputRegisters");
     mInfoMap.insert(QModbusDataUnit::HoldingRegisters, "HoldingRegisters");
-    mAllRegisterCount = mInfoMap.count()*mRegisterNumber;
 }
 
 SAKModbusCommonController::~SAKModbusCommonController()
@@ -53,6 +55,28 @@ void SAKModbusCommonController::closeDevice()
     }
 }
 
+void SAKModbusCommonController::compareRegisterData()
+{
+    QString filter = QString("Snapshot (*.qsakmbs)");
+    QString oldFileName = QFileDialog::getOpenFileName(this, tr("Old Snapshot"), QString("./"), filter);
+    if (oldFileName.isEmpty()){
+        return;
+    }
+    QString newFileName = QFileDialog::getOpenFileName(this, tr("New Snapshot"), oldFileName, filter);
+    if (newFileName.isEmpty()){
+        return;
+    }
+
+    QString errorString;
+    QVector<SAKModbusCommonSnapshot::SAKStructDifferenceContext> differences;
+    if (SAKModbusCommonSnapshot::diff(oldFileName, newFileName, &differences, &errorString)){
+        SAKModbusCommonSnapshotDiffDialog dialog(differences, this);
+        dialog.exec();
+    }else{
+        QMessageBox::warning(this, tr("Compare Snapshots Failed"), errorString);
+    }
+}
+
 void SAKModbusCommonController::appendSection(QWidget *section)
 {
     Q_ASSERT_X(section, __FUNCTION__, "Parameter can not be null!");
@@ -67,6 +91,11 @@ QModbusDevice *SAKModbusCommonController::device()
     return mDevice;
 }
 
+SAKModbusCommonStatistics *SAKModbusCommonController::statistics()
+{
+    return mStatistics;
+}
+
 void SAKModbusCommonController::init()
 {
     mDevice = initModbusDevice();
@@ -113,74 +142,82 @@ QModbusDevice *SAKModbusCommonController::initModbusDevice()
 
 void SAKModbusCommonController::setModbusServerMap(QModbusServer *server)
 {
+    // The initial values are the values of the data units.
     QModbusDataUnitMap reg;
-    reg.insert(QModbusDataUnit::Coils, {QModbusDataUnit::Coils, 0, mRegisterNumber});
-    reg.insert(QModbusDataUnit::DiscreteInputs, {QModbusDataUnit::DiscreteInputs, 0, mRegisterNumber});
-    reg.insert(QModbusDataUnit::InputRegisters, {QModbusDataUnit::InputRegisters, 0, mRegisterNumber});
-    reg.insert(QModbusDataUnit::HoldingRegisters, {QModbusDataUnit::HoldingRegisters, 0, mRegisterNumber});
+    reg.insert(QModbusDataUnit::Coils, QModbusDataUnit(QModbusDataUnit::Coils, 0, QVector<quint16>(mRegisterNumber, 0)));
+    reg.insert(QModbusDataUnit::DiscreteInputs, QModbusDataUnit(QModbusDataUnit::DiscreteInputs, 0, QVector<quint16>(mRegisterNumber, 0)));
+    reg.insert(QModbusDataUnit::InputRegisters, QModbusDataUnit(QModbusDataUnit::InputRegisters, 0, QVector<quint16>(mRegisterNumber, 0xffff)));
+    reg.insert(QModbusDataUnit::HoldingRegisters, QModbusDataUnit(QModbusDataUnit::HoldingRegisters, 0, QVector<quint16>(mRegisterNumber, 0xffff)));
     server->setMap(reg);
-    for (int i = 0; i < mRegisterNumber; i++){
-        server->setData(QModbusDataUnit::Coils, i, false);
-        server->setData(QModbusDataUnit::DiscreteInputs, i, false);
-        server->setData(QModbusDataUnit::InputRegisters, i, 0xffff);
-        server->setData(QModbusDataUnit::HoldingRegisters, i, 0xffff);
+}
+
+QVector<quint16> SAKModbusCommonController::serverRegisterValues(QModbusServer *server,
+                                                                QModbusDataUnit::RegisterType type,
+                                                                quint16 startAddress,
+                                                                quint16 registerNumber)
+{
+    // The registers out of the map are not read.
+    int number = qMin(int(registerNumber), int(mRegisterNumber) - int(startAddress));
+    if ((!server) || (number <= 0)){
+        return QVector<quint16>();
     }
+
+    QModbusDataUnit unit(type, startAddress, quint16(number));
+    if (!server->data(&unit)){
+        emit invokeOutputMessage(tr("Can not get the values of registers which type is:%1").arg(type));
+        return QVector<quint16>();
+    }
+
+    return unit.values();
 }
 
 QString SAKModbusCommonController::getSaveFileName()
 {
-    QString defaultFileName = QDateTime::currentDateTime().toString("yyyyMMddhhmmss").append(".json").prepend("./");
-    auto fileName = QFileDialog::getSaveFileName(this, tr("Export Register Data"), defaultFileName, QString("Json (*.json *.txt)"));
+    QString defaultFileName = QDateTime::currentDateTime().toString("yyyyMMddhhmmss").append(".qsakmbs").prepend("./");
+    auto fileName = QFileDialog::getSaveFileName(this, tr("Export Register Data"), defaultFileName, QString("Snapshot (*.qsakmbs);;Json (*.json *.txt)"));
     return fileName;
 }
 
 QString SAKModbusCommonController::getOpenFileName()
 {
-    QString defaultFileName = QDateTime::currentDateTime().toString("yyyyMMddhhmmss").append(".json").prepend("./");
-    auto fileName = QFileDialog::getOpenFileName(this, tr("Export Register Data"), defaultFileName, QString("Json (*.json *.txt)"));
+    QString defaultFileName = QString("./");
+    auto fileName = QFileDialog::getOpenFileName(this, tr("Import Register Data"), defaultFileName, QString("Snapshot (*.qsakmbs);;Json (*.json *.txt)"));
     return fileName;
 }
 
 void SAKModbusCommonController::saveServerRegisterData(QModbusServer *server, QString fileName)
 {
     Q_ASSERT_X(server, __FUNCTION__, "The parameter can not be null!");
+    if (!isJsonFile(fileName)){
+        QString errorString;
+        if (!SAKModbusCommonSnapshot::save(server, fileName, mRegisterNumber, &errorString)){
+            qWarning() << "Can not save the snapshot(" << fileName << ")" << errorString;
+            QMessageBox::warning(this, tr("Export Data Failed"), tr("The data was exported failed:%1").arg(errorString));
+        }
+        return;
+    }
+
     QFile file(fileName);
     if (file.open(QFile::WriteOnly | QFile::Text)){
         QMapIterator<QModbusDataUnit::RegisterType, QString> mapIterator(mInfoMap);
         QJsonObject jsonObj;
-        QProgressBar *pb = progressBar();
-        int pValue = 0;
-        int percent = 0;
         while (mapIterator.hasNext()) {
             mapIterator.next();
             QModbusDataUnit::RegisterType type = mapIterator.key();
             QString typeName = mapIterator.value();
-             QJsonArray jsonArr;
-            for (int i = 0; i < mRegisterNumber; i++){
-                quint16 value = 0;
-                server->data(type, i, &value);
+            // The values of a type are read at once.
+            QModbusDataUnit unit(type, 0, mRegisterNumber);
+            server->data(&unit);
+            QJsonArray jsonArr;
+            for (auto &value : unit.values()){
                 jsonArr.append(value);
-                pValue += 1;
-                int pTemp = pValue*100/mAllRegisterCount;
-                if (pTemp != percent){
-                    pb->setValue(pValue);
-                    qApp->processEvents();
-                    percent = pTemp;
-                }
             }
             jsonObj.insert(typeName, jsonArr);
         }
         QJsonDocument jsonDoc;
         jsonDoc.setObject(jsonObj);
-        QTextStream out(&file);
-        out << jsonDoc.toJson();
+        file.write(jsonDoc.toJson());
         file.close();
-
-        pb->close();
-        delete pb->parent();
-#if 0
-        QMessageBox::information(this, tr("Export Data Successfully"), tr("The data was exported successfully!"));
-#endif
     }else{
         qWarning() << "Can not open the file(" << fileName << ")" << file.errorString();
         QMessageBox::warning(this, tr("Export Data Failed"), tr("The data was exported failed:%1").arg(file.errorString()));
@@ -190,6 +227,23 @@ void SAKModbusCommonController::saveServerRegisterData(QModbusServer *server, QS
 void SAKModbusCommonController::setServerRegisterData(QModbusServer *server, QString fileName)
 {
     Q_ASSERT_X(server, __FUNCTION__, "The parameter can not be null!");
+    // The signal is emitted once for each type after all of the values are set.
+    server->blockSignals(true);
+    if (!isJsonFile(fileName)){
+        QString errorString;
+        if (SAKModbusCommonSnapshot::restore(server, fileName, &errorString)){
+            server->blockSignals(false);
+            for (auto type : SAKModbusCommonSnapshot::registerTypes()){
+                emit dataWritten(type, 0, mRegisterNumber);
+            }
+        }else{
+            server->blockSignals(false);
+            QMessageBox::warning(this, tr("Import Data Failed"), tr("The data was imported failed:%1").arg(errorString));
+            qWarning() << "Can not restore the snapshot(" << fileName << ")" << errorString;
+        }
+        return;
+    }
+
     QFile file(fileName);
     if (file.open(QFile::ReadOnly | QFile::Text)){
         QByteArray json = file.readAll();
@@ -199,50 +253,36 @@ void SAKModbusCommonController::setServerRegisterData(QModbusServer *server, QSt
         if (jsonDoc.isObject()){
             QJsonObject jsonObj = jsonDoc.object();
             QMapIterator<QModbusDataUnit::RegisterType, QString> mapIterator(mInfoMap);
-            QProgressBar *pb = progressBar();
-            int pValue = 0;
-            int percent = 0;
+            QList<QModbusDataUnit> units;
             while (mapIterator.hasNext()) {
                 mapIterator.next();
                 QModbusDataUnit::RegisterType type = mapIterator.key();
                 QString typeName = mapIterator.value();
                 QJsonArray jsonArr = jsonObj.value(typeName).toArray();
-                auto arrayCount = jsonArr.count();
-                for (int i = 0; (i < arrayCount) && (i < mRegisterNumber); i++){
-                    auto value = quint16(jsonArr.at(i).toInt());
-                    server->setData(type, i, value);
-                    pValue += 1;
-                    int pTemp = pValue*100/mAllRegisterCount;
-                    if (pTemp != percent){
-                        pb->setValue(pValue);
-                        qApp->processEvents();
-                        percent = pTemp;
-                    }
+                int count = qMin(jsonArr.count(), int(mRegisterNumber));
+                QVector<quint16> values(count);
+                for (int i = 0; i < count; i++){
+                    values[i] = quint16(jsonArr.at(i).toInt());
                 }
-                emit dataWritten(type, 0, arrayCount > mRegisterNumber ? mRegisterNumber : arrayCount);
+                QModbusDataUnit unit(type, 0, values);
+                server->setData(unit);
+                units.append(unit);
+            }
+            server->blockSignals(false);
+            for (auto &unit : units){
+                emit dataWritten(unit.registerType(), 0, int(unit.valueCount()));
             }
-            pb->close();
-            delete pb->parent();
-#if 0
-            QMessageBox::information(this, tr("Import Data Successfully"), tr("The data was imported successfully!"));
-#endif
         }
+        server->blockSignals(false);
     }else{
+        server->blockSignals(false);
         QMessageBox::warning(this, tr("Import Data Failed"), tr("The data was imported failed:%1").arg(file.errorString()));
         qWarning() << "Can not open the file(" << fileName << ")" << file.errorString();
     }
 }
 
-QProgressBar *SAKModbusCommonController::progressBar()
+bool SAKModbusCommonController::isJsonFile(const QString &fileName)
 {
-    QDialog *dialog = new QDialog;;
-    QVBoxLayout *vLayout = new QVBoxLayout(dialog);
-    QProgressBar *progressBar = new QProgressBar(dialog);
-    progressBar->setMinimum(0);
-    progressBar->setMaximum(mAllRegisterCount);
-    vLayout->addWidget(progressBar);
-    dialog->setWindowFlags(Qt::FramelessWindowHint);
-    dialog->setModal(true);
-    dialog->show();
-    return progressBar;
+    return fileName.endsWith(".json", Qt::CaseInsensitive)
+            || fileName.endsWith(".txt", Qt::CaseInsensitive);
 }
@@ -13,11 +13,12 @@
 #include <QWidget>
 #include <QJsonArray>
 #include <QHBoxLayout>
-#include <QProgressBar>
 #include <QModbusDevice>
 #include <QModbusServer>
 #include <QModbusDataUnit>
 
+#include "SAKModbusCommonStatistics.hh"
+
 class SAKModbusCommonController : public QWidget
 {
     Q_OBJECT
@@ -28,12 +29,18 @@ public:
     virtual void open() = 0;
     virtual void setData(QModbusDataUnit::RegisterType type, quint16 address, quint16 value) = 0;
     virtual quint16 registerValue(QModbusDataUnit::RegisterType type, quint16 address) = 0;
+    // Get the values of continuous registers in one step.
+    virtual QVector<quint16> registerValues(QModbusDataUnit::RegisterType type, quint16 startAddress, quint16 registerNumber) = 0;
     virtual void exportRegisterData() = 0;
     virtual void importRegisterData() = 0;
 
     void closeDevice();
+    // Compare two snapshots of register data.
+    void compareRegisterData();
     void appendSection(QWidget *section);
     QModbusDevice *device();
+    // Traffic statistics of the device.
+    SAKModbusCommonStatistics *statistics();
     // You must call the device in the constructor of sublcass.
     void init();
 protected:
@@ -42,10 +49,11 @@ protected:
     // You can use device() to get the device instance.
     virtual QModbusDevice *initModbusDevice();
     void setModbusServerMap(QModbusServer *server);
+    QVector<quint16> serverRegisterValues(QModbusServer *server, QModbusDataUnit::RegisterType type, quint16 startAddress, quint16 registerNumber);
     QString getSaveFileName();
     QString getOpenFileName();
+    // The file is a binary snapshot or a json file(*.json, *.txt).
     void saveServerRegisterData(QModbusServer *server, QString fileName);
-    // The file is the json file.
     void setServerRegisterData(QModbusServer *server, QString fileName);
 private:
     QVBoxLayout *mSectionLayout;
@@ -53,9 +61,9 @@ private:
     QModbusDevice *mDevice;
     quint16 mRegisterNumber;
     QMap<QModbusDataUnit::RegisterType, QString> mInfoMap;
-    int mAllRegisterCount;
+    SAKModbusCommonStatistics *mStatistics;
 private:
-    QProgressBar *progressBar();
+    bool isJsonFile(const QString &fileName);
 signals:
     void deviceStateChanged();
     void modbusDataUnitRead(QModbusDataUnit mdu);
@@ -0,0 +1,258 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QRegularExpression>
+
+#include "SAKModbusCommonRegisterModel.hh"
+
+SAKModbusCommonRegisterModel::SAKModbusCommonRegisterModel(
+        QModbusDataUnit::RegisterType registerType,
+        QObject *parent)
+    :QAbstractTableModel(parent)
+    ,mRegisterType(registerType)
+    ,mValues(65536, 0)
+    ,mStartAddress(0)
+    ,mRegisterNumber(0)
+{
+
+}
+
+int SAKModbusCommonRegisterModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : mRegisterNumber;
+}
+
+int SAKModbusCommonRegisterModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant SAKModbusCommonRegisterModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || (index.row() >= mRegisterNumber)) {
+        return QVariant();
+    }
+
+    int address = mStartAddress + index.row();
+    if ((role == Qt::DisplayRole) || (role == Qt::EditRole)) {
+        if (index.column() == ColumnAddress) {
+            return QString("%1").arg(QString::number(address), 5, '0');
+        } else if (index.column() == ColumnValue) {
+            return valueText(mValues.at(address));
+        } else {
+            return role == Qt::DisplayRole ? decodedText(address) : QVariant();
+        }
+    } else if (role == Qt::TextAlignmentRole) {
+        return int(Qt::AlignCenter);
+    }
+
+    return QVariant();
+}
+
+bool SAKModbusCommonRegisterModel::setData(const QModelIndex &index,
+                                           const QVariant &value,
+                                           int role)
+{
+    if (!index.isValid()
+            || (role != Qt::EditRole)
+            || (index.column() != ColumnValue)) {
+        return false;
+    }
+
+    // Such as "1" for coils and "00ff" for registers.
+    QString text = value.toString().trimmed();
+    QRegularExpression regExp(isBitRegister()
+                              ? QString("^[01]$")
+                              : QString("^[a-fA-F0-9]{1,4}$"));
+    if (!regExp.match(text).hasMatch()) {
+        return false;
+    }
+
+    quint16 address = quint16(mStartAddress + index.row());
+    quint16 registerValue = quint16(text.toUInt(Q_NULLPTR, 16));
+    mValues[address] = registerValue;
+    emitRowsChanged(address, address);
+    emit registerValueChanged(mRegisterType, address, registerValue);
+    return true;
+}
+
+QVariant SAKModbusCommonRegisterModel::headerData(int section,
+                                                  Qt::Orientation orientation,
+                                                  int role) const
+{
+    if ((orientation == Qt::Horizontal) && (role == Qt::DisplayRole)) {
+        if (section == ColumnAddress) {
+            return tr("Address");
+        } else if (section == ColumnValue) {
+            return isBitRegister() ? tr("Value") : tr("Value(Hex)");
+        } else if (section == ColumnDecoded) {
+            return tr("Decoded Value");
+        }
+    }
+
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+Qt::ItemFlags SAKModbusCommonRegisterModel::flags(const QModelIndex &index) const
+{
+    Qt::ItemFlags itemFlags = QAbstractTableModel::flags(index);
+    if (index.isValid() && (index.column() == ColumnValue)) {
+        itemFlags |= Qt::ItemIsEditable;
+    }
+
+    return itemFlags;
+}
+
+void SAKModbusCommonRegisterModel::setRange(int startAddress, int registerNumber)
+{
+    startAddress = qBound(0, startAddress, mValues.count() - 1);
+    registerNumber = qBound(0, registerNumber, mValues.count() - startAddress);
+
+    beginResetModel();
+    mStartAddress = startAddress;
+    mRegisterNumber = registerNumber;
+    endResetModel();
+}
+
+int SAKModbusCommonRegisterModel::startAddress() const
+{
+    return mStartAddress;
+}
+
+int SAKModbusCommonRegisterModel::registerNumber() const
+{
+    return mRegisterNumber;
+}
+
+void SAKModbusCommonRegisterModel::setValue(quint16 address, quint16 value)
+{
+    mValues[address] = value;
+    emitRowsChanged(address, address);
+}
+
+void SAKModbusCommonRegisterModel::setValues(quint16 startAddress,
+                                             const QVector<quint16> &values)
+{
+    int count = qMin(values.count(), mValues.count() - int(startAddress));
+    if (count <= 0) {
+        return;
+    }
+
+    std::copy(values.constBegin(),
+              values.constBegin() + count,
+              mValues.begin() + startAddress);
+
+    emitRowsChanged(startAddress, startAddress + count - 1);
+}
+
+quint16 SAKModbusCommonRegisterModel::value(quint16 address) const
+{
+    return mValues.at(address);
+}
+
+void SAKModbusCommonRegisterModel::setDefinition(
+        const SAKModbusCommonCodec::SAKStructDefinitionContext &ctx)
+{
+    if (ctx.registerNumber == 0) {
+        return;
+    }
+
+    removeDefinitions(ctx.startAddress, ctx.registerNumber);
+    mDefinitions.insert(ctx.startAddress, ctx);
+    emitRowsChanged(ctx.startAddress, ctx.startAddress + ctx.registerNumber - 1);
+}
+
+void SAKModbusCommonRegisterModel::removeDefinitions(quint16 startAddress,
+                                                     quint16 registerNumber)
+{
+    int endAddress = int(startAddress) + registerNumber;
+    auto it = mDefinitions.begin();
+    while (it != mDefinitions.end()) {
+        int start = it.key();
+        int end = start + it.value().registerNumber;
+        if ((start < endAddress) && (startAddress < end)) {
+            it = mDefinitions.erase(it);
+            emitRowsChanged(start, end - 1);
+        } else {
+            ++it;
+        }
+    }
+}
+
+QList<SAKModbusCommonCodec::SAKStructDefinitionContext>
+SAKModbusCommonRegisterModel::definitions() const
+{
+    return mDefinitions.values();
+}
+
+QModbusDataUnit::RegisterType SAKModbusCommonRegisterModel::registerType() const
+{
+    return mRegisterType;
+}
+
+bool SAKModbusCommonRegisterModel::isBitRegister() const
+{
+    return (mRegisterType == QModbusDataUnit::Coils)
+            || (mRegisterType == QModbusDataUnit::DiscreteInputs);
+}
+
+QString SAKModbusCommonRegisterModel::valueText(quint16 value) const
+{
+    if (isBitRegister()) {
+        return value ? QString("1") : QString("0");
+    }
+
+    return QString("%1").arg(QString::number(value, 16), 4, '0');
+}
+
+QString SAKModbusCommonRegisterModel::decodedText(int address) const
+{
+    // The definition which start address is not greater than the address.
+    auto it = mDefinitions.upperBound(quint16(address));
+    if (isBitRegister() || (it == mDefinitions.constBegin())) {
+        return QString();
+    }
+
+    --it;
+    auto &ctx = it.value();
+    int end = int(ctx.startAddress) + ctx.registerNumber;
+    int width = SAKModbusCommonCodec::registerWidth(ctx.dataType);
+    width = width ? width : ctx.registerNumber;
+    int offset = address - ctx.startAddress;
+    if ((address >= end) || (offset%width) || (address + width > end)) {
+        return QString();
+    }
+
+    return SAKModbusCommonCodec::text(mValues.constData() + address,
+                                      width,
+                                      ctx.dataType,
+                                      ctx.byteOrder);
+}
+
+void SAKModbusCommonRegisterModel::emitRowsChanged(int firstAddress, int lastAddress)
+{
+    // The decoded value which is spanned the first register is changed too.
+    auto it = mDefinitions.upperBound(quint16(firstAddress));
+    if (it != mDefinitions.begin()) {
+        --it;
+        auto &ctx = it.value();
+        if (firstAddress < int(ctx.startAddress) + ctx.registerNumber) {
+            int width = SAKModbusCommonCodec::registerWidth(ctx.dataType);
+            width = width ? width : ctx.registerNumber;
+            firstAddress -= (firstAddress - ctx.startAddress)%width;
+        }
+    }
+
+    // Only the rows those are in the range are refreshed.
+    int firstRow = qMax(firstAddress - mStartAddress, 0);
+    int lastRow = qMin(lastAddress - mStartAddress, mRegisterNumber - 1);
+    if (firstRow <= lastRow) {
+        emit dataChanged(index(firstRow, ColumnValue), index(lastRow, ColumnDecoded));
+    }
+}
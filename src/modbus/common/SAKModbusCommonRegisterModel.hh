@@ -0,0 +1,99 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKMODBUSCOMMONREGISTERMODEL_HH
+#define SAKMODBUSCOMMONREGISTERMODEL_HH
+
+#include <QMap>
+#include <QVector>
+#include <QModbusDataUnit>
+#include <QAbstractTableModel>
+
+#include "SAKModbusCommonCodec.hh"
+
+/// @brief Values of a type of registers, the values are stored in a flat array
+/// which covers the whole address space, the rows of the model are the registers
+/// of the range to be shown, so the row of an address is got directly.
+class SAKModbusCommonRegisterModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum SAKEnumColumn {
+        ColumnAddress,
+        ColumnValue,
+        ColumnDecoded,
+        ColumnCount
+    };
+public:
+    SAKModbusCommonRegisterModel(QModbusDataUnit::RegisterType registerType,
+                                 QObject *parent = Q_NULLPTR);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index,
+                 const QVariant &value,
+                 int role = Qt::EditRole) override;
+    QVariant headerData(int section,
+                        Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    /**
+     * @brief setRange: Set the registers to be shown.
+     * @param startAddress: The address of the first row.
+     * @param registerNumber: The number of rows.
+     */
+    void setRange(int startAddress, int registerNumber);
+    int startAddress() const;
+    int registerNumber() const;
+
+    /**
+     * @brief setValue: Update the value of a register, it does not emit
+     * registerValueChanged().
+     */
+    void setValue(quint16 address, quint16 value);
+
+    /**
+     * @brief setValues: Update the values of continuous registers, the rows
+     * are refreshed once.
+     */
+    void setValues(quint16 startAddress, const QVector<quint16> &values);
+    quint16 value(quint16 address) const;
+
+    /**
+     * @brief setDefinition: Decode the registers of a range as a type, the
+     * definitions those are overlapped with the range are removed. The decoded
+     * value is shown in the row of the first register of a value.
+     */
+    void setDefinition(const SAKModbusCommonCodec::SAKStructDefinitionContext &ctx);
+    // Remove the definitions those are overlapped with the range.
+    void removeDefinitions(quint16 startAddress, quint16 registerNumber);
+    QList<SAKModbusCommonCodec::SAKStructDefinitionContext> definitions() const;
+    QModbusDataUnit::RegisterType registerType() const;
+private:
+    QModbusDataUnit::RegisterType mRegisterType;
+    QVector<quint16> mValues;
+    int mStartAddress;
+    int mRegisterNumber;
+    // The key is the start address of a definition.
+    QMap<quint16, SAKModbusCommonCodec::SAKStructDefinitionContext> mDefinitions;
+private:
+    bool isBitRegister() const;
+    QString valueText(quint16 value) const;
+    QString decodedText(int address) const;
+    void emitRowsChanged(int firstAddress, int lastAddress);
+signals:
+    // The value is changed by the user.
+    void registerValueChanged(QModbusDataUnit::RegisterType registerType,
+                              quint16 address,
+                              quint16 value);
+};
+
+#endif // SAKMODBUSCOMMONREGISTERMODEL_HH
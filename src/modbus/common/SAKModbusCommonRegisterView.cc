@@ -7,23 +7,40 @@
  * QtSwissArmyKnife is licensed according to the terms in
  * the file LICENCE in the root of the source code directory.
  */
+#include <QMenu>
 #include <QDebug>
-#include "SAKModbusCommonRegister.hh"
-#include "SAKModbusCommonFlowLayout.hh"
+#include <QHeaderView>
+#include <QActionGroup>
+
+#include "SAKModbusCommonRegisterModel.hh"
 #include "SAKModbusCommonRegisterView.hh"
 
 #include "ui_SAKModbusCommonReigsterView.h"
 
 SAKModbusCommonRegisterView::SAKModbusCommonRegisterView(QModbusDataUnit::RegisterType registerType, QWidget *parent)
     :QWidget(parent)
+    ,mRegisterModel(new SAKModbusCommonRegisterModel(registerType, this))
     ,mRegisterType(registerType)
-    ,mReigsterCount(0)
+    ,mByteOrder(SAKModbusCommonCodec::ByteOrderABCD)
     ,ui(new Ui::SAKModbusCommonReigsterView)
 {
     ui->setupUi(this);
 
-    mFlowLayout = new SAKModbusCommonFlowLayout;
-    ui->scrollAreaWidgetContents->setLayout(mFlowLayout);
+    // The rows are created by the view when they are visible, so all of the
+    // registers can be shown.
+    ui->tableView->setModel(mRegisterModel);
+    ui->tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    connect(mRegisterModel, &SAKModbusCommonRegisterModel::registerValueChanged,
+            this, &SAKModbusCommonRegisterView::registerValueChanged);
+
+    // The bits can not be decoded.
+    bool isBitRegister = (registerType == QModbusDataUnit::Coils)
+            || (registerType == QModbusDataUnit::DiscreteInputs);
+    ui->tableView->setColumnHidden(SAKModbusCommonRegisterModel::ColumnDecoded, isBitRegister);
+    if (!isBitRegister) {
+        connect(ui->tableView, &QTableView::customContextMenuRequested,
+                this, &SAKModbusCommonRegisterView::showContextMenu);
+    }
 }
 
 SAKModbusCommonRegisterView::~SAKModbusCommonRegisterView()
@@ -33,45 +50,75 @@ SAKModbusCommonRegisterView::~SAKModbusCommonRegisterView()
 
 void SAKModbusCommonRegisterView::updateRegister(int startAddress, int registerNumber)
 {
-    // Remove the old widgets
-    while (true) {
-        QLayoutItem *item = mFlowLayout->takeAt(0);
-        if (item){
-            delete item->widget();
-            delete item;
-        }else{
-            break;
-        }
-    }
-
-    mReigsterCount = registerNumber;
-    SAKModbusCommonRegister *registerWidget = Q_NULLPTR;
-    for (quint16 i = 0; i < registerNumber; i++){
-        registerWidget = new SAKModbusCommonRegister(mRegisterType, startAddress + i, startAddress + i, this);
-        ui->scrollAreaWidgetContents->layout()->addWidget(registerWidget);
-        connect(registerWidget, &SAKModbusCommonRegister::registerValueChanged, this, &SAKModbusCommonRegisterView::registerValueChanged);
-    }
-
-    if (registerWidget){
-        emit invokeUpdateRegisterValue(registerWidget->type(), startAddress, registerNumber);
+    mRegisterModel->setRange(startAddress, registerNumber);
+    if (mRegisterModel->registerNumber()){
+        emit invokeUpdateRegisterValue(mRegisterType,
+                                       mRegisterModel->startAddress(),
+                                       mRegisterModel->registerNumber());
     }
 }
 
 void SAKModbusCommonRegisterView::updateRegisterValue(quint16 address, quint16 value)
 {
-    for (int i = 0; i < mReigsterCount; i++ ){
-        QLayoutItem *item = mFlowLayout->itemAt(i);
-        auto itemWidget = qobject_cast<SAKModbusCommonRegister*>(item->widget());
-        if (itemWidget && (address == itemWidget->address())){
-            itemWidget->blockSignals(true);
-            itemWidget->setValue(value);
-            itemWidget->blockSignals(false);
-            break;
-        }
-    }
+    mRegisterModel->setValue(address, value);
+}
+
+void SAKModbusCommonRegisterView::updateRegisterValues(quint16 startAddress,
+                                                       const QVector<quint16> &values)
+{
+    mRegisterModel->setValues(startAddress, values);
 }
 
 QModbusDataUnit::RegisterType SAKModbusCommonRegisterView::registerType()
 {
     return mRegisterType;
 }
+
+void SAKModbusCommonRegisterView::showContextMenu(const QPoint &pos)
+{
+    auto rows = ui->tableView->selectionModel()->selectedRows();
+    if (rows.isEmpty()) {
+        return;
+    }
+
+    int firstRow = rows.first().row();
+    int lastRow = firstRow;
+    for (auto &index : rows) {
+        firstRow = qMin(firstRow, index.row());
+        lastRow = qMax(lastRow, index.row());
+    }
+    SAKModbusCommonCodec::SAKStructDefinitionContext ctx;
+    ctx.startAddress = quint16(mRegisterModel->startAddress() + firstRow);
+    ctx.registerNumber = quint16(lastRow - firstRow + 1);
+
+    QMenu menu(this);
+    QMenu *byteOrderMenu = menu.addMenu(tr("Byte Order"));
+    QActionGroup *byteOrderGroup = new QActionGroup(&menu);
+    QStringList byteOrderNames = SAKModbusCommonCodec::byteOrderNames();
+    for (int i = 0; i < byteOrderNames.count(); i++) {
+        QAction *action = byteOrderMenu->addAction(byteOrderNames.at(i));
+        action->setCheckable(true);
+        action->setChecked(i == mByteOrder);
+        byteOrderGroup->addAction(action);
+        connect(action, &QAction::triggered, this, [=](){mByteOrder = i;});
+    }
+
+    QMenu *dataTypeMenu = menu.addMenu(tr("Decode As"));
+    QStringList dataTypeNames = SAKModbusCommonCodec::dataTypeNames();
+    for (int i = 0; i < dataTypeNames.count(); i++) {
+        QAction *action = dataTypeMenu->addAction(dataTypeNames.at(i));
+        connect(action, &QAction::triggered, this, [=](){
+            SAKModbusCommonCodec::SAKStructDefinitionContext definition = ctx;
+            definition.dataType = i;
+            definition.byteOrder = mByteOrder;
+            mRegisterModel->setDefinition(definition);
+        });
+    }
+
+    QAction *clearAction = menu.addAction(tr("Clear Decoding"));
+    connect(clearAction, &QAction::triggered, this, [=](){
+        mRegisterModel->removeDefinitions(ctx.startAddress, ctx.registerNumber);
+    });
+
+    menu.exec(ui->tableView->viewport()->mapToGlobal(pos));
+}
@@ -17,7 +17,7 @@ namespace Ui {
     class SAKModbusCommonReigsterView;
 }
 
-class SAKModbusCommonFlowLayout;
+class SAKModbusCommonRegisterModel;
 class SAKModbusCommonRegisterView : public QWidget
 {
     Q_OBJECT
@@ -32,11 +32,16 @@ public:
      */
     void updateRegister(int startAddress, int registerNumber);
     void updateRegisterValue(quint16 address, quint16 value);
+    // Update the values of continuous registers, the view is refreshed once.
+    void updateRegisterValues(quint16 startAddress, const QVector<quint16> &values);
     QModbusDataUnit::RegisterType registerType();
 private:
-    SAKModbusCommonFlowLayout *mFlowLayout;
+    SAKModbusCommonRegisterModel *mRegisterModel;
     QModbusDataUnit::RegisterType mRegisterType;
-    int mReigsterCount;
+    int mByteOrder;
+private:
+    // Decode the selected registers as a type.
+    void showContextMenu(const QPoint &pos);
 signals:
     void registerValueChanged(QModbusDataUnit::RegisterType registerType, quint16 address, quint16 value);
     void invokeUpdateRegisterValue(QModbusDataUnit::RegisterType registerTyp, quint16 startAddress, quint16 addressNumber);
@@ -45,3 +45,8 @@ void SAKModbusCommonRegisterViewController::on_importPushButton_clicked()
 {
     emit invokeImport();
 }
+
+void SAKModbusCommonRegisterViewController::on_comparePushButton_clicked()
+{
+    emit invokeCompare();
+}
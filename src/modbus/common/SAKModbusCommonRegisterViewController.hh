@@ -30,12 +30,14 @@ signals:
     void invokeUpdateRegister(int startAddress, int registerNumber);
     void invokeExport();
     void invokeImport();
+    void invokeCompare();
 private:
     Ui::SAKModbusCommonRegisterViewController *ui;
 private slots:
     void on_updatePushButton_clicked();
     void on_exportPushButton_clicked();
     void on_importPushButton_clicked();
+    void on_comparePushButton_clicked();
 };
 
 #endif // SAKMODBUSCOMMONREIGSTERVIEWCONTROLLER_HH
@@ -0,0 +1,202 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QFile>
+#include <QtEndian>
+
+#include "SAKModbusCommonSnapshot.hh"
+
+namespace {
+const char sakModbusSnapshotMagic[8] = {'Q', 'S', 'A', 'K', 'M', 'B', 'S', '\0'};
+const quint32 sakModbusSnapshotVersion = 1;
+// Magic, version and register number
+const int sakModbusSnapshotHeaderSize = 16;
+// The address space of a register type, the block offsets can not overflow
+const quint32 sakModbusSnapshotMaxRegisterNumber = 65536;
+}
+
+QList<QModbusDataUnit::RegisterType> SAKModbusCommonSnapshot::registerTypes()
+{
+    QList<QModbusDataUnit::RegisterType> types;
+    types << QModbusDataUnit::Coils
+          << QModbusDataUnit::DiscreteInputs
+          << QModbusDataUnit::InputRegisters
+          << QModbusDataUnit::HoldingRegisters;
+    return types;
+}
+
+bool SAKModbusCommonSnapshot::save(QModbusServer *server,
+                                   const QString &fileName,
+                                   quint16 registerNumber,
+                                   QString *errorString)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        if (errorString) {
+            *errorString = file.errorString();
+        }
+        return false;
+    }
+
+    QByteArray header(sakModbusSnapshotMagic, sizeof(sakModbusSnapshotMagic));
+    header.resize(sakModbusSnapshotHeaderSize);
+    qToLittleEndian<quint32>(sakModbusSnapshotVersion,
+                             reinterpret_cast<uchar*>(header.data()) + 8);
+    qToLittleEndian<quint32>(registerNumber,
+                             reinterpret_cast<uchar*>(header.data()) + 12);
+    file.write(header);
+
+    QByteArray block(int(registerNumber)*2, '\0');
+    for (auto type : registerTypes()) {
+        // The values of a type are read at once.
+        QModbusDataUnit unit(type, 0, registerNumber);
+        server->data(&unit);
+        const QVector<quint16> unitValues = unit.values();
+        uchar *ptr = reinterpret_cast<uchar*>(block.data());
+        for (int i = 0; i < unitValues.count(); i++) {
+            qToLittleEndian<quint16>(unitValues.at(i), ptr + 2*i);
+        }
+        file.write(block);
+    }
+
+    file.close();
+    if (file.error() != QFile::NoError) {
+        if (errorString) {
+            *errorString = file.errorString();
+        }
+        return false;
+    }
+
+    return true;
+}
+
+bool SAKModbusCommonSnapshot::restore(QModbusServer *server,
+                                      const QString &fileName,
+                                      QString *errorString)
+{
+    QFile file(fileName);
+    quint32 registerNumber = 0;
+    const uchar *data = map(file, &registerNumber, errorString);
+    if (!data) {
+        return false;
+    }
+
+    auto types = registerTypes();
+    for (int i = 0; i < types.count(); i++) {
+        const uchar *block = data + i*registerNumber*2;
+        // The data unit is rejected if it is out of the map of the server.
+        if (!server->setData(QModbusDataUnit(types.at(i), 0,
+                                             values(block, registerNumber)))) {
+            if (errorString) {
+                *errorString = QString("The map of the server is smaller than "
+                                       "the snapshot(%1 registers): %2")
+                        .arg(registerNumber).arg(file.fileName());
+            }
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SAKModbusCommonSnapshot::diff(const QString &oldFileName,
+                                   const QString &newFileName,
+                                   QVector<SAKStructDifferenceContext> *differences,
+                                   QString *errorString)
+{
+    QFile oldFile(oldFileName);
+    QFile newFile(newFileName);
+    quint32 oldRegisterNumber = 0;
+    quint32 newRegisterNumber = 0;
+    const uchar *oldData = map(oldFile, &oldRegisterNumber, errorString);
+    const uchar *newData = map(newFile, &newRegisterNumber, errorString);
+    if ((!oldData) || (!newData)) {
+        return false;
+    }
+
+    // The blocks are compared in chunks, most of the registers are the same
+    // generally.
+    const quint32 chunkSize = 64;
+    quint32 registerNumber = qMin(oldRegisterNumber, newRegisterNumber);
+    auto types = registerTypes();
+    for (int i = 0; i < types.count(); i++) {
+        const uchar *oldBlock = oldData + i*oldRegisterNumber*2;
+        const uchar *newBlock = newData + i*newRegisterNumber*2;
+        for (quint32 chunk = 0; chunk < registerNumber; chunk += chunkSize) {
+            quint32 count = qMin(chunkSize, registerNumber - chunk);
+            if (memcmp(oldBlock + chunk*2, newBlock + chunk*2, count*2) == 0) {
+                continue;
+            }
+
+            for (quint32 address = chunk; address < chunk + count; address++) {
+                quint16 oldValue = qFromLittleEndian<quint16>(oldBlock + address*2);
+                quint16 newValue = qFromLittleEndian<quint16>(newBlock + address*2);
+                if (oldValue != newValue) {
+                    differences->append(SAKStructDifferenceContext{
+                                            types.at(i),
+                                            quint16(address),
+                                            oldValue,
+                                            newValue});
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+const uchar *SAKModbusCommonSnapshot::map(QFile &file,
+                                          quint32 *registerNumber,
+                                          QString *errorString)
+{
+    if (!file.open(QFile::ReadOnly)) {
+        if (errorString) {
+            *errorString = file.errorString();
+        }
+        return Q_NULLPTR;
+    }
+
+    uchar *data = file.map(0, file.size());
+    if ((!data) || (file.size() < sakModbusSnapshotHeaderSize)) {
+        if (errorString) {
+            *errorString = QString("Can not map the file: %1").arg(file.fileName());
+        }
+        return Q_NULLPTR;
+    }
+
+    quint32 version = qFromLittleEndian<quint32>(data + 8);
+    *registerNumber = qFromLittleEndian<quint32>(data + 12);
+    qint64 size = sakModbusSnapshotHeaderSize
+            + qint64(*registerNumber)*2*registerTypes().count();
+    if ((memcmp(data, sakModbusSnapshotMagic, sizeof(sakModbusSnapshotMagic)) != 0)
+            || (version != sakModbusSnapshotVersion)
+            || (*registerNumber > sakModbusSnapshotMaxRegisterNumber)
+            || (file.size() < size)) {
+        if (errorString) {
+            *errorString = QString("Invalid snapshot file: %1").arg(file.fileName());
+        }
+        return Q_NULLPTR;
+    }
+
+    return data + sakModbusSnapshotHeaderSize;
+}
+
+QVector<quint16> SAKModbusCommonSnapshot::values(const uchar *data,
+                                                 quint32 registerNumber)
+{
+    QVector<quint16> ret(int(registerNumber));
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    memcpy(ret.data(), data, registerNumber*2);
+#else
+    for (quint32 i = 0; i < registerNumber; i++) {
+        ret[i] = qFromLittleEndian<quint16>(data + i*2);
+    }
+#endif
+    return ret;
+}
@@ -0,0 +1,71 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKMODBUSCOMMONSNAPSHOT_HH
+#define SAKMODBUSCOMMONSNAPSHOT_HH
+
+#include <QFile>
+#include <QList>
+#include <QVector>
+#include <QString>
+#include <QModbusServer>
+#include <QModbusDataUnit>
+
+/// @brief Binary snapshot of the data map of a modbus server. The file is a
+/// header followed by the values(little endian quint16) of coils, discrete
+/// inputs, input registers and holding registers, the file is mapped to memory
+/// when it is read, so restoring and comparing snapshots are fast.
+class SAKModbusCommonSnapshot
+{
+public:
+    struct SAKStructDifferenceContext {
+        QModbusDataUnit::RegisterType type;
+        quint16 address;
+        quint16 oldValue;
+        quint16 newValue;
+    };
+
+    /**
+     * @brief registerTypes: The register types in the order of the file.
+     */
+    static QList<QModbusDataUnit::RegisterType> registerTypes();
+
+    /**
+     * @brief save: Write the registers of the server to a snapshot file.
+     * @param registerNumber: The number of registers of each type.
+     * @param errorString: Error description, it can be null.
+     */
+    static bool save(QModbusServer *server,
+                     const QString &fileName,
+                     quint16 registerNumber,
+                     QString *errorString = Q_NULLPTR);
+
+    /**
+     * @brief restore: Set the registers of the server from a snapshot file, a
+     * block is set for each register type. It fails if a block is out of the
+     * map of the server.
+     */
+    static bool restore(QModbusServer *server,
+                        const QString &fileName,
+                        QString *errorString = Q_NULLPTR);
+
+    /**
+     * @brief diff: Get the registers which values are different between two
+     * snapshot files.
+     */
+    static bool diff(const QString &oldFileName,
+                     const QString &newFileName,
+                     QVector<SAKStructDifferenceContext> *differences,
+                     QString *errorString = Q_NULLPTR);
+private:
+    static const uchar *map(QFile &file, quint32 *registerNumber, QString *errorString);
+    static QVector<quint16> values(const uchar *data, quint32 registerNumber);
+};
+
+#endif // SAKMODBUSCOMMONSNAPSHOT_HH
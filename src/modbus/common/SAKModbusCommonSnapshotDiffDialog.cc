@@ -0,0 +1,99 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QMap>
+#include <QLabel>
+#include <QTableView>
+#include <QHeaderView>
+#include <QVBoxLayout>
+#include <QAbstractTableModel>
+
+#include "SAKModbusCommonSnapshotDiffDialog.hh"
+
+namespace {
+// The rows are created when they are visible, the whole map can be different.
+class SAKModbusCommonSnapshotDiffModel : public QAbstractTableModel
+{
+public:
+    SAKModbusCommonSnapshotDiffModel(
+            const QVector<SAKModbusCommonSnapshot::SAKStructDifferenceContext> &differences,
+            QObject *parent)
+        :QAbstractTableModel(parent)
+        ,mDifferences(differences)
+    {
+        mTypeNames.insert(QModbusDataUnit::Coils, QObject::tr("Coils"));
+        mTypeNames.insert(QModbusDataUnit::DiscreteInputs, QObject::tr("Discrete Inputs"));
+        mTypeNames.insert(QModbusDataUnit::InputRegisters, QObject::tr("Input Registers"));
+        mTypeNames.insert(QModbusDataUnit::HoldingRegisters, QObject::tr("Holding Registers"));
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : mDifferences.count();
+    }
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : 4;
+    }
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override
+    {
+        if ((!index.isValid()) || (role != Qt::DisplayRole)) {
+            return QVariant();
+        }
+
+        auto ctx = mDifferences.at(index.row());
+        switch (index.column()) {
+        case 0: return mTypeNames.value(ctx.type);
+        case 1: return ctx.address;
+        case 2: return QString("%1").arg(QString::number(ctx.oldValue, 16), 4, '0');
+        default: return QString("%1").arg(QString::number(ctx.newValue, 16), 4, '0');
+        }
+    }
+
+    QVariant headerData(int section,
+                        Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override
+    {
+        if ((orientation == Qt::Horizontal) && (role == Qt::DisplayRole)) {
+            QStringList labels;
+            labels << QObject::tr("Type") << QObject::tr("Address")
+                   << QObject::tr("Old Value(Hex)") << QObject::tr("New Value(Hex)");
+            return labels.value(section);
+        }
+
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+private:
+    QVector<SAKModbusCommonSnapshot::SAKStructDifferenceContext> mDifferences;
+    QMap<int, QString> mTypeNames;
+};
+}
+
+SAKModbusCommonSnapshotDiffDialog::SAKModbusCommonSnapshotDiffDialog(
+        const QVector<SAKModbusCommonSnapshot::SAKStructDifferenceContext> &differences,
+        QWidget *parent)
+    :QDialog(parent)
+{
+    setWindowTitle(tr("Snapshot Differences"));
+    resize(600, 400);
+
+    QTableView *tableView = new QTableView(this);
+    tableView->setModel(new SAKModbusCommonSnapshotDiffModel(differences, this));
+    tableView->verticalHeader()->setVisible(false);
+    tableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    tableView->setAlternatingRowColors(true);
+
+    QLabel *label = new QLabel(tr("%1 register(s) are different").arg(differences.count()),
+                               this);
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(tableView);
+    layout->addWidget(label);
+}
@@ -0,0 +1,28 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKMODBUSCOMMONSNAPSHOTDIFFDIALOG_HH
+#define SAKMODBUSCOMMONSNAPSHOTDIFFDIALOG_HH
+
+#include <QDialog>
+#include <QVector>
+
+#include "SAKModbusCommonSnapshot.hh"
+
+/// @brief Show the differences between two snapshots.
+class SAKModbusCommonSnapshotDiffDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    SAKModbusCommonSnapshotDiffDialog(
+            const QVector<SAKModbusCommonSnapshot::SAKStructDifferenceContext> &differences,
+            QWidget *parent = Q_NULLPTR);
+};
+
+#endif // SAKMODBUSCOMMONSNAPSHOTDIFFDIALOG_HH
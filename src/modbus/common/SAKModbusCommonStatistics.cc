@@ -0,0 +1,260 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QFile>
+#include <QDateTime>
+#include <QTextStream>
+
+#include "SAKModbusCommonStatistics.hh"
+
+// 16 buckets for each power of 2, the latency is not greater than 2^30 us.
+#define SAK_BUCKET_COUNT 432
+// 10 minutes
+#define SAK_SAMPLE_CAPACITY 600
+
+SAKModbusCommonStatistics::SAKModbusCommonStatistics(QObject *parent)
+    :QObject(parent)
+    ,mSamples(SAK_SAMPLE_CAPACITY)
+    ,mSampleHead(0)
+    ,mSampleCount(0)
+{
+    resetCounter(mCurrent);
+    mSampleTimer.setInterval(1000);
+    connect(&mSampleTimer, &QTimer::timeout,
+            this, &SAKModbusCommonStatistics::takeSample);
+    mSampleTimer.start();
+}
+
+void SAKModbusCommonStatistics::addRecord(int serverAddress,
+                                          int functionCode,
+                                          qint64 latency,
+                                          int result)
+{
+    quint32 key = (quint32(serverAddress & 0xff) << 8) | quint32(functionCode & 0xff);
+    auto it = mCounters.find(key);
+    if (it == mCounters.end()) {
+        SAKStructCounterContext ctx;
+        resetCounter(ctx);
+        ctx.serverAddress = serverAddress;
+        ctx.functionCode = functionCode;
+        it = mCounters.insert(key, ctx);
+    }
+
+    countRecord(it.value(), latency, result);
+    countRecord(mCurrent, latency, result);
+}
+
+void SAKModbusCommonStatistics::clear()
+{
+    mCounters.clear();
+    mSampleHead = 0;
+    mSampleCount = 0;
+    resetCounter(mCurrent);
+}
+
+QList<SAKModbusCommonStatistics::SAKStructCounterContext>
+SAKModbusCommonStatistics::counters()
+{
+    return mCounters.values();
+}
+
+QVector<SAKModbusCommonStatistics::SAKStructSampleContext>
+SAKModbusCommonStatistics::samples()
+{
+    QVector<SAKStructSampleContext> ctxs;
+    ctxs.reserve(mSampleCount);
+    int first = (mSampleHead - mSampleCount + SAK_SAMPLE_CAPACITY) % SAK_SAMPLE_CAPACITY;
+    for (int i = 0; i < mSampleCount; i++) {
+        ctxs.append(mSamples.at((first + i) % SAK_SAMPLE_CAPACITY));
+    }
+
+    return ctxs;
+}
+
+bool SAKModbusCommonStatistics::exportCsv(const QString &fileName,
+                                          QString *errorString)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate | QFile::Text)) {
+        if (errorString) {
+            *errorString = file.errorString();
+        }
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "unit id,function code,requests,exceptions,timeouts,errors,"
+           "min(ms),avg(ms),p99(ms),max(ms)\n";
+    for (auto &ctx : mCounters) {
+        qint64 responses = ctx.requests - ctx.timeouts - ctx.errors;
+        out << ctx.serverAddress << ","
+            << QString("0x%1").arg(ctx.functionCode, 2, 16, QChar('0')) << ","
+            << ctx.requests << ","
+            << ctx.exceptions << ","
+            << ctx.timeouts << ","
+            << ctx.errors << ","
+            << (responses > 0 ? ctx.minLatency/1000.0 : 0) << ","
+            << (responses > 0 ? ctx.totalLatency/1000.0/responses : 0) << ","
+            << percentile(ctx.histogram, 99)/1000.0 << ","
+            << ctx.maxLatency/1000.0 << "\n";
+    }
+
+    out << "\n";
+    out << "time,requests/s,exceptions,timeouts,errors,avg(ms),p99(ms)\n";
+    for (auto &ctx : samples()) {
+        out << QDateTime::fromMSecsSinceEpoch(ctx.timestamp).toString(Qt::ISODate) << ","
+            << ctx.requestsPerSecond << ","
+            << ctx.exceptions << ","
+            << ctx.timeouts << ","
+            << ctx.errors << ","
+            << ctx.averageLatency << ","
+            << ctx.p99Latency << "\n";
+    }
+
+    out.flush();
+    return true;
+}
+
+int SAKModbusCommonStatistics::functionCode(QModbusDataUnit::RegisterType type,
+                                            bool isWriting)
+{
+    switch (type) {
+    case QModbusDataUnit::Coils:
+        return isWriting ? 0x0f : 0x01;
+    case QModbusDataUnit::DiscreteInputs:
+        return 0x02;
+    case QModbusDataUnit::HoldingRegisters:
+        return isWriting ? 0x10 : 0x03;
+    case QModbusDataUnit::InputRegisters:
+        return 0x04;
+    default:
+        return 0;
+    }
+}
+
+int SAKModbusCommonStatistics::result(QModbusDevice::Error error)
+{
+    switch (error) {
+    case QModbusDevice::NoError:
+        return ResultSuccess;
+    case QModbusDevice::ProtocolError:
+        return ResultException;
+    case QModbusDevice::TimeoutError:
+        return ResultTimeout;
+    default:
+        return ResultError;
+    }
+}
+
+qint64 SAKModbusCommonStatistics::percentile(const QVector<quint32> &histogram,
+                                             double p)
+{
+    qint64 total = 0;
+    for (auto &count : histogram) {
+        total += count;
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // The rank of the value, it starts from 1.
+    qint64 rank = qMax(qint64(1), qint64(total*p/100.0 + 0.5));
+    qint64 counted = 0;
+    for (int i = 0; i < histogram.count(); i++) {
+        counted += histogram.at(i);
+        if (counted >= rank) {
+            return bucketValue(i);
+        }
+    }
+
+    return bucketValue(histogram.count() - 1);
+}
+
+int SAKModbusCommonStatistics::bucketIndex(qint64 latency)
+{
+    if (latency < 16) {
+        return int(qMax(latency, qint64(0)));
+    }
+
+    latency = qMin(latency, (qint64(1) << 30) - 1);
+    int exponent = 4;
+    while ((latency >> (exponent + 1)) != 0) {
+        exponent += 1;
+    }
+
+    int sub = int((latency >> (exponent - 4)) & 0x0f);
+    return (exponent - 3)*16 + sub;
+}
+
+qint64 SAKModbusCommonStatistics::bucketValue(int index)
+{
+    if (index < 16) {
+        return index;
+    }
+
+    int exponent = index/16 + 3;
+    int sub = index%16;
+    return qint64(16 + sub) << (exponent - 4);
+}
+
+void SAKModbusCommonStatistics::resetCounter(SAKStructCounterContext &ctx)
+{
+    ctx.serverAddress = 0;
+    ctx.functionCode = 0;
+    ctx.requests = 0;
+    ctx.exceptions = 0;
+    ctx.timeouts = 0;
+    ctx.errors = 0;
+    ctx.minLatency = 0;
+    ctx.maxLatency = 0;
+    ctx.totalLatency = 0;
+    ctx.histogram = QVector<quint32>(SAK_BUCKET_COUNT, 0);
+}
+
+void SAKModbusCommonStatistics::countRecord(SAKStructCounterContext &ctx,
+                                            qint64 latency,
+                                            int result)
+{
+    ctx.requests += 1;
+    if (result == ResultTimeout) {
+        ctx.timeouts += 1;
+        return;
+    } else if (result == ResultError) {
+        ctx.errors += 1;
+        return;
+    } else if (result == ResultException) {
+        ctx.exceptions += 1;
+    }
+
+    // The latency of a response(an exception response too).
+    bool isFirst = (ctx.requests - ctx.timeouts - ctx.errors) == 1;
+    ctx.minLatency = isFirst ? latency : qMin(ctx.minLatency, latency);
+    ctx.maxLatency = qMax(ctx.maxLatency, latency);
+    ctx.totalLatency += latency;
+    ctx.histogram[bucketIndex(latency)] += 1;
+}
+
+void SAKModbusCommonStatistics::takeSample()
+{
+    qint64 responses = mCurrent.requests - mCurrent.timeouts - mCurrent.errors;
+    SAKStructSampleContext ctx;
+    ctx.timestamp = QDateTime::currentMSecsSinceEpoch();
+    ctx.requestsPerSecond = mCurrent.requests*1000.0/mSampleTimer.interval();
+    ctx.exceptions = mCurrent.exceptions;
+    ctx.timeouts = mCurrent.timeouts;
+    ctx.errors = mCurrent.errors;
+    ctx.averageLatency = responses > 0 ? mCurrent.totalLatency/1000.0/responses : 0;
+    ctx.p99Latency = percentile(mCurrent.histogram, 99)/1000.0;
+
+    mSamples[mSampleHead] = ctx;
+    mSampleHead = (mSampleHead + 1) % SAK_SAMPLE_CAPACITY;
+    mSampleCount = qMin(mSampleCount + 1, SAK_SAMPLE_CAPACITY);
+    resetCounter(mCurrent);
+    emit sampleTaken(ctx);
+}
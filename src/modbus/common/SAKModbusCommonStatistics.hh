@@ -0,0 +1,99 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKMODBUSCOMMONSTATISTICS_HH
+#define SAKMODBUSCOMMONSTATISTICS_HH
+
+#include <QMap>
+#include <QTimer>
+#include <QObject>
+#include <QVector>
+#include <QModbusDevice>
+#include <QModbusDataUnit>
+
+/// @brief Traffic statistics of a modbus device, the counters are grouped by
+/// unit id and function code. The latencies are counted by a log-linear
+/// histogram(16 buckets for each power of 2, the error is less than 7%), so the
+/// percentiles can be got without storing any latency. A sample of all of the
+/// traffic is taken every second and kept in a ring buffer.
+class SAKModbusCommonStatistics : public QObject
+{
+    Q_OBJECT
+public:
+    enum SAKEnumResult {
+        ResultSuccess,
+        ResultException,
+        ResultTimeout,
+        ResultError
+    };
+
+    struct SAKStructCounterContext {
+        int serverAddress;
+        int functionCode;
+        qint64 requests;
+        qint64 exceptions;
+        qint64 timeouts;
+        qint64 errors;
+        qint64 minLatency;      // us
+        qint64 maxLatency;      // us
+        qint64 totalLatency;    // us, the latencies of successes and exceptions
+        QVector<quint32> histogram;
+    };
+
+    struct SAKStructSampleContext {
+        qint64 timestamp;       // ms since epoch
+        double requestsPerSecond;
+        qint64 exceptions;
+        qint64 timeouts;
+        qint64 errors;
+        double averageLatency;  // ms
+        double p99Latency;      // ms
+    };
+public:
+    SAKModbusCommonStatistics(QObject *parent = Q_NULLPTR);
+
+    /**
+     * @brief addRecord: Count a finished request(or a request processed by server).
+     * @param serverAddress: Unit id.
+     * @param functionCode: Function code of the request.
+     * @param latency: Round-trip time(or processing time of server), unit: us.
+     * @param result: See SAKEnumResult.
+     */
+    void addRecord(int serverAddress, int functionCode, qint64 latency, int result);
+    void clear();
+
+    QList<SAKStructCounterContext> counters();
+    // The samples of the ring buffer, the oldest one is the first one.
+    QVector<SAKStructSampleContext> samples();
+    // Save the counters and the samples to a csv file.
+    bool exportCsv(const QString &fileName, QString *errorString = Q_NULLPTR);
+
+    static int functionCode(QModbusDataUnit::RegisterType type, bool isWriting);
+    static int result(QModbusDevice::Error error);
+    // The percentile(0-100) of the histogram, unit: us.
+    static qint64 percentile(const QVector<quint32> &histogram, double p);
+    static int bucketIndex(qint64 latency);
+    static qint64 bucketValue(int index);
+private:
+    QMap<quint32, SAKStructCounterContext> mCounters;
+    QVector<SAKStructSampleContext> mSamples;
+    int mSampleHead;
+    int mSampleCount;
+    // The traffic of current second.
+    SAKStructCounterContext mCurrent;
+    QTimer mSampleTimer;
+private:
+    void resetCounter(SAKStructCounterContext &ctx);
+    void countRecord(SAKStructCounterContext &ctx, qint64 latency, int result);
+    void takeSample();
+signals:
+    void sampleTaken(const SAKStructSampleContext &ctx);
+};
+
+#endif // SAKMODBUSCOMMONSTATISTICS_HH
@@ -0,0 +1,71 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QPainter>
+#include <QPolygonF>
+
+#include "SAKModbusCommonStatisticsChart.hh"
+
+SAKModbusCommonStatisticsChart::SAKModbusCommonStatisticsChart(QWidget *parent)
+    :QWidget(parent)
+{
+    setMinimumHeight(120);
+}
+
+void SAKModbusCommonStatisticsChart::setSamples(
+        const QVector<SAKModbusCommonStatistics::SAKStructSampleContext> &samples)
+{
+    mSamples = samples;
+    update();
+}
+
+void SAKModbusCommonStatisticsChart::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+    painter.setPen(palette().mid().color());
+    painter.drawRect(rect().adjusted(0, 0, -1, -1));
+
+    double maxRequests = 0;
+    double maxLatency = 0;
+    for (auto &ctx : mSamples) {
+        maxRequests = qMax(maxRequests, ctx.requestsPerSecond);
+        maxLatency = qMax(maxLatency, ctx.p99Latency);
+    }
+
+    QString text = tr("Requests: %1/s(max), P99: %2 ms(max)")
+            .arg(maxRequests, 0, 'f', 1)
+            .arg(maxLatency, 0, 'f', 2);
+    painter.setPen(palette().text().color());
+    painter.drawText(rect().adjusted(4, 2, -4, -2), Qt::AlignLeft | Qt::AlignTop, text);
+    if (mSamples.count() < 2) {
+        return;
+    }
+
+    // The newest sample is at the right edge.
+    QRectF area = QRectF(rect()).adjusted(2, fontMetrics().height() + 4, -2, -2);
+    double step = area.width()/(mSamples.count() - 1);
+    QPolygonF requestsLine;
+    QPolygonF latencyLine;
+    for (int i = 0; i < mSamples.count(); i++) {
+        auto &ctx = mSamples.at(i);
+        double x = area.left() + i*step;
+        double requests = maxRequests > 0 ? ctx.requestsPerSecond/maxRequests : 0;
+        double latency = maxLatency > 0 ? ctx.p99Latency/maxLatency : 0;
+        requestsLine.append(QPointF(x, area.bottom() - requests*area.height()));
+        latencyLine.append(QPointF(x, area.bottom() - latency*area.height()));
+    }
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(Qt::blue, 1.5));
+    painter.drawPolyline(requestsLine);
+    painter.setPen(QPen(Qt::red, 1.5));
+    painter.drawPolyline(latencyLine);
+}
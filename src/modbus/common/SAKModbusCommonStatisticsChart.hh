@@ -0,0 +1,32 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKMODBUSCOMMONSTATISTICSCHART_HH
+#define SAKMODBUSCOMMONSTATISTICSCHART_HH
+
+#include <QWidget>
+#include <QPaintEvent>
+
+#include "SAKModbusCommonStatistics.hh"
+
+/// @brief Requests per second(blue) and p99 latency(red) of the samples, each
+/// curve is scaled to its max value.
+class SAKModbusCommonStatisticsChart : public QWidget
+{
+    Q_OBJECT
+public:
+    SAKModbusCommonStatisticsChart(QWidget *parent = Q_NULLPTR);
+    void setSamples(const QVector<SAKModbusCommonStatistics::SAKStructSampleContext> &samples);
+protected:
+    void paintEvent(QPaintEvent *event) override;
+private:
+    QVector<SAKModbusCommonStatistics::SAKStructSampleContext> mSamples;
+};
+
+#endif // SAKMODBUSCOMMONSTATISTICSCHART_HH
@@ -0,0 +1,136 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QDebug>
+#include <QDateTime>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QVBoxLayout>
+
+#include "SAKModbusCommonStatisticsChart.hh"
+#include "SAKModbusCommonStatisticsWidget.hh"
+#include "ui_SAKModbusCommonStatisticsWidget.h"
+
+SAKModbusCommonStatisticsWidget::SAKModbusCommonStatisticsWidget(QWidget *parent)
+    :QWidget(parent)
+    ,mChart(Q_NULLPTR)
+    ,ui(new Ui::SAKModbusCommonStatisticsWidget)
+{
+    ui->setupUi(this);
+    mChart = new SAKModbusCommonStatisticsChart(this);
+    auto layout = new QVBoxLayout(ui->chartWidget);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(mChart);
+
+    QStringList headerLabels;
+    headerLabels << tr("Unit ID") << tr("Function Code") << tr("Requests")
+                 << tr("Exceptions") << tr("Timeouts") << tr("Errors")
+                 << tr("Min(ms)") << tr("Avg(ms)") << tr("P99(ms)") << tr("Max(ms)");
+    ui->tableWidget->setColumnCount(headerLabels.count());
+    ui->tableWidget->setHorizontalHeaderLabels(headerLabels);
+    ui->tableWidget->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    ui->tableWidget->verticalHeader()->setVisible(false);
+
+    connect(ui->clearPushButton, &QPushButton::clicked,
+            this, &SAKModbusCommonStatisticsWidget::clearStatistics);
+    connect(ui->exportPushButton, &QPushButton::clicked,
+            this, &SAKModbusCommonStatisticsWidget::exportStatistics);
+}
+
+SAKModbusCommonStatisticsWidget::~SAKModbusCommonStatisticsWidget()
+{
+    delete ui;
+}
+
+void SAKModbusCommonStatisticsWidget::setStatistics(SAKModbusCommonStatistics *statistics)
+{
+    if (mStatistics) {
+        disconnect(mStatistics, Q_NULLPTR, this, Q_NULLPTR);
+    }
+
+    mStatistics = statistics;
+    if (mStatistics) {
+        connect(mStatistics, &SAKModbusCommonStatistics::sampleTaken,
+                this, &SAKModbusCommonStatisticsWidget::updateStatistics);
+    }
+    updateStatistics();
+}
+
+void SAKModbusCommonStatisticsWidget::updateStatistics()
+{
+    // The counters are refreshed once a second, and only if they are visible.
+    if ((!mStatistics) || (!isVisible())) {
+        if (!mStatistics) {
+            ui->tableWidget->setRowCount(0);
+            mChart->setSamples(QVector<SAKModbusCommonStatistics::SAKStructSampleContext>());
+        }
+        return;
+    }
+
+    auto counters = mStatistics->counters();
+    ui->tableWidget->setRowCount(counters.count());
+    for (int row = 0; row < counters.count(); row++) {
+        auto &ctx = counters.at(row);
+        qint64 responses = ctx.requests - ctx.timeouts - ctx.errors;
+        double avg = responses > 0 ? ctx.totalLatency/1000.0/responses : 0;
+        QStringList texts;
+        texts << QString::number(ctx.serverAddress)
+              << QString("0x%1").arg(ctx.functionCode, 2, 16, QChar('0'))
+              << QString::number(ctx.requests)
+              << QString::number(ctx.exceptions)
+              << QString::number(ctx.timeouts)
+              << QString::number(ctx.errors)
+              << QString::number(ctx.minLatency/1000.0, 'f', 2)
+              << QString::number(avg, 'f', 2)
+              << QString::number(SAKModbusCommonStatistics::percentile(ctx.histogram, 99)/1000.0, 'f', 2)
+              << QString::number(ctx.maxLatency/1000.0, 'f', 2);
+        for (int column = 0; column < texts.count(); column++) {
+            auto item = ui->tableWidget->item(row, column);
+            if (!item) {
+                item = new QTableWidgetItem;
+                item->setTextAlignment(Qt::AlignCenter);
+                ui->tableWidget->setItem(row, column, item);
+            }
+            item->setText(texts.at(column));
+        }
+    }
+
+    mChart->setSamples(mStatistics->samples());
+}
+
+void SAKModbusCommonStatisticsWidget::clearStatistics()
+{
+    if (mStatistics) {
+        mStatistics->clear();
+    }
+    updateStatistics();
+}
+
+void SAKModbusCommonStatisticsWidget::exportStatistics()
+{
+    if (!mStatistics) {
+        return;
+    }
+
+    QString defaultName = QDateTime::currentDateTime().toString("yyyyMMddhhmmss").append(".csv").prepend("./");
+    auto fileName = QFileDialog::getSaveFileName(this,
+                                                 tr("Export Statistics"),
+                                                 defaultName,
+                                                 QString("CSV (*.csv)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QString errorString;
+    if (!mStatistics->exportCsv(fileName, &errorString)) {
+        QMessageBox::warning(this, tr("Export Statistics"),
+                             tr("Can not save the file:%1").arg(errorString));
+    }
+}
@@ -0,0 +1,44 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKMODBUSCOMMONSTATISTICSWIDGET_HH
+#define SAKMODBUSCOMMONSTATISTICSWIDGET_HH
+
+#include <QWidget>
+#include <QPointer>
+
+#include "SAKModbusCommonStatistics.hh"
+
+namespace Ui {
+    class SAKModbusCommonStatisticsWidget;
+}
+
+class SAKModbusCommonStatisticsChart;
+/// @brief Counters(by unit id and function code) and the live chart.
+class SAKModbusCommonStatisticsWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit SAKModbusCommonStatisticsWidget(QWidget *parent = Q_NULLPTR);
+    ~SAKModbusCommonStatisticsWidget();
+
+    /// @brief The statistics of current controller, it can be null.
+    void setStatistics(SAKModbusCommonStatistics *statistics);
+private:
+    QPointer<SAKModbusCommonStatistics> mStatistics;
+    SAKModbusCommonStatisticsChart *mChart;
+private:
+    void updateStatistics();
+    void clearStatistics();
+    void exportStatistics();
+private:
+    Ui::SAKModbusCommonStatisticsWidget *ui;
+};
+
+#endif // SAKMODBUSCOMMONSTATISTICSWIDGET_HH
@@ -49,6 +49,11 @@ quint16 SAKModbusServerController::registerValue(QModbusDataUnit::RegisterType t
     return value;
 }
 
+QVector<quint16> SAKModbusServerController::registerValues(QModbusDataUnit::RegisterType type, quint16 startAddress, quint16 registerNumber)
+{
+    return serverRegisterValues(qobject_cast<QModbusServer*>(device()), type, startAddress, registerNumber);
+}
+
 void SAKModbusServerController::exportRegisterData()
 {
     auto fileName = getSaveFileName();
@@ -20,6 +20,7 @@ public:
     SAKModbusServerController(QWidget *parent = Q_NULLPTR);
     virtual void setData(QModbusDataUnit::RegisterType type, quint16 address, quint16 value) final;
     virtual quint16 registerValue(QModbusDataUnit::RegisterType type, quint16 address) final;
+    virtual QVector<quint16> registerValues(QModbusDataUnit::RegisterType type, quint16 startAddress, quint16 registerNumber) final;
     virtual void exportRegisterData() final;
     virtual void importRegisterData() final;
 protected:
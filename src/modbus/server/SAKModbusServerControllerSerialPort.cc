@@ -9,6 +9,7 @@
  */
 #include "SAKModbusCommonServerSection.hh"
 #include "SAKModbusCommonSerialPortSection.hh"
+#include "SAKModbusServerDevice.hh"
 #include "SAKModbusServerControllerSerialPort.hh"
 
 SAKModbusServerControllerSerialPort::SAKModbusServerControllerSerialPort(QWidget *parent)
@@ -38,9 +39,9 @@ void SAKModbusServerControllerSerialPort::open()
 QModbusDevice *SAKModbusServerControllerSerialPort::initModbusDevice()
 {
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-    auto dev = new QModbusRtuSerialSlave;
+    auto dev = new SAKModbusServerDevice<QModbusRtuSerialSlave>(statistics());
 #else
-    auto dev = new QModbusRtuSerialServer;
+    auto dev = new SAKModbusServerDevice<QModbusRtuSerialServer>(statistics());
 #endif
     return dev;
 }
@@ -11,6 +11,7 @@
 #include <QModbusTcpServer>
 #include "SAKModbusCommonHostSection.hh"
 #include "SAKModbusCommonServerSection.hh"
+#include "SAKModbusServerDevice.hh"
 #include "SAKModbusServerControllerTcp.hh"
 
 SAKModbusServerControllerTcp::SAKModbusServerControllerTcp(QWidget *parent)
@@ -35,6 +36,6 @@ void SAKModbusServerControllerTcp::open()
 
 QModbusDevice *SAKModbusServerControllerTcp::initModbusDevice()
 {
-    auto dev = new QModbusTcpServer;
+    auto dev = new SAKModbusServerDevice<QModbusTcpServer>(statistics());
     return dev;
 }
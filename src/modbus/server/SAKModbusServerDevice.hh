@@ -0,0 +1,50 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKMODBUSSERVERDEVICE_HH
+#define SAKMODBUSSERVERDEVICE_HH
+
+#include <QPointer>
+#include <QModbusPdu>
+#include <QElapsedTimer>
+
+#include "SAKModbusCommonStatistics.hh"
+
+/// @brief A modbus server(QModbusTcpServer, QModbusRtuSerialSlave...) which
+/// counts the requests processed, the latency is the processing time.
+template <typename T>
+class SAKModbusServerDevice : public T
+{
+public:
+    SAKModbusServerDevice(SAKModbusCommonStatistics *statistics)
+        :T()
+        ,mStatistics(statistics)
+    {}
+protected:
+    QModbusResponse processRequest(const QModbusPdu &request) override
+    {
+        QElapsedTimer elapsedTimer;
+        elapsedTimer.start();
+        QModbusResponse response = T::processRequest(request);
+        if (mStatistics) {
+            int result = response.isException()
+                    ? SAKModbusCommonStatistics::ResultException
+                    : SAKModbusCommonStatistics::ResultSuccess;
+            mStatistics->addRecord(T::serverAddress(),
+                                   request.functionCode(),
+                                   elapsedTimer.nsecsElapsed()/1000,
+                                   result);
+        }
+        return response;
+    }
+private:
+    QPointer<SAKModbusCommonStatistics> mStatistics;
+};
+
+#endif // SAKMODBUSSERVERDEVICE_HH
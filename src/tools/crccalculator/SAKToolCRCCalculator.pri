@@ -5,8 +5,10 @@ FORMS += \
     $$PWD/src/SAKToolCRCCalculator.ui
 
 HEADERS += \
-    $$PWD/src/SAKToolCRCCalculator.hh
+    $$PWD/src/SAKToolCRCCalculator.hh \
+    $$PWD/src/SAKToolCRCCalculatorThread.hh
 
 SOURCES += \
-    $$PWD/src/SAKToolCRCCalculator.cc
+    $$PWD/src/SAKToolCRCCalculator.cc \
+    $$PWD/src/SAKToolCRCCalculatorThread.cc
 
@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2018-2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2018-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -9,17 +9,23 @@
  */
 #include <QComboBox>
 #include <QMetaEnum>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QMessageBox>
 #include <QDesktopServices>
 #include <QLoggingCategory>
 
 #include "SAKCommonCrcInterface.hh"
 #include "SAKToolCRCCalculator.hh"
+#include "SAKToolCRCCalculatorThread.hh"
 #include "ui_SAKToolCRCCalculator.h"
 
 SAKToolCRCCalculator::SAKToolCRCCalculator(QWidget* parent)
     :QWidget(parent)
     ,mLogCategory("CRCCalculator")
     ,mCrcInterface(new SAKCommonCrcInterface)
+    ,mThread(Q_NULLPTR)
     ,mUi(new Ui::SAKToolCRCCalculator)
 {
     mUi->setupUi(this);
@@ -60,14 +66,32 @@ SAKToolCRCCalculator::SAKToolCRCCalculator(QWidget* parent)
     mLabelInfo->installEventFilter(this);
     mLabelInfo->setCursor(QCursor(Qt::PointingHandCursor));
 
+    mFileLineEdit = mUi->lineEditFile;
+    mExpectedLineEdit = mUi->lineEditExpected;
+    mAllModelsCheckBox = mUi->checkBoxAllModels;
+    mFileProgressBar = mUi->progressBarFile;
+    mModelsTableWidget = mUi->tableWidgetModels;
+    mCalculateFileBt = mUi->pushButtonCalculateFile;
+    mFileProgressBar->setRange(0, 100);
+    mFileProgressBar->setValue(0);
+    mModelsTableWidget->setColumnCount(3);
+    mModelsTableWidget->setHorizontalHeaderLabels(QStringList() << tr("Parameter model")
+                                                  << tr("Result(HEX)") << tr("Matched"));
+    mModelsTableWidget->horizontalHeader()->setStretchLastSection(true);
+    mModelsTableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
     initParameterModel();
     connect(mParameterComboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(changedParameterModel(int)));
     connect(mCalculatedBt, SIGNAL(clicked()), this, SLOT(calculate()));
     connect(mInputTextEdit, SIGNAL(textChanged()), this, SLOT(textFormatControl()));
+    connect(mUi->pushButtonFile, SIGNAL(clicked()), this, SLOT(browseFile()));
+    connect(mCalculateFileBt, SIGNAL(clicked()), this, SLOT(calculateFile()));
+    connect(mExpectedLineEdit, SIGNAL(textChanged(QString)), this, SLOT(updateMatches()));
 }
 
 SAKToolCRCCalculator::~SAKToolCRCCalculator()
 {
+    stopThread();
     QLoggingCategory category(mLogCategory);
     qCInfo(category) << "Goodbye CRCCalculator";
     delete mCrcInterface;
@@ -147,6 +171,62 @@ void SAKToolCRCCalculator::calculate()
 
     mHexCRCOutput->setText(crcHexString);
     mBinCRCOutput->setText(crcBinString);
+
+    // The crc of all models, it is used to find out which model a device uses.
+    if (mAllModelsCheckBox->isChecked()){
+        mModelsTableWidget->setRowCount(0);
+        for (int i = 0; i < models.keyCount(); i++){
+            auto var = static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(models.value(i));
+            SAKCommonCrcInterface::SAKStructCrcContext ctx;
+            mCrcInterface->crcInit(&ctx, var);
+            SAKCommonCrcInterface::crcUpdate(&ctx,
+                                             reinterpret_cast<const uint8_t*>(inputArray.constData()),
+                                             static_cast<uint64_t>(inputArray.length()));
+            setResult(var, SAKCommonCrcInterface::crcFinal(&ctx));
+        }
+    }
+}
+
+int SAKToolCRCCalculator::currentModel()
+{
+    QMetaEnum models = QMetaEnum::fromType<SAKCommonCrcInterface::SAKEnumCrcModel>();
+    bool ok = false;
+    int ret = models.keyToValue(mParameterComboBox->currentText().toLatin1().constData(), &ok);
+    return ok ? ret : int(SAKCommonCrcInterface::CRC_8);
+}
+
+void SAKToolCRCCalculator::stopThread()
+{
+    if (mThread){
+        mThread->blockSignals(true);
+        mThread->requestInterruption();
+        mThread->wait();
+        mThread->deleteLater();
+        mThread = Q_NULLPTR;
+    }
+}
+
+void SAKToolCRCCalculator::setResult(int model, quint32 crc)
+{
+    auto crcModel = static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(model);
+    int bitsWidth = mCrcInterface->bitsWidth(crcModel);
+    QString crcHexString = QString("0x%1").arg(QString::number(crc, 16), bitsWidth/4, '0');
+    if (model == currentModel()){
+        mHexCRCOutput->setText(crcHexString);
+        mBinCRCOutput->setText(QString("%1").arg(QString::number(crc, 2), bitsWidth, '0'));
+    }
+
+    QMetaEnum models = QMetaEnum::fromType<SAKCommonCrcInterface::SAKEnumCrcModel>();
+    int row = mModelsTableWidget->rowCount();
+    mModelsTableWidget->insertRow(row);
+    auto modelItem = new QTableWidgetItem(QString(models.valueToKey(model)));
+    modelItem->setData(Qt::UserRole, model);
+    auto crcItem = new QTableWidgetItem(crcHexString);
+    crcItem->setData(Qt::UserRole, crc);
+    mModelsTableWidget->setItem(row, 0, modelItem);
+    mModelsTableWidget->setItem(row, 1, crcItem);
+    mModelsTableWidget->setItem(row, 2, new QTableWidgetItem);
+    updateMatches();
 }
 
 void SAKToolCRCCalculator::textFormatControl()
@@ -197,6 +277,103 @@ void SAKToolCRCCalculator::changedParameterModel(int index)
     mLabelPolyFormula->setText(mCrcInterface->friendlyPoly(model));
 }
 
+void SAKToolCRCCalculator::browseFile()
+{
+    QString fileName = QFileDialog::getOpenFileName(this, tr("Input file"),
+                                                    mFileLineEdit->text());
+    if (!fileName.isEmpty()){
+        mFileLineEdit->setText(fileName);
+    }
+}
+
+void SAKToolCRCCalculator::calculateFile()
+{
+    if (mThread){
+        fileCalculated();
+        return;
+    }
+
+    QString fileName = mFileLineEdit->text().trimmed();
+    if (!QFileInfo(fileName).isFile()){
+        QMessageBox::warning(this, tr("Input file"), tr("The file is not existed!"));
+        return;
+    }
+
+    QList<SAKCommonCrcInterface::SAKEnumCrcModel> list;
+    if (mAllModelsCheckBox->isChecked()){
+        QMetaEnum models = QMetaEnum::fromType<SAKCommonCrcInterface::SAKEnumCrcModel>();
+        for (int i = 0; i < models.keyCount(); i++){
+            list.append(static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(models.value(i)));
+        }
+    }else{
+        list.append(static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(currentModel()));
+    }
+
+    mModelsTableWidget->setRowCount(0);
+    mFileProgressBar->setValue(0);
+    mThread = new SAKToolCRCCalculatorThread(fileName, list, this);
+    connect(mThread, &SAKToolCRCCalculatorThread::crcCalculated,
+            this, &SAKToolCRCCalculator::setResult);
+    connect(mThread, &SAKToolCRCCalculatorThread::progressChanged,
+            mFileProgressBar, &QProgressBar::setValue);
+    connect(mThread, &SAKToolCRCCalculatorThread::outputMessage,
+            this, [=](QString msg, bool isErrMsg){
+        if (isErrMsg){
+            QMessageBox::warning(this, tr("Input file"), msg);
+        }
+    });
+    connect(mThread, &QThread::finished, this, &SAKToolCRCCalculator::fileCalculated);
+    mThread->start();
+    mCalculateFileBt->setText(tr("Stop"));
+    mCalculatedBt->setEnabled(false);
+}
+
+void SAKToolCRCCalculator::updateMatches()
+{
+    QString text = mExpectedLineEdit->text().trimmed();
+    text.remove(QRegularExpression("^0[xX]"));
+    text.remove(' ');
+    bool ok = false;
+    quint32 expected = text.toUInt(&ok, 16);
+
+    for (int i = 0; i < mModelsTableWidget->rowCount(); i++){
+        auto model = static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(
+                    mModelsTableWidget->item(i, 0)->data(Qt::UserRole).toInt());
+        quint32 crc = mModelsTableWidget->item(i, 1)->data(Qt::UserRole).toUInt();
+        int bytes = mCrcInterface->bitsWidth(model)/8;
+
+        // Such as the crc of modbus, the low byte is sent first.
+        quint32 swapped = 0;
+        for (int j = 0; j < bytes; j++){
+            swapped = (swapped << 8) | ((crc >> (8*j)) & 0xff);
+        }
+
+        QString matched;
+        if (ok && (!text.isEmpty())){
+            if (expected == crc){
+                matched = tr("Yes");
+            }else if ((bytes > 1) && (expected == swapped)){
+                matched = tr("Yes(byte swapped)");
+            }
+        }
+
+        auto item = mModelsTableWidget->item(i, 2);
+        item->setText(matched);
+        for (int j = 0; j < mModelsTableWidget->columnCount(); j++){
+            mModelsTableWidget->item(i, j)->setBackground(matched.isEmpty()
+                                                          ? QBrush()
+                                                          : QBrush(Qt::green));
+        }
+    }
+}
+
+void SAKToolCRCCalculator::fileCalculated()
+{
+    stopThread();
+    mCalculateFileBt->setText(tr("Calculate file"));
+    mCalculatedBt->setEnabled(true);
+}
+
 bool SAKToolCRCCalculator::eventFilter(QObject *watched, QEvent *event)
 {
     if (event->type() == QEvent::MouseButtonDblClick){
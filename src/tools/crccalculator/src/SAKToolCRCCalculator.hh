@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2018-2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2018-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -18,7 +18,9 @@
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QPushButton>
+#include <QProgressBar>
 #include <QRadioButton>
+#include <QTableWidget>
 #include <QJsonDocument>
 #include <QJsonParseError>
 
@@ -27,6 +29,7 @@ namespace Ui {
 }
 
 class SAKCommonCrcInterface;
+class SAKToolCRCCalculatorThread;
 class SAKToolCRCCalculator:public QWidget
 {
     Q_OBJECT
@@ -38,12 +41,20 @@ protected:
 private:
     const char *mLogCategory;
     SAKCommonCrcInterface *mCrcInterface;
+    SAKToolCRCCalculatorThread *mThread;
 private:
     void initParameterModel();
+    int currentModel();
+    void stopThread();
+    void setResult(int model, quint32 crc);
 private slots:
     void calculate();
     void textFormatControl();
     void changedParameterModel(int index);
+    void browseFile();
+    void calculateFile();
+    void updateMatches();
+    void fileCalculated();
 private:
     Ui::SAKToolCRCCalculator* mUi;
     QComboBox* mWidthComboBox;
@@ -61,5 +72,11 @@ private:
     QPushButton* mCalculatedBt;
     QLabel *mLabelPolyFormula;
     QLabel *mLabelInfo;
+    QLineEdit *mFileLineEdit;
+    QLineEdit *mExpectedLineEdit;
+    QCheckBox *mAllModelsCheckBox;
+    QProgressBar *mFileProgressBar;
+    QTableWidget *mModelsTableWidget;
+    QPushButton *mCalculateFileBt;
 };
 #endif
@@ -0,0 +1,157 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QFile>
+#include <QVector>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QByteArray>
+#include <QThreadPool>
+
+#include "SAKToolCRCCalculatorThread.hh"
+
+namespace {
+typedef QVector<SAKCommonCrcInterface::SAKStructCrcContext> SAKCrcContextVector;
+
+// All of the models are fed with a small piece which is in the cache before the
+// next piece, so the data is read from memory once.
+void crcUpdateAll(SAKCrcContextVector *contexts, const uint8_t *data, qint64 length)
+{
+    const qint64 pieceLength = 64*1024;
+    while (length > 0) {
+        qint64 piece = qMin(length, pieceLength);
+        for (auto &var : *contexts) {
+            SAKCommonCrcInterface::crcUpdate(&var, data, uint64_t(piece));
+        }
+        data += piece;
+        length -= piece;
+    }
+}
+
+class SAKToolCRCCalculatorTask : public QRunnable
+{
+public:
+    SAKToolCRCCalculatorTask(SAKCrcContextVector *contexts,
+                             const uint8_t *data,
+                             qint64 length,
+                             QSemaphore *semaphore)
+        :mContexts(contexts)
+        ,mData(data)
+        ,mLength(length)
+        ,mSemaphore(semaphore)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() final
+    {
+        crcUpdateAll(mContexts, mData, mLength);
+        mSemaphore->release();
+    }
+private:
+    SAKCrcContextVector *mContexts;
+    const uint8_t *mData;
+    qint64 mLength;
+    QSemaphore *mSemaphore;
+};
+}
+
+SAKToolCRCCalculatorThread::SAKToolCRCCalculatorThread(
+        const QString &fileName,
+        const QList<SAKCommonCrcInterface::SAKEnumCrcModel> &models,
+        QObject *parent)
+    :QThread(parent)
+    ,mFileName(fileName)
+    ,mModels(models)
+{
+
+}
+
+void SAKToolCRCCalculatorThread::run()
+{
+    QFile file(mFileName);
+    if (!file.open(QFile::ReadOnly)) {
+        emit outputMessage(file.errorString(), true);
+        return;
+    }
+
+    SAKCrcContextVector contexts(mModels.count());
+    for (int i = 0; i < mModels.count(); i++) {
+        SAKCommonCrcInterface::crcInit(&contexts[i], mModels.at(i));
+    }
+
+    // The parts of a block are calculated from the register 0.
+    const int threadCount = qMax(1, QThread::idealThreadCount());
+    QVector<SAKCrcContextVector> partContexts(threadCount, contexts);
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    QSemaphore semaphore;
+
+    const qint64 blockLength = 32*1024*1024;
+    const qint64 minPartLength = 1024*1024;
+    QByteArray buffer;
+    buffer.resize(int(qMin(blockLength, qMax<qint64>(file.size(), 1))));
+    qint64 allBytes = file.size();
+    qint64 consumeBytes = 0;
+    int percent = 0;
+    while (!isInterruptionRequested()) {
+        qint64 length = file.read(buffer.data(), buffer.size());
+        if (length < 0) {
+            emit outputMessage(file.errorString(), true);
+            return;
+        } else if (length == 0) {
+            break;
+        }
+
+        const uint8_t *data = reinterpret_cast<const uint8_t*>(buffer.constData());
+        int parts = int(qBound<qint64>(1, length/minPartLength, threadCount));
+        if (parts == 1) {
+            crcUpdateAll(&contexts, data, length);
+        } else {
+            qint64 partLength = length/parts;
+            for (int i = 0; i < parts; i++) {
+                for (auto &var : partContexts[i]) {
+                    var.reg = 0;
+                }
+
+                qint64 offset = i*partLength;
+                qint64 len = (i == parts - 1) ? (length - offset) : partLength;
+                threadPool.start(new SAKToolCRCCalculatorTask(&partContexts[i], data + offset,
+                                                              len, &semaphore));
+            }
+            semaphore.acquire(parts);
+
+            for (int i = 0; i < parts; i++) {
+                qint64 len = (i == parts - 1) ? (length - i*partLength) : partLength;
+                for (int j = 0; j < contexts.count(); j++) {
+                    contexts[j].reg = SAKCommonCrcInterface::crcCombine(&contexts[j],
+                                                                        contexts[j].reg,
+                                                                        partContexts[i][j].reg,
+                                                                        uint64_t(len));
+                }
+            }
+        }
+
+        consumeBytes += length;
+        int temp = allBytes ? int(consumeBytes*100/allBytes) : 100;
+        if (temp != percent) {
+            percent = temp;
+            emit progressChanged(percent);
+        }
+    }
+
+    if (isInterruptionRequested()) {
+        return;
+    }
+
+    for (int i = 0; i < contexts.count(); i++) {
+        emit crcCalculated(mModels.at(i), SAKCommonCrcInterface::crcFinal(&contexts.at(i)));
+    }
+    emit progressChanged(100);
+}
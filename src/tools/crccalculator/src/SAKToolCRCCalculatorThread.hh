@@ -0,0 +1,40 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLCRCCALCULATORTHREAD_HH
+#define SAKTOOLCRCCALCULATORTHREAD_HH
+
+#include <QList>
+#include <QThread>
+#include <QString>
+
+#include "SAKCommonCrcInterface.hh"
+
+/// @brief Calculate the crc of a file with several models, the file is read
+/// once. A block of the file is split to several parts which are calculated by
+/// the threads of a pool, the parts are merged with crcCombine().
+class SAKToolCRCCalculatorThread : public QThread
+{
+    Q_OBJECT
+public:
+    SAKToolCRCCalculatorThread(const QString &fileName,
+                               const QList<SAKCommonCrcInterface::SAKEnumCrcModel> &models,
+                               QObject *parent = Q_NULLPTR);
+private:
+    QString mFileName;
+    QList<SAKCommonCrcInterface::SAKEnumCrcModel> mModels;
+private:
+    void run() final;
+signals:
+    void outputMessage(QString msg, bool isErrMsg);
+    void progressChanged(int percent);
+    void crcCalculated(int model, quint32 crc);
+};
+
+#endif // SAKTOOLCRCCALCULATORTHREAD_HH
@@ -6,15 +6,34 @@ contains(DEFINES, SAK_IMPORT_MODULE_FILECHECKER){
         $$PWD/src
 
     FORMS += \
-    $$PWD/src/SAKToolFileChecker.ui
+    $$PWD/src/SAKToolFileChecker.ui \
+    $$PWD/src/SAKToolFileCheckerBatch.ui
 
     HEADERS += \
         $$PWD/src/QtCryptographicHashCalculator.hh \
-    $$PWD/src/SAKToolFileChecker.hh
+    $$PWD/src/SAKToolFileChecker.hh \
+    $$PWD/src/SAKToolFileCheckerBatch.hh \
+    $$PWD/src/SAKToolFileCheckerBatchCalculator.hh \
+    $$PWD/src/SAKToolFileCheckerBenchmark.hh \
+    $$PWD/src/SAKToolFileCheckerBlake3Hasher.hh \
+    $$PWD/src/SAKToolFileCheckerCrcHasher.hh \
+    $$PWD/src/SAKToolFileCheckerHasher.hh \
+    $$PWD/src/SAKToolFileCheckerManifest.hh \
+    $$PWD/src/SAKToolFileCheckerReader.hh \
+    $$PWD/src/SAKToolFileCheckerXxh3Hasher.hh
 
     SOURCES += \
         $$PWD/src/QtCryptographicHashCalculator.cc \
-    $$PWD/src/SAKToolFileChecker.cc
+    $$PWD/src/SAKToolFileChecker.cc \
+    $$PWD/src/SAKToolFileCheckerBatch.cc \
+    $$PWD/src/SAKToolFileCheckerBatchCalculator.cc \
+    $$PWD/src/SAKToolFileCheckerBenchmark.cc \
+    $$PWD/src/SAKToolFileCheckerBlake3Hasher.cc \
+    $$PWD/src/SAKToolFileCheckerCrcHasher.cc \
+    $$PWD/src/SAKToolFileCheckerHasher.cc \
+    $$PWD/src/SAKToolFileCheckerManifest.cc \
+    $$PWD/src/SAKToolFileCheckerReader.cc \
+    $$PWD/src/SAKToolFileCheckerXxh3Hasher.cc
 }else {
     message("The Qt edition does not support the QCryptographicHash::Algorithm enum type, the program will not has file chcker module.")
 }
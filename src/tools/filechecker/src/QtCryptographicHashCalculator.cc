@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2018-2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2018-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -7,17 +7,56 @@
  * QtSwissArmyKnife is licensed according to the terms in
  * the file LICENCE in the root of the source code directory.
  */
-#include <QFile>
 #include <QDebug>
-#include <QDateTime>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
 #include <QApplication>
+#include <QElapsedTimer>
 
-#include "QtCryptographicHashCalculator.hh"
 #include "SAKToolFileChecker.hh"
+#include "SAKToolFileCheckerReader.hh"
+#include "SAKToolFileCheckerHasher.hh"
+#include "QtCryptographicHashCalculator.hh"
+
+namespace {
+// Feed a block to a hasher in a thread of the pool.
+class SAKToolFileCheckerTask : public QRunnable
+{
+public:
+    SAKToolFileCheckerTask(SAKToolFileCheckerHasher *hasher,
+                           const uchar *data,
+                           qint64 length,
+                           QSemaphore *semaphore)
+        :mHasher(hasher)
+        ,mData(data)
+        ,mLength(length)
+        ,mSemaphore(semaphore)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() final
+    {
+        mHasher->addData(mData, mLength);
+        mSemaphore->release();
+    }
+private:
+    SAKToolFileCheckerHasher *mHasher;
+    const uchar *mData;
+    qint64 mLength;
+    QSemaphore *mSemaphore;
+};
+}
+
 QtCryptographicHashCalculator::QtCryptographicHashCalculator(SAKToolFileChecker *controller, QObject *parent)
     :QThread (parent)
     ,mCryptographicHashController (controller)
 {
+    // The parameters are copied, the controller is not accessed by the thread.
+    mFileName = controller->fileName();
+    mAlgorithms = controller->algorithms();
+
     connect(this, &QtCryptographicHashCalculator::updateResult, controller, &SAKToolFileChecker::updateResult);
     connect(this, &QtCryptographicHashCalculator::outputMessage, controller, &SAKToolFileChecker::outputMessage);
     connect(this, &QtCryptographicHashCalculator::updateProgressBar, controller, &SAKToolFileChecker::updateProgressBar);
@@ -26,102 +65,100 @@ QtCryptographicHashCalculator::QtCryptographicHashCalculator(SAKToolFileChecker
 
 void QtCryptographicHashCalculator::run()
 {
-    QCryptographicHash::Algorithm algorithm = mCryptographicHashController->algorithm();
-    QCryptographicHash cryptographicHash(algorithm);
-    cryptographicHash.reset();
-
-    QString fileName = mCryptographicHashController->fileName();
-    QFile file(fileName);
-    if (file.open(QFile::ReadOnly)){
-        qint64 allBytes = file.size();
-        emit progressBarMaxValueChanged(allBytes);
-
-        qint64 consumeBytes = 0;
-        qint64 remainBytes = 0;
-        qint64 percent = 0;
-        qint64 percenTemp = 0;
-        qint64 startTime = 0;
-        qint64 endTime = 0;
-        qint64 consumeTime = 0;
-        qint64 remainTime = 0;
-
-        qint64 hours = 0;
-        qint64 minutes = 0;
-        qint64 seconds = 0;
-        qint64 hoursTemp = 0;
-        qint64 minutesTemp = 0;
-        qint64 secondsTemp = 0;
-
-        // The number of bytes read at a time
-        int dataBlock = 1024*1024;
-
-        while (1) {                       
-            startTime = QDateTime::currentDateTime().toMSecsSinceEpoch();
-
-            QByteArray array = file.read(dataBlock);
-            consumeBytes += array.length();
-            remainBytes = allBytes - consumeBytes;
-
-            // Effectively reduce the frequency of signal transmission
-            percenTemp = (consumeBytes*100)/allBytes;
-            if (percenTemp != percent){
-                percent = percenTemp;
-                emit updateProgressBar(percent);
-            }
+    QStringList names;
+    QList<SAKToolFileCheckerHasher*> hashers;
+    for (auto &var : mAlgorithms){
+        auto hasher = SAKToolFileCheckerHasher::create(var);
+        if (hasher){
+            names.append(var);
+            hashers.append(hasher);
+        }
+    }
 
-            // Returns an empty array. There are two possibilities.
-            // One is that the file has been read, and the other is that the file has been read incorrectly.
-            // Both cases are considered to be the end of the check calculation
-            if (array.isEmpty()){
-                outputMessage(tr("Calculating finished"), false);
-                QApplication::beep();
-                break;
-            }
+    if (hashers.isEmpty()){
+        emit outputMessage(tr("No algorithm is selected"), true);
+        return;
+    }
 
-            cryptographicHash.addData(array);
-
-            // Calculating remaining time
-            endTime = QDateTime::currentDateTime().toMSecsSinceEpoch();
-            consumeTime = endTime - startTime;
-
-            if (consumeTime != 0){
-                consumeTimeList.append(consumeTime);
-                while (consumeTimeList.length() > 1000) {
-                    consumeTimeList.removeFirst();
-                }
-                qint64 averageConsumeTime = 0;
-                for (auto &var : consumeTimeList){
-                    averageConsumeTime += var;
-                }
-                averageConsumeTime = averageConsumeTime/consumeTimeList.count();
-                if (averageConsumeTime > 0){
-                    remainTime = remainBytes/dataBlock*averageConsumeTime;
-
-                    hoursTemp = (remainTime%(24*60*60*1000))/(60*60*1000);
-                    minutesTemp = ((remainTime%(24*60*60*1000))%(60*60*1000))/(1*60*1000);
-                    secondsTemp = (((remainTime%(24*60*60*1000))%(60*60*1000))%(1*60*1000))/1000;
-
-                    if ((hours != hoursTemp) || (minutes != minutesTemp) || (seconds != secondsTemp)){
-                        hours = hoursTemp;
-                        minutes = minutesTemp;
-                        seconds = secondsTemp;
-                        emit remainTimeChanged(QString("%1:%2:%3")
-                                               .arg(QString::number(hours), 2, '0')
-                                               .arg(QString::number(minutes), 2, '0')
-                                               .arg(QString::number(seconds), 2, '0'));
-                    }
-                }
-            }
+    SAKToolFileCheckerReader reader;
+    if (!reader.open(mFileName)){
+        emit outputMessage(reader.errorString(), true);
+        qDeleteAll(hashers);
+        return;
+    }
 
-            // Responsing the interruption requested
-            if (isInterruptionRequested()){
-                return;
+    // The last hasher is fed by this thread, the others are fed by the pool.
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(qMax(1, hashers.count() - 1));
+    QSemaphore semaphore;
+
+    qint64 allBytes = reader.size();
+    emit progressBarMaxValueChanged(allBytes);
+
+    qint64 consumeBytes = 0;
+    qint64 percent = 0;
+    qint64 remainSeconds = -1;
+    // Bytes per ms, it is an exponential moving average, so the memory is constant.
+    double averageSpeed = 0;
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+    // Nanoseconds, a fast block may take less than 1 ms.
+    qint64 lastTime = 0;
+
+    qint64 length = 0;
+    const uchar *data = Q_NULLPTR;
+    while ((data = reader.read(&length))){
+        for (int i = 0; i < hashers.count() - 1; i++){
+            threadPool.start(new SAKToolFileCheckerTask(hashers.at(i), data, length, &semaphore));
+        }
+        hashers.last()->addData(data, length);
+        semaphore.acquire(hashers.count() - 1);
+
+        consumeBytes += length;
+
+        // Effectively reduce the frequency of signal transmission
+        qint64 percentTemp = allBytes ? (consumeBytes*100)/allBytes : 100;
+        if (percentTemp != percent){
+            percent = percentTemp;
+            emit updateProgressBar(percent);
+        }
+
+        // Calculating remaining time
+        qint64 currentTime = elapsedTimer.nsecsElapsed();
+        qint64 consumeTime = currentTime - lastTime;
+        lastTime = currentTime;
+        if (consumeTime > 0){
+            double speed = double(length)*1000000/consumeTime;
+            averageSpeed = averageSpeed > 0 ? averageSpeed*0.8 + speed*0.2 : speed;
+            qint64 remainTime = qint64((allBytes - consumeBytes)/averageSpeed);
+            if (remainTime/1000 != remainSeconds){
+                remainSeconds = remainTime/1000;
+                qint64 hours = remainSeconds/3600;
+                qint64 minutes = (remainSeconds%3600)/60;
+                qint64 seconds = remainSeconds%60;
+                emit remainTimeChanged(QString("%1:%2:%3")
+                                       .arg(QString::number(hours), 2, '0')
+                                       .arg(QString::number(minutes), 2, '0')
+                                       .arg(QString::number(seconds), 2, '0'));
             }
         }
 
-        QByteArray result = cryptographicHash.result();
-        emit updateResult(result);
-    }else{
-        outputMessage(file.errorString(), true);
+        // Responsing the interruption requested
+        if (isInterruptionRequested()){
+            qDeleteAll(hashers);
+            return;
+        }
+    }
+
+    if (reader.hasError()){
+        emit outputMessage(reader.errorString(), true);
+    } else {
+        for (int i = 0; i < hashers.count(); i++){
+            emit updateResult(names.at(i), hashers.at(i)->result());
+        }
+        emit outputMessage(tr("Calculating finished"), false);
+        QApplication::beep();
     }
+
+    qDeleteAll(hashers);
 }
@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2018-2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2018-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -11,8 +11,11 @@
 #define QTCRYPTOGRAPHICHASHCALCULATOR_HH
 
 #include <QThread>
+#include <QStringList>
 
 class SAKToolFileChecker;
+/// @brief The file is read once, the blocks are fed to all of the algorithms
+/// selected(in parallel if there are several algorithms).
 class QtCryptographicHashCalculator:public QThread
 {
     Q_OBJECT
@@ -20,12 +23,13 @@ public:
     QtCryptographicHashCalculator(SAKToolFileChecker *controller, QObject *parent = Q_NULLPTR);
 private:
     SAKToolFileChecker *mCryptographicHashController;
-    QList<qint64> consumeTimeList;
+    QString mFileName;
+    QStringList mAlgorithms;
 private:
     void run() final;
 signals:
     void outputMessage(QString msg, bool isErrMsg);
-    void updateResult(QByteArray result);
+    void updateResult(QString algorithm, QByteArray result);
     void progressBarMaxValueChanged(qint64 value);
     void updateProgressBar(qint64 currentValue);
     void remainTimeChanged(QString remainTime);
@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2018-2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2018-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -8,49 +8,48 @@
  * the file LICENCE in the root of the source code directory.
  */
 #include <QDebug>
-#include <QMetaEnum>
 #include <QFileDialog>
 
-#include "QtCryptographicHashCalculator.hh"
 #include "SAKToolFileChecker.hh"
+#include "SAKToolFileCheckerHasher.hh"
+#include "SAKToolFileCheckerBenchmark.hh"
+#include "QtCryptographicHashCalculator.hh"
 #include "ui_SAKToolFileChecker.h"
 
 SAKToolFileChecker::SAKToolFileChecker(QWidget *parent)
     :QWidget(parent)
     ,mFileName(QString("C:/Windows/explorer.exe"))
-    ,mAlgorithm(QCryptographicHash::Md5)
     ,mCalculator (Q_NULLPTR)
+    ,mBenchmark (Q_NULLPTR)
     ,mUi (new Ui::SAKToolFileChecker)
 {
     mUi->setupUi(this);
 
     // Initializing data member about ui
     mFilePathlineEdit = mUi->filePathlineEdit;
-    mAlgorithmComboBox = mUi->algorithmComboBox;
-    mResultLineEdit = mUi->resultLineEdit;
+    mAlgorithmListWidget = mUi->algorithmListWidget;
+    mResultPlainTextEdit = mUi->resultPlainTextEdit;
     mCalculatorProgressBar = mUi->calculatorProgressBar;
     mOpenPushButton = mUi->openPushButton;
     mStartStopPushButton = mUi->startStopPushButton;
+    mBenchmarkPushButton = mUi->benchmarkPushButton;
     mUpperCheckBox = mUi->upperCheckBox;
     mMessageLabel = mUi->messageLabel;
     mRemainTimeLabel = mUi->remainTimeLabel;
     mFilePathlineEdit->setText(mFileName);
 
-    // Appending algorithms to combo box
-#if QT_VERSION < QT_VERSION_CHECK(5, 9, 0)
-    QMetaEnum algorithms = QMetaEnum::fromType<SAKToolFileChecker::Algorithm>();
-#else
-    QMetaEnum algorithms = QMetaEnum::fromType<QCryptographicHash::Algorithm>();
-#endif
-    QStringList algorithmsStringList;
-    for (int i = 0; i < algorithms.keyCount(); i++){
-        algorithmsStringList.append(QString(algorithms.key(i)));
+    // Appending algorithms(and crc models) to list widget
+    for (auto &var : SAKToolFileCheckerHasher::algorithmNames()){
+        auto item = new QListWidgetItem(var, mAlgorithmListWidget);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(var == QString("Md5") ? Qt::Checked : Qt::Unchecked);
     }
-    mAlgorithmComboBox->addItems(algorithmsStringList);
-    mAlgorithmComboBox->setCurrentText("Md5");
+    connect(mAlgorithmListWidget, &QListWidget::itemChanged, this, [=](){
+        clearResults();
+        mCalculatorProgressBar->setValue(0);
+    });
 
     mFilePathlineEdit->setReadOnly(true);
-    mResultLineEdit->setReadOnly(true);
     mCalculatorProgressBar->setMinimum(0);
     mCalculatorProgressBar->setMaximum(100);
     mCalculatorProgressBar->setValue(0);
@@ -65,6 +64,7 @@ SAKToolFileChecker::SAKToolFileChecker(QWidget *parent)
 
 SAKToolFileChecker::~SAKToolFileChecker()
 {
+    stopBenchmark();
     delete mUi;
     if (mCalculator){
         mCalculator->blockSignals(true);
@@ -78,8 +78,9 @@ SAKToolFileChecker::~SAKToolFileChecker()
 
 void SAKToolFileChecker::setUiEnable(bool enable)
 {
-    mAlgorithmComboBox->setEnabled(enable);
+    mAlgorithmListWidget->setEnabled(enable);
     mOpenPushButton->setEnabled(enable);
+    mBenchmarkPushButton->setEnabled(enable);
 }
 
 QString SAKToolFileChecker::fileName()
@@ -87,19 +88,23 @@ QString SAKToolFileChecker::fileName()
     return mFileName;
 }
 
-QCryptographicHash::Algorithm SAKToolFileChecker::algorithm()
+QStringList SAKToolFileChecker::algorithms()
 {
-    return mAlgorithm;
+    QStringList names;
+    for (int i = 0; i < mAlgorithmListWidget->count(); i++){
+        auto item = mAlgorithmListWidget->item(i);
+        if (item->checkState() == Qt::Checked){
+            names.append(item->text());
+        }
+    }
+
+    return names;
 }
 
-void SAKToolFileChecker::updateResult(QByteArray result)
+void SAKToolFileChecker::updateResult(QString algorithm, QByteArray result)
 {
-    QString resultString = QString(result.toHex());
-    if (mUpperCheckBox->isChecked()){
-        mResultLineEdit->setText(resultString.toUpper());
-    }else{
-        mResultLineEdit->setText(resultString);
-    }
+    mResults.insert(algorithm, result);
+    showResults();
 }
 
 void SAKToolFileChecker::outputMessage(QString msg, bool isErrMsg)
@@ -138,6 +143,37 @@ void SAKToolFileChecker::clearMessage()
     mRemainTimeLabel->clear();
 }
 
+void SAKToolFileChecker::showResults()
+{
+    QStringList lines;
+    for (auto it = mResults.constBegin(); it != mResults.constEnd(); ++it){
+        QString resultString = QString(it.value().toHex());
+        if (mUpperCheckBox->isChecked()){
+            resultString = resultString.toUpper();
+        }
+        lines.append(QString("%1: %2").arg(it.key(), resultString));
+    }
+
+    mResultPlainTextEdit->setPlainText(lines.join('\n'));
+}
+
+void SAKToolFileChecker::clearResults()
+{
+    mResults.clear();
+    mResultPlainTextEdit->clear();
+}
+
+void SAKToolFileChecker::stopBenchmark()
+{
+    if (mBenchmark){
+        mBenchmark->blockSignals(true);
+        mBenchmark->requestInterruption();
+        mBenchmark->wait();
+        mBenchmark->deleteLater();
+        mBenchmark = Q_NULLPTR;
+    }
+}
+
 void SAKToolFileChecker::on_openPushButton_clicked()
 {
     mFileName = QFileDialog::getOpenFileName();
@@ -147,22 +183,10 @@ void SAKToolFileChecker::on_openPushButton_clicked()
     }
 
     mCalculatorProgressBar->setValue(0);
-    mResultLineEdit->clear();
+    clearResults();
     mMessageLabel->clear();
 }
 
-void SAKToolFileChecker::on_algorithmComboBox_currentIndexChanged(int index)
-{
-#if QT_VERSION < QT_VERSION_CHECK(5, 9, 0)
-    QMetaEnum algorithms = QMetaEnum::fromType<SAKToolFileChecker::Algorithm>();
-#else
-    QMetaEnum algorithms = QMetaEnum::fromType<QCryptographicHash::Algorithm>();
-#endif
-    mAlgorithm = static_cast<QCryptographicHash::Algorithm>(algorithms.value(index));
-    mResultLineEdit->clear();
-    mCalculatorProgressBar->setValue(0);
-}
-
 void SAKToolFileChecker::on_startStopPushButton_clicked()
 {
     if (mCalculator){
@@ -176,6 +200,7 @@ void SAKToolFileChecker::on_startStopPushButton_clicked()
         mStartStopPushButton->setText(tr("Calculate"));
         setUiEnable(true);
     }else{
+        clearResults();
         mCalculator = new QtCryptographicHashCalculator(this);
         connect(mCalculator, &QThread::finished, this, &SAKToolFileChecker::finished);
         mCalculator->start();
@@ -184,12 +209,42 @@ void SAKToolFileChecker::on_startStopPushButton_clicked()
     }
 }
 
-void SAKToolFileChecker::on_upperCheckBox_clicked()
+void SAKToolFileChecker::on_benchmarkPushButton_clicked()
 {
-    QString temp = mResultLineEdit->text();
-    if (mUpperCheckBox->isChecked()){
-        mResultLineEdit->setText(temp.toUpper());
+    if (mBenchmark){
+        stopBenchmark();
+        mBenchmarkPushButton->setText(tr("Benchmark"));
+        setUiEnable(true);
+        mBenchmarkPushButton->setEnabled(true);
+        mStartStopPushButton->setEnabled(true);
     }else{
-        mResultLineEdit->setText(temp.toLower());
+        clearResults();
+        mBenchmark = new SAKToolFileCheckerBenchmark(mFileName, this);
+        connect(mBenchmark, &SAKToolFileCheckerBenchmark::outputMessage,
+                this, &SAKToolFileChecker::outputMessage);
+        connect(mBenchmark, &SAKToolFileCheckerBenchmark::benchmarkResult,
+                this, [=](QString algorithm, double megabytesPerSecond){
+            mResultPlainTextEdit->appendPlainText(
+                        QString("%1: %2 MB/s").arg(algorithm)
+                        .arg(megabytesPerSecond, 0, 'f', 1));
+        });
+        connect(mBenchmark, &QThread::finished, this, [=](){
+            if (mBenchmark){
+                on_benchmarkPushButton_clicked();
+            }
+        });
+        mBenchmark->start();
+        setUiEnable(false);
+        mBenchmarkPushButton->setEnabled(true);
+        mStartStopPushButton->setEnabled(false);
+        mBenchmarkPushButton->setText(tr("StopBenchmark"));
+    }
+}
+
+void SAKToolFileChecker::on_upperCheckBox_clicked()
+{
+    // The benchmark results are not digests.
+    if (!mResults.isEmpty()){
+        showResults();
     }
 }
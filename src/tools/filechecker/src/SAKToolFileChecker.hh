@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2018-2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2018-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -10,20 +10,23 @@
 #ifndef SAKTOOLFILECHECKER_HH
 #define SAKTOOLFILECHECKER_HH
 
+#include <QMap>
 #include <QTimer>
 #include <QLabel>
 #include <QWidget>
 #include <QLineEdit>
-#include <QComboBox>
 #include <QCheckBox>
+#include <QListWidget>
 #include <QPushButton>
 #include <QProgressBar>
+#include <QPlainTextEdit>
 #include <QCryptographicHash>
 
 namespace Ui {
     class SAKToolFileChecker;
 }
 
+class SAKToolFileCheckerBenchmark;
 class QtCryptographicHashCalculator;
 class SAKToolFileChecker : public QWidget
 {
@@ -34,8 +37,9 @@ public:
 
     void setUiEnable(bool enable);
     QString fileName();
-    QCryptographicHash::Algorithm algorithm();
-    void updateResult(QByteArray result);
+    // The algorithms checked(the names of SAKToolFileCheckerHasher).
+    QStringList algorithms();
+    void updateResult(QString algorithm, QByteArray result);
     void outputMessage(QString msg, bool isErrMsg = false);
     void updateProgressBar(int currentValue);
     void changeRemainTime(QString remainTime);
@@ -63,26 +67,31 @@ public:
 private:
     void finished();
     void clearMessage();
+    void showResults();
+    void clearResults();
+    void stopBenchmark();
 private:
     QString mFileName;
-    QCryptographicHash::Algorithm mAlgorithm;
+    QMap<QString, QByteArray> mResults;
     QtCryptographicHashCalculator *mCalculator;
+    SAKToolFileCheckerBenchmark *mBenchmark;
     QTimer mClearMessageTimer;
 private:
     Ui::SAKToolFileChecker *mUi;
     QLineEdit *mFilePathlineEdit;
-    QComboBox *mAlgorithmComboBox;
-    QLineEdit *mResultLineEdit;
+    QListWidget *mAlgorithmListWidget;
+    QPlainTextEdit *mResultPlainTextEdit;
     QProgressBar *mCalculatorProgressBar;
     QPushButton *mOpenPushButton;
     QPushButton *mStartStopPushButton;
+    QPushButton *mBenchmarkPushButton;
     QCheckBox *mUpperCheckBox;
     QLabel *mMessageLabel;
     QLabel *mRemainTimeLabel;
 private slots:
     void on_openPushButton_clicked();
-    void on_algorithmComboBox_currentIndexChanged(int index);
     void on_startStopPushButton_clicked();
+    void on_benchmarkPushButton_clicked();
     void on_upperCheckBox_clicked();
 };
 
@@ -0,0 +1,265 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QDir>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QApplication>
+
+#include "SAKToolFileCheckerBatch.hh"
+#include "SAKToolFileCheckerHasher.hh"
+#include "SAKToolFileCheckerBatchCalculator.hh"
+#include "ui_SAKToolFileCheckerBatch.h"
+
+SAKToolFileCheckerBatch::SAKToolFileCheckerBatch(QWidget *parent)
+    :QWidget(parent)
+    ,mCalculator(Q_NULLPTR)
+    ,mUi(new Ui::SAKToolFileCheckerBatch)
+{
+    mUi->setupUi(this);
+    mDirectoryLineEdit = mUi->directoryLineEdit;
+    mManifestLineEdit = mUi->manifestLineEdit;
+    mAlgorithmComboBox = mUi->algorithmComboBox;
+    mWorkerSpinBox = mUi->workerSpinBox;
+    mCacheCheckBox = mUi->cacheCheckBox;
+    mFileTableWidget = mUi->fileTableWidget;
+    mWorkerTableWidget = mUi->workerTableWidget;
+    mProgressBar = mUi->progressBar;
+    mSpeedLabel = mUi->speedLabel;
+    mMessageLabel = mUi->messageLabel;
+    mGeneratePushButton = mUi->generatePushButton;
+    mVerifyPushButton = mUi->verifyPushButton;
+
+    mAlgorithmComboBox->addItems(SAKToolFileCheckerHasher::algorithmNames());
+    mAlgorithmComboBox->setCurrentText("Sha256");
+    mWorkerSpinBox->setRange(1, 256);
+    mWorkerSpinBox->setValue(qMax(1, QThread::idealThreadCount()));
+    mCacheCheckBox->setChecked(true);
+    mCacheCheckBox->setToolTip(SAKToolFileCheckerBatchCalculator::cacheFileName());
+
+    mFileTableWidget->setColumnCount(3);
+    mFileTableWidget->setHorizontalHeaderLabels(
+                QStringList() << tr("File") << tr("Digest") << tr("State"));
+    mFileTableWidget->horizontalHeader()->setStretchLastSection(true);
+    mFileTableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mWorkerTableWidget->setColumnCount(3);
+    mWorkerTableWidget->setHorizontalHeaderLabels(
+                QStringList() << tr("Worker") << tr("Files") << tr("MB/s"));
+    mWorkerTableWidget->horizontalHeader()->setStretchLastSection(true);
+    mWorkerTableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mWorkerTableWidget->verticalHeader()->hide();
+
+    mProgressBar->setRange(0, 100);
+    mProgressBar->setValue(0);
+
+    mClearMessageTimer.setInterval(SAK_CLEAR_MESSAGE_INTERVAL);
+    connect(&mClearMessageTimer, &QTimer::timeout, this, [=](){
+        mClearMessageTimer.stop();
+        mMessageLabel->clear();
+    });
+
+    setWindowTitle(tr("Checksum Assistant"));
+}
+
+SAKToolFileCheckerBatch::~SAKToolFileCheckerBatch()
+{
+    stop();
+    delete mUi;
+}
+
+void SAKToolFileCheckerBatch::start(int mode)
+{
+    SAKToolFileCheckerBatchCalculator::SAKStructParameters parameters;
+    parameters.mode = mode;
+    parameters.directory = mDirectoryLineEdit->text().trimmed();
+    parameters.manifest = mManifestLineEdit->text().trimmed();
+    parameters.algorithm = mAlgorithmComboBox->currentText();
+    parameters.cacheEnable = mCacheCheckBox->isChecked();
+    parameters.workerCount = mWorkerSpinBox->value();
+    if (parameters.manifest.isEmpty()) {
+        outputMessage(tr("The manifest is not specified"), true);
+        return;
+    }
+
+    if (mode == SAKToolFileCheckerBatchCalculator::ModeGenerate
+            && (!QFileInfo(parameters.directory).isDir())) {
+        outputMessage(tr("The directory is not existed"), true);
+        return;
+    }
+
+    mFileTableWidget->setRowCount(0);
+    mWorkerTableWidget->setRowCount(0);
+    mProgressBar->setValue(0);
+    mSpeedLabel->clear();
+
+    mCalculator = new SAKToolFileCheckerBatchCalculator(parameters, this);
+    connect(mCalculator, &SAKToolFileCheckerBatchCalculator::outputMessage,
+            this, &SAKToolFileCheckerBatch::outputMessage);
+    connect(mCalculator, &SAKToolFileCheckerBatchCalculator::fileChecked,
+            this, &SAKToolFileCheckerBatch::onFileChecked);
+    connect(mCalculator, &SAKToolFileCheckerBatchCalculator::progressChanged,
+            this, &SAKToolFileCheckerBatch::onProgressChanged);
+    connect(mCalculator, &SAKToolFileCheckerBatchCalculator::workerSpeedChanged,
+            this, &SAKToolFileCheckerBatch::onWorkerSpeedChanged);
+    connect(mCalculator, &SAKToolFileCheckerBatchCalculator::speedChanged,
+            this, &SAKToolFileCheckerBatch::onSpeedChanged);
+    connect(mCalculator, &QThread::finished, this, [=](){
+        stop();
+    });
+    mCalculator->start();
+
+    if (mode == SAKToolFileCheckerBatchCalculator::ModeGenerate) {
+        mGeneratePushButton->setText(tr("Stop"));
+        mVerifyPushButton->setEnabled(false);
+    } else {
+        mVerifyPushButton->setText(tr("Stop"));
+        mGeneratePushButton->setEnabled(false);
+    }
+    setUiEnable(false);
+}
+
+void SAKToolFileCheckerBatch::stop()
+{
+    if (mCalculator) {
+        mCalculator->requestInterruption();
+        mCalculator->wait();
+        mCalculator->deleteLater();
+        mCalculator = Q_NULLPTR;
+    }
+
+    mGeneratePushButton->setText(tr("Generate"));
+    mVerifyPushButton->setText(tr("Verify"));
+    mGeneratePushButton->setEnabled(true);
+    mVerifyPushButton->setEnabled(true);
+    setUiEnable(true);
+}
+
+void SAKToolFileCheckerBatch::setUiEnable(bool enable)
+{
+    mDirectoryLineEdit->setEnabled(enable);
+    mManifestLineEdit->setEnabled(enable);
+    mAlgorithmComboBox->setEnabled(enable);
+    mWorkerSpinBox->setEnabled(enable);
+    mCacheCheckBox->setEnabled(enable);
+    mUi->directoryPushButton->setEnabled(enable);
+    mUi->manifestPushButton->setEnabled(enable);
+}
+
+void SAKToolFileCheckerBatch::outputMessage(QString msg, bool isErrMsg)
+{
+    if (isErrMsg){
+        QApplication::beep();
+        msg = QString("<font color=red>%1</font>").arg(msg);
+    }else{
+        msg = QString("<font color=blue>%1</font>").arg(msg);
+    }
+
+    mMessageLabel->setText(msg);
+    mClearMessageTimer.start();
+}
+
+void SAKToolFileCheckerBatch::onFileChecked(QString fileName,
+                                            QByteArray digest,
+                                            int state,
+                                            bool cached)
+{
+    QString stateString;
+    if (state == SAKToolFileCheckerBatchCalculator::StateOk) {
+        stateString = cached ? tr("OK(cached)") : tr("OK");
+    } else if (state == SAKToolFileCheckerBatchCalculator::StateFailed) {
+        stateString = tr("FAILED");
+    } else {
+        stateString = tr("FAILED open or read");
+    }
+
+    int row = mFileTableWidget->rowCount();
+    mFileTableWidget->insertRow(row);
+    mFileTableWidget->setItem(row, 0, new QTableWidgetItem(fileName));
+    mFileTableWidget->setItem(row, 1, new QTableWidgetItem(QString(digest.toHex())));
+    auto item = new QTableWidgetItem(stateString);
+    if (state != SAKToolFileCheckerBatchCalculator::StateOk) {
+        item->setForeground(Qt::red);
+    }
+    mFileTableWidget->setItem(row, 2, item);
+}
+
+void SAKToolFileCheckerBatch::onProgressChanged(qint64 checkedBytes, qint64 allBytes)
+{
+    mProgressBar->setValue(allBytes ? int(checkedBytes*100/allBytes) : 100);
+}
+
+void SAKToolFileCheckerBatch::onWorkerSpeedChanged(int worker,
+                                                   int files,
+                                                   double megabytesPerSecond)
+{
+    if (mWorkerTableWidget->rowCount() <= worker) {
+        mWorkerTableWidget->setRowCount(worker + 1);
+    }
+
+    auto setText = [=](int column, const QString &text){
+        auto item = mWorkerTableWidget->item(worker, column);
+        if (!item) {
+            item = new QTableWidgetItem;
+            mWorkerTableWidget->setItem(worker, column, item);
+        }
+        item->setText(text);
+    };
+
+    setText(0, QString::number(worker + 1));
+    setText(1, QString::number(files));
+    setText(2, QString::number(megabytesPerSecond, 'f', 1));
+}
+
+void SAKToolFileCheckerBatch::onSpeedChanged(double megabytesPerSecond)
+{
+    mSpeedLabel->setText(tr("Total %1 MB/s").arg(megabytesPerSecond, 0, 'f', 1));
+}
+
+void SAKToolFileCheckerBatch::on_directoryPushButton_clicked()
+{
+    QString dir = QFileDialog::getExistingDirectory(this, tr("Directory"),
+                                                    mDirectoryLineEdit->text());
+    if (!dir.isEmpty()) {
+        mDirectoryLineEdit->setText(dir);
+        if (mManifestLineEdit->text().isEmpty()) {
+            QString name = mAlgorithmComboBox->currentText().toUpper() + "SUMS";
+            mManifestLineEdit->setText(QDir(dir).absoluteFilePath(name));
+        }
+    }
+}
+
+void SAKToolFileCheckerBatch::on_manifestPushButton_clicked()
+{
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Manifest"),
+                                                    mManifestLineEdit->text(),
+                                                    QString(), Q_NULLPTR,
+                                                    QFileDialog::DontConfirmOverwrite);
+    if (!fileName.isEmpty()) {
+        mManifestLineEdit->setText(fileName);
+    }
+}
+
+void SAKToolFileCheckerBatch::on_generatePushButton_clicked()
+{
+    if (mCalculator) {
+        stop();
+    } else {
+        start(SAKToolFileCheckerBatchCalculator::ModeGenerate);
+    }
+}
+
+void SAKToolFileCheckerBatch::on_verifyPushButton_clicked()
+{
+    if (mCalculator) {
+        stop();
+    } else {
+        start(SAKToolFileCheckerBatchCalculator::ModeVerify);
+    }
+}
@@ -0,0 +1,71 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLFILECHECKERBATCH_HH
+#define SAKTOOLFILECHECKERBATCH_HH
+
+#include <QLabel>
+#include <QTimer>
+#include <QWidget>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QProgressBar>
+
+namespace Ui {
+    class SAKToolFileCheckerBatch;
+}
+
+class SAKToolFileCheckerBatchCalculator;
+/// @brief Checksum of a directory tree, the manifest generated can be verified
+/// by sha256sum -c(or md5sum -c...), and the manifests of such tools can be
+/// verified too.
+class SAKToolFileCheckerBatch : public QWidget
+{
+    Q_OBJECT
+public:
+    Q_INVOKABLE SAKToolFileCheckerBatch(QWidget *parent = Q_NULLPTR);
+    ~SAKToolFileCheckerBatch();
+private:
+    SAKToolFileCheckerBatchCalculator *mCalculator;
+    QTimer mClearMessageTimer;
+private:
+    void start(int mode);
+    void stop();
+    void setUiEnable(bool enable);
+    void outputMessage(QString msg, bool isErrMsg);
+    void onFileChecked(QString fileName, QByteArray digest, int state, bool cached);
+    void onProgressChanged(qint64 checkedBytes, qint64 allBytes);
+    void onWorkerSpeedChanged(int worker, int files, double megabytesPerSecond);
+    void onSpeedChanged(double megabytesPerSecond);
+private:
+    Ui::SAKToolFileCheckerBatch *mUi;
+    QLineEdit *mDirectoryLineEdit;
+    QLineEdit *mManifestLineEdit;
+    QComboBox *mAlgorithmComboBox;
+    QSpinBox *mWorkerSpinBox;
+    QCheckBox *mCacheCheckBox;
+    QTableWidget *mFileTableWidget;
+    QTableWidget *mWorkerTableWidget;
+    QProgressBar *mProgressBar;
+    QLabel *mSpeedLabel;
+    QLabel *mMessageLabel;
+    QPushButton *mGeneratePushButton;
+    QPushButton *mVerifyPushButton;
+private slots:
+    void on_directoryPushButton_clicked();
+    void on_manifestPushButton_clicked();
+    void on_generatePushButton_clicked();
+    void on_verifyPushButton_clicked();
+};
+
+#endif // SAKTOOLFILECHECKERBATCH_HH
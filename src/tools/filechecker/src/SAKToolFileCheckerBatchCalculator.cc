@@ -0,0 +1,385 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <algorithm>
+#include <QDir>
+#include <QFile>
+#include <QDebug>
+#include <QVector>
+#include <QAtomicInt>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QJsonObject>
+#include <QThreadPool>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QScopedPointer>
+#include <QStandardPaths>
+
+#include "SAKToolFileCheckerReader.hh"
+#include "SAKToolFileCheckerHasher.hh"
+#include "SAKToolFileCheckerManifest.hh"
+#include "SAKToolFileCheckerBatchCalculator.hh"
+
+namespace {
+struct SAKStructBatchJob {
+    QString fileName;
+    QString absoluteFileName;
+    qint64 size;
+    qint64 modified;
+    QByteArray expectedDigest;
+    QByteArray digest;
+    int state;
+    bool cached;
+};
+
+struct SAKStructBatchContext {
+    SAKStructBatchJob *jobs;
+    int jobCount;
+    QAtomicInt nextJob;
+    QAtomicInteger<qint64> checkedBytes;
+    QString algorithm;
+    const QHash<QString, SAKToolFileCheckerBatchCalculator::SAKStructCacheEntry> *cache;
+};
+
+struct SAKStructBatchWorkerStatistics {
+    QAtomicInteger<qint64> bytes;
+    QAtomicInt files;
+};
+
+// A worker takes the next job from the shared index until all jobs are taken.
+class SAKToolFileCheckerBatchWorker : public QRunnable
+{
+public:
+    SAKToolFileCheckerBatchWorker(SAKToolFileCheckerBatchCalculator *calculator,
+                                  SAKStructBatchContext *context,
+                                  SAKStructBatchWorkerStatistics *statistics)
+        :mCalculator(calculator)
+        ,mContext(context)
+        ,mStatistics(statistics)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() final
+    {
+        SAKToolFileCheckerReader reader;
+        while (!mCalculator->isInterruptionRequested()) {
+            int index = mContext->nextJob.fetchAndAddOrdered(1);
+            if (index >= mContext->jobCount) {
+                break;
+            }
+
+            SAKStructBatchJob &job = mContext->jobs[index];
+            check(&reader, &job);
+            mStatistics->files.fetchAndAddOrdered(1);
+
+            int state = job.state;
+            if (!job.expectedDigest.isNull()) {
+                if (state == SAKToolFileCheckerBatchCalculator::StateOk
+                        && job.digest != job.expectedDigest) {
+                    state = SAKToolFileCheckerBatchCalculator::StateFailed;
+                }
+            }
+            job.state = state;
+            emit mCalculator->fileChecked(job.fileName, job.digest, state, job.cached);
+        }
+    }
+private:
+    void check(SAKToolFileCheckerReader *reader, SAKStructBatchJob *job)
+    {
+        job->cached = false;
+        job->state = SAKToolFileCheckerBatchCalculator::StateOk;
+        QFileInfo info(job->absoluteFileName);
+        if (!info.exists()) {
+            job->state = SAKToolFileCheckerBatchCalculator::StateMissing;
+            return;
+        }
+
+        job->size = info.size();
+        job->modified = info.lastModified().toMSecsSinceEpoch();
+        if (mContext->cache) {
+            auto it = mContext->cache->constFind(job->absoluteFileName);
+            if ((it != mContext->cache->constEnd())
+                    && (it->size == job->size)
+                    && (it->modified == job->modified)) {
+                job->digest = it->digest;
+                job->cached = true;
+                mContext->checkedBytes.fetchAndAddOrdered(job->size);
+                return;
+            }
+        }
+
+        if (!reader->open(job->absoluteFileName)) {
+            job->state = SAKToolFileCheckerBatchCalculator::StateMissing;
+            return;
+        }
+
+        QScopedPointer<SAKToolFileCheckerHasher>
+                hasher(SAKToolFileCheckerHasher::create(mContext->algorithm));
+        qint64 length = 0;
+        const uchar *data = Q_NULLPTR;
+        while ((data = reader->read(&length))) {
+            hasher->addData(data, length);
+            mStatistics->bytes.fetchAndAddOrdered(length);
+            mContext->checkedBytes.fetchAndAddOrdered(length);
+            if (mCalculator->isInterruptionRequested()) {
+                break;
+            }
+        }
+
+        if (reader->hasError()) {
+            job->state = SAKToolFileCheckerBatchCalculator::StateMissing;
+        } else {
+            job->digest = hasher->result();
+        }
+        reader->close();
+    }
+private:
+    SAKToolFileCheckerBatchCalculator *mCalculator;
+    SAKStructBatchContext *mContext;
+    SAKStructBatchWorkerStatistics *mStatistics;
+};
+}
+
+SAKToolFileCheckerBatchCalculator::SAKToolFileCheckerBatchCalculator(
+        const SAKStructParameters &parameters, QObject *parent)
+    :QThread(parent)
+    ,mParameters(parameters)
+{
+
+}
+
+QString SAKToolFileCheckerBatchCalculator::cacheFileName()
+{
+    QString path = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    return QString("%1/FileCheckerCache.json").arg(path);
+}
+
+void SAKToolFileCheckerBatchCalculator::run()
+{
+    QScopedPointer<SAKToolFileCheckerHasher>
+            hasher(SAKToolFileCheckerHasher::create(mParameters.algorithm));
+    if (!hasher) {
+        emit outputMessage(tr("Unknown algorithm: %1").arg(mParameters.algorithm), true);
+        return;
+    }
+
+    // Collecting jobs
+    QVector<SAKStructBatchJob> jobs;
+    QString errorString;
+    QDir baseDir;
+    if (mParameters.mode == ModeVerify) {
+        QList<SAKToolFileCheckerManifest::SAKStructEntry> entries;
+        if (!SAKToolFileCheckerManifest::read(mParameters.manifest, &entries, &errorString)) {
+            emit outputMessage(errorString, true);
+            return;
+        }
+
+        // The paths of manifest are relative to the directory of the manifest.
+        baseDir = QFileInfo(mParameters.manifest).absoluteDir();
+        for (auto &var : entries) {
+            SAKStructBatchJob job;
+            job.fileName = var.fileName;
+            job.absoluteFileName = QDir::cleanPath(baseDir.absoluteFilePath(var.fileName));
+            job.size = QFileInfo(job.absoluteFileName).size();
+            job.modified = 0;
+            job.expectedDigest = var.digest;
+            jobs.append(job);
+        }
+    } else {
+        baseDir = QDir(mParameters.directory);
+        QString manifest = QFileInfo(mParameters.manifest).absoluteFilePath();
+        QDirIterator it(baseDir.absolutePath(),
+                        QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot,
+                        QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            QFileInfo info = it.fileInfo();
+            if (info.absoluteFilePath() == manifest) {
+                continue;
+            }
+
+            SAKStructBatchJob job;
+            job.fileName = baseDir.relativeFilePath(info.absoluteFilePath());
+            job.absoluteFileName = info.absoluteFilePath();
+            job.size = info.size();
+            job.modified = 0;
+            jobs.append(job);
+
+            if (isInterruptionRequested()) {
+                return;
+            }
+        }
+
+        if (jobs.isEmpty()) {
+            emit outputMessage(tr("There is no file in the directory"), true);
+            return;
+        }
+    }
+
+    // The largest files are taken first, the small ones fill the gaps at the end.
+    std::stable_sort(jobs.begin(), jobs.end(),
+                     [](const SAKStructBatchJob &a, const SAKStructBatchJob &b){
+        return a.size > b.size;
+    });
+
+    qint64 allBytes = 0;
+    for (auto &var : jobs) {
+        allBytes += var.size;
+    }
+
+    QHash<QString, SAKStructCacheEntry> cache;
+    if (mParameters.cacheEnable) {
+        cache = readCache();
+    }
+
+    SAKStructBatchContext context;
+    context.jobs = jobs.data();
+    context.jobCount = jobs.count();
+    context.algorithm = mParameters.algorithm;
+    context.cache = mParameters.cacheEnable ? &cache : Q_NULLPTR;
+
+    int workerCount = qMax(1, mParameters.workerCount);
+    QVector<SAKStructBatchWorkerStatistics> statistics(workerCount);
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(workerCount);
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+    for (int i = 0; i < workerCount; i++) {
+        threadPool.start(new SAKToolFileCheckerBatchWorker(this, &context, &statistics[i]));
+    }
+
+    // The statistics are reported by this thread, the workers only count.
+    auto report = [&](){
+        double seconds = qMax<qint64>(1, elapsedTimer.elapsed())/1000.0;
+        qint64 hashedBytes = 0;
+        for (int i = 0; i < workerCount; i++) {
+            qint64 bytes = statistics[i].bytes.loadAcquire();
+            hashedBytes += bytes;
+            emit workerSpeedChanged(i, statistics[i].files.loadAcquire(),
+                                    bytes/seconds/(1024*1024));
+        }
+        emit speedChanged(hashedBytes/seconds/(1024*1024));
+        emit progressChanged(context.checkedBytes.loadAcquire(), allBytes);
+    };
+
+    while (!threadPool.waitForDone(500)) {
+        report();
+    }
+    report();
+
+    if (isInterruptionRequested()) {
+        return;
+    }
+
+    // Summarizing
+    int failedCount = 0;
+    int missingCount = 0;
+    int cachedCount = 0;
+    QList<SAKToolFileCheckerManifest::SAKStructEntry> entries;
+    for (auto &var : jobs) {
+        if (var.state == StateFailed) {
+            failedCount += 1;
+        } else if (var.state == StateMissing) {
+            missingCount += 1;
+        } else {
+            if (var.cached) {
+                cachedCount += 1;
+            }
+
+            // A file which is failed in verifying is not cached, its contents may be wrong.
+            SAKStructCacheEntry entry{var.size, var.modified, var.digest};
+            cache.insert(var.absoluteFileName, entry);
+            entries.append(SAKToolFileCheckerManifest::SAKStructEntry{var.fileName, var.digest});
+        }
+    }
+
+    if (mParameters.cacheEnable) {
+        writeCache(cache);
+    }
+
+    if (mParameters.mode == ModeGenerate) {
+        std::sort(entries.begin(), entries.end(),
+                  [](const SAKToolFileCheckerManifest::SAKStructEntry &a,
+                  const SAKToolFileCheckerManifest::SAKStructEntry &b){
+            return a.fileName < b.fileName;
+        });
+        if (!SAKToolFileCheckerManifest::write(mParameters.manifest, entries, &errorString)) {
+            emit outputMessage(errorString, true);
+            return;
+        }
+    }
+
+    QString msg = tr("%1 files(%2 from cache), %3 failed, %4 unreadable")
+            .arg(jobs.count()).arg(cachedCount).arg(failedCount).arg(missingCount);
+    emit outputMessage(msg, failedCount || missingCount);
+}
+
+QHash<QString, SAKToolFileCheckerBatchCalculator::SAKStructCacheEntry>
+SAKToolFileCheckerBatchCalculator::readCache()
+{
+    QHash<QString, SAKStructCacheEntry> cache;
+    QFile file(cacheFileName());
+    if (!file.open(QFile::ReadOnly)) {
+        return cache;
+    }
+
+    // {"Sha256": {"<file>": {"size": 0, "modified": 0, "digest": "hex"}}}
+    QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    QJsonObject files = root.value(mParameters.algorithm).toObject();
+    for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+        QJsonObject obj = it.value().toObject();
+        SAKStructCacheEntry entry;
+        entry.size = qint64(obj.value("size").toDouble());
+        entry.modified = qint64(obj.value("modified").toDouble());
+        entry.digest = QByteArray::fromHex(obj.value("digest").toString().toLatin1());
+        cache.insert(it.key(), entry);
+    }
+
+    return cache;
+}
+
+void SAKToolFileCheckerBatchCalculator::writeCache(
+        const QHash<QString, SAKStructCacheEntry> &cache)
+{
+    QString fileName = cacheFileName();
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+
+    QJsonObject root;
+    QFile file(fileName);
+    if (file.open(QFile::ReadOnly)) {
+        root = QJsonDocument::fromJson(file.readAll()).object();
+        file.close();
+    }
+
+    QJsonObject files;
+    for (auto it = cache.constBegin(); it != cache.constEnd(); ++it) {
+        QJsonObject obj;
+        obj.insert("size", double(it->size));
+        obj.insert("modified", double(it->modified));
+        obj.insert("digest", QString(it->digest.toHex()));
+        files.insert(it.key(), obj);
+    }
+    root.insert(mParameters.algorithm, files);
+
+    QSaveFile saveFile(fileName);
+    if (saveFile.open(QFile::WriteOnly)) {
+        saveFile.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        if (!saveFile.commit()) {
+            qWarning() << "Can not write the cache file:" << saveFile.errorString();
+        }
+    } else {
+        qWarning() << "Can not open the cache file:" << saveFile.errorString();
+    }
+}
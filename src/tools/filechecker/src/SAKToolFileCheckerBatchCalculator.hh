@@ -0,0 +1,73 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLFILECHECKERBATCHCALCULATOR_HH
+#define SAKTOOLFILECHECKERBATCHCALCULATOR_HH
+
+#include <QHash>
+#include <QThread>
+#include <QString>
+#include <QByteArray>
+
+/// @brief Calculate the digests of all files of a directory tree(or the files
+/// listed by a manifest). The files are taken by the workers one by one from a
+/// shared queue, so a worker which finishes early takes more files. The digests
+/// of the files whose size and modified time are not changed can be taken from
+/// the cache.
+class SAKToolFileCheckerBatchCalculator : public QThread
+{
+    Q_OBJECT
+public:
+    enum SAKEnumMode {
+        ModeGenerate,
+        ModeVerify
+    };
+
+    enum SAKEnumState {
+        StateOk,
+        StateFailed,
+        StateMissing
+    };
+
+    struct SAKStructParameters {
+        int mode;
+        // The directory to be hashed(ModeGenerate)
+        QString directory;
+        // The manifest to be written(ModeGenerate) or verified(ModeVerify)
+        QString manifest;
+        // A name of SAKToolFileCheckerHasher::algorithmNames()
+        QString algorithm;
+        bool cacheEnable;
+        int workerCount;
+    };
+
+    struct SAKStructCacheEntry {
+        qint64 size;
+        qint64 modified;
+        QByteArray digest;
+    };
+
+    SAKToolFileCheckerBatchCalculator(const SAKStructParameters &parameters,
+                                      QObject *parent = Q_NULLPTR);
+    static QString cacheFileName();
+private:
+    SAKStructParameters mParameters;
+private:
+    void run() final;
+    QHash<QString, SAKStructCacheEntry> readCache();
+    void writeCache(const QHash<QString, SAKStructCacheEntry> &cache);
+signals:
+    void outputMessage(QString msg, bool isErrMsg);
+    void fileChecked(QString fileName, QByteArray digest, int state, bool cached);
+    void progressChanged(qint64 checkedBytes, qint64 allBytes);
+    void workerSpeedChanged(int worker, int files, double megabytesPerSecond);
+    void speedChanged(double megabytesPerSecond);
+};
+
+#endif // SAKTOOLFILECHECKERBATCHCALCULATOR_HH
@@ -0,0 +1,76 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QScopedPointer>
+
+#include "SAKToolFileCheckerReader.hh"
+#include "SAKToolFileCheckerHasher.hh"
+#include "SAKToolFileCheckerBenchmark.hh"
+
+SAKToolFileCheckerBenchmark::SAKToolFileCheckerBenchmark(const QString &fileName,
+                                                         QObject *parent)
+    :QThread(parent)
+    ,mFileName(fileName)
+{
+
+}
+
+void SAKToolFileCheckerBenchmark::run()
+{
+    SAKToolFileCheckerReader reader;
+    if (!reader.open(mFileName)) {
+        emit outputMessage(reader.errorString(), true);
+        return;
+    }
+
+    const qint64 maxSampleLength = 256*1024*1024;
+    QByteArray sample;
+    sample.reserve(int(qMin(reader.size(), maxSampleLength)));
+    qint64 length = 0;
+    const uchar *data = Q_NULLPTR;
+    while ((sample.length() < maxSampleLength) && (data = reader.read(&length))) {
+        length = qMin(length, maxSampleLength - sample.length());
+        sample.append(reinterpret_cast<const char*>(data), int(length));
+    }
+
+    if (reader.hasError()) {
+        emit outputMessage(reader.errorString(), true);
+        return;
+    } else if (sample.isEmpty()) {
+        emit outputMessage(tr("The file is empty"), true);
+        return;
+    }
+
+    const uchar *sampleData = reinterpret_cast<const uchar*>(sample.constData());
+    for (auto &var : SAKToolFileCheckerHasher::algorithmNames()) {
+        // The sample is hashed several times if it is small, the timing of
+        // a few microseconds is meaningless.
+        qint64 bytes = 0;
+        QElapsedTimer elapsedTimer;
+        elapsedTimer.start();
+        do {
+            QScopedPointer<SAKToolFileCheckerHasher> hasher(SAKToolFileCheckerHasher::create(var));
+            hasher->addData(sampleData, sample.length());
+            hasher->result();
+            bytes += sample.length();
+        } while (elapsedTimer.elapsed() < 200 && !isInterruptionRequested());
+
+        if (isInterruptionRequested()) {
+            return;
+        }
+
+        double seconds = qMax<qint64>(1, elapsedTimer.nsecsElapsed())/1e9;
+        emit benchmarkResult(var, bytes/seconds/(1024*1024));
+    }
+
+    emit outputMessage(tr("Benchmark finished(%1 MB of the file)")
+                       .arg(sample.length()/(1024.0*1024), 0, 'f', 1), false);
+}
@@ -0,0 +1,32 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLFILECHECKERBENCHMARK_HH
+#define SAKTOOLFILECHECKERBENCHMARK_HH
+
+#include <QThread>
+#include <QString>
+
+/// @brief Measure the throughput of all algorithms. The head of the file(256 MB
+/// at most) is read to memory once, so the speed of the disk is excluded.
+class SAKToolFileCheckerBenchmark : public QThread
+{
+    Q_OBJECT
+public:
+    SAKToolFileCheckerBenchmark(const QString &fileName, QObject *parent = Q_NULLPTR);
+private:
+    QString mFileName;
+private:
+    void run() final;
+signals:
+    void outputMessage(QString msg, bool isErrMsg);
+    void benchmarkResult(QString algorithm, double megabytesPerSecond);
+};
+
+#endif // SAKTOOLFILECHECKERBENCHMARK_HH
@@ -0,0 +1,350 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <cstring>
+#include <QVector>
+#include <QtEndian>
+#include <QRunnable>
+#include <QAtomicInt>
+#include <QSemaphore>
+#include <QThreadPool>
+
+#include "SAKToolFileCheckerBlake3Hasher.hh"
+
+namespace {
+const quint32 kIv[8] = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+const int kPermutation[16] = {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8};
+
+enum SAKEnumBlake3Flag {
+    FlagChunkStart = 1,
+    FlagChunkEnd = 2,
+    FlagParent = 4,
+    FlagRoot = 8
+};
+
+// 512 chunks(512 KB) are hashed by a task at most.
+const int kMaxSubtreeLevel = 9;
+
+inline quint32 rotr32(quint32 v, int r)
+{
+    return (v >> r) | (v << (32 - r));
+}
+
+inline void g(quint32 *s, int a, int b, int c, int d, quint32 x, quint32 y)
+{
+    s[a] = s[a] + s[b] + x;
+    s[d] = rotr32(s[d] ^ s[a], 16);
+    s[c] = s[c] + s[d];
+    s[b] = rotr32(s[b] ^ s[c], 12);
+    s[a] = s[a] + s[b] + y;
+    s[d] = rotr32(s[d] ^ s[a], 8);
+    s[c] = s[c] + s[d];
+    s[b] = rotr32(s[b] ^ s[c], 7);
+}
+
+void compress(const quint32 *cv, const quint32 *block, quint64 counter,
+              quint32 blockLength, quint32 flags, quint32 *out)
+{
+    quint32 s[16] = {
+        cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+        kIv[0], kIv[1], kIv[2], kIv[3],
+        quint32(counter), quint32(counter >> 32), blockLength, flags
+    };
+    quint32 m[16];
+    memcpy(m, block, sizeof(m));
+
+    for (int round = 0; round < 7; round++) {
+        g(s, 0, 4, 8, 12, m[0], m[1]);
+        g(s, 1, 5, 9, 13, m[2], m[3]);
+        g(s, 2, 6, 10, 14, m[4], m[5]);
+        g(s, 3, 7, 11, 15, m[6], m[7]);
+        g(s, 0, 5, 10, 15, m[8], m[9]);
+        g(s, 1, 6, 11, 12, m[10], m[11]);
+        g(s, 2, 7, 8, 13, m[12], m[13]);
+        g(s, 3, 4, 9, 14, m[14], m[15]);
+
+        quint32 permuted[16];
+        for (int i = 0; i < 16; i++) {
+            permuted[i] = m[kPermutation[i]];
+        }
+        memcpy(m, permuted, sizeof(m));
+    }
+
+    for (int i = 0; i < 8; i++) {
+        out[i] = s[i] ^ s[i + 8];
+        out[i + 8] = s[i + 8] ^ cv[i];
+    }
+}
+
+inline void blockWords(const uchar *block, quint32 *words)
+{
+    for (int i = 0; i < 16; i++) {
+        words[i] = qFromLittleEndian<quint32>(block + 4*i);
+    }
+}
+
+void parentCv(const quint32 *left, const quint32 *right, quint32 *cv)
+{
+    quint32 block[16];
+    quint32 out[16];
+    memcpy(block, left, 8*sizeof(quint32));
+    memcpy(block + 8, right, 8*sizeof(quint32));
+    compress(kIv, block, 0, 64, FlagParent, out);
+    memcpy(cv, out, 8*sizeof(quint32));
+}
+
+void chunkCv(const uchar *chunk, quint64 counter, quint32 *cv)
+{
+    quint32 words[16];
+    quint32 out[16];
+    memcpy(cv, kIv, sizeof(kIv));
+    for (int i = 0; i < 16; i++) {
+        quint32 flags = (i == 0 ? FlagChunkStart : 0) | (i == 15 ? FlagChunkEnd : 0);
+        blockWords(chunk + 64*i, words);
+        compress(cv, words, counter, 64, flags, out);
+        memcpy(cv, out, 8*sizeof(quint32));
+    }
+}
+
+struct SAKStructBlake3Subtree {
+    const uchar *data;
+    quint64 counter;
+    int level;
+    quint32 cv[8];
+};
+
+void subtreeCv(SAKStructBlake3Subtree *subtree)
+{
+    quint32 cvs[1 << kMaxSubtreeLevel][8];
+    int count = 1 << subtree->level;
+    for (int i = 0; i < count; i++) {
+        chunkCv(subtree->data + i*1024, subtree->counter + quint64(i), cvs[i]);
+    }
+
+    while (count > 1) {
+        for (int i = 0; i < count/2; i++) {
+            parentCv(cvs[2*i], cvs[2*i + 1], cvs[i]);
+        }
+        count /= 2;
+    }
+    memcpy(subtree->cv, cvs[0], sizeof(subtree->cv));
+}
+
+// The subtrees are taken one by one from a shared index.
+class SAKToolFileCheckerBlake3Task : public QRunnable
+{
+public:
+    SAKToolFileCheckerBlake3Task(SAKStructBlake3Subtree *subtrees,
+                                 int count,
+                                 QAtomicInt *next,
+                                 QSemaphore *semaphore)
+        :mSubtrees(subtrees)
+        ,mCount(count)
+        ,mNext(next)
+        ,mSemaphore(semaphore)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() final
+    {
+        work(mSubtrees, mCount, mNext);
+        if (mSemaphore) {
+            mSemaphore->release();
+        }
+    }
+
+    static void work(SAKStructBlake3Subtree *subtrees, int count, QAtomicInt *next)
+    {
+        int index = 0;
+        while ((index = next->fetchAndAddOrdered(1)) < count) {
+            subtreeCv(&subtrees[index]);
+        }
+    }
+private:
+    SAKStructBlake3Subtree *mSubtrees;
+    int mCount;
+    QAtomicInt *mNext;
+    QSemaphore *mSemaphore;
+};
+}
+
+SAKToolFileCheckerBlake3Hasher::SAKToolFileCheckerBlake3Hasher()
+    :mBlockLength(0)
+    ,mBlocksCompressed(0)
+    ,mChunkCounter(0)
+    ,mCvStackLength(0)
+{
+    memcpy(mChunkCv, kIv, sizeof(mChunkCv));
+    memset(mBlock, 0, sizeof(mBlock));
+}
+
+void SAKToolFileCheckerBlake3Hasher::addData(const uchar *data, qint64 length)
+{
+    while (length > 0) {
+        if (mBlocksCompressed*BlockLength + mBlockLength == ChunkLength) {
+            finishChunk();
+        }
+
+        // The chunks are hashed in place, the last byte is kept for the
+        // chunk being hashed, it may be the root.
+        if ((mBlocksCompressed == 0) && (mBlockLength == 0) && (length > ChunkLength)) {
+            quint64 chunks = quint64(length - 1)/ChunkLength;
+            hashChunks(data, chunks);
+            data += chunks*ChunkLength;
+            length -= qint64(chunks*ChunkLength);
+        }
+
+        int chunkLength = mBlocksCompressed*BlockLength + mBlockLength;
+        int copied = int(qMin<qint64>(length, ChunkLength - chunkLength));
+        updateChunk(data, copied);
+        data += copied;
+        length -= copied;
+    }
+}
+
+QByteArray SAKToolFileCheckerBlake3Hasher::result()
+{
+    quint32 cv[8];
+    quint32 block[16];
+    quint32 out[16];
+    memcpy(cv, mChunkCv, sizeof(cv));
+    blockWords(mBlock, block);
+    quint64 counter = mChunkCounter;
+    quint32 blockLength = quint32(mBlockLength);
+    quint32 flags = FlagChunkEnd | (mBlocksCompressed == 0 ? FlagChunkStart : 0);
+
+    // Merging the chunk being hashed with the subtrees from the top of stack.
+    for (int i = mCvStackLength - 1; i >= 0; i--) {
+        compress(cv, block, counter, blockLength, flags, out);
+        memcpy(block, mCvStack[i], 8*sizeof(quint32));
+        memcpy(block + 8, out, 8*sizeof(quint32));
+        memcpy(cv, kIv, sizeof(cv));
+        counter = 0;
+        blockLength = BlockLength;
+        flags = FlagParent;
+    }
+
+    compress(cv, block, counter, blockLength, flags | FlagRoot, out);
+    QByteArray bytes(32, 0);
+    for (int i = 0; i < 8; i++) {
+        qToLittleEndian<quint32>(out[i], reinterpret_cast<uchar*>(bytes.data()) + 4*i);
+    }
+    return bytes;
+}
+
+void SAKToolFileCheckerBlake3Hasher::updateChunk(const uchar *data, int length)
+{
+    while (length > 0) {
+        // The last block of a chunk is compressed while finishing the chunk.
+        if (mBlockLength == BlockLength) {
+            quint32 words[16];
+            quint32 out[16];
+            quint32 flags = (mBlocksCompressed == 0) ? FlagChunkStart : 0;
+            blockWords(mBlock, words);
+            compress(mChunkCv, words, mChunkCounter, BlockLength, flags, out);
+            memcpy(mChunkCv, out, sizeof(mChunkCv));
+            mBlocksCompressed += 1;
+            mBlockLength = 0;
+            memset(mBlock, 0, sizeof(mBlock));
+        }
+
+        int copied = qMin(length, BlockLength - mBlockLength);
+        memcpy(mBlock + mBlockLength, data, size_t(copied));
+        mBlockLength += copied;
+        data += copied;
+        length -= copied;
+    }
+}
+
+void SAKToolFileCheckerBlake3Hasher::finishChunk()
+{
+    quint32 words[16];
+    quint32 out[16];
+    quint32 flags = FlagChunkEnd | (mBlocksCompressed == 0 ? FlagChunkStart : 0);
+    blockWords(mBlock, words);
+    compress(mChunkCv, words, mChunkCounter, quint32(mBlockLength), flags, out);
+    pushCv(out, 0);
+
+    memcpy(mChunkCv, kIv, sizeof(mChunkCv));
+    memset(mBlock, 0, sizeof(mBlock));
+    mBlockLength = 0;
+    mBlocksCompressed = 0;
+}
+
+void SAKToolFileCheckerBlake3Hasher::hashChunks(const uchar *data, quint64 chunks)
+{
+    // Splitting the chunks to the largest complete subtrees.
+    QVector<SAKStructBlake3Subtree> subtrees;
+    quint64 counter = mChunkCounter;
+    while (chunks > 0) {
+        int level = 0;
+        while ((level < kMaxSubtreeLevel)
+               && (((counter >> level) & 1) == 0)
+               && ((quint64(2) << level) <= chunks)) {
+            level += 1;
+        }
+
+        SAKStructBlake3Subtree subtree;
+        subtree.data = data;
+        subtree.counter = counter;
+        subtree.level = level;
+        subtrees.append(subtree);
+
+        quint64 count = quint64(1) << level;
+        data += count*ChunkLength;
+        counter += count;
+        chunks -= count;
+    }
+
+    // The calling thread takes subtrees too, so the hashing goes on even if
+    // there is no idle thread in the pool.
+    QAtomicInt next(0);
+    QSemaphore semaphore;
+    int started = 0;
+    QThreadPool *threadPool = QThreadPool::globalInstance();
+    int taskCount = qMin(subtrees.count() - 1, threadPool->maxThreadCount());
+    for (int i = 0; i < taskCount; i++) {
+        auto task = new SAKToolFileCheckerBlake3Task(subtrees.data(), subtrees.count(),
+                                                     &next, &semaphore);
+        if (!threadPool->tryStart(task)) {
+            delete task;
+            break;
+        }
+        started += 1;
+    }
+    SAKToolFileCheckerBlake3Task::work(subtrees.data(), subtrees.count(), &next);
+    semaphore.acquire(started);
+
+    for (auto &var : subtrees) {
+        pushCv(var.cv, var.level);
+    }
+}
+
+void SAKToolFileCheckerBlake3Hasher::pushCv(const quint32 *cv, int level)
+{
+    // The subtrees of the same size are merged, the number of the subtrees on
+    // the stack is the number of 1 bits of the chunks count.
+    quint32 newCv[8];
+    memcpy(newCv, cv, sizeof(newCv));
+    quint64 total = (mChunkCounter + (quint64(1) << level)) >> level;
+    while ((total & 1) == 0) {
+        mCvStackLength -= 1;
+        parentCv(mCvStack[mCvStackLength], newCv, newCv);
+        total >>= 1;
+    }
+
+    memcpy(mCvStack[mCvStackLength], newCv, sizeof(newCv));
+    mCvStackLength += 1;
+    mChunkCounter += quint64(1) << level;
+}
@@ -0,0 +1,49 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLFILECHECKERBLAKE3HASHER_HH
+#define SAKTOOLFILECHECKERBLAKE3HASHER_HH
+
+#include "SAKToolFileCheckerHasher.hh"
+
+/// @brief BLAKE3(256 bits output, hash mode), the same as the output of b3sum.
+/// The input is a binary tree of 1 KB chunks, the subtrees of a large block
+/// are hashed by the threads of the global thread pool at the same time.
+class SAKToolFileCheckerBlake3Hasher : public SAKToolFileCheckerHasher
+{
+public:
+    SAKToolFileCheckerBlake3Hasher();
+    void addData(const uchar *data, qint64 length) final;
+    QByteArray result() final;
+private:
+    enum {
+        BlockLength = 64,
+        ChunkLength = 1024,
+        // The maximum depth of the tree(2^54 chunks)
+        MaxDepth = 54
+    };
+
+    // The chunk being hashed
+    quint32 mChunkCv[8];
+    uchar mBlock[BlockLength];
+    int mBlockLength;
+    int mBlocksCompressed;
+    // The number of chunks completed, it is the counter of the chunk being hashed.
+    quint64 mChunkCounter;
+    // The chaining values of the subtrees completed, the largest one is at the bottom.
+    quint32 mCvStack[MaxDepth][8];
+    int mCvStackLength;
+private:
+    void updateChunk(const uchar *data, int length);
+    void finishChunk();
+    void hashChunks(const uchar *data, quint64 chunks);
+    void pushCv(const quint32 *cv, int level);
+};
+
+#endif // SAKTOOLFILECHECKERBLAKE3HASHER_HH
@@ -0,0 +1,31 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QtEndian>
+
+#include "SAKToolFileCheckerCrcHasher.hh"
+
+SAKToolFileCheckerCrcHasher::SAKToolFileCheckerCrcHasher(
+        SAKCommonCrcInterface::SAKEnumCrcModel model)
+{
+    SAKCommonCrcInterface::crcInit(&mContext, model);
+}
+
+void SAKToolFileCheckerCrcHasher::addData(const uchar *data, qint64 length)
+{
+    SAKCommonCrcInterface::crcUpdate(&mContext, data, uint64_t(length));
+}
+
+QByteArray SAKToolFileCheckerCrcHasher::result()
+{
+    uint32_t crc = SAKCommonCrcInterface::crcFinal(&mContext);
+    QByteArray bytes(4, 0);
+    qToBigEndian<quint32>(crc, reinterpret_cast<uchar*>(bytes.data()));
+    return bytes.right(mContext.bitsWidth/8);
+}
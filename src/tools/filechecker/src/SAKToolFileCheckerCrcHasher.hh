@@ -0,0 +1,27 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLFILECHECKERCRCHASHER_HH
+#define SAKTOOLFILECHECKERCRCHASHER_HH
+
+#include "SAKCommonCrcInterface.hh"
+#include "SAKToolFileCheckerHasher.hh"
+
+class SAKToolFileCheckerCrcHasher : public SAKToolFileCheckerHasher
+{
+public:
+    SAKToolFileCheckerCrcHasher(SAKCommonCrcInterface::SAKEnumCrcModel model);
+    void addData(const uchar *data, qint64 length) final;
+    // Big endian
+    QByteArray result() final;
+private:
+    SAKCommonCrcInterface::SAKStructCrcContext mContext;
+};
+
+#endif // SAKTOOLFILECHECKERCRCHASHER_HH
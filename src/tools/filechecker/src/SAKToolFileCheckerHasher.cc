@@ -0,0 +1,98 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QMetaEnum>
+
+#include "SAKToolFileChecker.hh"
+#include "SAKToolFileCheckerHasher.hh"
+#include "SAKToolFileCheckerCrcHasher.hh"
+#include "SAKToolFileCheckerXxh3Hasher.hh"
+#include "SAKToolFileCheckerBlake3Hasher.hh"
+
+namespace {
+// The algorithms which are not provided by QCryptographicHash
+const char *kXxh3 = "XXH3";
+const char *kXxh128 = "XXH128";
+const char *kBlake3 = "BLAKE3";
+}
+
+SAKToolFileCheckerHasher *SAKToolFileCheckerHasher::create(const QString &name)
+{
+    if (name == QString(kXxh3) || name == QString(kXxh128)) {
+        return new SAKToolFileCheckerXxh3Hasher(name == QString(kXxh128));
+    } else if (name == QString(kBlake3)) {
+        return new SAKToolFileCheckerBlake3Hasher;
+    }
+
+    bool ok = false;
+    QByteArray key = name.toLatin1();
+    QMetaEnum models = QMetaEnum::fromType<SAKCommonCrcInterface::SAKEnumCrcModel>();
+    int model = models.keyToValue(key.constData(), &ok);
+    if (ok) {
+        return new SAKToolFileCheckerCrcHasher(
+                    static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(model));
+    }
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 9, 0)
+    QMetaEnum algorithms = QMetaEnum::fromType<SAKToolFileChecker::Algorithm>();
+#else
+    QMetaEnum algorithms = QMetaEnum::fromType<QCryptographicHash::Algorithm>();
+#endif
+    int algorithm = algorithms.keyToValue(key.constData(), &ok);
+    if (ok) {
+        return new SAKToolFileCheckerCryptographicHasher(
+                    static_cast<QCryptographicHash::Algorithm>(algorithm));
+    }
+
+    return Q_NULLPTR;
+}
+
+QStringList SAKToolFileCheckerHasher::algorithmNames()
+{
+    QStringList names;
+#if QT_VERSION < QT_VERSION_CHECK(5, 9, 0)
+    QMetaEnum algorithms = QMetaEnum::fromType<SAKToolFileChecker::Algorithm>();
+#else
+    QMetaEnum algorithms = QMetaEnum::fromType<QCryptographicHash::Algorithm>();
+#endif
+    for (int i = 0; i < algorithms.keyCount(); i++){
+        names.append(QString(algorithms.key(i)));
+    }
+    names << QString(kXxh3) << QString(kXxh128) << QString(kBlake3);
+
+    QMetaEnum models = QMetaEnum::fromType<SAKCommonCrcInterface::SAKEnumCrcModel>();
+    for (int i = 0; i < models.keyCount(); i++){
+        names.append(QString(models.key(i)));
+    }
+
+    return names;
+}
+
+SAKToolFileCheckerCryptographicHasher::SAKToolFileCheckerCryptographicHasher(
+        QCryptographicHash::Algorithm algorithm)
+    :mCryptographicHash(algorithm)
+{
+
+}
+
+void SAKToolFileCheckerCryptographicHasher::addData(const uchar *data, qint64 length)
+{
+    // The length of QCryptographicHash::addData(const char*, int) is an int.
+    while (length > 0) {
+        int block = int(qMin(length, qint64(1) << 30));
+        mCryptographicHash.addData(reinterpret_cast<const char*>(data), block);
+        data += block;
+        length -= block;
+    }
+}
+
+QByteArray SAKToolFileCheckerCryptographicHasher::result()
+{
+    return mCryptographicHash.result();
+}
@@ -0,0 +1,47 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLFILECHECKERHASHER_HH
+#define SAKTOOLFILECHECKERHASHER_HH
+
+#include <QString>
+#include <QByteArray>
+#include <QStringList>
+#include <QCryptographicHash>
+
+/// @brief A digest which is fed block by block, the algorithms are the ones of
+/// QCryptographicHash, XXH3, XXH128, BLAKE3 and the crc models(see
+/// SAKToolFileCheckerCrcHasher).
+class SAKToolFileCheckerHasher
+{
+public:
+    virtual ~SAKToolFileCheckerHasher(){}
+    virtual void addData(const uchar *data, qint64 length) = 0;
+    virtual QByteArray result() = 0;
+
+    /**
+     * @brief create: Create a hasher.
+     * @param name: A name of algorithmNames().
+     * @return Null is returned if the name is unknown.
+     */
+    static SAKToolFileCheckerHasher *create(const QString &name);
+    static QStringList algorithmNames();
+};
+
+class SAKToolFileCheckerCryptographicHasher : public SAKToolFileCheckerHasher
+{
+public:
+    SAKToolFileCheckerCryptographicHasher(QCryptographicHash::Algorithm algorithm);
+    void addData(const uchar *data, qint64 length) final;
+    QByteArray result() final;
+private:
+    QCryptographicHash mCryptographicHash;
+};
+
+#endif // SAKTOOLFILECHECKERHASHER_HH
@@ -0,0 +1,143 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <cctype>
+#include <QFile>
+#include <QObject>
+#include <QSaveFile>
+
+#include "SAKToolFileCheckerManifest.hh"
+
+QByteArray SAKToolFileCheckerManifest::toLine(const SAKStructEntry &entry)
+{
+    QByteArray name = entry.fileName.toUtf8();
+    bool escaped = name.contains('\\') || name.contains('\n');
+    if (escaped) {
+        name.replace("\\", "\\\\");
+        name.replace("\n", "\\n");
+    }
+
+    QByteArray line;
+    if (escaped) {
+        line.append('\\');
+    }
+    line.append(entry.digest.toHex());
+    line.append("  ");
+    line.append(name);
+    return line;
+}
+
+bool SAKToolFileCheckerManifest::fromLine(const QByteArray &line, SAKStructEntry *entry)
+{
+    QByteArray temp = line;
+    if (temp.endsWith('\r')) {
+        temp.chop(1);
+    }
+
+    bool escaped = temp.startsWith('\\');
+    if (escaped) {
+        temp.remove(0, 1);
+    }
+
+    // "<digest>  <name>" in text mode, "<digest> *<name>" in binary mode.
+    int index = temp.indexOf(' ');
+    if ((index <= 0) || (index + 2 > temp.length())
+            || ((temp.at(index + 1) != ' ') && (temp.at(index + 1) != '*'))) {
+        return false;
+    }
+
+    QByteArray hex = temp.left(index);
+    for (auto &var : hex) {
+        if (!isxdigit(uchar(var))) {
+            return false;
+        }
+    }
+    if (hex.length() % 2) {
+        return false;
+    }
+
+    QByteArray name = temp.mid(index + 2);
+    if (name.isEmpty()) {
+        return false;
+    }
+
+    if (escaped) {
+        QByteArray unescaped;
+        for (int i = 0; i < name.length(); i++) {
+            if ((name.at(i) == '\\') && (i + 1 < name.length())) {
+                i += 1;
+                unescaped.append(name.at(i) == 'n' ? '\n' : name.at(i));
+            } else {
+                unescaped.append(name.at(i));
+            }
+        }
+        name = unescaped;
+    }
+
+    entry->digest = QByteArray::fromHex(hex);
+    entry->fileName = QString::fromUtf8(name);
+    return true;
+}
+
+bool SAKToolFileCheckerManifest::read(const QString &fileName,
+                                      QList<SAKStructEntry> *entries,
+                                      QString *errorString)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        *errorString = file.errorString();
+        return false;
+    }
+
+    int lineNumber = 0;
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine();
+        lineNumber += 1;
+        if (line.endsWith('\n')) {
+            line.chop(1);
+        }
+
+        if (line.trimmed().isEmpty()) {
+            continue;
+        }
+
+        SAKStructEntry entry;
+        if (!fromLine(line, &entry)) {
+            *errorString = QObject::tr("Invalid manifest line: %1").arg(lineNumber);
+            return false;
+        }
+        entries->append(entry);
+    }
+
+    return true;
+}
+
+bool SAKToolFileCheckerManifest::write(const QString &fileName,
+                                       const QList<SAKStructEntry> &entries,
+                                       QString *errorString)
+{
+    // The old manifest is kept if writing failed.
+    QSaveFile file(fileName);
+    if (!file.open(QFile::WriteOnly)) {
+        *errorString = file.errorString();
+        return false;
+    }
+
+    for (auto &var : entries) {
+        file.write(toLine(var));
+        file.write("\n");
+    }
+
+    if (!file.commit()) {
+        *errorString = file.errorString();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,45 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLFILECHECKERMANIFEST_HH
+#define SAKTOOLFILECHECKERMANIFEST_HH
+
+#include <QList>
+#include <QString>
+#include <QByteArray>
+
+/// @brief A manifest which is compatible with the output of sha256sum(and
+/// md5sum, sha1sum...), a line is "<hex digest>  <relative path>". The paths
+/// contain '\' or '\n' are escaped and the line is prefixed with '\'.
+class SAKToolFileCheckerManifest
+{
+public:
+    struct SAKStructEntry {
+        QString fileName;
+        QByteArray digest;
+    };
+
+    static QByteArray toLine(const SAKStructEntry &entry);
+    /**
+     * @brief fromLine: Parse a line of manifest.
+     * @param line: A line without the line ending.
+     * @param entry: The entry parsed.
+     * @return false: The line is not a valid manifest line.
+     */
+    static bool fromLine(const QByteArray &line, SAKStructEntry *entry);
+
+    static bool read(const QString &fileName,
+                     QList<SAKStructEntry> *entries,
+                     QString *errorString);
+    static bool write(const QString &fileName,
+                      const QList<SAKStructEntry> &entries,
+                      QString *errorString);
+};
+
+#endif // SAKTOOLFILECHECKERMANIFEST_HH
@@ -0,0 +1,108 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include "SAKToolFileCheckerReader.hh"
+
+SAKToolFileCheckerReader::SAKToolFileCheckerReader(qint64 blockSize)
+    :mBlockSize(blockSize)
+    ,mOffset(0)
+    ,mMappedBlock(Q_NULLPTR)
+    ,mIsMappingEnabled(true)
+{
+
+}
+
+SAKToolFileCheckerReader::~SAKToolFileCheckerReader()
+{
+    close();
+}
+
+bool SAKToolFileCheckerReader::open(const QString &fileName)
+{
+    close();
+    mFile.setFileName(fileName);
+    mOffset = 0;
+    mIsMappingEnabled = true;
+    mErrorString.clear();
+    if (!mFile.open(QFile::ReadOnly)) {
+        mErrorString = mFile.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+void SAKToolFileCheckerReader::close()
+{
+    if (mMappedBlock) {
+        mFile.unmap(mMappedBlock);
+        mMappedBlock = Q_NULLPTR;
+    }
+
+    if (mFile.isOpen()) {
+        mFile.close();
+    }
+}
+
+const uchar *SAKToolFileCheckerReader::read(qint64 *length)
+{
+    *length = 0;
+    if (mMappedBlock) {
+        mFile.unmap(mMappedBlock);
+        mMappedBlock = Q_NULLPTR;
+    }
+
+    qint64 remaining = mFile.size() - mOffset;
+    if ((!mFile.isOpen()) || (remaining <= 0) || (!mErrorString.isEmpty())) {
+        return Q_NULLPTR;
+    }
+
+    qint64 blockLength = qMin(mBlockSize, remaining);
+    if (mIsMappingEnabled) {
+        mMappedBlock = mFile.map(mOffset, blockLength);
+        if (mMappedBlock) {
+            mOffset += blockLength;
+            *length = blockLength;
+            return mMappedBlock;
+        }
+
+        // Such as the files of a pipe or a special file system.
+        mIsMappingEnabled = false;
+        mFile.seek(mOffset);
+    }
+
+    if (mBuffer.size() < blockLength) {
+        mBuffer.resize(int(blockLength));
+    }
+
+    qint64 ret = mFile.read(mBuffer.data(), blockLength);
+    if (ret <= 0) {
+        mErrorString = ret < 0 ? mFile.errorString() : QString("Unexpected end of file");
+        return Q_NULLPTR;
+    }
+
+    mOffset += ret;
+    *length = ret;
+    return reinterpret_cast<const uchar*>(mBuffer.constData());
+}
+
+qint64 SAKToolFileCheckerReader::size() const
+{
+    return mFile.size();
+}
+
+bool SAKToolFileCheckerReader::hasError() const
+{
+    return !mErrorString.isEmpty();
+}
+
+QString SAKToolFileCheckerReader::errorString() const
+{
+    return mErrorString;
+}
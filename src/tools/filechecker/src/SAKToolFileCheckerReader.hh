@@ -0,0 +1,48 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLFILECHECKERREADER_HH
+#define SAKTOOLFILECHECKERREADER_HH
+
+#include <QFile>
+#include <QString>
+#include <QByteArray>
+
+/// @brief Read a file block by block. The blocks are mapped to memory(the page
+/// cache is used directly), a buffer which is allocated once is used if the
+/// file can not be mapped.
+class SAKToolFileCheckerReader
+{
+public:
+    SAKToolFileCheckerReader(qint64 blockSize = 8*1024*1024);
+    ~SAKToolFileCheckerReader();
+
+    bool open(const QString &fileName);
+    void close();
+
+    /**
+     * @brief read: Get the next block, the block is valid until the next calling.
+     * @param length: The length of the block.
+     * @return Null is returned if the file is read or an error occurred.
+     */
+    const uchar *read(qint64 *length);
+    qint64 size() const;
+    bool hasError() const;
+    QString errorString() const;
+private:
+    QFile mFile;
+    qint64 mBlockSize;
+    qint64 mOffset;
+    uchar *mMappedBlock;
+    bool mIsMappingEnabled;
+    QByteArray mBuffer;
+    QString mErrorString;
+};
+
+#endif // SAKTOOLFILECHECKERREADER_HH
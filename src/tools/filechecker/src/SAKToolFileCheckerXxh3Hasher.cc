@@ -0,0 +1,401 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <cstring>
+#include <QtEndian>
+
+#include "SAKToolFileCheckerXxh3Hasher.hh"
+
+namespace {
+const quint64 kPrime32_1 = 0x9E3779B1U;
+const quint64 kPrime32_2 = 0x85EBCA77U;
+const quint64 kPrime32_3 = 0xC2B2AE3DU;
+const quint64 kPrime64_1 = 0x9E3779B185EBCA87ULL;
+const quint64 kPrime64_2 = 0xC2B2AE3D27D4EB4FULL;
+const quint64 kPrime64_3 = 0x165667B19E3779F9ULL;
+const quint64 kPrime64_4 = 0x85EBCA77C2B2AE63ULL;
+const quint64 kPrime64_5 = 0x27D4EB2F165667C5ULL;
+const quint64 kPrimeMx1 = 0x165667919E3779F9ULL;
+const quint64 kPrimeMx2 = 0x9FB21C651E98DF25ULL;
+
+const int kSecretSize = 192;
+const uchar kSecret[kSecretSize] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+// Offsets of the secret used by the long input.
+const int kSecretLastStripeOffset = kSecretSize - 64 - 7;
+const int kSecretScrambleOffset = kSecretSize - 64;
+const int kSecretMergeOffset = 11;
+const int kSecretMidSizeOffset = 3;
+const int kSecretMidSizeLastOffset = 136 - 17;
+
+struct SAKStruct128 {
+    quint64 low;
+    quint64 high;
+};
+
+inline quint32 read32(const uchar *p)
+{
+    return qFromLittleEndian<quint32>(p);
+}
+
+inline quint64 read64(const uchar *p)
+{
+    return qFromLittleEndian<quint64>(p);
+}
+
+inline quint64 rotl64(quint64 v, int r)
+{
+    return (v << r) | (v >> (64 - r));
+}
+
+inline quint32 rotl32(quint32 v, int r)
+{
+    return (v << r) | (v >> (32 - r));
+}
+
+inline quint32 swap32(quint32 v)
+{
+    return qbswap<quint32>(v);
+}
+
+inline quint64 swap64(quint64 v)
+{
+    return qbswap<quint64>(v);
+}
+
+inline SAKStruct128 mul64to128(quint64 a, quint64 b)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = static_cast<unsigned __int128>(a)*b;
+    return SAKStruct128{quint64(product), quint64(product >> 64)};
+#else
+    quint64 lolo = (a & 0xFFFFFFFFULL)*(b & 0xFFFFFFFFULL);
+    quint64 hilo = (a >> 32)*(b & 0xFFFFFFFFULL);
+    quint64 lohi = (a & 0xFFFFFFFFULL)*(b >> 32);
+    quint64 hihi = (a >> 32)*(b >> 32);
+    quint64 cross = (lolo >> 32) + (hilo & 0xFFFFFFFFULL) + lohi;
+    quint64 upper = (hilo >> 32) + (cross >> 32) + hihi;
+    quint64 lower = (cross << 32) | (lolo & 0xFFFFFFFFULL);
+    return SAKStruct128{lower, upper};
+#endif
+}
+
+inline quint64 mulFold64(quint64 a, quint64 b)
+{
+    SAKStruct128 product = mul64to128(a, b);
+    return product.low ^ product.high;
+}
+
+inline quint64 xxh64Avalanche(quint64 h)
+{
+    h ^= h >> 33;
+    h *= kPrime64_2;
+    h ^= h >> 29;
+    h *= kPrime64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+inline quint64 avalanche(quint64 h)
+{
+    h ^= h >> 37;
+    h *= kPrimeMx1;
+    h ^= h >> 32;
+    return h;
+}
+
+inline quint64 rrmxmx(quint64 h, quint64 length)
+{
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= kPrimeMx2;
+    h ^= (h >> 35) + length;
+    h *= kPrimeMx2;
+    h ^= h >> 28;
+    return h;
+}
+
+inline quint64 mix16(const uchar *input, const uchar *secret)
+{
+    return mulFold64(read64(input) ^ read64(secret), read64(input + 8) ^ read64(secret + 8));
+}
+
+inline void mix32(SAKStruct128 *acc, const uchar *input1, const uchar *input2, const uchar *secret)
+{
+    acc->low += mix16(input1, secret);
+    acc->low ^= read64(input2) + read64(input2 + 8);
+    acc->high += mix16(input2, secret + 16);
+    acc->high ^= read64(input1) + read64(input1 + 8);
+}
+
+inline void accumulate512(quint64 *acc, const uchar *input, const uchar *secret)
+{
+    for (int i = 0; i < 8; i++) {
+        quint64 value = read64(input + 8*i);
+        quint64 key = value ^ read64(secret + 8*i);
+        acc[i ^ 1] += value;
+        acc[i] += (key & 0xFFFFFFFFULL)*(key >> 32);
+    }
+}
+
+inline void scramble(quint64 *acc, const uchar *secret)
+{
+    for (int i = 0; i < 8; i++) {
+        quint64 value = acc[i];
+        value ^= value >> 47;
+        value ^= read64(secret + 8*i);
+        value *= kPrime32_1;
+        acc[i] = value;
+    }
+}
+
+quint64 mergeAccumulators(const quint64 *acc, const uchar *secret, quint64 start)
+{
+    quint64 result = start;
+    for (int i = 0; i < 4; i++) {
+        result += mulFold64(acc[2*i] ^ read64(secret + 16*i),
+                            acc[2*i + 1] ^ read64(secret + 16*i + 8));
+    }
+    return avalanche(result);
+}
+
+quint64 hashShort64(const uchar *input, quint64 length)
+{
+    const uchar *secret = kSecret;
+    if (length > 128) {
+        quint64 acc = length*kPrime64_1;
+        int rounds = int(length/16);
+        for (int i = 0; i < 8; i++) {
+            acc += mix16(input + 16*i, secret + 16*i);
+        }
+        acc = avalanche(acc);
+        for (int i = 8; i < rounds; i++) {
+            acc += mix16(input + 16*i, secret + 16*(i - 8) + kSecretMidSizeOffset);
+        }
+        acc += mix16(input + length - 16, secret + kSecretMidSizeLastOffset);
+        return avalanche(acc);
+    } else if (length > 16) {
+        quint64 acc = length*kPrime64_1;
+        if (length > 32) {
+            if (length > 64) {
+                if (length > 96) {
+                    acc += mix16(input + 48, secret + 96);
+                    acc += mix16(input + length - 64, secret + 112);
+                }
+                acc += mix16(input + 32, secret + 64);
+                acc += mix16(input + length - 48, secret + 80);
+            }
+            acc += mix16(input + 16, secret + 32);
+            acc += mix16(input + length - 32, secret + 48);
+        }
+        acc += mix16(input, secret);
+        acc += mix16(input + length - 16, secret + 16);
+        return avalanche(acc);
+    } else if (length > 8) {
+        quint64 low = read64(input) ^ (read64(secret + 24) ^ read64(secret + 32));
+        quint64 high = read64(input + length - 8) ^ (read64(secret + 40) ^ read64(secret + 48));
+        quint64 acc = length + swap64(low) + high + mulFold64(low, high);
+        return avalanche(acc);
+    } else if (length >= 4) {
+        quint64 input1 = read32(input);
+        quint64 input2 = read32(input + length - 4);
+        quint64 keyed = (input2 + (input1 << 32)) ^ (read64(secret + 8) ^ read64(secret + 16));
+        return rrmxmx(keyed, length);
+    } else if (length > 0) {
+        quint32 combined = (quint32(input[0]) << 16) | (quint32(input[length >> 1]) << 24)
+                | quint32(input[length - 1]) | (quint32(length) << 8);
+        quint64 keyed = combined ^ (read32(secret) ^ read32(secret + 4));
+        return xxh64Avalanche(keyed);
+    }
+
+    return xxh64Avalanche(read64(secret + 56) ^ read64(secret + 64));
+}
+
+SAKStruct128 hashShort128(const uchar *input, quint64 length)
+{
+    const uchar *secret = kSecret;
+    SAKStruct128 h;
+    if (length > 16) {
+        SAKStruct128 acc{length*kPrime64_1, 0};
+        if (length > 128) {
+            int rounds = int(length/32);
+            for (int i = 0; i < 4; i++) {
+                mix32(&acc, input + 32*i, input + 32*i + 16, secret + 32*i);
+            }
+            acc.low = avalanche(acc.low);
+            acc.high = avalanche(acc.high);
+            for (int i = 4; i < rounds; i++) {
+                mix32(&acc, input + 32*i, input + 32*i + 16,
+                      secret + kSecretMidSizeOffset + 32*(i - 4));
+            }
+            mix32(&acc, input + length - 16, input + length - 32,
+                  secret + kSecretMidSizeLastOffset - 16);
+        } else {
+            if (length > 32) {
+                if (length > 64) {
+                    if (length > 96) {
+                        mix32(&acc, input + 48, input + length - 64, secret + 96);
+                    }
+                    mix32(&acc, input + 32, input + length - 48, secret + 64);
+                }
+                mix32(&acc, input + 16, input + length - 32, secret + 32);
+            }
+            mix32(&acc, input, input + length - 16, secret);
+        }
+        h.low = avalanche(acc.low + acc.high);
+        h.high = 0 - avalanche(acc.low*kPrime64_1 + acc.high*kPrime64_4 + length*kPrime64_2);
+    } else if (length > 8) {
+        quint64 flipLow = read64(secret + 32) ^ read64(secret + 40);
+        quint64 flipHigh = read64(secret + 48) ^ read64(secret + 56);
+        quint64 inputLow = read64(input);
+        quint64 inputHigh = read64(input + length - 8);
+        SAKStruct128 m = mul64to128(inputLow ^ inputHigh ^ flipLow, kPrime64_1);
+        m.low += (length - 1) << 54;
+        inputHigh ^= flipHigh;
+        m.high += inputHigh + (inputHigh & 0xFFFFFFFFULL)*(kPrime32_2 - 1);
+        m.low ^= swap64(m.high);
+        h = mul64to128(m.low, kPrime64_2);
+        h.high += m.high*kPrime64_2;
+        h.low = avalanche(h.low);
+        h.high = avalanche(h.high);
+    } else if (length >= 4) {
+        quint64 inputLow = read32(input);
+        quint64 inputHigh = read32(input + length - 4);
+        quint64 keyed = (inputLow + (inputHigh << 32)) ^ (read64(secret + 16) ^ read64(secret + 24));
+        h = mul64to128(keyed, kPrime64_1 + (length << 2));
+        h.high += h.low << 1;
+        h.low ^= h.high >> 3;
+        h.low ^= h.low >> 35;
+        h.low *= kPrimeMx2;
+        h.low ^= h.low >> 28;
+        h.high = avalanche(h.high);
+    } else if (length > 0) {
+        quint32 low = (quint32(input[0]) << 16) | (quint32(input[length >> 1]) << 24)
+                | quint32(input[length - 1]) | (quint32(length) << 8);
+        quint32 high = rotl32(swap32(low), 13);
+        h.low = xxh64Avalanche(low ^ (read32(secret) ^ read32(secret + 4)));
+        h.high = xxh64Avalanche(high ^ (read32(secret + 8) ^ read32(secret + 12)));
+    } else {
+        h.low = xxh64Avalanche(read64(secret + 64) ^ read64(secret + 72));
+        h.high = xxh64Avalanche(read64(secret + 80) ^ read64(secret + 88));
+    }
+
+    return h;
+}
+}
+
+SAKToolFileCheckerXxh3Hasher::SAKToolFileCheckerXxh3Hasher(bool is128Bits)
+    :mIs128Bits(is128Bits)
+    ,mTotalLength(0)
+    ,mBufferLength(0)
+{
+    const quint64 init[8] = {
+        kPrime32_3, kPrime64_1, kPrime64_2, kPrime64_3,
+        kPrime64_4, kPrime32_2, kPrime64_5, kPrime32_1
+    };
+    memcpy(mAccumulators, init, sizeof(mAccumulators));
+    memset(mLastStripe, 0, sizeof(mLastStripe));
+}
+
+void SAKToolFileCheckerXxh3Hasher::addData(const uchar *data, qint64 length)
+{
+    mTotalLength += quint64(length);
+    while (length > 0) {
+        if (mBufferLength == BlockLength) {
+            consumeBlock(mBuffer);
+            memcpy(mLastStripe, mBuffer + BlockLength - StripeLength, StripeLength);
+            mBufferLength = 0;
+        }
+
+        // The blocks are consumed in place if there is nothing buffered.
+        if (mBufferLength == 0 && length > BlockLength) {
+            while (length > BlockLength) {
+                consumeBlock(data);
+                data += BlockLength;
+                length -= BlockLength;
+            }
+            memcpy(mLastStripe, data - StripeLength, StripeLength);
+        }
+
+        int copied = int(qMin<qint64>(length, BlockLength - mBufferLength));
+        memcpy(mBuffer + mBufferLength, data, size_t(copied));
+        mBufferLength += copied;
+        data += copied;
+        length -= copied;
+    }
+}
+
+QByteArray SAKToolFileCheckerXxh3Hasher::result()
+{
+    SAKStruct128 h;
+    if (mTotalLength <= 240) {
+        if (mIs128Bits) {
+            h = hashShort128(mBuffer, mTotalLength);
+        } else {
+            h.high = 0;
+            h.low = hashShort64(mBuffer, mTotalLength);
+        }
+    } else {
+        quint64 acc[8];
+        memcpy(acc, mAccumulators, sizeof(acc));
+        int stripes = (mBufferLength - 1)/StripeLength;
+        for (int i = 0; i < stripes; i++) {
+            accumulate512(acc, mBuffer + i*StripeLength, kSecret + 8*i);
+        }
+
+        uchar lastStripe[StripeLength];
+        const uchar *last = mBuffer + mBufferLength - StripeLength;
+        if (mBufferLength < StripeLength) {
+            int catchup = StripeLength - mBufferLength;
+            memcpy(lastStripe, mLastStripe + StripeLength - catchup, size_t(catchup));
+            memcpy(lastStripe + catchup, mBuffer, size_t(mBufferLength));
+            last = lastStripe;
+        }
+        accumulate512(acc, last, kSecret + kSecretLastStripeOffset);
+
+        h.low = mergeAccumulators(acc, kSecret + kSecretMergeOffset, mTotalLength*kPrime64_1);
+        h.high = 0;
+        if (mIs128Bits) {
+            h.high = mergeAccumulators(acc, kSecret + kSecretSize - 64 - kSecretMergeOffset,
+                                       ~(mTotalLength*kPrime64_2));
+        }
+    }
+
+    QByteArray bytes;
+    if (mIs128Bits) {
+        bytes.resize(16);
+        qToBigEndian<quint64>(h.high, reinterpret_cast<uchar*>(bytes.data()));
+        qToBigEndian<quint64>(h.low, reinterpret_cast<uchar*>(bytes.data()) + 8);
+    } else {
+        bytes.resize(8);
+        qToBigEndian<quint64>(h.low, reinterpret_cast<uchar*>(bytes.data()));
+    }
+    return bytes;
+}
+
+void SAKToolFileCheckerXxh3Hasher::consumeBlock(const uchar *block)
+{
+    const int stripes = (kSecretSize - StripeLength)/8;
+    for (int i = 0; i < stripes; i++) {
+        accumulate512(mAccumulators, block + i*StripeLength, kSecret + 8*i);
+    }
+    scramble(mAccumulators, kSecret + kSecretScrambleOffset);
+}
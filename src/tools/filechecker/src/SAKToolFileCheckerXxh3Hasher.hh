@@ -0,0 +1,42 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLFILECHECKERXXH3HASHER_HH
+#define SAKTOOLFILECHECKERXXH3HASHER_HH
+
+#include "SAKToolFileCheckerHasher.hh"
+
+/// @brief XXH3(64 bits) and XXH128 with the default secret and the seed 0, it
+/// is not a cryptographic hash. The result is the canonical(big endian)
+/// representation, the same as the output of xxhsum -H3 or -H2.
+class SAKToolFileCheckerXxh3Hasher : public SAKToolFileCheckerHasher
+{
+public:
+    SAKToolFileCheckerXxh3Hasher(bool is128Bits);
+    void addData(const uchar *data, qint64 length) final;
+    QByteArray result() final;
+private:
+    enum {
+        StripeLength = 64,
+        BlockLength = 1024
+    };
+
+    bool mIs128Bits;
+    quint64 mAccumulators[8];
+    quint64 mTotalLength;
+    // The input is buffered until it is known that it is not the last block.
+    uchar mBuffer[BlockLength];
+    int mBufferLength;
+    // The tail of the last block consumed, the last stripe may overlap it.
+    uchar mLastStripe[StripeLength];
+private:
+    void consumeBlock(const uchar *block);
+};
+
+#endif // SAKTOOLFILECHECKERXXH3HASHER_HH
@@ -2,11 +2,18 @@ INCLUDEPATH += \
     $$PWD/src
 
 FORMS += \
-    $$PWD/src/SAKToolFloatAssistant.ui
+    $$PWD/src/SAKToolFloatAssistant.ui \
+    $$PWD/src/SAKToolFloatAssistantBulk.ui
 
 HEADERS += \
-    $$PWD/src/SAKToolFloatAssistant.hh
+    $$PWD/src/SAKToolFloatAssistant.hh \
+    $$PWD/src/SAKToolFloatAssistantBulk.hh \
+    $$PWD/src/SAKToolFloatAssistantBulkThread.hh \
+    $$PWD/src/SAKToolFloatAssistantDecoder.hh
 
 SOURCES += \
-    $$PWD/src/SAKToolFloatAssistant.cc
+    $$PWD/src/SAKToolFloatAssistant.cc \
+    $$PWD/src/SAKToolFloatAssistantBulk.cc \
+    $$PWD/src/SAKToolFloatAssistantBulkThread.cc \
+    $$PWD/src/SAKToolFloatAssistantDecoder.cc
 
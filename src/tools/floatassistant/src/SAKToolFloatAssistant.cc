@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2020-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -10,6 +10,7 @@
 #include <QDebug>
 #include "SAKCommonInterface.hh"
 #include "SAKToolFloatAssistant.hh"
+#include "SAKToolFloatAssistantBulk.hh"
 #include "ui_SAKToolFloatAssistant.h"
 
 SAKToolFloatAssistant::SAKToolFloatAssistant(QWidget *parent)
@@ -152,3 +153,10 @@ void SAKToolFloatAssistant::on_doubleRadioButton_clicked()
 {
     on_createPushButton_clicked();
 }
+
+void SAKToolFloatAssistant::on_bulkPushButton_clicked()
+{
+    auto dialog = new SAKToolFloatAssistantBulk(this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->show();
+}
@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2020-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -35,6 +35,7 @@ private slots:
     void on_bigEndianCheckBox_clicked();
     void on_floatRadioButton_clicked();
     void on_doubleRadioButton_clicked();
+    void on_bulkPushButton_clicked();
 };
 
 #endif // SAKTOOLFLOATASSISTANT_HH
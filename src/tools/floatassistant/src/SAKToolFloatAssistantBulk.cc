@@ -0,0 +1,168 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QFileInfo>
+#include <QStringList>
+#include <QFileDialog>
+#include <QMessageBox>
+
+#include "SAKToolFloatAssistantBulk.hh"
+#include "SAKToolFloatAssistantBulkThread.hh"
+#include "ui_SAKToolFloatAssistantBulk.h"
+
+// Samples those are shown, all of the samples can be exported.
+#define SAK_PREVIEW_COUNT 1000
+
+SAKToolFloatAssistantBulk::SAKToolFloatAssistantBulk(QWidget *parent)
+    :QDialog(parent)
+    ,ui(new Ui::SAKToolFloatAssistantBulk)
+    ,mThread(Q_NULLPTR)
+{
+    ui->setupUi(this);
+}
+
+SAKToolFloatAssistantBulk::~SAKToolFloatAssistantBulk()
+{
+    stopThread();
+    delete ui;
+}
+
+void SAKToolFloatAssistantBulk::startThread(const QString &csvFileName)
+{
+    SAKToolFloatAssistantBulkThread::ParametersContext ctx;
+    ctx.fileName = ui->fileLineEdit->text().trimmed();
+    ctx.hexText = ui->hexPlainTextEdit->toPlainText();
+    ctx.decoding.type = static_cast<SAKToolFloatAssistantDecoder::SAKEnumSampleType>(
+                ui->typeComboBox->currentIndex());
+    ctx.decoding.bigEndian = ui->bigEndianCheckBox->isChecked();
+    ctx.decoding.offset = ui->offsetSpinBox->value();
+    ctx.decoding.stride = ui->strideSpinBox->value();
+    ctx.csvFileName = csvFileName;
+    ctx.previewCount = SAK_PREVIEW_COUNT;
+
+    if ((!ctx.fileName.isEmpty()) && (!QFileInfo(ctx.fileName).isFile())) {
+        QMessageBox::warning(this, tr("Input file"), tr("The file is not existed!"));
+        return;
+    }
+
+    int size = SAKToolFloatAssistantDecoder::sampleSize(ctx.decoding.type);
+    if (ctx.decoding.stride && (ctx.decoding.stride < size)) {
+        QMessageBox::warning(this,
+                             tr("Stride"),
+                             tr("The stride must not be less than %1!").arg(size));
+        return;
+    }
+
+    ui->progressBar->setValue(0);
+    ui->progressBar->setFormat(QString("%p%"));
+    ui->statisticsLabel->clear();
+    ui->previewPlainTextEdit->clear();
+    mThread = new SAKToolFloatAssistantBulkThread(ctx, this);
+    connect(mThread, &SAKToolFloatAssistantBulkThread::progressChanged,
+            ui->progressBar, &QProgressBar::setValue);
+    connect(mThread, &SAKToolFloatAssistantBulkThread::previewDecoded,
+            this, &SAKToolFloatAssistantBulk::onPreviewDecoded);
+    connect(mThread, &SAKToolFloatAssistantBulkThread::statisticsCalculated,
+            this, &SAKToolFloatAssistantBulk::onStatisticsCalculated);
+    connect(mThread, &SAKToolFloatAssistantBulkThread::outputMessage,
+            this, &SAKToolFloatAssistantBulk::outputMessage);
+    connect(mThread, &QThread::finished,
+            this, &SAKToolFloatAssistantBulk::onThreadFinished);
+    mThread->start();
+    ui->decodePushButton->setText(tr("Stop"));
+    ui->exportPushButton->setEnabled(false);
+}
+
+void SAKToolFloatAssistantBulk::stopThread()
+{
+    if (mThread) {
+        mThread->blockSignals(true);
+        mThread->requestInterruption();
+        mThread->wait();
+        mThread->deleteLater();
+        mThread = Q_NULLPTR;
+    }
+}
+
+void SAKToolFloatAssistantBulk::onThreadFinished()
+{
+    stopThread();
+    ui->decodePushButton->setText(tr("Decode"));
+    ui->exportPushButton->setEnabled(true);
+}
+
+void SAKToolFloatAssistantBulk::onPreviewDecoded(QVector<double> samples)
+{
+    // Samples of float32 are shown with 9 digits, others are shown exactly.
+    bool isFloat32 = ui->typeComboBox->currentIndex()
+            == SAKToolFloatAssistantDecoder::SampleTypeFloat32;
+    QStringList lines;
+    for (int i = 0; i < samples.count(); i++) {
+        lines.append(QString("%1: %2").arg(i).arg(samples.at(i), 0, 'g',
+                                                  isFloat32 ? 9 : 17));
+    }
+    ui->previewPlainTextEdit->setPlainText(lines.join(QChar('\n')));
+}
+
+void SAKToolFloatAssistantBulk::onStatisticsCalculated(qint64 count,
+                                                       qint64 invalidCount,
+                                                       double min,
+                                                       double max,
+                                                       double mean,
+                                                       double standardDeviation)
+{
+    ui->statisticsLabel->setText(
+                tr("Count: %1, NaN/Inf: %2, Min: %3, Max: %4, Mean: %5, Std dev: %6")
+                .arg(count)
+                .arg(invalidCount)
+                .arg(min, 0, 'g', 9)
+                .arg(max, 0, 'g', 9)
+                .arg(mean, 0, 'g', 9)
+                .arg(standardDeviation, 0, 'g', 9));
+}
+
+void SAKToolFloatAssistantBulk::outputMessage(QString msg, bool isErrMsg)
+{
+    if (isErrMsg) {
+        QMessageBox::warning(this, tr("Bulk Decoding"), msg);
+    } else {
+        ui->progressBar->setFormat(msg);
+    }
+}
+
+void SAKToolFloatAssistantBulk::on_browsePushButton_clicked()
+{
+    QString fileName = QFileDialog::getOpenFileName(this,
+                                                    tr("Input file"),
+                                                    ui->fileLineEdit->text());
+    if (!fileName.isEmpty()) {
+        ui->fileLineEdit->setText(fileName);
+    }
+}
+
+void SAKToolFloatAssistantBulk::on_decodePushButton_clicked()
+{
+    if (mThread) {
+        onThreadFinished();
+        return;
+    }
+
+    startThread(QString());
+}
+
+void SAKToolFloatAssistantBulk::on_exportPushButton_clicked()
+{
+    QString fileName = QFileDialog::getSaveFileName(this,
+                                                    tr("Export CSV"),
+                                                    QString("samples.csv"),
+                                                    tr("CSV (*.csv)"));
+    if (!fileName.isEmpty()) {
+        startThread(fileName);
+    }
+}
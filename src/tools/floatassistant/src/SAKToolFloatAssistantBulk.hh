@@ -0,0 +1,48 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLFLOATASSISTANTBULK_HH
+#define SAKTOOLFLOATASSISTANTBULK_HH
+
+#include <QDialog>
+#include <QVector>
+
+namespace Ui {
+    class SAKToolFloatAssistantBulk;
+}
+class SAKToolFloatAssistantBulkThread;
+/// @brief Decode arrays of samples of a hex blob or a file.
+class SAKToolFloatAssistantBulk : public QDialog
+{
+    Q_OBJECT
+public:
+    SAKToolFloatAssistantBulk(QWidget *parent = Q_NULLPTR);
+    ~SAKToolFloatAssistantBulk();
+private:
+    Ui::SAKToolFloatAssistantBulk *ui;
+    SAKToolFloatAssistantBulkThread *mThread;
+private:
+    void startThread(const QString &csvFileName);
+    void stopThread();
+    void onThreadFinished();
+    void onPreviewDecoded(QVector<double> samples);
+    void onStatisticsCalculated(qint64 count,
+                                qint64 invalidCount,
+                                double min,
+                                double max,
+                                double mean,
+                                double standardDeviation);
+    void outputMessage(QString msg, bool isErrMsg);
+private slots:
+    void on_browsePushButton_clicked();
+    void on_decodePushButton_clicked();
+    void on_exportPushButton_clicked();
+};
+
+#endif // SAKTOOLFLOATASSISTANTBULK_HH
@@ -0,0 +1,140 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QFile>
+#include <QSaveFile>
+#include <QElapsedTimer>
+
+#include "SAKToolFloatAssistantBulkThread.hh"
+
+// Samples those are decoded at a time.
+#define SAK_SAMPLES_PER_BLOCK (64*1024)
+
+SAKToolFloatAssistantBulkThread::SAKToolFloatAssistantBulkThread(
+        const ParametersContext &ctx,
+        QObject *parent)
+    :QThread(parent)
+    ,mParameters(ctx)
+{
+
+}
+
+void SAKToolFloatAssistantBulkThread::run()
+{
+    QFile file(mParameters.fileName);
+    QByteArray bytes;
+    const char *data = Q_NULLPTR;
+    qint64 length = 0;
+    if (mParameters.fileName.isEmpty()) {
+        // Invalid characters such as spaces are skipped.
+        bytes = QByteArray::fromHex(mParameters.hexText.toLatin1());
+        data = bytes.constData();
+        length = bytes.length();
+    } else {
+        if (!file.open(QFile::ReadOnly)) {
+            emit outputMessage(file.errorString(), true);
+            return;
+        }
+
+        length = file.size();
+        data = reinterpret_cast<const char*>(file.map(0, length));
+        if (!data) {
+            bytes = file.readAll();
+            data = bytes.constData();
+            length = bytes.length();
+        }
+    }
+
+    const auto &decoding = mParameters.decoding;
+    const qint64 count = SAKToolFloatAssistantDecoder::sampleCount(length, decoding);
+    if (count <= 0) {
+        emit outputMessage(tr("No sample can be decoded!"), true);
+        return;
+    }
+
+    QSaveFile csvFile(mParameters.csvFileName);
+    if (!mParameters.csvFileName.isEmpty()) {
+        if (!csvFile.open(QFile::WriteOnly | QFile::Text)) {
+            emit outputMessage(csvFile.errorString(), true);
+            return;
+        }
+        csvFile.write("index,value\n");
+    }
+
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+    SAKToolFloatAssistantDecoder::SAKStructStatisticsContext statistics;
+    SAKToolFloatAssistantDecoder::statisticsInit(&statistics);
+    QVector<double> samples(int(qMin<qint64>(count, SAK_SAMPLES_PER_BLOCK)));
+    QByteArray lines;
+    int percent = -1;
+    for (qint64 first = 0; first < count; first += samples.count()) {
+        if (isInterruptionRequested()) {
+            csvFile.cancelWriting();
+            emit outputMessage(tr("Decoding is canceled."), false);
+            return;
+        }
+
+        int n = int(qMin<qint64>(count - first, samples.count()));
+        SAKToolFloatAssistantDecoder::decode(data, first, n, decoding, samples.data());
+        SAKToolFloatAssistantDecoder::statisticsUpdate(&statistics, samples.constData(), n);
+        if (first == 0) {
+            emit previewDecoded(samples.mid(0, qMin(n, mParameters.previewCount)));
+        }
+
+        if (csvFile.isOpen()) {
+            lines.clear();
+            for (int i = 0; i < n; i++) {
+                lines.append(QByteArray::number(first + i));
+                lines.append(',');
+                lines.append(sampleToText(samples.at(i)));
+                lines.append('\n');
+            }
+
+            if (csvFile.write(lines) != lines.length()) {
+                csvFile.cancelWriting();
+                emit outputMessage(csvFile.errorString(), true);
+                return;
+            }
+        }
+
+        int currentPercent = int((first + n)*100/count);
+        if (currentPercent != percent) {
+            percent = currentPercent;
+            emit progressChanged(percent);
+        }
+    }
+
+    if (csvFile.isOpen() && (!csvFile.commit())) {
+        emit outputMessage(csvFile.errorString(), true);
+        return;
+    }
+
+    emit statisticsCalculated(statistics.count,
+                              statistics.invalidCount,
+                              statistics.min,
+                              statistics.max,
+                              statistics.mean,
+                              SAKToolFloatAssistantDecoder::standardDeviation(statistics));
+    emit outputMessage(tr("%1 samples are decoded in %2 ms.")
+                       .arg(count).arg(elapsedTimer.elapsed()), false);
+}
+
+QByteArray SAKToolFloatAssistantBulkThread::sampleToText(double sample) const
+{
+    switch (mParameters.decoding.type) {
+    case SAKToolFloatAssistantDecoder::SampleTypeFloat32:
+        // 9 digits are enough to get the same float back.
+        return QByteArray::number(sample, 'g', 9);
+    case SAKToolFloatAssistantDecoder::SampleTypeFloat64:
+        return QByteArray::number(sample, 'g', 17);
+    default:
+        return QByteArray::number(qint64(sample));
+    }
+}
@@ -0,0 +1,57 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLFLOATASSISTANTBULKTHREAD_HH
+#define SAKTOOLFLOATASSISTANTBULKTHREAD_HH
+
+#include <QThread>
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+
+#include "SAKToolFloatAssistantDecoder.hh"
+
+/// @brief Decode the samples of a hex blob or a file in blocks, statistics
+/// are calculated and the samples can be exported to a csv file. The file is
+/// mapped, so large files are not read to memory.
+class SAKToolFloatAssistantBulkThread : public QThread
+{
+    Q_OBJECT
+public:
+    struct ParametersContext {
+        // The hex text is decoded if the file name is empty.
+        QString fileName;
+        QString hexText;
+        SAKToolFloatAssistantDecoder::SAKStructDecodingContext decoding;
+        // Samples are not exported if it is empty.
+        QString csvFileName;
+        // The number of the first samples to be shown.
+        int previewCount;
+    };
+
+    SAKToolFloatAssistantBulkThread(const ParametersContext &ctx,
+                                    QObject *parent = Q_NULLPTR);
+private:
+    ParametersContext mParameters;
+private:
+    void run() final;
+    QByteArray sampleToText(double sample) const;
+signals:
+    void outputMessage(QString msg, bool isErrMsg);
+    void progressChanged(int percent);
+    void previewDecoded(QVector<double> samples);
+    void statisticsCalculated(qint64 count,
+                              qint64 invalidCount,
+                              double min,
+                              double max,
+                              double mean,
+                              double standardDeviation);
+};
+
+#endif // SAKTOOLFLOATASSISTANTBULKTHREAD_HH
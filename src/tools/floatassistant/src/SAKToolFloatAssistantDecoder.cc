@@ -0,0 +1,194 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <cmath>
+#include <cstring>
+#include <QtEndian>
+
+#include "SAKToolFloatAssistantDecoder.hh"
+
+namespace {
+template<typename T>
+void swapToHost(T *buffer, int count, bool bigEndian)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+    // The array versions of Qt are vectorized, the buffer is converted in place.
+    if (bigEndian) {
+        qFromBigEndian<T>(buffer, count, buffer);
+    } else {
+        qFromLittleEndian<T>(buffer, count, buffer);
+    }
+#else
+    if (bigEndian == (QSysInfo::ByteOrder == QSysInfo::BigEndian)) {
+        return;
+    }
+
+    // The loop is simple enough to be vectorized by the compiler.
+    for (int i = 0; i < count; i++) {
+        buffer[i] = qbswap(buffer[i]);
+    }
+#endif
+}
+
+// T is the type of a sample, U is the unsigned integer which has the same size.
+template<typename T, typename U>
+void decodeSamples(const char *data,
+                   qint64 count,
+                   qint64 stride,
+                   bool bigEndian,
+                   double *samples)
+{
+    Q_STATIC_ASSERT(sizeof(T) == sizeof(U));
+    const int bufferSize = 1024;
+    U buffer[bufferSize];
+    while (count > 0) {
+        int n = int(qMin<qint64>(count, bufferSize));
+        if (stride == qint64(sizeof(U))) {
+            memcpy(buffer, data, size_t(n)*sizeof(U));
+        } else {
+            for (int i = 0; i < n; i++) {
+                memcpy(&buffer[i], data + i*stride, sizeof(U));
+            }
+        }
+
+        swapToHost<U>(buffer, n, bigEndian);
+        for (int i = 0; i < n; i++) {
+            T value;
+            memcpy(&value, &buffer[i], sizeof(T));
+            samples[i] = double(value);
+        }
+
+        data += n*stride;
+        samples += n;
+        count -= n;
+    }
+}
+}
+
+int SAKToolFloatAssistantDecoder::sampleSize(SAKEnumSampleType type)
+{
+    switch (type) {
+    case SampleTypeFloat32: return int(sizeof(float));
+    case SampleTypeFloat64: return int(sizeof(double));
+    case SampleTypeInt16: return int(sizeof(qint16));
+    case SampleTypeInt32: return int(sizeof(qint32));
+    }
+
+    return 1;
+}
+
+qint64 SAKToolFloatAssistantDecoder::sampleCount(qint64 length,
+                                                 const SAKStructDecodingContext &ctx)
+{
+    const qint64 size = sampleSize(ctx.type);
+    const qint64 stride = ctx.stride > 0 ? ctx.stride : size;
+    if ((ctx.offset < 0) || ((length - ctx.offset) < size)) {
+        return 0;
+    }
+
+    return (length - ctx.offset - size)/stride + 1;
+}
+
+void SAKToolFloatAssistantDecoder::decode(const char *data,
+                                          qint64 first,
+                                          qint64 count,
+                                          const SAKStructDecodingContext &ctx,
+                                          double *samples)
+{
+    const qint64 stride = ctx.stride > 0 ? ctx.stride : sampleSize(ctx.type);
+    data += ctx.offset + first*stride;
+    switch (ctx.type) {
+    case SampleTypeFloat32:
+        decodeSamples<float, quint32>(data, count, stride, ctx.bigEndian, samples);
+        break;
+    case SampleTypeFloat64:
+        decodeSamples<double, quint64>(data, count, stride, ctx.bigEndian, samples);
+        break;
+    case SampleTypeInt16:
+        decodeSamples<qint16, quint16>(data, count, stride, ctx.bigEndian, samples);
+        break;
+    case SampleTypeInt32:
+        decodeSamples<qint32, quint32>(data, count, stride, ctx.bigEndian, samples);
+        break;
+    }
+}
+
+void SAKToolFloatAssistantDecoder::statisticsInit(SAKStructStatisticsContext *ctx)
+{
+    ctx->count = 0;
+    ctx->invalidCount = 0;
+    ctx->min = 0;
+    ctx->max = 0;
+    ctx->mean = 0;
+    ctx->m2 = 0;
+}
+
+void SAKToolFloatAssistantDecoder::statisticsUpdate(SAKStructStatisticsContext *ctx,
+                                                    const double *samples,
+                                                    qint64 count)
+{
+    // The mean of the block is calculated first, then the block is merged,
+    // it is more accurate than updating the mean sample by sample.
+    qint64 n = 0;
+    double sum = 0;
+    double min = 0;
+    double max = 0;
+    for (qint64 i = 0; i < count; i++) {
+        double value = samples[i];
+        if (!std::isfinite(value)) {
+            continue;
+        }
+
+        if (n == 0) {
+            min = value;
+            max = value;
+        } else {
+            min = qMin(min, value);
+            max = qMax(max, value);
+        }
+        sum += value;
+        n += 1;
+    }
+
+    ctx->invalidCount += count - n;
+    if (n == 0) {
+        return;
+    }
+
+    double mean = sum/n;
+    double m2 = 0;
+    for (qint64 i = 0; i < count; i++) {
+        if (std::isfinite(samples[i])) {
+            double delta = samples[i] - mean;
+            m2 += delta*delta;
+        }
+    }
+
+    if (ctx->count == 0) {
+        ctx->min = min;
+        ctx->max = max;
+        ctx->mean = mean;
+        ctx->m2 = m2;
+        ctx->count = n;
+        return;
+    }
+
+    double total = double(ctx->count + n);
+    double delta = mean - ctx->mean;
+    ctx->min = qMin(ctx->min, min);
+    ctx->max = qMax(ctx->max, max);
+    ctx->mean += delta*n/total;
+    ctx->m2 += m2 + delta*delta*ctx->count*n/total;
+    ctx->count += n;
+}
+
+double SAKToolFloatAssistantDecoder::standardDeviation(const SAKStructStatisticsContext &ctx)
+{
+    return ctx.count > 1 ? std::sqrt(ctx.m2/(ctx.count - 1)) : 0;
+}
@@ -0,0 +1,82 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLFLOATASSISTANTDECODER_HH
+#define SAKTOOLFLOATASSISTANTDECODER_HH
+
+#include <QtGlobal>
+
+/// @brief Decode arrays of samples from raw bytes, such as the samples of a
+/// sensor those are captured from frames. Samples are gathered to a buffer and
+/// the byte order of the buffer is converted at once, which is vectorized.
+class SAKToolFloatAssistantDecoder
+{
+public:
+    enum SAKEnumSampleType {
+        SampleTypeFloat32,
+        SampleTypeFloat64,
+        SampleTypeInt16,
+        SampleTypeInt32
+    };
+
+    struct SAKStructDecodingContext {
+        SAKEnumSampleType type;
+        bool bigEndian;
+        // Bytes those are skipped before the first sample.
+        qint64 offset;
+        // Bytes from a sample to the next one, 0 means the samples are packed.
+        qint64 stride;
+    };
+
+    struct SAKStructStatisticsContext {
+        // The number of finite samples.
+        qint64 count;
+        // The number of nan and infinite samples, they are not counted.
+        qint64 invalidCount;
+        double min;
+        double max;
+        double mean;
+        // Sum of squares of differences from the mean.
+        double m2;
+    };
+
+    static int sampleSize(SAKEnumSampleType type);
+
+    /**
+     * @brief sampleCount: Get the number of samples those can be decoded.
+     * @param length: Bytes of the data.
+     * @param ctx: Decoding parameters.
+     * @return The number of samples.
+     */
+    static qint64 sampleCount(qint64 length, const SAKStructDecodingContext &ctx);
+
+    /**
+     * @brief decode: Decode continuous samples.
+     * @param data: The whole data, the offset of ctx is not skipped.
+     * @param first: Index of the first sample to be decoded.
+     * @param count: Number of samples, first + count must not be greater than
+     * sampleCount().
+     * @param ctx: Decoding parameters.
+     * @param samples: Decoded samples, count samples are stored.
+     */
+    static void decode(const char *data,
+                       qint64 first,
+                       qint64 count,
+                       const SAKStructDecodingContext &ctx,
+                       double *samples);
+
+    // Calculate statistics of samples, the samples can be fed in blocks.
+    static void statisticsInit(SAKStructStatisticsContext *ctx);
+    static void statisticsUpdate(SAKStructStatisticsContext *ctx,
+                                 const double *samples,
+                                 qint64 count);
+    static double standardDeviation(const SAKStructStatisticsContext &ctx);
+};
+
+#endif // SAKTOOLFLOATASSISTANTDECODER_HH
@@ -36,15 +36,25 @@ contains(DEFINES, SAK_IMPORT_MODULE_QRCODE){
 
 contains(DEFINES, SAK_IMPORT_MODULE_QRCODE){
     FORMS += \
-    $$PWD/src/SAKToolQRCodeCreator.ui
+    $$PWD/src/SAKToolQRCodeCreator.ui \
+    $$PWD/src/SAKToolQRCodeCreatorBatch.ui
 
     HEADERS += \
         $$PWD/src/SAKQRCode.hh \
-    $$PWD/src/SAKToolQRCodeCreator.hh
+    $$PWD/src/SAKToolQRCodeCreator.hh \
+    $$PWD/src/SAKToolQRCodeCreatorBatch.hh \
+    $$PWD/src/SAKToolQRCodeCreatorBatchThread.hh \
+    $$PWD/src/SAKToolQRCodeCreatorEncoder.hh
 
     SOURCES += \
         $$PWD/src/SAKQRCode.cc \
-    $$PWD/src/SAKToolQRCodeCreator.cc
+    $$PWD/src/SAKToolQRCodeCreator.cc \
+    $$PWD/src/SAKToolQRCodeCreatorBatch.cc \
+    $$PWD/src/SAKToolQRCodeCreatorBatchThread.cc \
+    $$PWD/src/SAKToolQRCodeCreatorEncoder.cc
+
+    # libqrencode is thread safe with pthread, see config.h
+    unix:LIBS += -lpthread
 
     HEADERS += \
         $$PWD/src/config.h
@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2018-2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2018-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -46,6 +46,5 @@ void SAKQRCode::paintEvent(QPaintEvent *event)
    /// @brief 绘制二维码
    QPainter painter(this);
    QRect qrCodeRect = QRect(qrCodeLeftMargin, qrCodeTopMargin, innerPixmap.height(), innerPixmap.height());
-   innerPixmap = innerPixmap.scaledToHeight(qrCodeRect.height());
    painter.drawPixmap(qrCodeRect, innerPixmap);
 }
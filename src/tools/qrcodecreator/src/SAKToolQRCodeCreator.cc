@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2020-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -15,10 +15,8 @@
 
 #include "SAKQRCode.hh"
 #include "SAKToolQRCodeCreator.hh"
-
-extern "C" {
-    #include "qrencode.h"
-}
+#include "SAKToolQRCodeCreatorBatch.hh"
+#include "SAKToolQRCodeCreatorEncoder.hh"
 
 #include "ui_SAKToolQRCodeCreator.h"
 
@@ -47,48 +45,14 @@ SAKToolQRCodeCreator::~SAKToolQRCodeCreator()
 
 QPixmap SAKToolQRCodeCreator::encodeString(const QString &text, int width)
 {
-    if (text.length() == 0){
+    // The text is encoded as utf8, so that non-latin text is not corrupted.
+    QImage image = SAKToolQRCodeCreatorEncoder::encode(text,
+                                                       SAKToolQRCodeCreatorEncoder::LevelL);
+    if (image.isNull()) {
         return QPixmap();
     }
 
-    QRcode *qrcode = QRcode_encodeString(text.toLatin1().constData(), 0, QR_ECLEVEL_L, QR_MODE_8, 0);
-    if (qrcode == Q_NULLPTR) {
-        return QPixmap();
-    }
-
-    unsigned char *p = Q_NULLPTR;
-    unsigned char *q = Q_NULLPTR;
-    int realwidth = qrcode->width;
-    int x, y, bit;
-
-    QImage image = QImage(realwidth, realwidth, QImage::Format_Indexed8);
-    image.fill(qRgb(255, 255, 255));
-
-    QRgb black = qRgb(255, 255, 255);
-    image.setColor(0, black);
-    QRgb white = qRgb(0, 0, 0);
-    image.setColor(1, white);
-
-    p = qrcode->data;
-    for (y = 0; y < qrcode->width; y++) {
-        bit = 7;
-        for (x = 0; x< qrcode->width; x++) {
-            if ((*p & 1) << bit){
-                image.setPixel(x, y, 1);
-            } else {
-                image.setPixel(x, y, 0);
-            }
-            bit--;
-            if (bit < 0){
-                q++;
-                bit = 7;
-            }
-            p++;
-        }
-    }
-
-    QRcode_free(qrcode);
-    return QPixmap::fromImage(image.scaledToWidth(width));
+    return QPixmap::fromImage(image.scaledToWidth(width, Qt::FastTransformation));
 }
 
 void SAKToolQRCodeCreator::on_savePushButton_clicked()
@@ -116,3 +80,10 @@ void SAKToolQRCodeCreator::on_createPushButton_clicked()
     QPixmap pix = encodeString(plainTextEdit->toPlainText(), 100);
     qrCodeWidget->updateQRCode(pix);
 }
+
+void SAKToolQRCodeCreator::on_batchPushButton_clicked()
+{
+    auto dialog = new SAKToolQRCodeCreatorBatch(this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->show();
+}
@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2020-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -44,6 +44,7 @@ private:
 private slots:
     void on_savePushButton_clicked();
     void on_createPushButton_clicked();
+    void on_batchPushButton_clicked();
 };
 
 #endif
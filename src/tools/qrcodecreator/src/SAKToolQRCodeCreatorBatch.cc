@@ -0,0 +1,287 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QSet>
+#include <QFile>
+#include <QPixmap>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QTextStream>
+
+#include "SAKToolQRCodeCreatorBatch.hh"
+#include "SAKToolQRCodeCreatorBatchThread.hh"
+#include "ui_SAKToolQRCodeCreatorBatch.h"
+
+SAKToolQRCodeCreatorBatch::SAKToolQRCodeCreatorBatch(QWidget *parent)
+    :QDialog(parent)
+    ,ui(new Ui::SAKToolQRCodeCreatorBatch)
+    ,mThread(Q_NULLPTR)
+{
+    ui->setupUi(this);
+}
+
+SAKToolQRCodeCreatorBatch::~SAKToolQRCodeCreatorBatch()
+{
+    stopThread();
+    delete ui;
+}
+
+QStringList SAKToolQRCodeCreatorBatch::texts() const
+{
+    QStringList list;
+    int column = ui->columnSpinBox->value();
+    QStringList lines = ui->inputPlainTextEdit->toPlainText().split(QChar('\n'));
+    for (auto &var : lines) {
+        QString text = column > 0 ? csvField(var, column - 1) : var;
+        if (!text.trimmed().isEmpty()) {
+            list.append(text);
+        }
+    }
+
+    return list;
+}
+
+QString SAKToolQRCodeCreatorBatch::csvField(const QString &line, int column) const
+{
+    // Fields are separated by ',', a field which is quoted by '"' can contain
+    // ',' and "" means a '"'.
+    QString field;
+    int index = 0;
+    bool isQuoted = false;
+    for (int i = 0; i < line.length(); i++) {
+        QChar ch = line.at(i);
+        if (isQuoted) {
+            if (ch != QChar('"')) {
+                field.append(ch);
+            } else if ((i + 1 < line.length()) && (line.at(i + 1) == QChar('"'))) {
+                field.append(ch);
+                i += 1;
+            } else {
+                isQuoted = false;
+            }
+        } else if (ch == QChar('"')) {
+            isQuoted = true;
+        } else if (ch == QChar(',')) {
+            if (index == column) {
+                return field;
+            }
+
+            index += 1;
+            field.clear();
+        } else {
+            field.append(ch);
+        }
+    }
+
+    return index == column ? field : QString();
+}
+
+QString SAKToolQRCodeCreatorBatch::cacheKey(const QString &text, int level) const
+{
+    return QString::number(level) + QChar(':') + text;
+}
+
+void SAKToolQRCodeCreatorBatch::stopThread()
+{
+    if (mThread) {
+        mThread->blockSignals(true);
+        mThread->requestInterruption();
+        mThread->wait();
+        mThread->deleteLater();
+        mThread = Q_NULLPTR;
+    }
+}
+
+void SAKToolQRCodeCreatorBatch::onThreadFinished()
+{
+    int level = ui->levelComboBox->currentIndex();
+    QVector<QImage> codes = mThread->codes();
+    for (int i = 0; i < codes.count(); i++) {
+        mCache.insert(cacheKey(mEncodingTexts.at(i), level), codes.at(i));
+    }
+
+    stopThread();
+    ui->encodePushButton->setText(tr("Encode"));
+    showCodes(mElapsedTimer.elapsed());
+}
+
+void SAKToolQRCodeCreatorBatch::showCodes(qint64 elapsed)
+{
+    int level = ui->levelComboBox->currentIndex();
+    int failedCount = 0;
+    mCodes.clear();
+    ui->previewListWidget->clear();
+    QSize iconSize = ui->previewListWidget->iconSize();
+    for (auto &var : mTexts) {
+        QImage code = mCache.value(cacheKey(var, level));
+        failedCount += code.isNull() ? 1 : 0;
+        mCodes.append(code);
+
+        auto item = new QListWidgetItem(var, ui->previewListWidget);
+        if (!code.isNull()) {
+            item->setIcon(QPixmap::fromImage(code.scaled(iconSize,
+                                                         Qt::KeepAspectRatio,
+                                                         Qt::FastTransformation)));
+        }
+    }
+
+    QString status = tr("%1 codes are encoded in %2 ms (%3 codes/s), %4 codes are got from cache.")
+            .arg(mEncodingTexts.count())
+            .arg(elapsed)
+            .arg(elapsed ? mEncodingTexts.count()*1000/elapsed : mEncodingTexts.count())
+            .arg(mTexts.count() - mEncodingTexts.count());
+    if (failedCount) {
+        status.append(tr(" %1 texts can not be encoded!").arg(failedCount));
+    }
+    ui->statusLabel->setText(status);
+    ui->pngPushButton->setEnabled(!mCodes.isEmpty());
+    ui->svgPushButton->setEnabled(!mCodes.isEmpty());
+}
+
+SAKToolQRCodeCreatorEncoder::SAKStructSheetContext
+SAKToolQRCodeCreatorBatch::sheetContext() const
+{
+    SAKToolQRCodeCreatorEncoder::SAKStructSheetContext ctx;
+    ctx.columns = ui->columnsSpinBox->value();
+    ctx.rows = ui->rowsSpinBox->value();
+    ctx.moduleSize = ui->moduleSizeSpinBox->value();
+    ctx.margin = 4;
+    ctx.showLabel = ui->labelCheckBox->isChecked();
+    return ctx;
+}
+
+void SAKToolQRCodeCreatorBatch::exportSheets(bool isSvg)
+{
+    QString fileName = QFileDialog::getSaveFileName(
+                this,
+                tr("Export sheets"),
+                isSvg ? QString("sheet.svg") : QString("sheet.png"),
+                isSvg ? QString("SVG(*.svg)") : QString("PNG(*.png)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    // The sheets are saved as "sheet_1.png", "sheet_2.png"... if there are
+    // more qr codes than a sheet can hold.
+    auto ctx = sheetContext();
+    const int codesPerSheet = ctx.columns*ctx.rows;
+    const int sheetCount = (mCodes.count() + codesPerSheet - 1)/codesPerSheet;
+    QFileInfo fileInfo(fileName);
+    for (int i = 0; i < sheetCount; i++) {
+        QString sheetFileName = fileName;
+        if (sheetCount > 1) {
+            sheetFileName = fileInfo.absolutePath()
+                    + QString("/%1_%2.%3").arg(fileInfo.completeBaseName())
+                    .arg(i + 1)
+                    .arg(isSvg ? QString("svg") : QString("png"));
+        }
+
+        QVector<QImage> codes = mCodes.mid(i*codesPerSheet, codesPerSheet);
+        QStringList labels = mTexts.mid(i*codesPerSheet, codesPerSheet);
+        bool ok = false;
+        if (isSvg) {
+            QSaveFile file(sheetFileName);
+            if (file.open(QFile::WriteOnly)) {
+                file.write(SAKToolQRCodeCreatorEncoder::renderSvgSheet(codes, labels, ctx));
+                ok = file.commit();
+            }
+        } else {
+            QImage sheet = SAKToolQRCodeCreatorEncoder::renderSheet(codes, labels, ctx);
+            ok = sheet.save(sheetFileName, "PNG");
+        }
+
+        if (!ok) {
+            QMessageBox::warning(this,
+                                 tr("Export sheets"),
+                                 tr("Can not write the file: %1").arg(sheetFileName));
+            return;
+        }
+    }
+
+    ui->statusLabel->setText(tr("%1 sheets are exported.").arg(sheetCount));
+}
+
+void SAKToolQRCodeCreatorBatch::on_importPushButton_clicked()
+{
+    QString fileName = QFileDialog::getOpenFileName(this,
+                                                    tr("Import"),
+                                                    QString(),
+                                                    QString("CSV(*.csv);;Text(*.txt);;All(*)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+        QMessageBox::warning(this, tr("Import"), file.errorString());
+        return;
+    }
+
+    QTextStream textStream(&file);
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    textStream.setCodec("UTF-8");
+#endif
+    ui->inputPlainTextEdit->setPlainText(textStream.readAll());
+}
+
+void SAKToolQRCodeCreatorBatch::on_encodePushButton_clicked()
+{
+    if (mThread) {
+        stopThread();
+        ui->encodePushButton->setText(tr("Encode"));
+        return;
+    }
+
+    mTexts = texts();
+    if (mTexts.isEmpty()) {
+        QMessageBox::warning(this, tr("Encode"), tr("Nothing to be encoded!"));
+        return;
+    }
+
+    // The duplicated texts and the cached texts are not encoded.
+    int level = ui->levelComboBox->currentIndex();
+    QSet<QString> texts;
+    mEncodingTexts.clear();
+    for (auto &var : mTexts) {
+        if ((!mCache.contains(cacheKey(var, level))) && (!texts.contains(var))) {
+            texts.insert(var);
+            mEncodingTexts.append(var);
+        }
+    }
+
+    mCodes.clear();
+    ui->pngPushButton->setEnabled(false);
+    ui->svgPushButton->setEnabled(false);
+    mElapsedTimer.start();
+    if (mEncodingTexts.isEmpty()) {
+        showCodes(0);
+        return;
+    }
+
+    ui->progressBar->setValue(0);
+    mThread = new SAKToolQRCodeCreatorBatchThread(mEncodingTexts, level, this);
+    connect(mThread, &SAKToolQRCodeCreatorBatchThread::progressChanged,
+            ui->progressBar, &QProgressBar::setValue);
+    connect(mThread, &QThread::finished,
+            this, &SAKToolQRCodeCreatorBatch::onThreadFinished);
+    mThread->start();
+    ui->encodePushButton->setText(tr("Stop"));
+}
+
+void SAKToolQRCodeCreatorBatch::on_pngPushButton_clicked()
+{
+    exportSheets(false);
+}
+
+void SAKToolQRCodeCreatorBatch::on_svgPushButton_clicked()
+{
+    exportSheets(true);
+}
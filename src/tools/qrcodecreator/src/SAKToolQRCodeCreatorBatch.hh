@@ -0,0 +1,61 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLQRCODECREATORBATCH_HH
+#define SAKTOOLQRCODECREATORBATCH_HH
+
+#include <QHash>
+#include <QImage>
+#include <QDialog>
+#include <QVector>
+#include <QStringList>
+#include <QElapsedTimer>
+
+#include "SAKToolQRCodeCreatorEncoder.hh"
+
+namespace Ui {
+    class SAKToolQRCodeCreatorBatch;
+}
+class SAKToolQRCodeCreatorBatchThread;
+/// @brief Encode lines of a list or a csv file to qr codes and export them as
+/// sheets, such as labels of devices. The qr codes are cached, a text is not
+/// encoded again if it has been encoded with the same level.
+class SAKToolQRCodeCreatorBatch : public QDialog
+{
+    Q_OBJECT
+public:
+    SAKToolQRCodeCreatorBatch(QWidget *parent = Q_NULLPTR);
+    ~SAKToolQRCodeCreatorBatch();
+private:
+    Ui::SAKToolQRCodeCreatorBatch *ui;
+    SAKToolQRCodeCreatorBatchThread *mThread;
+    // The key is made up of the level and the text, see cacheKey().
+    QHash<QString, QImage> mCache;
+    QStringList mTexts;
+    // The texts those are not cached, they are being encoded.
+    QStringList mEncodingTexts;
+    QVector<QImage> mCodes;
+    QElapsedTimer mElapsedTimer;
+private:
+    QStringList texts() const;
+    QString csvField(const QString &line, int column) const;
+    QString cacheKey(const QString &text, int level) const;
+    void stopThread();
+    void onThreadFinished();
+    void showCodes(qint64 elapsed);
+    SAKToolQRCodeCreatorEncoder::SAKStructSheetContext sheetContext() const;
+    void exportSheets(bool isSvg);
+private slots:
+    void on_importPushButton_clicked();
+    void on_encodePushButton_clicked();
+    void on_pngPushButton_clicked();
+    void on_svgPushButton_clicked();
+};
+
+#endif // SAKTOOLQRCODECREATORBATCH_HH
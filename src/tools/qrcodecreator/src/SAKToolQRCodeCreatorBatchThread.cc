@@ -0,0 +1,116 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QRunnable>
+#include <QSemaphore>
+#include <QAtomicInt>
+#include <QThreadPool>
+
+#include "SAKToolQRCodeCreatorEncoder.hh"
+#include "SAKToolQRCodeCreatorBatchThread.hh"
+
+namespace {
+class SAKToolQRCodeCreatorBatchTask : public QRunnable
+{
+public:
+    SAKToolQRCodeCreatorBatchTask(const QStringList *texts,
+                                  int level,
+                                  QImage *codes,
+                                  QAtomicInt *nextIndex,
+                                  QAtomicInt *encodedCount,
+                                  QThread *thread,
+                                  QSemaphore *semaphore)
+        :mTexts(texts)
+        ,mLevel(level)
+        ,mCodes(codes)
+        ,mNextIndex(nextIndex)
+        ,mEncodedCount(encodedCount)
+        ,mThread(thread)
+        ,mSemaphore(semaphore)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() final
+    {
+        const int count = mTexts->count();
+        while (!mThread->isInterruptionRequested()) {
+            int index = mNextIndex->fetchAndAddOrdered(1);
+            if (index >= count) {
+                break;
+            }
+
+            mCodes[index] = SAKToolQRCodeCreatorEncoder::encode(mTexts->at(index), mLevel);
+            mEncodedCount->fetchAndAddOrdered(1);
+        }
+        mSemaphore->release();
+    }
+private:
+    const QStringList *mTexts;
+    int mLevel;
+    QImage *mCodes;
+    QAtomicInt *mNextIndex;
+    QAtomicInt *mEncodedCount;
+    QThread *mThread;
+    QSemaphore *mSemaphore;
+};
+}
+
+SAKToolQRCodeCreatorBatchThread::SAKToolQRCodeCreatorBatchThread(
+        const QStringList &texts,
+        int level,
+        QObject *parent)
+    :QThread(parent)
+    ,mTexts(texts)
+    ,mLevel(level)
+{
+
+}
+
+QVector<QImage> SAKToolQRCodeCreatorBatchThread::codes() const
+{
+    return mCodes;
+}
+
+void SAKToolQRCodeCreatorBatchThread::run()
+{
+    const int count = mTexts.count();
+    mCodes = QVector<QImage>(count);
+    if (count == 0) {
+        return;
+    }
+
+    QAtomicInt nextIndex(0);
+    QAtomicInt encodedCount(0);
+    QSemaphore semaphore;
+    QImage *codes = mCodes.data();
+    int taskCount = qBound(1, QThreadPool::globalInstance()->maxThreadCount(), count);
+    for (int i = 0; i < taskCount; i++) {
+        QThreadPool::globalInstance()->start(
+                    new SAKToolQRCodeCreatorBatchTask(&mTexts,
+                                                      mLevel,
+                                                      codes,
+                                                      &nextIndex,
+                                                      &encodedCount,
+                                                      this,
+                                                      &semaphore));
+    }
+
+    // The tasks are waited for even if the thread is interrupted, they are
+    // using the data of the thread.
+    int percent = -1;
+    while (!semaphore.tryAcquire(taskCount, 100)) {
+        int currentPercent = encodedCount.loadAcquire()*100/count;
+        if (currentPercent != percent) {
+            percent = currentPercent;
+            emit progressChanged(percent);
+        }
+    }
+    emit progressChanged(100);
+}
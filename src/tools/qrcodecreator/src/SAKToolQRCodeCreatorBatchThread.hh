@@ -0,0 +1,44 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLQRCODECREATORBATCHTHREAD_HH
+#define SAKTOOLQRCODECREATORBATCHTHREAD_HH
+
+#include <QImage>
+#include <QThread>
+#include <QVector>
+#include <QStringList>
+
+/// @brief Encode texts to qr codes, the texts are encoded by the threads of
+/// the global thread pool, a thread takes the next text when it is free.
+class SAKToolQRCodeCreatorBatchThread : public QThread
+{
+    Q_OBJECT
+public:
+    SAKToolQRCodeCreatorBatchThread(const QStringList &texts,
+                                    int level,
+                                    QObject *parent = Q_NULLPTR);
+
+    /**
+     * @brief codes: Get the qr codes, it is valid after the thread is finished.
+     * @return The qr codes of the texts, the qr code of a text which can not be
+     * encoded is null.
+     */
+    QVector<QImage> codes() const;
+private:
+    QStringList mTexts;
+    int mLevel;
+    QVector<QImage> mCodes;
+private:
+    void run() final;
+signals:
+    void progressChanged(int percent);
+};
+
+#endif // SAKTOOLQRCODECREATORBATCHTHREAD_HH
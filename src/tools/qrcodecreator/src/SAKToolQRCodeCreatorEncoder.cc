@@ -0,0 +1,202 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <cstring>
+#include <QFont>
+#include <QMutex>
+#include <QPainter>
+#include <QFontMetrics>
+
+#include "config.h"
+#include "SAKToolQRCodeCreatorEncoder.hh"
+
+extern "C" {
+    #include "qrencode.h"
+}
+
+// Pixels of a label.
+#define SAK_LABEL_FONT_SIZE 12
+
+QImage SAKToolQRCodeCreatorEncoder::encode(const QString &text, int level)
+{
+    if (text.isEmpty()) {
+        return QImage();
+    }
+
+#ifndef HAVE_LIBPTHREAD
+    // The tables of libqrencode are initialized lazily without lock.
+    static QMutex mutex;
+    QMutexLocker locker(&mutex);
+#endif
+    // The text is case sensitive, or lower case letters are encoded as upper
+    // case letters.
+    QByteArray utf8 = text.toUtf8();
+    QRcode *qrcode = QRcode_encodeString(utf8.constData(),
+                                         0,
+                                         static_cast<QRecLevel>(level),
+                                         QR_MODE_8,
+                                         1);
+#ifndef HAVE_LIBPTHREAD
+    locker.unlock();
+#endif
+    if (!qrcode) {
+        return QImage();
+    }
+
+    // The lowest bit of a module of libqrencode is 1 if the module is black.
+    const int width = qrcode->width;
+    QImage image(width, width, QImage::Format_Mono);
+    image.setColor(0, qRgb(255, 255, 255));
+    image.setColor(1, qRgb(0, 0, 0));
+    const unsigned char *p = qrcode->data;
+    for (int y = 0; y < width; y++) {
+        uchar *line = image.scanLine(y);
+        memset(line, 0, size_t(image.bytesPerLine()));
+        for (int x = 0; x < width; x++) {
+            if (p[x] & 1) {
+                line[x >> 3] |= uchar(0x80 >> (x & 7));
+            }
+        }
+        p += width;
+    }
+
+    QRcode_free(qrcode);
+    return image;
+}
+
+QImage SAKToolQRCodeCreatorEncoder::renderSheet(const QVector<QImage> &codes,
+                                                const QStringList &labels,
+                                                const SAKStructSheetContext &ctx)
+{
+    const int cell = cellSize(codes, ctx);
+    const int labelPixels = labelHeight(ctx);
+    QImage sheet(cell*ctx.columns,
+                 (cell + labelPixels)*ctx.rows,
+                 QImage::Format_RGB32);
+    sheet.fill(Qt::white);
+
+    QPainter painter(&sheet);
+    QFont font = painter.font();
+    font.setPixelSize(SAK_LABEL_FONT_SIZE);
+    painter.setFont(font);
+    QFontMetrics fontMetrics(font);
+    for (int i = 0; i < codes.count(); i++) {
+        const QImage &code = codes.at(i);
+        int left = (i % ctx.columns)*cell;
+        int top = (i/ctx.columns)*(cell + labelPixels);
+        if (!code.isNull()) {
+            // The qr code is centered, without smoothing.
+            int size = code.width()*ctx.moduleSize;
+            painter.drawImage(QRect(left + (cell - size)/2,
+                                    top + (cell - size)/2,
+                                    size,
+                                    size),
+                              code);
+        }
+
+        if (ctx.showLabel && (i < labels.count())) {
+            QString label = fontMetrics.elidedText(labels.at(i), Qt::ElideMiddle, cell);
+            painter.drawText(QRect(left, top + cell, cell, labelPixels),
+                             Qt::AlignHCenter | Qt::AlignTop,
+                             label);
+        }
+    }
+
+    return sheet;
+}
+
+QByteArray SAKToolQRCodeCreatorEncoder::renderSvgSheet(const QVector<QImage> &codes,
+                                                       const QStringList &labels,
+                                                       const SAKStructSheetContext &ctx)
+{
+    const int cell = cellSize(codes, ctx);
+    const int labelPixels = labelHeight(ctx);
+    const int width = cell*ctx.columns;
+    const int height = (cell + labelPixels)*ctx.rows;
+    const int moduleSize = ctx.moduleSize;
+
+    QByteArray svg;
+    svg.append(QString("<svg xmlns=\"http://www.w3.org/2000/svg\" "
+                       "width=\"%1\" height=\"%2\" viewBox=\"0 0 %1 %2\" "
+                       "shape-rendering=\"crispEdges\">\n")
+               .arg(width).arg(height).toUtf8());
+    svg.append("<rect width=\"100%\" height=\"100%\" fill=\"#ffffff\"/>\n");
+
+    // Continuous black modules of a row are drawn as a rectangle.
+    QByteArray path;
+    QStringList texts;
+    for (int i = 0; i < codes.count(); i++) {
+        const QImage &code = codes.at(i);
+        int left = (i % ctx.columns)*cell;
+        int top = (i/ctx.columns)*(cell + labelPixels);
+        if (!code.isNull()) {
+            int size = code.width()*moduleSize;
+            int x0 = left + (cell - size)/2;
+            int y0 = top + (cell - size)/2;
+            for (int y = 0; y < code.height(); y++) {
+                const uchar *line = code.constScanLine(y);
+                int x = 0;
+                while (x < code.width()) {
+                    if (!(line[x >> 3] & (0x80 >> (x & 7)))) {
+                        x += 1;
+                        continue;
+                    }
+
+                    int start = x;
+                    while ((x < code.width()) && (line[x >> 3] & (0x80 >> (x & 7)))) {
+                        x += 1;
+                    }
+                    path.append(QString("M%1 %2h%3v%4h-%3z")
+                                .arg(x0 + start*moduleSize)
+                                .arg(y0 + y*moduleSize)
+                                .arg((x - start)*moduleSize)
+                                .arg(moduleSize)
+                                .toLatin1());
+                }
+            }
+        }
+
+        if (ctx.showLabel && (i < labels.count())) {
+            texts.append(QString("<text x=\"%1\" y=\"%2\">%3</text>")
+                         .arg(left + cell/2)
+                         .arg(top + cell + SAK_LABEL_FONT_SIZE)
+                         .arg(labels.at(i).toHtmlEscaped()));
+        }
+    }
+
+    svg.append("<path fill=\"#000000\" d=\"");
+    svg.append(path);
+    svg.append("\"/>\n");
+    if (texts.count()) {
+        svg.append(QString("<g font-family=\"sans-serif\" font-size=\"%1\" "
+                           "text-anchor=\"middle\" fill=\"#000000\">\n")
+                   .arg(SAK_LABEL_FONT_SIZE).toUtf8());
+        svg.append(texts.join(QChar('\n')).toUtf8());
+        svg.append("\n</g>\n");
+    }
+    svg.append("</svg>\n");
+    return svg;
+}
+
+int SAKToolQRCodeCreatorEncoder::cellSize(const QVector<QImage> &codes,
+                                          const SAKStructSheetContext &ctx)
+{
+    // Qr codes of different versions are placed in cells of the same size.
+    int modules = 0;
+    for (auto &var : codes) {
+        modules = qMax(modules, var.width());
+    }
+
+    return (modules + 2*ctx.margin)*ctx.moduleSize;
+}
+
+int SAKToolQRCodeCreatorEncoder::labelHeight(const SAKStructSheetContext &ctx)
+{
+    return ctx.showLabel ? SAK_LABEL_FONT_SIZE*2 : 0;
+}
@@ -0,0 +1,79 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLQRCODECREATORENCODER_HH
+#define SAKTOOLQRCODECREATORENCODER_HH
+
+#include <QImage>
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+#include <QStringList>
+
+/// @brief Encode text to qr codes and render sheets of qr codes. A qr code is
+/// a mono image which has a pixel for a module, it is scaled without smoothing
+/// when it is drawn, so the modules are rendered once only.
+class SAKToolQRCodeCreatorEncoder
+{
+public:
+    // Error correction levels, the values are the same as QRecLevel.
+    enum SAKEnumLevel {
+        LevelL,
+        LevelM,
+        LevelQ,
+        LevelH
+    };
+
+    struct SAKStructSheetContext {
+        int columns;
+        int rows;
+        // Pixels of a module.
+        int moduleSize;
+        // Modules of the quiet zone around a qr code.
+        int margin;
+        // Print the text under the qr code.
+        bool showLabel;
+    };
+
+    /**
+     * @brief encode: Encode the text as utf8 bytes. It can be called by
+     * several threads at the same time.
+     * @param text: Text to be encoded.
+     * @param level: See SAKEnumLevel.
+     * @return A pixel for a module, null image is returned if failed.
+     */
+    static QImage encode(const QString &text, int level);
+
+    /**
+     * @brief renderSheet: Render qr codes to an image, the qr codes are placed
+     * from left to right, then from top to bottom.
+     * @param codes: Qr codes those are returned by encode(), they must not be
+     * more than ctx.columns*ctx.rows.
+     * @param labels: Texts of the qr codes.
+     * @param ctx: Layout of the sheet.
+     * @return The sheet.
+     */
+    static QImage renderSheet(const QVector<QImage> &codes,
+                              const QStringList &labels,
+                              const SAKStructSheetContext &ctx);
+
+    /**
+     * @brief renderSvgSheet: The same as renderSheet(), the sheet is svg.
+     * @return Svg document.
+     */
+    static QByteArray renderSvgSheet(const QVector<QImage> &codes,
+                                     const QStringList &labels,
+                                     const SAKStructSheetContext &ctx);
+private:
+    static int cellSize(const QVector<QImage> &codes,
+                        const SAKStructSheetContext &ctx);
+    static int labelHeight(const SAKStructSheetContext &ctx);
+};
+
+#endif // SAKTOOLQRCODECREATORENCODER_HH
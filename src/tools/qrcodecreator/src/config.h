@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2020-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -15,6 +15,11 @@
 #define MICRO_VERSION 2
 #define VERSION "4.0.2"
 
+/// @brief libqrencode可被多个线程同时调用（需要pthread）
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_LIBPTHREAD 1
+#endif
+
 #ifndef STATIC_IN_RELEASE
 #define STATIC_IN_RELEASE static
 #endif
@@ -5,8 +5,12 @@ FORMS += \
     $$PWD/src/SAKToolStringAssistant.ui
 
 HEADERS += \
-    $$PWD/src/SAKToolStringAssistant.hh
+    $$PWD/src/SAKToolStringAssistant.hh \
+    $$PWD/src/SAKToolStringAssistantConverter.hh \
+    $$PWD/src/SAKToolStringAssistantOutputModel.hh
 
 SOURCES += \
-    $$PWD/src/SAKToolStringAssistant.cc
+    $$PWD/src/SAKToolStringAssistant.cc \
+    $$PWD/src/SAKToolStringAssistantConverter.cc \
+    $$PWD/src/SAKToolStringAssistantOutputModel.cc
 
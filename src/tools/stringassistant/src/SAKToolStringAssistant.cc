@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2020-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -7,58 +7,131 @@
  * QtSwissArmyKnife is licensed according to the terms in
  * the file LICENCE in the root of the source code directory.
  */
-#include "SAKToolStringAssistant.hh"
+#include <QClipboard>
+#include <QTextDocument>
+#include <QApplication>
+
 #include "SAKCommonDataStructure.hh"
+#include "SAKToolStringAssistant.hh"
+#include "SAKToolStringAssistantConverter.hh"
+#include "SAKToolStringAssistantOutputModel.hh"
 #include "ui_SAKToolStringAssistant.h"
 
 SAKToolStringAssistant::SAKToolStringAssistant(QWidget *parent)
     :QDialog(parent)
     ,ui(new Ui::SAKToolStringAssistant)
+    ,mConverter(new SAKToolStringAssistantConverter(this))
+    ,mOutputModel(new SAKToolStringAssistantOutputModel(this))
+    ,mGeneration(0)
+    ,mChangedPosition(0)
 {
     ui->setupUi(this);
+    ui->outputListView->setModel(mOutputModel);
     SAKCommonDataStructure::setComboBoxTextInputFormat(ui->inputFormatComboBox);
     SAKCommonDataStructure::setComboBoxTextOutputFormat(ui->outputFormatComboBox);
+
+    mDebounceTimer.setSingleShot(true);
+    mDebounceTimer.setInterval(200);
+    connect(&mDebounceTimer, &QTimer::timeout,
+            this, &SAKToolStringAssistant::convert);
+    connect(ui->textEdit->document(), &QTextDocument::contentsChange,
+            this, &SAKToolStringAssistant::onContentsChange);
+
+    // The results of the obsolete requests are dropped by the generation.
+    connect(mConverter, &SAKToolStringAssistantConverter::bytesConverted,
+            this, &SAKToolStringAssistant::onBytesConverted);
+    connect(mConverter, &SAKToolStringAssistantConverter::textConverted,
+            this, &SAKToolStringAssistant::onTextConverted);
+    mConverter->start();
 }
 
 SAKToolStringAssistant::~SAKToolStringAssistant()
 {
+    // The thread is stopped before the widgets are destroyed.
+    delete mConverter;
     delete ui;
 }
 
-void SAKToolStringAssistant::on_textEdit_textChanged()
+void SAKToolStringAssistant::convert()
+{
+    mDebounceTimer.stop();
+    mGeneration += 1;
+
+    SAKToolStringAssistantConverter::ParametersContext ctx;
+    ctx.generation = mGeneration;
+    ctx.text = ui->textEdit->toPlainText();
+    ctx.position = mChangedPosition;
+    ctx.inputFormat = ui->inputFormatComboBox->currentData().toInt();
+    ctx.outputFormat = ui->outputFormatComboBox->currentData().toInt();
+    mConverter->convert(ctx);
+
+    mChangedPosition = ctx.text.length();
+    ui->statusLabel->setText(tr("Converting..."));
+}
+
+void SAKToolStringAssistant::onContentsChange(int position,
+                                              int charsRemoved,
+                                              int charsAdded)
+{
+    Q_UNUSED(charsRemoved);
+    Q_UNUSED(charsAdded);
+    mChangedPosition = qMin(mChangedPosition, position);
+}
+
+void SAKToolStringAssistant::onBytesConverted(quint64 generation,
+                                              int from,
+                                              QByteArray bytes,
+                                              bool finished)
 {
-    if (!ui->textEdit->blockSignals(true)){
-        QString inputString = ui->textEdit->toPlainText();
-        auto inputFormat = static_cast<SAKCommonDataStructure::SAKEnumTextFormatInput>(ui->inputFormatComboBox->currentData().toInt());
-        QString cookedString = SAKCommonDataStructure::formattingString(inputString, inputFormat);
-        ui->textEdit->setText(cookedString);
-        ui->textEdit->moveCursor(QTextCursor::End);
-        ui->textEdit->blockSignals(false);
-        on_createPushButton_clicked();
-    }else{
-        Q_ASSERT_X(false, __FUNCTION__, "Oh, No!");
+    if (generation != mGeneration) {
+        return;
+    }
+
+    int outputFormat = ui->outputFormatComboBox->currentData().toInt();
+    if ((outputFormat == SAKCommonDataStructure::OutputFormatBin)
+            || (outputFormat == SAKCommonDataStructure::OutputFormatOct)
+            || (outputFormat == SAKCommonDataStructure::OutputFormatDec)
+            || (outputFormat == SAKCommonDataStructure::OutputFormatHex)) {
+        mOutputModel->setBytes(from, bytes, outputFormat);
+    }
+
+    ui->statusLabel->setText(finished
+                             ? tr("%1 bytes").arg(bytes.length())
+                             : tr("Converting... %1 bytes").arg(bytes.length()));
+}
+
+void SAKToolStringAssistant::onTextConverted(quint64 generation, QString text)
+{
+    if (generation == mGeneration) {
+        mOutputModel->setText(text);
     }
 }
 
+void SAKToolStringAssistant::on_textEdit_textChanged()
+{
+    mDebounceTimer.start();
+}
+
 void SAKToolStringAssistant::on_inputFormatComboBox_currentIndexChanged(int index)
 {
     Q_UNUSED(index);
     ui->textEdit->clear();
-    on_createPushButton_clicked();
+    mChangedPosition = 0;
+    convert();
 }
 
 void SAKToolStringAssistant::on_createPushButton_clicked()
 {
-    QString inputString = ui->textEdit->toPlainText();
-    auto inputFormat = static_cast<SAKCommonDataStructure::SAKEnumTextFormatInput>(ui->inputFormatComboBox->currentData().toInt());
-    QByteArray inputArray = SAKCommonDataStructure::stringToByteArray(inputString, inputFormat);
-    auto outputFormat = static_cast<SAKCommonDataStructure::SAKEnumTextFormatOutput>(ui->outputFormatComboBox->currentData().toInt());
-    auto outputString = SAKCommonDataStructure::byteArrayToString(inputArray, outputFormat);
-    ui->textBrowser->setText(outputString);
+    convert();
 }
 
 void SAKToolStringAssistant::on_outputFormatComboBox_currentTextChanged(const QString &arg1)
 {
     Q_UNUSED(arg1);
-    on_createPushButton_clicked();
+    convert();
+}
+
+void SAKToolStringAssistant::on_copyPushButton_clicked()
+{
+    QApplication::clipboard()->setText(mOutputModel->toPlainText());
 }
@@ -1,5 +1,5 @@
 ﻿/*
- * Copyright 2020 Qter(qsaker@qq.com). All rights reserved.
+ * Copyright 2020-2021 Qter(qsaker@qq.com). All rights reserved.
  *
  * The file is encoded using "utf8 with bom", it is a part
  * of QtSwissArmyKnife project.
@@ -10,8 +10,12 @@
 #ifndef SAKTOOLSTRINGASSISTANT_HH
 #define SAKTOOLSTRINGASSISTANT_HH
 
+#include <QTimer>
 #include <QDialog>
 
+class SAKToolStringAssistantConverter;
+class SAKToolStringAssistantOutputModel;
+
 namespace Ui {
     class SAKToolStringAssistant;
 }
@@ -23,11 +27,27 @@ public:
     ~SAKToolStringAssistant();
 private:
     Ui::SAKToolStringAssistant *ui;
+    SAKToolStringAssistantConverter *mConverter;
+    SAKToolStringAssistantOutputModel *mOutputModel;
+    // The text is converted after the user stops typing for a while.
+    QTimer mDebounceTimer;
+    quint64 mGeneration;
+    // The first character those is changed since the last converting.
+    int mChangedPosition;
+private:
+    void convert();
+    void onContentsChange(int position, int charsRemoved, int charsAdded);
+    void onBytesConverted(quint64 generation,
+                          int from,
+                          QByteArray bytes,
+                          bool finished);
+    void onTextConverted(quint64 generation, QString text);
 private slots:
     void on_textEdit_textChanged();
     void on_inputFormatComboBox_currentIndexChanged(int index);
     void on_createPushButton_clicked();
     void on_outputFormatComboBox_currentTextChanged(const QString &arg1);
+    void on_copyPushButton_clicked();
 };
 
 #endif // SAKTOOLSTRINGASSISTANT_HH
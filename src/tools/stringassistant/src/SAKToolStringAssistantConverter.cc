@@ -0,0 +1,227 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include "SAKCommonDataStructure.hh"
+#include "SAKToolStringAssistantConverter.hh"
+
+// Characters of a chunk, the parsing state is cached for every chunk.
+#define SAK_CHUNK_SIZE (64*1024)
+// The bytes converted are reported every some chunks.
+#define SAK_REPORTING_CHUNKS 16
+
+static int sakDigitValue(QChar ch, int base)
+{
+    ushort c = ch.unicode();
+    int value = -1;
+    if ((c >= '0') && (c <= '9')) {
+        value = c - '0';
+    } else if ((c >= 'a') && (c <= 'f')) {
+        value = c - 'a' + 10;
+    } else if ((c >= 'A') && (c <= 'F')) {
+        value = c - 'A' + 10;
+    }
+
+    return value < base ? value : -1;
+}
+
+static int sakBase(int inputFormat)
+{
+    switch (inputFormat) {
+    case SAKCommonDataStructure::InputFormatBin: return 2;
+    case SAKCommonDataStructure::InputFormatOct: return 8;
+    case SAKCommonDataStructure::InputFormatDec: return 10;
+    case SAKCommonDataStructure::InputFormatHex: return 16;
+    default: return 0;
+    }
+}
+
+SAKToolStringAssistantConverter::SAKToolStringAssistantConverter(QObject *parent)
+    :QThread(parent)
+    ,mHasPendingParameters(false)
+    ,mInputFormat(-1)
+{
+
+}
+
+SAKToolStringAssistantConverter::~SAKToolStringAssistantConverter()
+{
+    mParametersMutex.lock();
+    requestInterruption();
+    mThreadWaitCondition.wakeAll();
+    mParametersMutex.unlock();
+    wait();
+}
+
+void SAKToolStringAssistantConverter::convert(const ParametersContext &ctx)
+{
+    mParametersMutex.lock();
+    if (mHasPendingParameters) {
+        // The pending request is never parsed, so the text before the first
+        // character changed of both requests is the same as the cached one.
+        int position = qMin(ctx.position, mPendingParameters.position);
+        mPendingParameters = ctx;
+        mPendingParameters.position = position;
+    } else {
+        mPendingParameters = ctx;
+        mHasPendingParameters = true;
+    }
+    mLatestGeneration.storeRelease(ctx.generation);
+    mThreadWaitCondition.wakeAll();
+    mParametersMutex.unlock();
+}
+
+void SAKToolStringAssistantConverter::run()
+{
+    while (!isInterruptionRequested()) {
+        ParametersContext ctx;
+        if (takeParameters(ctx)) {
+            innerConvert(ctx);
+            continue;
+        }
+
+        mParametersMutex.lock();
+        if ((!mHasPendingParameters) && (!isInterruptionRequested())) {
+            mThreadWaitCondition.wait(&mParametersMutex);
+        }
+        mParametersMutex.unlock();
+    }
+}
+
+bool SAKToolStringAssistantConverter::takeParameters(ParametersContext &ctx)
+{
+    QMutexLocker locker(&mParametersMutex);
+    if (mHasPendingParameters) {
+        ctx = mPendingParameters;
+        mPendingParameters.text.clear();
+        mHasPendingParameters = false;
+        return true;
+    }
+
+    return false;
+}
+
+void SAKToolStringAssistantConverter::innerConvert(const ParametersContext &ctx)
+{
+    if (ctx.inputFormat != mInputFormat) {
+        mInputFormat = ctx.inputFormat;
+        mCheckpoints.clear();
+        mBytes.clear();
+    }
+
+    if (mCheckpoints.isEmpty()) {
+        mCheckpoints.append(SAKStructCheckpoint{0, QString()});
+    }
+
+    // The chunks before the first character changed are not parsed again.
+    const int length = ctx.text.length();
+    int position = qBound(0, ctx.position, length);
+    int index = qMin(position/SAK_CHUNK_SIZE, mCheckpoints.count() - 1);
+    mCheckpoints.resize(index + 1);
+    mBytes.truncate(mCheckpoints.at(index).bytes);
+    QString pending = mCheckpoints.at(index).pending;
+
+    int from = mBytes.length();
+    int chunks = 0;
+    for (int offset = index*SAK_CHUNK_SIZE; offset < length; offset += SAK_CHUNK_SIZE) {
+        if (offset != index*SAK_CHUNK_SIZE) {
+            mCheckpoints.append(SAKStructCheckpoint{mBytes.length(), pending});
+        }
+
+        parseChunk(ctx.text.constData() + offset,
+                   qMin(SAK_CHUNK_SIZE, length - offset),
+                   pending);
+        if (isCanceled(ctx.generation)) {
+            return;
+        }
+
+        if ((++chunks % SAK_REPORTING_CHUNKS) == 0) {
+            emit bytesConverted(ctx.generation, from, mBytes, false);
+            from = mBytes.length();
+        }
+    }
+
+    // The trailing characters make up the last byte, such as "1" of "01 1".
+    QByteArray bytes = mBytes + pendingBytes(pending);
+    emit bytesConverted(ctx.generation, from, bytes, true);
+
+    auto outputFormat =
+            static_cast<SAKCommonDataStructure::SAKEnumTextFormatOutput>(ctx.outputFormat);
+    if ((outputFormat != SAKCommonDataStructure::OutputFormatBin)
+            && (outputFormat != SAKCommonDataStructure::OutputFormatOct)
+            && (outputFormat != SAKCommonDataStructure::OutputFormatDec)
+            && (outputFormat != SAKCommonDataStructure::OutputFormatHex)) {
+        QString text = SAKCommonDataStructure::byteArrayToString(bytes, outputFormat);
+        if (!isCanceled(ctx.generation)) {
+            emit textConverted(ctx.generation, text);
+        }
+    }
+}
+
+bool SAKToolStringAssistantConverter::isCanceled(quint64 generation)
+{
+    return isInterruptionRequested()
+            || (mLatestGeneration.loadAcquire() != generation);
+}
+
+void SAKToolStringAssistantConverter::parseChunk(const QChar *chunk,
+                                                 int length,
+                                                 QString &pending)
+{
+    // The characters those are removed by
+    // SAKCommonDataStructure::formattingString() are skipped.
+    if (mInputFormat == SAKCommonDataStructure::InputFormatAscii) {
+        for (int i = 0; i < length; i++) {
+            if (chunk[i].unicode() <= 127) {
+                mBytes.append(char(chunk[i].unicode()));
+            }
+        }
+    } else if (mInputFormat == SAKCommonDataStructure::InputFormatLocal) {
+        // A surrogate pair must not be encoded separately.
+        QString str = pending + QString(chunk, length);
+        pending.clear();
+        if (str.length() && str.at(str.length() - 1).isHighSurrogate()) {
+            pending = str.right(1);
+            str.chop(1);
+        }
+        mBytes.append(str.toLocal8Bit());
+    } else {
+        const int base = sakBase(mInputFormat);
+        const int width = base == 2 ? 8 : 2;
+        for (int i = 0; i < length; i++) {
+            if (sakDigitValue(chunk[i], base) < 0) {
+                continue;
+            }
+
+            pending.append(chunk[i]);
+            if (pending.length() == width) {
+                mBytes.append(pendingBytes(pending));
+                pending.clear();
+            }
+        }
+    }
+}
+
+QByteArray SAKToolStringAssistantConverter::pendingBytes(const QString &pending)
+{
+    if (pending.isEmpty()) {
+        return QByteArray();
+    }
+
+    if (mInputFormat == SAKCommonDataStructure::InputFormatLocal) {
+        return pending.toLocal8Bit();
+    }
+
+    const int base = sakBase(mInputFormat);
+    int value = 0;
+    for (int i = 0; i < pending.length(); i++) {
+        value = value*base + sakDigitValue(pending.at(i), base);
+    }
+
+    return QByteArray(1, char(value));
+}
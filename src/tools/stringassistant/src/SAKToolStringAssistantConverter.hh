@@ -0,0 +1,91 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLSTRINGASSISTANTCONVERTER_HH
+#define SAKTOOLSTRINGASSISTANTCONVERTER_HH
+
+#include <QMutex>
+#include <QVector>
+#include <QThread>
+#include <QAtomicInteger>
+#include <QWaitCondition>
+
+/// @brief Converting thread of the string assistant. The input text is parsed
+/// in chunks, the parsing state at the beginning of every chunk is cached, so
+/// that a new request is parsed from the chunk which contains the first edited
+/// character only. A request replaces the pending one, and the running one is
+/// given up between two chunks if a newer request is arrived.
+class SAKToolStringAssistantConverter : public QThread
+{
+    Q_OBJECT
+public:
+    struct ParametersContext {
+        quint64 generation;
+        QString text;
+        // The first character those is changed since the last request.
+        int position;
+        int inputFormat;
+        int outputFormat;
+    };
+
+    SAKToolStringAssistantConverter(QObject *parent = Q_NULLPTR);
+    ~SAKToolStringAssistantConverter();
+
+    /**
+     * @brief convert: Convert the text, the pending request is replaced.
+     * @param ctx: Parameters of the request.
+     */
+    void convert(const ParametersContext &ctx);
+protected:
+    void run() final;
+private:
+    struct SAKStructCheckpoint {
+        int bytes;
+        // The characters those do not make up a byte yet.
+        QString pending;
+    };
+
+    ParametersContext mPendingParameters;
+    bool mHasPendingParameters;
+    QAtomicInteger<quint64> mLatestGeneration;
+    // It protects the pending parameters and the waiting of the thread.
+    QMutex mParametersMutex;
+    QWaitCondition mThreadWaitCondition;
+
+    // Only accessed by the converting thread.
+    QVector<SAKStructCheckpoint> mCheckpoints;
+    QByteArray mBytes;
+    int mInputFormat;
+private:
+    bool takeParameters(ParametersContext &ctx);
+    void innerConvert(const ParametersContext &ctx);
+    bool isCanceled(quint64 generation);
+    void parseChunk(const QChar *chunk, int length, QString &pending);
+    QByteArray pendingBytes(const QString &pending);
+signals:
+    /**
+     * @brief bytesConverted: The input text is converted(or partially converted).
+     * @param generation: The generation of the request.
+     * @param from: The first byte those is changed.
+     * @param bytes: All of the bytes converted.
+     * @param finished: false means that more bytes are coming.
+     */
+    void bytesConverted(quint64 generation,
+                        int from,
+                        QByteArray bytes,
+                        bool finished);
+
+    /**
+     * @brief textConverted: The bytes are decoded as text, it is emitted for
+     * the text output formats only, after bytesConverted(..., true).
+     */
+    void textConverted(quint64 generation, QString text);
+};
+
+#endif // SAKTOOLSTRINGASSISTANTCONVERTER_HH
@@ -0,0 +1,140 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#include <QStringList>
+
+#include "SAKCommonDataStructure.hh"
+#include "SAKToolStringAssistantOutputModel.hh"
+
+// Bytes of a row of the bytes output formats.
+#define SAK_BYTES_PER_ROW 16
+// Long lines of the text are broken, or the view becomes slow.
+#define SAK_CHARACTERS_PER_ROW 256
+
+SAKToolStringAssistantOutputModel::SAKToolStringAssistantOutputModel(QObject *parent)
+    :QAbstractListModel(parent)
+    ,mMode(ModeBytes)
+    ,mOutputFormat(SAKCommonDataStructure::OutputFormatHex)
+{
+
+}
+
+int SAKToolStringAssistantOutputModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    if (mMode == ModeBytes) {
+        return (mBytes.length() + SAK_BYTES_PER_ROW - 1)/SAK_BYTES_PER_ROW;
+    }
+
+    return mLineStarts.count();
+}
+
+QVariant SAKToolStringAssistantOutputModel::data(const QModelIndex &index, int role) const
+{
+    if ((!index.isValid())
+            || (index.row() >= rowCount())
+            || (role != Qt::DisplayRole)) {
+        return QVariant();
+    }
+
+    if (mMode == ModeBytes) {
+        QByteArray bytes = mBytes.mid(index.row()*SAK_BYTES_PER_ROW,
+                                      SAK_BYTES_PER_ROW);
+        auto format =
+                static_cast<SAKCommonDataStructure::SAKEnumTextFormatOutput>(mOutputFormat);
+        return SAKCommonDataStructure::byteArrayToString(bytes, format).trimmed();
+    }
+
+    return mText.mid(mLineStarts.at(index.row()), lineLength(index.row()));
+}
+
+void SAKToolStringAssistantOutputModel::setBytes(int from,
+                                                 const QByteArray &bytes,
+                                                 int outputFormat)
+{
+    if ((mMode != ModeBytes) || (mOutputFormat != outputFormat)) {
+        beginResetModel();
+        mMode = ModeBytes;
+        mOutputFormat = outputFormat;
+        mBytes = bytes;
+        mText.clear();
+        mLineStarts.clear();
+        endResetModel();
+        return;
+    }
+
+    int oldRows = rowCount();
+    int newRows = (bytes.length() + SAK_BYTES_PER_ROW - 1)/SAK_BYTES_PER_ROW;
+    if (newRows < oldRows) {
+        beginRemoveRows(QModelIndex(), newRows, oldRows - 1);
+        mBytes = bytes;
+        endRemoveRows();
+    } else if (newRows > oldRows) {
+        beginInsertRows(QModelIndex(), oldRows, newRows - 1);
+        mBytes = bytes;
+        endInsertRows();
+    } else {
+        mBytes = bytes;
+    }
+
+    int firstRow = qMax(0, from)/SAK_BYTES_PER_ROW;
+    int lastRow = qMin(oldRows, newRows) - 1;
+    if (firstRow <= lastRow) {
+        emit dataChanged(index(firstRow), index(lastRow));
+    }
+}
+
+void SAKToolStringAssistantOutputModel::setText(const QString &text)
+{
+    beginResetModel();
+    mMode = ModeText;
+    mBytes.clear();
+    mText = text;
+    mLineStarts.clear();
+    int start = 0;
+    const int length = mText.length();
+    while (start < length) {
+        mLineStarts.append(start);
+        int end = mText.indexOf(QChar('\n'), start);
+        end = end < 0 ? length : end + 1;
+        start = qMin(end, start + SAK_CHARACTERS_PER_ROW);
+    }
+    endResetModel();
+}
+
+QString SAKToolStringAssistantOutputModel::toPlainText() const
+{
+    if (mMode == ModeText) {
+        return mText;
+    }
+
+    QStringList lines;
+    for (int i = 0; i < rowCount(); i++) {
+        lines.append(data(index(i)).toString());
+    }
+
+    return lines.join(QChar('\n'));
+}
+
+int SAKToolStringAssistantOutputModel::lineLength(int row) const
+{
+    int end = (row + 1) < mLineStarts.count()
+            ? mLineStarts.at(row + 1)
+            : mText.length();
+    int length = end - mLineStarts.at(row);
+    // The line feed is not shown.
+    if (length && (mText.at(end - 1) == QChar('\n'))) {
+        length -= 1;
+    }
+
+    return length;
+}
@@ -0,0 +1,61 @@
+﻿/*
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ */
+#ifndef SAKTOOLSTRINGASSISTANTOUTPUTMODEL_HH
+#define SAKTOOLSTRINGASSISTANTOUTPUTMODEL_HH
+
+#include <QVector>
+#include <QByteArray>
+#include <QAbstractListModel>
+
+/// @brief Output of the string assistant, a row is a line of the output. The
+/// rows of the bytes output formats are formatted when they are shown, so only
+/// the visible rows are formatted.
+class SAKToolStringAssistantOutputModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    SAKToolStringAssistantOutputModel(QObject *parent = Q_NULLPTR);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief setBytes: Show bytes as bin, oct, dec or hex text.
+     * @param from: The first byte those is changed, the rows before it are not
+     * refreshed.
+     * @param bytes: All of the bytes.
+     * @param outputFormat: See SAKCommonDataStructure::SAKEnumTextFormatOutput.
+     */
+    void setBytes(int from, const QByteArray &bytes, int outputFormat);
+
+    /**
+     * @brief setText: Show the decoded text.
+     */
+    void setText(const QString &text);
+
+    /**
+     * @brief toPlainText: Get all of the output, rows are joined with '\n'.
+     */
+    QString toPlainText() const;
+private:
+    enum SAKEnumMode {
+        ModeBytes,
+        ModeText
+    } mMode;
+    QByteArray mBytes;
+    int mOutputFormat;
+    QString mText;
+    // The first character of every line of the text.
+    QVector<int> mLineStarts;
+private:
+    int lineLength(int row) const;
+};
+
+#endif // SAKTOOLSTRINGASSISTANTOUTPUTMODEL_HH
@@ -1,4 +1,16 @@
 TEMPLATE = subdirs
 CONFIG += ordered
 SUBDIRS += \
-    crc
+    crc \
+    device \
+    filechecker \
+    floatassistant \
+    maskkernel \
+    socketoptions \
+    storage \
+    udpdevice \
+    udpsessions
+
+qtHaveModule(serialbus){
+    SUBDIRS += modbus
+}
@@ -45,6 +45,9 @@ private slots:
 
     void crc32();
     void crc32mpeg2();
+
+    void crcStream();
+    void crcCombine();
 };
 
 SAKCRCInterfaceTest::SAKCRCInterfaceTest()
@@ -147,6 +150,58 @@ void SAKCRCInterfaceTest::crc32mpeg2()
     QCOMPARE(crc, 0x44EF8D9D);
 }
 
+void SAKCRCInterfaceTest::crcStream()
+{
+    uint8_t *data = reinterpret_cast<uint8_t*>(crcData.data());
+    uint64_t length = uint64_t(crcData.length());
+    QMetaEnum models = QMetaEnum::fromType<SAKCommonCrcInterface::SAKEnumCrcModel>();
+    for (int i = 0; i < models.keyCount(); i++) {
+        auto model = static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(models.value(i));
+        uint32_t crc = 0;
+        if (sakCRCInterface.bitsWidth(model) == 8) {
+            crc = sakCRCInterface.crcCalculate<quint8>(data, length, model);
+        } else if (sakCRCInterface.bitsWidth(model) == 16) {
+            crc = sakCRCInterface.crcCalculate<quint16>(data, length, model);
+        } else {
+            crc = sakCRCInterface.crcCalculate<quint32>(data, length, model);
+        }
+
+        // The data is fed by blocks.
+        SAKCommonCrcInterface::SAKStructCrcContext ctx;
+        sakCRCInterface.crcInit(&ctx, model);
+        SAKCommonCrcInterface::crcUpdate(&ctx, data, 5);
+        SAKCommonCrcInterface::crcUpdate(&ctx, data + 5, 0);
+        SAKCommonCrcInterface::crcUpdate(&ctx, data + 5, length - 5);
+        QCOMPARE(SAKCommonCrcInterface::crcFinal(&ctx), crc);
+    }
+}
+
+void SAKCRCInterfaceTest::crcCombine()
+{
+    uint8_t *data = reinterpret_cast<uint8_t*>(crcData.data());
+    uint64_t length = uint64_t(crcData.length());
+    QMetaEnum models = QMetaEnum::fromType<SAKCommonCrcInterface::SAKEnumCrcModel>();
+    for (int i = 0; i < models.keyCount(); i++) {
+        auto model = static_cast<SAKCommonCrcInterface::SAKEnumCrcModel>(models.value(i));
+        SAKCommonCrcInterface::SAKStructCrcContext whole;
+        sakCRCInterface.crcInit(&whole, model);
+        SAKCommonCrcInterface::crcUpdate(&whole, data, length);
+
+        // The second part is fed from the register 0, as a worker thread does.
+        for (uint64_t split = 0; split <= length; split++) {
+            SAKCommonCrcInterface::SAKStructCrcContext ctxA;
+            SAKCommonCrcInterface::SAKStructCrcContext ctxB;
+            sakCRCInterface.crcInit(&ctxA, model);
+            sakCRCInterface.crcInit(&ctxB, model);
+            ctxB.reg = 0;
+            SAKCommonCrcInterface::crcUpdate(&ctxA, data, split);
+            SAKCommonCrcInterface::crcUpdate(&ctxB, data + split, length - split);
+            ctxA.reg = SAKCommonCrcInterface::crcCombine(&ctxA, ctxA.reg, ctxB.reg, length - split);
+            QCOMPARE(SAKCommonCrcInterface::crcFinal(&ctxA), SAKCommonCrcInterface::crcFinal(&whole));
+        }
+    }
+}
+
 
 
 
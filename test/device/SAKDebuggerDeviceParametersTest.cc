@@ -0,0 +1,157 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QtTest>
+#include <QTemporaryDir>
+
+#include "SAKDebuggerDeviceParameters.hh"
+
+/**
+ * @brief The device parameters can be used without widgets.
+ */
+class SAKDebuggerDeviceParametersTest:public QObject
+{
+    Q_OBJECT
+private:
+    QTemporaryDir mTemporaryDir;
+private slots:
+    void defaultContext();
+    void withoutSettings();
+    void restoreFromSettings();
+    void socketOptions();
+};
+
+void SAKDebuggerDeviceParametersTest::defaultContext()
+{
+    SAKDebuggerDeviceParameters parameters(Q_NULLPTR, QString());
+    auto maskCtx = parameters.maskContext();
+    QCOMPARE(maskCtx.enableRx, false);
+    QCOMPARE(maskCtx.enableTx, false);
+
+    auto analyzerCtx = parameters.analyzerContext();
+    QCOMPARE(analyzerCtx.enable, false);
+    QVERIFY(analyzerCtx.startFlags.isEmpty());
+    QVERIFY(analyzerCtx.endFlags.isEmpty());
+}
+
+void SAKDebuggerDeviceParametersTest::withoutSettings()
+{
+    SAKDebuggerDeviceParameters parameters(Q_NULLPTR, QString());
+    QSignalSpy spy(&parameters, &SAKDebuggerDeviceParameters::maskContextChanged);
+
+    SAKDebuggerDeviceParameters::SAKStructMaskContext ctx;
+    ctx.enableRx = true;
+    ctx.enableTx = false;
+    ctx.rx = 0x5a;
+    ctx.tx = 0xa5;
+    ctx.mode = SAKDebuggerDeviceParameters::MaskModeByte;
+    parameters.setMaskContext(ctx);
+
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(parameters.maskContext().enableRx, true);
+    QCOMPARE(parameters.maskContext().rx, quint8(0x5a));
+    QCOMPARE(parameters.maskContext().tx, quint8(0xa5));
+}
+
+void SAKDebuggerDeviceParametersTest::restoreFromSettings()
+{
+    QString fileName = mTemporaryDir.filePath("device.ini");
+    QSettings settings(fileName, QSettings::IniFormat);
+
+    {
+        SAKDebuggerDeviceParameters parameters(&settings, "test");
+        SAKDebuggerDeviceParameters::SAKStructMaskContext maskCtx;
+        maskCtx.enableRx = true;
+        maskCtx.enableTx = true;
+        maskCtx.rx = 0x11;
+        maskCtx.tx = 0x22;
+        maskCtx.mode = SAKDebuggerDeviceParameters::MaskModeRollingKey;
+        maskCtx.rxKey = QByteArray::fromHex("0102");
+        maskCtx.txKey = QByteArray::fromHex("030405");
+        parameters.setMaskContext(maskCtx);
+
+        SAKDebuggerDeviceParameters::SAKStructAnalyzerContext analyzerCtx;
+        analyzerCtx.enable = true;
+        analyzerCtx.fixedLength = true;
+        analyzerCtx.length = 16;
+        analyzerCtx.startFlags = QByteArray::fromHex("aa55");
+        analyzerCtx.endFlags = QByteArray::fromHex("0d0a");
+        parameters.setAnalyzerContext(analyzerCtx);
+    }
+
+    SAKDebuggerDeviceParameters parameters(&settings, "test");
+    auto maskCtx = parameters.maskContext();
+    QCOMPARE(maskCtx.rx, quint8(0x11));
+    QCOMPARE(maskCtx.tx, quint8(0x22));
+    QCOMPARE(maskCtx.mode, int(SAKDebuggerDeviceParameters::MaskModeRollingKey));
+    QCOMPARE(maskCtx.rxKey, QByteArray::fromHex("0102"));
+    QCOMPARE(maskCtx.txKey, QByteArray::fromHex("030405"));
+    // The switches are not restored.
+    QCOMPARE(maskCtx.enableRx, false);
+
+    auto analyzerCtx = parameters.analyzerContext();
+    QCOMPARE(analyzerCtx.fixedLength, true);
+    QCOMPARE(analyzerCtx.length, 16);
+    QCOMPARE(analyzerCtx.startFlags, QByteArray::fromHex("aa55"));
+    QCOMPARE(analyzerCtx.endFlags, QByteArray::fromHex("0d0a"));
+}
+
+void SAKDebuggerDeviceParametersTest::socketOptions()
+{
+    QString fileName = mTemporaryDir.filePath("socket.ini");
+    QSettings settings(fileName, QSettings::IniFormat);
+
+    {
+        SAKDebuggerDeviceParameters parameters(&settings, "test");
+        // The system defaults are used by default.
+        auto ctx = parameters.socketOptionsContext();
+        QCOMPARE(ctx.receiveBufferSize, 0);
+        QCOMPARE(ctx.lowDelay, false);
+        QCOMPARE(ctx.keepAlive, false);
+        QCOMPARE(ctx.dscp, 0);
+
+        ctx.receiveBufferSize = 1024*1024;
+        ctx.sendBufferSize = 65536;
+        ctx.readBufferSize = 4096;
+        ctx.lowDelay = true;
+        ctx.keepAlive = true;
+        ctx.keepAliveIdle = 10;
+        ctx.keepAliveInterval = 2;
+        ctx.keepAliveCount = 3;
+        ctx.dscp = 46;
+        QSignalSpy spy(&parameters,
+                       &SAKDebuggerDeviceParameters::socketOptionsContextChanged);
+        parameters.setSocketOptionsContext(ctx);
+        QCOMPARE(spy.count(), 1);
+
+        QSignalSpy diagnosticsSpy(&parameters,
+                                  &SAKDebuggerDeviceParameters::socketOptionsDiagnosticsChanged);
+        parameters.setSocketOptionsDiagnostics(QString("Low delay: 1"));
+        QCOMPARE(diagnosticsSpy.count(), 1);
+        QCOMPARE(parameters.socketOptionsDiagnostics(), QString("Low delay: 1"));
+    }
+
+    SAKDebuggerDeviceParameters parameters(&settings, "test");
+    auto ctx = parameters.socketOptionsContext();
+    QCOMPARE(ctx.receiveBufferSize, 1024*1024);
+    QCOMPARE(ctx.sendBufferSize, 65536);
+    QCOMPARE(ctx.readBufferSize, 4096);
+    QCOMPARE(ctx.lowDelay, true);
+    QCOMPARE(ctx.keepAlive, true);
+    QCOMPARE(ctx.keepAliveIdle, 10);
+    QCOMPARE(ctx.keepAliveInterval, 2);
+    QCOMPARE(ctx.keepAliveCount, 3);
+    QCOMPARE(ctx.dscp, 46);
+    // The diagnostics are not saved.
+    QVERIFY(parameters.socketOptionsDiagnostics().isEmpty());
+}
+
+QTEST_MAIN(SAKDebuggerDeviceParametersTest)
+
+#include "SAKDebuggerDeviceParametersTest.moc"
@@ -0,0 +1,151 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QtTest>
+#include <QTemporaryDir>
+
+#include "SAKToolFileCheckerManifest.hh"
+#include "SAKToolFileCheckerXxh3Hasher.hh"
+#include "SAKToolFileCheckerBlake3Hasher.hh"
+
+/**
+ * @brief The manifest(sha256sum format) and the hashers of file checker.
+ */
+class SAKToolFileCheckerTest:public QObject
+{
+    Q_OBJECT
+private slots:
+    void line();
+    void escapedLine();
+    void invalidLine();
+    void file();
+    void hashers();
+};
+
+void SAKToolFileCheckerTest::line()
+{
+    // sha256sum of "abc"
+    QByteArray digest = QByteArray::fromHex(
+                "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    SAKToolFileCheckerManifest::SAKStructEntry entry{QString("dir/abc.txt"), digest};
+    QByteArray line = SAKToolFileCheckerManifest::toLine(entry);
+    QCOMPARE(line, QByteArray("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"
+                              "  dir/abc.txt"));
+
+    SAKToolFileCheckerManifest::SAKStructEntry parsed;
+    QVERIFY(SAKToolFileCheckerManifest::fromLine(line, &parsed));
+    QCOMPARE(parsed.fileName, entry.fileName);
+    QCOMPARE(parsed.digest, entry.digest);
+
+    // Binary mode and windows line ending
+    QVERIFY(SAKToolFileCheckerManifest::fromLine("0a0b *a b.bin\r", &parsed));
+    QCOMPARE(parsed.fileName, QString("a b.bin"));
+    QCOMPARE(parsed.digest, QByteArray::fromHex("0a0b"));
+}
+
+void SAKToolFileCheckerTest::escapedLine()
+{
+    SAKToolFileCheckerManifest::SAKStructEntry entry{QString("a\\b\nc"), QByteArray("\x01\x02")};
+    QByteArray line = SAKToolFileCheckerManifest::toLine(entry);
+    QCOMPARE(line, QByteArray("\\0102  a\\\\b\\nc"));
+
+    SAKToolFileCheckerManifest::SAKStructEntry parsed;
+    QVERIFY(SAKToolFileCheckerManifest::fromLine(line, &parsed));
+    QCOMPARE(parsed.fileName, entry.fileName);
+    QCOMPARE(parsed.digest, entry.digest);
+}
+
+void SAKToolFileCheckerTest::invalidLine()
+{
+    SAKToolFileCheckerManifest::SAKStructEntry parsed;
+    QVERIFY(!SAKToolFileCheckerManifest::fromLine("", &parsed));
+    QVERIFY(!SAKToolFileCheckerManifest::fromLine("0a0b", &parsed));
+    QVERIFY(!SAKToolFileCheckerManifest::fromLine("0a0b  ", &parsed));
+    QVERIFY(!SAKToolFileCheckerManifest::fromLine("0a0b name", &parsed));
+    QVERIFY(!SAKToolFileCheckerManifest::fromLine("0g0b  name", &parsed));
+    QVERIFY(!SAKToolFileCheckerManifest::fromLine("0a0  name", &parsed));
+}
+
+void SAKToolFileCheckerTest::file()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString fileName = dir.filePath("SHA256SUMS");
+
+    QList<SAKToolFileCheckerManifest::SAKStructEntry> entries;
+    entries.append(SAKToolFileCheckerManifest::SAKStructEntry{QString("a"), QByteArray("\xaa")});
+    entries.append(SAKToolFileCheckerManifest::SAKStructEntry{QString("b/c"), QByteArray("\xbb")});
+
+    QString errorString;
+    QVERIFY(SAKToolFileCheckerManifest::write(fileName, entries, &errorString));
+
+    QList<SAKToolFileCheckerManifest::SAKStructEntry> readEntries;
+    QVERIFY(SAKToolFileCheckerManifest::read(fileName, &readEntries, &errorString));
+    QCOMPARE(readEntries.count(), entries.count());
+    for (int i = 0; i < entries.count(); i++) {
+        QCOMPARE(readEntries.at(i).fileName, entries.at(i).fileName);
+        QCOMPARE(readEntries.at(i).digest, entries.at(i).digest);
+    }
+}
+
+void SAKToolFileCheckerTest::hashers()
+{
+    // The references are the outputs of xxhsum and b3sum, the input is
+    // (i*31 + 7)%251 for the i byte.
+    struct {
+        int length;
+        const char *xxh3;
+        const char *xxh128;
+        const char *blake3;
+    } const vectors[] = {
+        {0, "2d06800538d394c2", "99aa06d3014798d86001c324468d497f",
+         "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262"},
+        {3, "15f7093b173d005c", "46f66cb93538156515f7093b173d005c",
+         "545a7476d63b5a22936f733cd2cb89f162a7d864cb01b8b88437a36627b1303a"},
+        {100, "66ae152778cbc1c4", "aacc1d3c47a4615020d4a7247ef15e39",
+         "be08c1d6a426977b42cc4fde2b6404f97c928b2e75eb84993551e05fce998933"},
+        {200, "f4b54cdc82f20685", "7d5b21c921158e644ec0706f02ef2a5b",
+         "9915f0271277d0a701109867be67345453c19008d7e83e3e8bcbad2d464512eb"},
+        {1000, "84b0c79e3e1ac40e", "e719034ed2c87a3684b0c79e3e1ac40e",
+         "beb16c4780ceb84cec6cf34484eb280d8d7faaa5970da29b2aaf08bc2efdd795"},
+        {5000, "82c9e6e5b7476dc8", "34496ee9d0d4542082c9e6e5b7476dc8",
+         "1040a883f6e27eb41a20a0e013719659a5f1c170fd47cdd927c27be8ab1a0bc8"},
+        {1048577, "984c81cf9b480bec", "c1bd461e3f36e68a984c81cf9b480bec",
+         "48db5173adf40174f94a57ca0809c7307e59966b91858a7430182be8413a038a"},
+    };
+
+    for (auto &vector : vectors) {
+        QByteArray data(vector.length, 0);
+        for (int i = 0; i < data.length(); i++) {
+            data[i] = char((i*31 + 7)%251);
+        }
+        const uchar *p = reinterpret_cast<const uchar*>(data.constData());
+
+        // Fed at once and fed in blocks which are not aligned.
+        for (qint64 step : {qint64(data.length()), qint64(999)}) {
+            SAKToolFileCheckerXxh3Hasher xxh3(false);
+            SAKToolFileCheckerXxh3Hasher xxh128(true);
+            SAKToolFileCheckerBlake3Hasher blake3;
+            for (qint64 offset = 0; offset < data.length(); offset += step) {
+                qint64 length = qMin(step, data.length() - offset);
+                xxh3.addData(p + offset, length);
+                xxh128.addData(p + offset, length);
+                blake3.addData(p + offset, length);
+            }
+
+            QCOMPARE(xxh3.result().toHex(), QByteArray(vector.xxh3));
+            QCOMPARE(xxh128.result().toHex(), QByteArray(vector.xxh128));
+            QCOMPARE(blake3.result().toHex(), QByteArray(vector.blake3));
+        }
+    }
+}
+
+QTEST_MAIN(SAKToolFileCheckerTest)
+
+#include "SAKToolFileCheckerTest.moc"
@@ -0,0 +1,23 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += \
+    ../../src/common \
+    ../../src/tools/filechecker/src
+
+SOURCES += \
+    ../../src/tools/filechecker/src/SAKToolFileCheckerBlake3Hasher.cc \
+    ../../src/tools/filechecker/src/SAKToolFileCheckerManifest.cc \
+    ../../src/tools/filechecker/src/SAKToolFileCheckerXxh3Hasher.cc \
+    SAKToolFileCheckerTest.cc
+
+HEADERS += \
+    ../../src/tools/filechecker/src/SAKToolFileCheckerBlake3Hasher.hh \
+    ../../src/tools/filechecker/src/SAKToolFileCheckerHasher.hh \
+    ../../src/tools/filechecker/src/SAKToolFileCheckerManifest.hh \
+    ../../src/tools/filechecker/src/SAKToolFileCheckerXxh3Hasher.hh
@@ -0,0 +1,121 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QtTest>
+#include <QVector>
+
+#include "SAKToolFloatAssistantDecoder.hh"
+
+/**
+ * @brief Decoding samples and statistics of the bulk mode of float assistant.
+ */
+class SAKToolFloatAssistantTest:public QObject
+{
+    Q_OBJECT
+private slots:
+    void decode_data();
+    void decode();
+    void statistics();
+};
+
+void SAKToolFloatAssistantTest::decode_data()
+{
+    QTest::addColumn<int>("type");
+    QTest::addColumn<bool>("bigEndian");
+    QTest::addColumn<int>("offset");
+    QTest::addColumn<int>("stride");
+    QTest::addColumn<QByteArray>("hex");
+    QTest::addColumn<QVector<double>>("samples");
+
+    QTest::newRow("float32 little endian")
+            << int(SAKToolFloatAssistantDecoder::SampleTypeFloat32) << false << 0 << 0
+            << QByteArray("0000803f000000c0") << QVector<double>{1.0, -2.0};
+    QTest::newRow("float32 big endian")
+            << int(SAKToolFloatAssistantDecoder::SampleTypeFloat32) << true << 0 << 0
+            << QByteArray("3f800000c0000000") << QVector<double>{1.0, -2.0};
+    QTest::newRow("float64 big endian")
+            << int(SAKToolFloatAssistantDecoder::SampleTypeFloat64) << true << 0 << 0
+            << QByteArray("3ff8000000000000") << QVector<double>{1.5};
+    // A frame of 2 int16 channels, the second channel is decoded.
+    QTest::newRow("int16 channel")
+            << int(SAKToolFloatAssistantDecoder::SampleTypeInt16) << false << 2 << 4
+            << QByteArray("0100ffff0200feff0300") << QVector<double>{-1, -2};
+    QTest::newRow("int32 with offset")
+            << int(SAKToolFloatAssistantDecoder::SampleTypeInt32) << true << 1 << 0
+            << QByteArray("aa0000010080000000") << QVector<double>{256, -2147483648.0};
+    QTest::newRow("too short")
+            << int(SAKToolFloatAssistantDecoder::SampleTypeFloat64) << false << 0 << 0
+            << QByteArray("00000000000000") << QVector<double>{};
+}
+
+void SAKToolFloatAssistantTest::decode()
+{
+    QFETCH(int, type);
+    QFETCH(bool, bigEndian);
+    QFETCH(int, offset);
+    QFETCH(int, stride);
+    QFETCH(QByteArray, hex);
+    QFETCH(QVector<double>, samples);
+
+    SAKToolFloatAssistantDecoder::SAKStructDecodingContext ctx;
+    ctx.type = static_cast<SAKToolFloatAssistantDecoder::SAKEnumSampleType>(type);
+    ctx.bigEndian = bigEndian;
+    ctx.offset = offset;
+    ctx.stride = stride;
+    QByteArray data = QByteArray::fromHex(hex);
+    qint64 count = SAKToolFloatAssistantDecoder::sampleCount(data.length(), ctx);
+    QCOMPARE(count, qint64(samples.count()));
+
+    QVector<double> decoded(int(count));
+    SAKToolFloatAssistantDecoder::decode(data.constData(), 0, count, ctx, decoded.data());
+    QCOMPARE(decoded, samples);
+}
+
+void SAKToolFloatAssistantTest::statistics()
+{
+    // The samples are fed in blocks, the result is the same as feeding at once.
+    QVector<double> samples;
+    for (int i = 0; i < 10000; i++) {
+        samples.append(1000000 + (i % 7) - 3);
+    }
+    samples[5] = qQNaN();
+    samples[6] = qInf();
+
+    SAKToolFloatAssistantDecoder::SAKStructStatisticsContext ctx;
+    SAKToolFloatAssistantDecoder::statisticsInit(&ctx);
+    for (int i = 0; i < samples.count(); i += 333) {
+        int n = qMin(333, samples.count() - i);
+        SAKToolFloatAssistantDecoder::statisticsUpdate(&ctx, samples.constData() + i, n);
+    }
+
+    double sum = 0;
+    for (int i = 0; i < samples.count(); i++) {
+        if ((i != 5) && (i != 6)) {
+            sum += samples.at(i);
+        }
+    }
+    double mean = sum/9998;
+    double m2 = 0;
+    for (int i = 0; i < samples.count(); i++) {
+        if ((i != 5) && (i != 6)) {
+            m2 += (samples.at(i) - mean)*(samples.at(i) - mean);
+        }
+    }
+
+    QCOMPARE(ctx.count, qint64(9998));
+    QCOMPARE(ctx.invalidCount, qint64(2));
+    QCOMPARE(ctx.min, 999997.0);
+    QCOMPARE(ctx.max, 1000003.0);
+    QCOMPARE(ctx.mean, mean);
+    QCOMPARE(SAKToolFloatAssistantDecoder::standardDeviation(ctx), qSqrt(m2/9997));
+}
+
+QTEST_MAIN(SAKToolFloatAssistantTest)
+
+#include "SAKToolFloatAssistantTest.moc"
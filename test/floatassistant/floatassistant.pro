@@ -0,0 +1,18 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += \
+    ../../src/common \
+    ../../src/tools/floatassistant/src
+
+SOURCES += \
+    ../../src/tools/floatassistant/src/SAKToolFloatAssistantDecoder.cc \
+    SAKToolFloatAssistantTest.cc
+
+HEADERS += \
+    ../../src/tools/floatassistant/src/SAKToolFloatAssistantDecoder.hh
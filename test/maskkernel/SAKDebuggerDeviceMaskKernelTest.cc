@@ -0,0 +1,69 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QtTest>
+
+#include "SAKDebuggerDeviceMaskKernel.hh"
+
+/**
+ * @brief The mask kernel must give the same results as the scalar algorithm.
+ */
+class SAKDebuggerDeviceMaskKernelTest:public QObject
+{
+    Q_OBJECT
+private slots:
+    void maskKernel();
+};
+
+void SAKDebuggerDeviceMaskKernelTest::maskKernel()
+{
+    // Odd lengths, the vectorized body and the tail are both covered.
+    QByteArray origin;
+    for (int i = 0; i < 1000; i++) {
+        origin.append(char(i*7));
+    }
+
+    QByteArray bytes = origin;
+    SAKDebuggerDeviceMaskKernel::xorByte(bytes.data(), bytes.length(), 0x5a);
+    for (int i = 0; i < bytes.length(); i++) {
+        QCOMPARE(quint8(bytes.at(i)), quint8(origin.at(i) ^ 0x5a));
+    }
+
+    // The offset is continued by the next frame.
+    QByteArray key = QByteArray::fromHex("0102030405");
+    bytes = origin;
+    qint64 offset = SAKDebuggerDeviceMaskKernel::xorKey(bytes.data(), 333, key, 0);
+    offset = SAKDebuggerDeviceMaskKernel::xorKey(bytes.data() + 333,
+                                                 bytes.length() - 333,
+                                                 key,
+                                                 offset);
+    for (int i = 0; i < bytes.length(); i++) {
+        QCOMPARE(quint8(bytes.at(i)), quint8(origin.at(i) ^ key.at(i % key.length())));
+    }
+    QCOMPARE(offset, qint64(bytes.length() % key.length()));
+
+    // The key stream is symmetrical if the frames are the same.
+    quint32 seed = SAKDebuggerDeviceMaskKernel::streamSeed(key);
+    QVERIFY(seed != 0);
+    bytes = origin;
+    auto xorFrames = [&](){
+        quint32 state = SAKDebuggerDeviceMaskKernel::xorStream(bytes.data(), 17, seed);
+        SAKDebuggerDeviceMaskKernel::xorStream(bytes.data() + 17,
+                                               bytes.length() - 17,
+                                               state);
+    };
+    xorFrames();
+    QVERIFY(bytes != origin);
+    xorFrames();
+    QCOMPARE(bytes, origin);
+}
+
+QTEST_MAIN(SAKDebuggerDeviceMaskKernelTest)
+
+#include "SAKDebuggerDeviceMaskKernelTest.moc"
@@ -0,0 +1,17 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += \
+    ../../src/debuggers/debugger/device
+
+SOURCES += \
+    ../../src/debuggers/debugger/device/SAKDebuggerDeviceMaskKernel.cc \
+    SAKDebuggerDeviceMaskKernelTest.cc
+
+HEADERS += \
+    ../../src/debuggers/debugger/device/SAKDebuggerDeviceMaskKernel.hh
@@ -0,0 +1,220 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QModbusTcpServer>
+
+#include "SAKModbusCommonCodec.hh"
+#include "SAKModbusClientPoller.hh"
+#include "SAKModbusCommonSnapshot.hh"
+#include "SAKModbusCommonStatistics.hh"
+
+/**
+ * @brief Register data of modbus.
+ */
+class SAKModbusTest:public QObject
+{
+    Q_OBJECT
+private:
+    QTemporaryDir mTemporaryDir;
+private:
+    void setMap(QModbusServer *server, quint16 value);
+private slots:
+    void snapshot();
+    void snapshotDiff();
+    void snapshotInvalid();
+    void snapshotOutOfMap();
+    void coalesce();
+    void statistics();
+    void codec();
+};
+
+void SAKModbusTest::setMap(QModbusServer *server, quint16 value)
+{
+    QModbusDataUnitMap map;
+    for (auto type : SAKModbusCommonSnapshot::registerTypes()) {
+        map.insert(type, QModbusDataUnit(type, 0, QVector<quint16>(65535, value)));
+    }
+    server->setMap(map);
+}
+
+void SAKModbusTest::snapshot()
+{
+    QModbusTcpServer server;
+    setMap(&server, 0);
+    server.setData(QModbusDataUnit::Coils, 100, 1);
+    server.setData(QModbusDataUnit::HoldingRegisters, 65534, 0x1234);
+
+    QString fileName = mTemporaryDir.filePath("snapshot.qsakmbs");
+    QVERIFY(SAKModbusCommonSnapshot::save(&server, fileName, 65535));
+
+    QModbusTcpServer restoredServer;
+    setMap(&restoredServer, 0xffff);
+    QSignalSpy spy(&restoredServer, &QModbusServer::dataWritten);
+    QVERIFY(SAKModbusCommonSnapshot::restore(&restoredServer, fileName));
+    // A block is written for each type.
+    QCOMPARE(spy.count(), 4);
+
+    quint16 value = 0;
+    QVERIFY(restoredServer.data(QModbusDataUnit::Coils, 100, &value));
+    QCOMPARE(value, quint16(1));
+    QVERIFY(restoredServer.data(QModbusDataUnit::HoldingRegisters, 65534, &value));
+    QCOMPARE(value, quint16(0x1234));
+    QVERIFY(restoredServer.data(QModbusDataUnit::InputRegisters, 0, &value));
+    QCOMPARE(value, quint16(0));
+}
+
+void SAKModbusTest::snapshotDiff()
+{
+    QModbusTcpServer server;
+    setMap(&server, 0);
+    QString oldFileName = mTemporaryDir.filePath("old.qsakmbs");
+    QVERIFY(SAKModbusCommonSnapshot::save(&server, oldFileName, 65535));
+
+    server.setData(QModbusDataUnit::InputRegisters, 63, 0xaa);
+    server.setData(QModbusDataUnit::InputRegisters, 64, 0xbb);
+    QString newFileName = mTemporaryDir.filePath("new.qsakmbs");
+    QVERIFY(SAKModbusCommonSnapshot::save(&server, newFileName, 65535));
+
+    QVector<SAKModbusCommonSnapshot::SAKStructDifferenceContext> differences;
+    QVERIFY(SAKModbusCommonSnapshot::diff(oldFileName, newFileName, &differences));
+    QCOMPARE(differences.count(), 2);
+    QCOMPARE(differences.first().type, QModbusDataUnit::InputRegisters);
+    QCOMPARE(differences.first().address, quint16(63));
+    QCOMPARE(differences.last().oldValue, quint16(0));
+    QCOMPARE(differences.last().newValue, quint16(0xbb));
+}
+
+void SAKModbusTest::snapshotInvalid()
+{
+    QString fileName = mTemporaryDir.filePath("invalid.qsakmbs");
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write("invalid snapshot file");
+    file.close();
+
+    QModbusTcpServer server;
+    setMap(&server, 0);
+    QString errorString;
+    QVERIFY(!SAKModbusCommonSnapshot::restore(&server, fileName, &errorString));
+    QVERIFY(!errorString.isEmpty());
+}
+
+void SAKModbusTest::snapshotOutOfMap()
+{
+    QModbusTcpServer server;
+    setMap(&server, 0);
+    QString fileName = mTemporaryDir.filePath("large.qsakmbs");
+    QVERIFY(SAKModbusCommonSnapshot::save(&server, fileName, 65535));
+
+    QModbusTcpServer smallServer;
+    QModbusDataUnitMap map;
+    for (auto type : SAKModbusCommonSnapshot::registerTypes()) {
+        map.insert(type, QModbusDataUnit(type, 0, 100));
+    }
+    smallServer.setMap(map);
+    QString errorString;
+    QVERIFY(!SAKModbusCommonSnapshot::restore(&smallServer, fileName, &errorString));
+    QVERIFY(!errorString.isEmpty());
+}
+
+void SAKModbusTest::coalesce()
+{
+    typedef SAKModbusClientPoller::SAKStructRangeContext Range;
+    QList<Range> ranges;
+    ranges << Range{1, QModbusDataUnit::HoldingRegisters, 10, 10}
+           << Range{1, QModbusDataUnit::HoldingRegisters, 0, 8}
+           << Range{1, QModbusDataUnit::HoldingRegisters, 300, 300}
+           << Range{2, QModbusDataUnit::HoldingRegisters, 20, 10}
+           << Range{1, QModbusDataUnit::Coils, 0, 16};
+
+    // The gap(8, 9) is not read if the max gap is 0.
+    auto blocks = SAKModbusClientPoller::coalesce(ranges, 0);
+    QCOMPARE(blocks.count(), 7);
+
+    blocks = SAKModbusClientPoller::coalesce(ranges, 2);
+    QCOMPARE(blocks.count(), 6);
+    QCOMPARE(blocks.at(0).type, QModbusDataUnit::Coils);
+    QCOMPARE(blocks.at(1).startAddress, quint16(0));
+    QCOMPARE(blocks.at(1).registerNumber, quint16(20));
+    // 300 registers are split to 125 + 125 + 50.
+    QCOMPARE(blocks.at(2).registerNumber, quint16(125));
+    QCOMPARE(blocks.at(4).startAddress, quint16(550));
+    QCOMPARE(blocks.at(4).registerNumber, quint16(50));
+    QCOMPARE(blocks.at(5).serverAddress, 2);
+}
+
+void SAKModbusTest::statistics()
+{
+    // The values of the buckets are the lower bounds.
+    QCOMPARE(SAKModbusCommonStatistics::bucketValue(
+                 SAKModbusCommonStatistics::bucketIndex(15)), qint64(15));
+    QCOMPARE(SAKModbusCommonStatistics::bucketValue(
+                 SAKModbusCommonStatistics::bucketIndex(1000)), qint64(992));
+
+    SAKModbusCommonStatistics statistics;
+    for (int i = 1; i <= 100; i++) {
+        statistics.addRecord(1, 0x03, i*1000, SAKModbusCommonStatistics::ResultSuccess);
+    }
+    statistics.addRecord(1, 0x03, 0, SAKModbusCommonStatistics::ResultTimeout);
+    statistics.addRecord(2, 0x10, 500, SAKModbusCommonStatistics::ResultException);
+
+    auto counters = statistics.counters();
+    QCOMPARE(counters.count(), 2);
+    auto ctx = counters.first();
+    QCOMPARE(ctx.requests, qint64(101));
+    QCOMPARE(ctx.timeouts, qint64(1));
+    QCOMPARE(ctx.minLatency, qint64(1000));
+    QCOMPARE(ctx.maxLatency, qint64(100000));
+    qint64 p99 = SAKModbusCommonStatistics::percentile(ctx.histogram, 99);
+    QVERIFY(p99 > 92000 && p99 <= 99000);
+    QCOMPARE(counters.last().exceptions, qint64(1));
+
+    QString fileName = mTemporaryDir.filePath("statistics.csv");
+    QVERIFY(statistics.exportCsv(fileName));
+    QFile file(fileName);
+    QVERIFY(file.open(QFile::ReadOnly));
+    QVERIFY(file.readAll().contains("1,0x03,101,0,1,0"));
+}
+
+void SAKModbusTest::codec()
+{
+    typedef SAKModbusCommonCodec Codec;
+    // 1.0f is 0x3f800000, -2 is 0xfffffffe.
+    QVector<quint16> abcd = QVector<quint16>() << 0x3f80 << 0x0000 << 0xffff << 0xfffe;
+    QVector<quint16> cdab = QVector<quint16>() << 0x0000 << 0x3f80 << 0xfffe << 0xffff;
+    QVector<quint16> dcba = QVector<quint16>() << 0x0000 << 0x803f << 0xfeff << 0xffff;
+    QCOMPARE(Codec::text(abcd.constData(), 2, Codec::DataTypeFloat32, Codec::ByteOrderABCD),
+             QString("1"));
+    QCOMPARE(Codec::text(cdab.constData(), 2, Codec::DataTypeFloat32, Codec::ByteOrderCDAB),
+             QString("1"));
+    QCOMPARE(Codec::text(dcba.constData(), 2, Codec::DataTypeFloat32, Codec::ByteOrderDCBA),
+             QString("1"));
+    QCOMPARE(Codec::texts(abcd, Codec::DataTypeInt32, Codec::ByteOrderABCD),
+             QStringList() << QString("1065353216") << QString("-2"));
+
+    double values[2] = {0, 0};
+    QCOMPARE(Codec::decode(cdab.constData(), 4, Codec::DataTypeInt32, Codec::ByteOrderCDAB, values), 2);
+    QCOMPARE(values[1], -2.0);
+
+    // 64 bits integers are not limited by double.
+    QVector<quint16> int64 = QVector<quint16>() << 0x7fff << 0xffff << 0xffff << 0xffff;
+    QCOMPARE(Codec::text(int64.constData(), 4, Codec::DataTypeInt64, Codec::ByteOrderABCD),
+             QString("9223372036854775807"));
+
+    QVector<quint16> string = QVector<quint16>() << 0x5153 << 0x414b << 0x0000;
+    QCOMPARE(Codec::text(string.constData(), 3, Codec::DataTypeString, Codec::ByteOrderABCD),
+             QString("QSAK"));
+    QCOMPARE(Codec::bytes(string).toHex(), QByteArray("5153414b0000"));
+}
+
+QTEST_MAIN(SAKModbusTest)
+
+#include "SAKModbusTest.moc"
@@ -0,0 +1,24 @@
+QT += testlib serialbus
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += \
+    ../../src/modbus/client \
+    ../../src/modbus/common
+
+SOURCES += \
+    ../../src/modbus/client/SAKModbusClientPoller.cc \
+    ../../src/modbus/common/SAKModbusCommonCodec.cc \
+    ../../src/modbus/common/SAKModbusCommonSnapshot.cc \
+    ../../src/modbus/common/SAKModbusCommonStatistics.cc \
+    SAKModbusTest.cc
+
+HEADERS += \
+    ../../src/modbus/client/SAKModbusClientPoller.hh \
+    ../../src/modbus/common/SAKModbusCommonCodec.hh \
+    ../../src/modbus/common/SAKModbusCommonSnapshot.hh \
+    ../../src/modbus/common/SAKModbusCommonStatistics.hh
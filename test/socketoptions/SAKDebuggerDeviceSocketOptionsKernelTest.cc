@@ -0,0 +1,109 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QtTest>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUdpSocket>
+
+#ifdef Q_OS_LINUX
+#include <sys/socket.h>
+#endif
+
+#include "SAKDebuggerDeviceSocketOptionsKernel.hh"
+
+/**
+ * @brief The options are applied to loopback sockets and read back.
+ */
+class SAKDebuggerDeviceSocketOptionsKernelTest:public QObject
+{
+    Q_OBJECT
+private:
+    SAKDebuggerDeviceParameters::SAKStructSocketOptionsContext context();
+private slots:
+    void tcp();
+    void udp();
+};
+
+SAKDebuggerDeviceParameters::SAKStructSocketOptionsContext
+SAKDebuggerDeviceSocketOptionsKernelTest::context()
+{
+    SAKDebuggerDeviceParameters::SAKStructSocketOptionsContext ctx;
+    ctx.receiveBufferSize = 16384;
+    ctx.sendBufferSize = 0;
+    ctx.readBufferSize = 4096;
+    ctx.lowDelay = true;
+    ctx.keepAlive = true;
+    ctx.keepAliveIdle = 10;
+    ctx.keepAliveInterval = 2;
+    ctx.keepAliveCount = 3;
+    ctx.dscp = 46;
+    return ctx;
+}
+
+void SAKDebuggerDeviceSocketOptionsKernelTest::tcp()
+{
+    auto ctx = context();
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    QVERIFY(SAKDebuggerDeviceSocketOptionsKernel::applyToListener(
+                server.socketDescriptor(), ctx));
+
+    QTcpSocket client;
+    client.connectToHost(QHostAddress::LocalHost, server.serverPort());
+    QVERIFY(client.waitForConnected(5000));
+    QVERIFY(server.waitForNewConnection(5000));
+    QTcpSocket *socket = server.nextPendingConnection();
+    QVERIFY(socket);
+
+#ifdef Q_OS_LINUX
+    // The accepted socket inherits the receive buffer size of the listener.
+    int listenerSize = 0;
+    socklen_t length = socklen_t(sizeof(listenerSize));
+    QCOMPARE(::getsockopt(int(server.socketDescriptor()), SOL_SOCKET, SO_RCVBUF,
+                          &listenerSize, &length), 0);
+    QCOMPARE(socket->socketOption(QAbstractSocket::ReceiveBufferSizeSocketOption).toInt(),
+             listenerSize);
+#endif
+
+    QString values = SAKDebuggerDeviceSocketOptionsKernel::apply(socket, ctx);
+    QStringList lines = values.split(QChar('\n'));
+    QCOMPARE(socket->readBufferSize(), qint64(4096));
+    QCOMPARE(socket->socketOption(QAbstractSocket::LowDelayOption).toInt(), 1);
+    QCOMPARE(socket->socketOption(QAbstractSocket::KeepAliveOption).toInt(), 1);
+    QCOMPARE(socket->socketOption(QAbstractSocket::TypeOfServiceOption).toInt(), 46 << 2);
+    QVERIFY(socket->socketOption(QAbstractSocket::ReceiveBufferSizeSocketOption).toInt()
+            >= 16384);
+    QVERIFY(lines.contains(QString("Low delay: 1")));
+    QVERIFY(lines.contains(QString("Keep alive: 1")));
+    QVERIFY(lines.contains(QString("DSCP: 46 (type of service: 0xb8)")));
+#ifdef Q_OS_LINUX
+    QVERIFY(lines.contains(QString("Keep alive idle: 10")));
+    QVERIFY(lines.contains(QString("Keep alive interval: 2")));
+    QVERIFY(lines.contains(QString("Keep alive count: 3")));
+#endif
+}
+
+void SAKDebuggerDeviceSocketOptionsKernelTest::udp()
+{
+    auto ctx = context();
+    QUdpSocket socket;
+    QVERIFY(socket.bind(QHostAddress::LocalHost, 0));
+
+    QString values = SAKDebuggerDeviceSocketOptionsKernel::apply(&socket, ctx);
+    QCOMPARE(socket.socketOption(QAbstractSocket::TypeOfServiceOption).toInt(), 46 << 2);
+    QVERIFY(socket.socketOption(QAbstractSocket::ReceiveBufferSizeSocketOption).toInt()
+            >= 16384);
+    // The options of tcp only are not reported.
+    QVERIFY(!values.contains(QString("Keep alive")));
+}
+
+QTEST_MAIN(SAKDebuggerDeviceSocketOptionsKernelTest)
+
+#include "SAKDebuggerDeviceSocketOptionsKernelTest.moc"
@@ -0,0 +1,21 @@
+QT += testlib network
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += \
+    ../../src/debuggers/debugger/device
+
+SOURCES += \
+    ../../src/debuggers/debugger/device/SAKDebuggerDeviceParameters.cc \
+    ../../src/debuggers/debugger/device/SAKDebuggerDeviceSocketOptionsKernel.cc \
+    SAKDebuggerDeviceSocketOptionsKernelTest.cc
+
+HEADERS += \
+    ../../src/debuggers/debugger/device/SAKDebuggerDeviceParameters.hh \
+    ../../src/debuggers/debugger/device/SAKDebuggerDeviceSocketOptionsKernel.hh
+
+win32:LIBS += -lws2_32
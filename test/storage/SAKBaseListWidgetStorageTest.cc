@@ -0,0 +1,182 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QtTest>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <QSqlDatabase>
+
+#include "SAKBaseListWidgetStorage.hh"
+
+/**
+ * @brief The storage writes records with bound values in transactions, the
+ * statements are executed by the database worker.
+ */
+class SAKBaseListWidgetStorageTest:public QObject
+{
+    Q_OBJECT
+private:
+    QTemporaryDir mTemporaryDir;
+    QSqlDatabase mSqlDatabase;
+private:
+    int count();
+    QString description(quint64 id);
+private slots:
+    void initTestCase();
+    void init();
+    void quote();
+    void coalesce();
+    void deleteRecord();
+    void bulkInsert();
+    void readinRecords();
+    void cleanupTestCase();
+};
+
+int SAKBaseListWidgetStorageTest::count()
+{
+    QSqlQuery sqlQuery(mSqlDatabase);
+    sqlQuery.exec("SELECT COUNT(*) FROM test");
+    sqlQuery.next();
+    return sqlQuery.value(0).toInt();
+}
+
+QString SAKBaseListWidgetStorageTest::description(quint64 id)
+{
+    QSqlQuery sqlQuery(mSqlDatabase);
+    sqlQuery.prepare("SELECT description FROM test WHERE id=?");
+    sqlQuery.addBindValue(qint64(id));
+    sqlQuery.exec();
+    sqlQuery.next();
+    return sqlQuery.value(0).toString();
+}
+
+void SAKBaseListWidgetStorageTest::initTestCase()
+{
+    mSqlDatabase = QSqlDatabase::addDatabase("QSQLITE", "storage");
+    // The worker opens its own connection, so the database must be a file.
+    QVERIFY(mTemporaryDir.isValid());
+    mSqlDatabase.setDatabaseName(mTemporaryDir.filePath("storage.sqlite3"));
+    QVERIFY(mSqlDatabase.open());
+}
+
+void SAKBaseListWidgetStorageTest::init()
+{
+    QSqlQuery sqlQuery(mSqlDatabase);
+    sqlQuery.exec("DROP TABLE IF EXISTS test");
+    SAKBaseListWidgetStorage storage(&mSqlDatabase, "test");
+    storage.createTable("CREATE TABLE test(id INTEGER PRIMARY KEY NOT NULL,"
+                        "description TEXT NOT NULL,"
+                        "format INTEGER NOT NULL)");
+    storage.waitForWritten();
+    QVERIFY(mSqlDatabase.tables().contains("test"));
+}
+
+void SAKBaseListWidgetStorageTest::quote()
+{
+    SAKBaseListWidgetStorage storage(&mSqlDatabase, "test");
+    QJsonObject record;
+    record.insert("id", 1);
+    record.insert("description", QString("it's"));
+    record.insert("format", 2);
+    storage.insertRecord(record);
+    storage.updateRecord(1, "description", QString("'; DROP TABLE test; --"));
+    storage.waitForWritten();
+
+    QCOMPARE(count(), 1);
+    QCOMPARE(description(1), QString("'; DROP TABLE test; --"));
+}
+
+void SAKBaseListWidgetStorageTest::coalesce()
+{
+    SAKBaseListWidgetStorage storage(&mSqlDatabase, "test");
+    QJsonObject record;
+    record.insert("id", 1);
+    record.insert("description", QString());
+    record.insert("format", 0);
+    storage.insertRecord(record);
+    storage.waitForWritten();
+
+    // Such as typing, the last value is written.
+    QString text = "description";
+    for (int i = 1; i <= text.length(); i++) {
+        storage.updateRecord(1, "description", text.left(i));
+    }
+    storage.updateRecord(1, "format", 3);
+    QCOMPARE(description(1), QString());
+    storage.waitForWritten();
+    QCOMPARE(description(1), text);
+}
+
+void SAKBaseListWidgetStorageTest::deleteRecord()
+{
+    {
+        SAKBaseListWidgetStorage storage(&mSqlDatabase, "test");
+        for (int i = 1; i <= 3; i++) {
+            QJsonObject record;
+            record.insert("id", i);
+            record.insert("description", QString::number(i));
+            record.insert("format", 0);
+            storage.insertRecord(record);
+        }
+        storage.updateRecord(2, "description", QString("2"));
+        storage.deleteRecord(2);
+        // The pending operations are flushed when the storage is destroyed.
+    }
+    SAKBaseDatabaseWorker::instance(&mSqlDatabase)->waitForIdle();
+
+    QCOMPARE(count(), 2);
+    QCOMPARE(description(3), QString("3"));
+}
+
+void SAKBaseListWidgetStorageTest::bulkInsert()
+{
+    SAKBaseListWidgetStorage storage(&mSqlDatabase, "test");
+    for (int i = 1; i <= 10000; i++) {
+        QJsonObject record;
+        record.insert("id", i);
+        record.insert("description", QString("item%1").arg(i));
+        record.insert("format", i%4);
+        storage.insertRecord(record);
+    }
+    storage.waitForWritten();
+
+    QCOMPARE(count(), 10000);
+    QCOMPARE(description(10000), QString("item10000"));
+}
+
+void SAKBaseListWidgetStorageTest::readinRecords()
+{
+    SAKBaseListWidgetStorage storage(&mSqlDatabase, "test");
+    for (int i = 1; i <= 3; i++) {
+        QJsonObject record;
+        record.insert("id", i);
+        record.insert("description", QString::number(i));
+        record.insert("format", i);
+        storage.insertRecord(record);
+    }
+    storage.flush();
+
+    // The records are read after the queued writes.
+    QSignalSpy spy(&storage, &SAKBaseListWidgetStorage::recordsRead);
+    storage.readinRecords();
+    QVERIFY(spy.wait());
+    auto records = spy.first().first().value<QList<QVariantMap>>();
+    QCOMPARE(records.count(), 3);
+    QCOMPARE(records.last().value("description").toString(), QString("3"));
+    QCOMPARE(records.last().value("format").toInt(), 3);
+}
+
+void SAKBaseListWidgetStorageTest::cleanupTestCase()
+{
+    mSqlDatabase.close();
+}
+
+QTEST_MAIN(SAKBaseListWidgetStorageTest)
+
+#include "SAKBaseListWidgetStorageTest.moc"
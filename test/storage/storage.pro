@@ -0,0 +1,19 @@
+QT += testlib sql
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += \
+    ../../src/base
+
+SOURCES += \
+    ../../src/base/SAKBaseDatabaseWorker.cc \
+    ../../src/base/SAKBaseListWidgetStorage.cc \
+    SAKBaseListWidgetStorageTest.cc
+
+HEADERS += \
+    ../../src/base/SAKBaseDatabaseWorker.hh \
+    ../../src/base/SAKBaseListWidgetStorage.hh
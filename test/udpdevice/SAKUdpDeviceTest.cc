@@ -0,0 +1,146 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QtTest>
+#include <QUdpSocket>
+#include <QHostAddress>
+
+#include "SAKUdpClientDevice.hh"
+#include "SAKUdpServerDevice.hh"
+#include "SAKCommonDataStructure.hh"
+
+/**
+ * @brief The udp devices run over loopback without widgets.
+ */
+class SAKUdpDeviceTest:public QObject
+{
+    Q_OBJECT
+private:
+    quint16 freePort();
+    void closeDevice(SAKDebuggerDevice *device);
+private slots:
+    void loopback();
+    void multicastGroupsWithoutLocalPort();
+};
+
+quint16 SAKUdpDeviceTest::freePort()
+{
+    QUdpSocket socket;
+    socket.bind(QHostAddress::LocalHost, 0);
+    quint16 port = socket.localPort();
+    socket.close();
+    return port;
+}
+
+void SAKUdpDeviceTest::closeDevice(SAKDebuggerDevice *device)
+{
+    if (device->isRunning()) {
+        device->exit();
+        device->wait();
+    }
+}
+
+void SAKUdpDeviceTest::loopback()
+{
+    quint16 serverPort = freePort();
+    quint16 clientPort = freePort();
+    QVERIFY(serverPort && clientPort && (serverPort != clientPort));
+
+    SAKUdpServerParametersContext serverCtx;
+    serverCtx.serverHost = QString("127.0.0.1");
+    serverCtx.serverPort = serverPort;
+    serverCtx.currentClientPort = 0;
+    serverCtx.broadcast = false;
+    SAKUdpServerDevice server(Q_NULLPTR, QString());
+    server.setParametersContext(QVariant::fromValue(serverCtx));
+
+    SAKUdpClientParametersContext clientCtx;
+    clientCtx.peerHost = QString("127.0.0.1");
+    clientCtx.peerPort = serverPort;
+    clientCtx.localHost = QString("127.0.0.1");
+    clientCtx.localPort = clientPort;
+    clientCtx.specifyLocalInfo = true;
+    clientCtx.broadcast = false;
+    SAKUdpClientDevice client(Q_NULLPTR, QString());
+    client.setParametersContext(QVariant::fromValue(clientCtx));
+
+    QSignalSpy serverErrorSpy(&server, &SAKDebuggerDevice::errorOccurred);
+    QSignalSpy serverReadSpy(&server, &SAKDebuggerDevice::bytesRead);
+    QSignalSpy addClientSpy(&server, &SAKUdpServerDevice::addClient);
+    QSignalSpy clientErrorSpy(&client, &SAKDebuggerDevice::errorOccurred);
+    QSignalSpy clientReadSpy(&client, &SAKDebuggerDevice::bytesRead);
+    QSignalSpy clientInfoSpy(&client, &SAKUdpClientDevice::clientInfoChanged);
+
+    server.start();
+    client.start();
+    QTRY_COMPARE(clientInfoSpy.count(), 1);
+    QCOMPARE(clientInfoSpy.first().first().toString(),
+             QString("127.0.0.1:%1").arg(clientPort));
+
+    // The server is bound in its own thread, the datagram may be sent before
+    // the socket is bound.
+    for (int i = 0; (i < 50) && serverReadSpy.isEmpty(); i++) {
+        client.writeBytes(QByteArray("ping"));
+        QTest::qWait(100);
+    }
+    QVERIFY(serverReadSpy.count() > 0);
+    QCOMPARE(serverReadSpy.first().first().toByteArray(), QByteArray("ping"));
+    QVERIFY(addClientSpy.count() > 0);
+    QCOMPARE(addClientSpy.first().at(1).value<quint16>(), clientPort);
+
+    // Reply to the client.
+    serverCtx.currentClientHost = QString("127.0.0.1");
+    serverCtx.currentClientPort = clientPort;
+    serverCtx.clients = QStringList(QString("127.0.0.1:%1").arg(clientPort));
+    server.setParametersContext(QVariant::fromValue(serverCtx));
+    server.writeBytes(QByteArray("pong"));
+    QTRY_COMPARE(clientReadSpy.count(), 1);
+    QCOMPARE(clientReadSpy.first().first().toByteArray(), QByteArray("pong"));
+
+    // The client is bound to a unicast address, the groups can not be joined
+    // but the device keeps running.
+    QSignalSpy joinedSpy(&client, &SAKUdpClientDevice::multicastGroupsJoined);
+    clientCtx.multicastGroups = QStringList(QString("239.255.0.1"));
+    client.setParametersContext(QVariant::fromValue(clientCtx));
+    client.setParametersContext(QVariant::fromValue(clientCtx));
+    QTest::qWait(100);
+    QVERIFY(client.isRunning());
+    QCOMPARE(joinedSpy.count(), 0);
+
+    closeDevice(&client);
+    closeDevice(&server);
+    QCOMPARE(serverErrorSpy.count(), 0);
+    QCOMPARE(clientErrorSpy.count(), 0);
+}
+
+void SAKUdpDeviceTest::multicastGroupsWithoutLocalPort()
+{
+    SAKUdpClientParametersContext ctx;
+    ctx.peerHost = QString("127.0.0.1");
+    ctx.peerPort = freePort();
+    ctx.localHost = QString(SAK_HOST_ADDRESS_ANY);
+    ctx.localPort = 0;
+    ctx.specifyLocalInfo = false;
+    ctx.broadcast = false;
+    ctx.multicastGroups = QStringList(QString("239.255.0.1"));
+    SAKUdpClientDevice client(Q_NULLPTR, QString());
+    client.setParametersContext(QVariant::fromValue(ctx));
+
+    // The group datagrams can not be received, the device is not opened.
+    QSignalSpy errorSpy(&client, &SAKDebuggerDevice::errorOccurred);
+    QSignalSpy finishedSpy(&client, &QThread::finished);
+    client.start();
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(errorSpy.count(), 1);
+    closeDevice(&client);
+}
+
+QTEST_MAIN(SAKUdpDeviceTest)
+
+#include "SAKUdpDeviceTest.moc"
@@ -0,0 +1,45 @@
+QT += testlib network
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+DEFINES += \
+    SAK_IMPORT_MODULE_UDP \
+    SAK_IMPORT_MODULE_UDP_CLIENT \
+    SAK_IMPORT_MODULE_UDP_SERVER \
+    SAK_HOST_ADDRESS_ANY=\"\\\"Any\\\"\"
+
+INCLUDEPATH += \
+    ../../src/common \
+    ../../src/debuggers/debugger/device \
+    ../../src/debuggers/udp/client \
+    ../../src/debuggers/udp/common \
+    ../../src/debuggers/udp/server
+
+SOURCES += \
+    ../../src/common/SAKCommonDataStructure.cc \
+    ../../src/debuggers/debugger/device/SAKDebuggerDevice.cc \
+    ../../src/debuggers/debugger/device/SAKDebuggerDeviceMaskKernel.cc \
+    ../../src/debuggers/debugger/device/SAKDebuggerDeviceParameters.cc \
+    ../../src/debuggers/debugger/device/SAKDebuggerDeviceSocketOptionsKernel.cc \
+    ../../src/debuggers/udp/client/SAKUdpClientDevice.cc \
+    ../../src/debuggers/udp/common/SAKUdpMulticastGroups.cc \
+    ../../src/debuggers/udp/common/SAKUdpSessions.cc \
+    ../../src/debuggers/udp/server/SAKUdpServerDevice.cc \
+    SAKUdpDeviceTest.cc
+
+HEADERS += \
+    ../../src/common/SAKCommonDataStructure.hh \
+    ../../src/debuggers/debugger/device/SAKDebuggerDevice.hh \
+    ../../src/debuggers/debugger/device/SAKDebuggerDeviceMaskKernel.hh \
+    ../../src/debuggers/debugger/device/SAKDebuggerDeviceParameters.hh \
+    ../../src/debuggers/debugger/device/SAKDebuggerDeviceSocketOptionsKernel.hh \
+    ../../src/debuggers/udp/client/SAKUdpClientDevice.hh \
+    ../../src/debuggers/udp/common/SAKUdpMulticastGroups.hh \
+    ../../src/debuggers/udp/common/SAKUdpSessions.hh \
+    ../../src/debuggers/udp/server/SAKUdpServerDevice.hh
+
+win32:LIBS += -lws2_32
@@ -0,0 +1,133 @@
+﻿/****************************************************************************************
+ * Copyright 2021 Qter(qsaker@qq.com). All rights reserved.
+ *
+ * The file is encoded using "utf8 with bom", it is a part
+ * of QtSwissArmyKnife project.
+ *
+ * QtSwissArmyKnife is licensed according to the terms in
+ * the file LICENCE in the root of the source code directory.
+ ***************************************************************************************/
+#include <QtTest>
+#include <QHostAddress>
+
+#include "SAKUdpSessions.hh"
+#include "SAKUdpMulticastGroups.hh"
+
+/**
+ * @brief Per source sessions and multicast group descriptions of udp devices.
+ */
+class SAKUdpSessionsTest:public QObject
+{
+    Q_OBJECT
+private slots:
+    void demultiplex();
+    void idleSessions();
+    void maxSessions();
+    void multicastGroups();
+};
+
+void SAKUdpSessionsTest::demultiplex()
+{
+    SAKUdpSessions sessions;
+    QHostAddress group("239.0.0.1");
+    QHostAddress a("192.168.1.10");
+    QHostAddress b("192.168.1.11");
+    for (int i = 0; i < 10; i++) {
+        sessions.received(a, 5000, group, 100);
+    }
+    sessions.received(b, 5000, group, 8);
+    // IPv4-mapped sources of dual stack sockets are the same sessions.
+    sessions.received(QHostAddress("::ffff:192.168.1.11"), 5000, group, 8);
+    sessions.sent(b, 5000, 4);
+    // Sending to an unknown peer does not create a session.
+    sessions.sent(QHostAddress("10.0.0.1"), 5000, 4);
+    QCOMPARE(sessions.count(), 2);
+
+    auto changed = sessions.takeChanged();
+    QCOMPARE(changed.length(), 2);
+    for (auto &session : changed) {
+        QCOMPARE(session.destination, QString("239.0.0.1"));
+        if (session.host == QString("192.168.1.10")) {
+            QCOMPARE(session.rxDatagrams, qint64(10));
+            QCOMPARE(session.rxBytes, qint64(1000));
+            QCOMPARE(session.txDatagrams, qint64(0));
+        } else {
+            QCOMPARE(session.host, QString("192.168.1.11"));
+            QCOMPARE(session.rxDatagrams, qint64(2));
+            QCOMPARE(session.rxBytes, qint64(16));
+            QCOMPARE(session.txDatagrams, qint64(1));
+            QCOMPARE(session.txBytes, qint64(4));
+        }
+        QVERIFY(session.rxRate > 0);
+    }
+}
+
+void SAKUdpSessionsTest::idleSessions()
+{
+    SAKUdpSessions sessions;
+    QHostAddress a("192.168.1.10");
+    QHostAddress b("192.168.1.11");
+    sessions.received(a, 5000, QHostAddress(), 1);
+    sessions.received(b, 5000, QHostAddress(), 1);
+    QCOMPARE(sessions.takeChanged().length(), 2);
+
+    // b became idle, it is reported once with rx rate 0.
+    sessions.received(a, 5000, QHostAddress(), 1);
+    auto changed = sessions.takeChanged();
+    QCOMPARE(changed.length(), 2);
+    for (auto &session : changed) {
+        if (session.host == QString("192.168.1.11")) {
+            QCOMPARE(session.rxRate, 0.0);
+        }
+    }
+
+    sessions.received(a, 5000, QHostAddress(), 1);
+    changed = sessions.takeChanged();
+    QCOMPARE(changed.length(), 1);
+    QCOMPARE(changed.first().host, QString("192.168.1.10"));
+    QCOMPARE(changed.first().rxDatagrams, qint64(3));
+}
+
+void SAKUdpSessionsTest::maxSessions()
+{
+    SAKUdpSessions sessions(4);
+    for (quint16 port = 1; port <= 6; port++) {
+        sessions.received(QHostAddress::LocalHost, port, QHostAddress(), 1);
+    }
+    QCOMPARE(sessions.count(), 4);
+    QCOMPARE(sessions.droppedDatagrams(), qint64(2));
+
+    sessions.clear();
+    QCOMPARE(sessions.count(), 0);
+    QVERIFY(sessions.takeChanged().isEmpty());
+}
+
+void SAKUdpSessionsTest::multicastGroups()
+{
+    QHostAddress address;
+    QNetworkInterface networkInterface;
+    QVERIFY(SAKUdpMulticastGroups::parse("239.0.0.1", &address, &networkInterface));
+    QCOMPARE(address, QHostAddress("239.0.0.1"));
+    QVERIFY(!networkInterface.isValid());
+    QVERIFY(SAKUdpMulticastGroups::parse("ff02::1", &address, &networkInterface));
+    QCOMPARE(address, QHostAddress("ff02::1"));
+    // The group is not joined on the default interface if the interface is
+    // not found.
+    QVERIFY(!SAKUdpMulticastGroups::parse("239.0.0.1@no-such-interface",
+                                          &address, &networkInterface));
+    QVERIFY(!SAKUdpMulticastGroups::parse("192.168.1.1", &address, &networkInterface));
+
+    QStringList groups;
+    QCOMPARE(SAKUdpMulticastGroups::bindingAddress(groups),
+             QHostAddress(QHostAddress::Any));
+    groups << "239.0.0.1";
+    QCOMPARE(SAKUdpMulticastGroups::bindingAddress(groups),
+             QHostAddress(QHostAddress::AnyIPv4));
+    groups.prepend("ff02::1");
+    QCOMPARE(SAKUdpMulticastGroups::bindingAddress(groups),
+             QHostAddress(QHostAddress::AnyIPv6));
+}
+
+QTEST_MAIN(SAKUdpSessionsTest)
+
+#include "SAKUdpSessionsTest.moc"
@@ -0,0 +1,19 @@
+QT += testlib network
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+INCLUDEPATH += \
+    ../../src/debuggers/udp/common
+
+SOURCES += \
+    ../../src/debuggers/udp/common/SAKUdpMulticastGroups.cc \
+    ../../src/debuggers/udp/common/SAKUdpSessions.cc \
+    SAKUdpSessionsTest.cc
+
+HEADERS += \
+    ../../src/debuggers/udp/common/SAKUdpMulticastGroups.hh \
+    ../../src/debuggers/udp/common/SAKUdpSessions.hh